@@ -6,11 +6,28 @@
 // Core
 #include "Hazel/Application.h"
 #include "Hazel/Log.h"
+#include "Hazel/LogHistory.h"
 #include "Hazel/Layer.h"
 #include "Hazel/LayerStack.h"
+#include "Hazel/FrameClock.h"
+#include "Hazel/FramePipeline.h"
+#include "Hazel/MappedFile.h"
+
+// Threading
+#include "Hazel/Threading/JobSystem.h"
+#include "Hazel/Threading/JobBenchmark.h"
+
+// Memory
+#include "Hazel/Memory/FrameAllocator.h"
+#include "Hazel/Memory/MemoryTracker.h"
+
+// Debug
+#include "Hazel/Debug/Profiler.h"
+#include "Hazel/Debug/FrameTimeHistogram.h"
 
 // Events
 #include "Hazel/Events/Event.h"
+#include "Hazel/Events/EventQueue.h"
 
 // ImGui
 #include "Hazel/ImGui/ImGuiLayer.h"
@@ -19,15 +36,43 @@
 #include "Hazel/Scripting/ScriptEngine.h"
 #include "Hazel/Scripting/ScriptComponent.h"
 
+// Animation
+#include "Hazel/Animation/Pose.h"
+#include "Hazel/Animation/Skeleton.h"
+#include "Hazel/Animation/AnimationClip.h"
+#include "Hazel/Animation/Animator.h"
+
+// Math
+#include "Hazel/Math/TransformBatch.h"
+
+// Scene
+#include "Hazel/Scene/Entity.h"
+#include "Hazel/Scene/Component.h"
+#include "Hazel/Scene/Components.h"
+#include "Hazel/Scene/Scene.h"
+#include "Hazel/Scene/TransformSystem.h"
+#include "Hazel/Scene/SceneFile.h"
+
 // Renderer
 #include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/RenderQueue.h"
+#include "Hazel/Renderer/ParallelDrawList.h"
+#include "Hazel/Renderer/RenderThread.h"
+#include "Hazel/Renderer/GpuProfiler.h"
 #include "Hazel/Renderer/Shader.h"
 #include "Hazel/Renderer/Buffer.h"
 #include "Hazel/Renderer/Camera.h"
 #include "Hazel/Renderer/EditorCamera.h"
+#include "Hazel/Renderer/CameraLatch.h"
 #include "Hazel/Renderer/Material.h"
 #include "Hazel/Renderer/Light.h"
 #include "Hazel/Renderer/MeshGenerator.h"
+#include "Hazel/Renderer/Mesh.h"
+#include "Hazel/Renderer/MeshCache.h"
+#include "Hazel/Renderer/MeshFile.h"
+#include "Hazel/Renderer/MeshImporter.h"
+#include "Hazel/Renderer/SkinnedMesh.h"
+#include "Hazel/Renderer/SkinningBuffer.h"
 #include "Hazel/Renderer/Framebuffer.h"
 
 // ---ENTRY POINT----------------
@@ -0,0 +1,80 @@
+#include "AnimationClip.h"
+#include "Skeleton.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Hazel {
+
+	AnimationClip::AnimationClip(const std::string& name, const Skeleton& skeleton, float duration, float sampleRate)
+		: m_Name(name), m_Duration((std::max)(duration, 0.0f)), m_SampleRate((std::max)(sampleRate, 1.0f))
+	{
+		m_JointCount = skeleton.GetJointCount();
+		m_PaddedJointCount = LocalPose::GetPaddedJointCount(m_JointCount);
+		m_FrameStride = static_cast<size_t>(LocalPose::ChannelCount) * m_PaddedJointCount;
+
+		// One keyframe per sample interval, plus one so 'duration' itself is covered
+		m_FrameCount = static_cast<uint32_t>(std::ceil(m_Duration * m_SampleRate)) + 1;
+
+		const LocalPose& bindPose = skeleton.GetBindPose();
+		m_Keyframes.resize(m_FrameStride * m_FrameCount);
+		for (uint32_t frame = 0; frame < m_FrameCount; frame++)
+			std::copy_n(bindPose.GetData(), m_FrameStride, GetFrame(frame));
+	}
+
+	void AnimationClip::SetJointTransform(uint32_t frame, uint32_t joint, const JointTransform& transform)
+	{
+		float* data = GetFrame(frame);
+		const uint32_t n = m_PaddedJointCount;
+		const float values[LocalPose::ChannelCount] = {
+			transform.Translation.x, transform.Translation.y, transform.Translation.z,
+			transform.Rotation.x, transform.Rotation.y, transform.Rotation.z, transform.Rotation.w,
+			transform.Scale.x, transform.Scale.y, transform.Scale.z
+		};
+
+		for (uint32_t channel = 0; channel < LocalPose::ChannelCount; channel++)
+			data[channel * n + joint] = values[channel];
+	}
+
+	JointTransform AnimationClip::GetJointTransform(uint32_t frame, uint32_t joint) const
+	{
+		const float* data = GetFrame(frame);
+		const uint32_t n = m_PaddedJointCount;
+		auto value = [&](PoseChannel channel) { return data[static_cast<uint32_t>(channel) * n + joint]; };
+
+		JointTransform transform;
+		transform.Translation = glm::vec3(value(PoseChannel::TranslationX), value(PoseChannel::TranslationY), value(PoseChannel::TranslationZ));
+		transform.Rotation = glm::quat(value(PoseChannel::RotationW), value(PoseChannel::RotationX),
+		                               value(PoseChannel::RotationY), value(PoseChannel::RotationZ));
+		transform.Scale = glm::vec3(value(PoseChannel::ScaleX), value(PoseChannel::ScaleY), value(PoseChannel::ScaleZ));
+		return transform;
+	}
+
+	void AnimationClip::Sample(float time, bool loop, LocalPose& out) const
+	{
+		if (out.GetJointCount() != m_JointCount)
+			out.Resize(m_JointCount);
+
+		if (m_Duration > 0.0f)
+		{
+			if (loop)
+			{
+				time = std::fmod(time, m_Duration);
+				if (time < 0.0f)
+					time += m_Duration;
+			}
+			time = std::clamp(time, 0.0f, m_Duration);
+		}
+		else
+		{
+			time = 0.0f;
+		}
+
+		float position = time * m_SampleRate;
+		uint32_t frame = (std::min)(static_cast<uint32_t>(position), m_FrameCount - 1);
+		uint32_t next = (std::min)(frame + 1, m_FrameCount - 1);
+		float weight = position - static_cast<float>(frame);
+
+		PoseOps::Blend(GetFrame(frame), GetFrame(next), weight, out.GetData(), m_PaddedJointCount);
+	}
+
+}
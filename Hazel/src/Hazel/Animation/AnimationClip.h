@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../Core.h"
+#include "Pose.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Hazel {
+
+	class Skeleton;
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about STL types in DLL interface
+#endif
+
+	// Uniformly sampled animation. Each keyframe is stored in the same SoA block
+	// layout as LocalPose, so sampling is a single SIMD blend of two keyframes.
+	class HAZEL_API AnimationClip
+	{
+	public:
+		// All keyframes start out as the skeleton's bind pose
+		AnimationClip(const std::string& name, const Skeleton& skeleton, float duration, float sampleRate = 30.0f);
+
+		void SetJointTransform(uint32_t frame, uint32_t joint, const JointTransform& transform);
+		JointTransform GetJointTransform(uint32_t frame, uint32_t joint) const;
+
+		// Writes the pose at 'time' (seconds) into out, wrapping when looping
+		void Sample(float time, bool loop, LocalPose& out) const;
+
+		const std::string& GetName() const { return m_Name; }
+		float GetDuration() const { return m_Duration; }
+		float GetSampleRate() const { return m_SampleRate; }
+		uint32_t GetFrameCount() const { return m_FrameCount; }
+		uint32_t GetJointCount() const { return m_JointCount; }
+
+	private:
+		float* GetFrame(uint32_t frame) { return m_Keyframes.data() + static_cast<size_t>(frame) * m_FrameStride; }
+		const float* GetFrame(uint32_t frame) const { return m_Keyframes.data() + static_cast<size_t>(frame) * m_FrameStride; }
+
+	private:
+		std::string m_Name;
+		float m_Duration;
+		float m_SampleRate;
+		uint32_t m_FrameCount;
+		uint32_t m_JointCount;
+		uint32_t m_PaddedJointCount;
+		size_t m_FrameStride;
+		std::vector<float> m_Keyframes;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
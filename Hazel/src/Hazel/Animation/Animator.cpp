@@ -0,0 +1,86 @@
+#include "Animator.h"
+#include "../Threading/JobSystem.h"
+#include "../Debug/Profiler.h"
+#include <algorithm>
+
+namespace Hazel {
+
+	// A character costs a few microseconds; batch enough of them to amortize a job
+	static constexpr size_t s_MinAnimatorsPerJob = 16;
+
+	Animator::Animator(const std::shared_ptr<Skeleton>& skeleton)
+		: m_Skeleton(skeleton)
+	{
+		HZ_MEMORY_TAG(Animation);
+
+		uint32_t jointCount = m_Skeleton->GetJointCount();
+		m_Pose = m_Skeleton->GetBindPose();
+		m_FadePose.Resize(jointCount);
+		m_ModelPose.resize(jointCount);
+		m_SkinningMatrices.resize(jointCount);
+	}
+
+	void Animator::Play(const std::shared_ptr<AnimationClip>& clip, bool loop, float speed)
+	{
+		m_Current = { clip, 0.0f, speed, loop };
+		m_Previous = {};
+		m_FadeDuration = 0.0f;
+	}
+
+	void Animator::CrossFade(const std::shared_ptr<AnimationClip>& clip, float duration, bool loop, float speed)
+	{
+		if (!m_Current.Clip || duration <= 0.0f)
+		{
+			Play(clip, loop, speed);
+			return;
+		}
+
+		m_Previous = m_Current;
+		m_Current = { clip, 0.0f, speed, loop };
+		m_FadeElapsed = 0.0f;
+		m_FadeDuration = duration;
+	}
+
+	void Animator::Update(float deltaTime)
+	{
+		m_Current.Time += deltaTime * m_Current.Speed;
+
+		if (m_Current.Clip)
+			m_Current.Clip->Sample(m_Current.Time, m_Current.Loop, m_Pose);
+		else
+			m_Pose = m_Skeleton->GetBindPose();
+
+		if (m_Previous.Clip)
+		{
+			m_Previous.Time += deltaTime * m_Previous.Speed;
+			m_FadeElapsed += deltaTime;
+
+			float weight = m_FadeElapsed / m_FadeDuration;
+			if (weight >= 1.0f)
+			{
+				m_Previous = {};
+			}
+			else
+			{
+				m_Previous.Clip->Sample(m_Previous.Time, m_Previous.Loop, m_FadePose);
+				PoseOps::Blend(m_FadePose, m_Pose, weight, m_Pose);
+			}
+		}
+
+		PoseOps::LocalToModel(*m_Skeleton, m_Pose, m_ModelPose.data());
+		PoseOps::ModelToSkinning(*m_Skeleton, m_ModelPose.data(), m_SkinningMatrices.data());
+	}
+
+	void AnimationSystem::Update(Animator* const* animators, size_t count, float deltaTime)
+	{
+		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_TAG(Animation);
+
+		JobSystem::ParallelFor(count, s_MinAnimatorsPerJob, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+				animators[i]->Update(deltaTime);
+		});
+	}
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "../Core.h"
+#include "AnimationClip.h"
+#include "Pose.h"
+#include "Skeleton.h"
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+namespace Hazel {
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about STL types in DLL interface
+#endif
+
+	// Playback state of one animated character: the current clip, an optional
+	// clip being faded out, and the resulting model-space and skinning matrices
+	class HAZEL_API Animator
+	{
+	public:
+		Animator(const std::shared_ptr<Skeleton>& skeleton);
+
+		void Play(const std::shared_ptr<AnimationClip>& clip, bool loop = true, float speed = 1.0f);
+		// Blends from whatever is playing now to 'clip' over 'duration' seconds
+		void CrossFade(const std::shared_ptr<AnimationClip>& clip, float duration, bool loop = true, float speed = 1.0f);
+
+		// Advances time, samples and blends the clips, then builds the model-space
+		// pose and skinning matrices. Touches only this animator, so many can be
+		// updated concurrently (see AnimationSystem).
+		void Update(float deltaTime);
+
+		const std::shared_ptr<Skeleton>& GetSkeleton() const { return m_Skeleton; }
+		const LocalPose& GetLocalPose() const { return m_Pose; }
+		const std::vector<glm::mat4>& GetModelPose() const { return m_ModelPose; }
+		const std::vector<glm::mat4>& GetSkinningMatrices() const { return m_SkinningMatrices; }
+
+	private:
+		struct Playback
+		{
+			std::shared_ptr<AnimationClip> Clip;
+			float Time = 0.0f;
+			float Speed = 1.0f;
+			bool Loop = true;
+		};
+
+		std::shared_ptr<Skeleton> m_Skeleton;
+		Playback m_Current;
+		Playback m_Previous;
+		float m_FadeElapsed = 0.0f;
+		float m_FadeDuration = 0.0f;
+
+		LocalPose m_Pose;
+		LocalPose m_FadePose;
+		std::vector<glm::mat4> m_ModelPose;
+		std::vector<glm::mat4> m_SkinningMatrices;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+	class HAZEL_API AnimationSystem
+	{
+	public:
+		// Updates many animators at once, spreading them across worker threads
+		static void Update(Animator* const* animators, size_t count, float deltaTime);
+		static void Update(const std::vector<Animator*>& animators, float deltaTime)
+		{
+			Update(animators.data(), animators.size(), deltaTime);
+		}
+	};
+
+}
@@ -0,0 +1,213 @@
+#include "Pose.h"
+#include "Skeleton.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define HZ_POSE_SIMD 1
+	#include <emmintrin.h>
+#else
+	#define HZ_POSE_SIMD 0
+#endif
+
+namespace Hazel {
+
+	glm::mat4 JointTransform::ToMatrix() const
+	{
+		glm::mat4 matrix = glm::mat4_cast(Rotation);
+		matrix[0] *= Scale.x;
+		matrix[1] *= Scale.y;
+		matrix[2] *= Scale.z;
+		matrix[3] = glm::vec4(Translation, 1.0f);
+		return matrix;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// LocalPose ////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	void LocalPose::Resize(uint32_t jointCount)
+	{
+		m_JointCount = jointCount;
+		m_PaddedJointCount = GetPaddedJointCount(jointCount);
+		m_Data.assign(static_cast<size_t>(ChannelCount) * m_PaddedJointCount, 0.0f);
+
+		// Identity everywhere, including the padding lanes, so normalizing a
+		// padded rotation never divides by zero
+		std::fill_n(GetChannel(PoseChannel::RotationW), m_PaddedJointCount, 1.0f);
+		std::fill_n(GetChannel(PoseChannel::ScaleX), m_PaddedJointCount * 3, 1.0f);
+	}
+
+	void LocalPose::SetJoint(uint32_t joint, const JointTransform& transform)
+	{
+		GetChannel(PoseChannel::TranslationX)[joint] = transform.Translation.x;
+		GetChannel(PoseChannel::TranslationY)[joint] = transform.Translation.y;
+		GetChannel(PoseChannel::TranslationZ)[joint] = transform.Translation.z;
+		GetChannel(PoseChannel::RotationX)[joint] = transform.Rotation.x;
+		GetChannel(PoseChannel::RotationY)[joint] = transform.Rotation.y;
+		GetChannel(PoseChannel::RotationZ)[joint] = transform.Rotation.z;
+		GetChannel(PoseChannel::RotationW)[joint] = transform.Rotation.w;
+		GetChannel(PoseChannel::ScaleX)[joint] = transform.Scale.x;
+		GetChannel(PoseChannel::ScaleY)[joint] = transform.Scale.y;
+		GetChannel(PoseChannel::ScaleZ)[joint] = transform.Scale.z;
+	}
+
+	JointTransform LocalPose::GetJoint(uint32_t joint) const
+	{
+		JointTransform transform;
+		transform.Translation = glm::vec3(GetChannel(PoseChannel::TranslationX)[joint],
+		                                  GetChannel(PoseChannel::TranslationY)[joint],
+		                                  GetChannel(PoseChannel::TranslationZ)[joint]);
+		transform.Rotation = glm::quat(GetChannel(PoseChannel::RotationW)[joint],
+		                               GetChannel(PoseChannel::RotationX)[joint],
+		                               GetChannel(PoseChannel::RotationY)[joint],
+		                               GetChannel(PoseChannel::RotationZ)[joint]);
+		transform.Scale = glm::vec3(GetChannel(PoseChannel::ScaleX)[joint],
+		                            GetChannel(PoseChannel::ScaleY)[joint],
+		                            GetChannel(PoseChannel::ScaleZ)[joint]);
+		return transform;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// PoseOps //////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	void PoseOps::Blend(const float* a, const float* b, float weight, float* out, uint32_t paddedJointCount)
+	{
+		const uint32_t n = paddedJointCount;
+		const uint32_t rotation = static_cast<uint32_t>(PoseChannel::RotationX) * n;
+		const uint32_t scale = static_cast<uint32_t>(PoseChannel::ScaleX) * n;
+		const uint32_t end = LocalPose::ChannelCount * n;
+
+#if HZ_POSE_SIMD
+		const __m128 t = _mm_set1_ps(weight);
+
+		// Translation and scale streams are plain lerps
+		auto lerpRange = [&](uint32_t begin, uint32_t last)
+		{
+			for (uint32_t i = begin; i < last; i += LocalPose::Lanes)
+			{
+				__m128 va = _mm_loadu_ps(a + i);
+				__m128 vb = _mm_loadu_ps(b + i);
+				_mm_storeu_ps(out + i, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), t)));
+			}
+		};
+		lerpRange(0, rotation);
+		lerpRange(scale, end);
+
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 three = _mm_set1_ps(3.0f);
+		for (uint32_t j = 0; j < n; j += LocalPose::Lanes)
+		{
+			const float* qa = a + rotation + j;
+			const float* qb = b + rotation + j;
+			float* qo = out + rotation + j;
+
+			__m128 ax = _mm_loadu_ps(qa), ay = _mm_loadu_ps(qa + n), az = _mm_loadu_ps(qa + 2 * n), aw = _mm_loadu_ps(qa + 3 * n);
+			__m128 bx = _mm_loadu_ps(qb), by = _mm_loadu_ps(qb + n), bz = _mm_loadu_ps(qb + 2 * n), bw = _mm_loadu_ps(qb + 3 * n);
+
+			// Take the shortest arc: flip b wherever dot(a, b) < 0
+			__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+			                        _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+			__m128 flip = _mm_and_ps(dot, signMask);
+			bx = _mm_xor_ps(bx, flip);
+			by = _mm_xor_ps(by, flip);
+			bz = _mm_xor_ps(bz, flip);
+			bw = _mm_xor_ps(bw, flip);
+
+			__m128 rx = _mm_add_ps(ax, _mm_mul_ps(_mm_sub_ps(bx, ax), t));
+			__m128 ry = _mm_add_ps(ay, _mm_mul_ps(_mm_sub_ps(by, ay), t));
+			__m128 rz = _mm_add_ps(az, _mm_mul_ps(_mm_sub_ps(bz, az), t));
+			__m128 rw = _mm_add_ps(aw, _mm_mul_ps(_mm_sub_ps(bw, aw), t));
+
+			// Normalize with rsqrt refined by one Newton-Raphson step
+			__m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)),
+			                                  _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw)));
+			__m128 estimate = _mm_rsqrt_ps(lengthSquared);
+			__m128 inverseLength = _mm_mul_ps(_mm_mul_ps(half, estimate),
+			                                  _mm_sub_ps(three, _mm_mul_ps(lengthSquared, _mm_mul_ps(estimate, estimate))));
+
+			_mm_storeu_ps(qo, _mm_mul_ps(rx, inverseLength));
+			_mm_storeu_ps(qo + n, _mm_mul_ps(ry, inverseLength));
+			_mm_storeu_ps(qo + 2 * n, _mm_mul_ps(rz, inverseLength));
+			_mm_storeu_ps(qo + 3 * n, _mm_mul_ps(rw, inverseLength));
+		}
+#else
+		for (uint32_t i = 0; i < rotation; i++)
+			out[i] = a[i] + (b[i] - a[i]) * weight;
+		for (uint32_t i = scale; i < end; i++)
+			out[i] = a[i] + (b[i] - a[i]) * weight;
+
+		for (uint32_t j = 0; j < n; j++)
+		{
+			const float* qa = a + rotation + j;
+			const float* qb = b + rotation + j;
+			float* qo = out + rotation + j;
+
+			float dot = qa[0] * qb[0] + qa[n] * qb[n] + qa[2 * n] * qb[2 * n] + qa[3 * n] * qb[3 * n];
+			float sign = dot < 0.0f ? -1.0f : 1.0f;
+
+			float r[4];
+			float lengthSquared = 0.0f;
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				r[c] = qa[c * n] + (sign * qb[c * n] - qa[c * n]) * weight;
+				lengthSquared += r[c] * r[c];
+			}
+
+			float inverseLength = 1.0f / std::sqrt(lengthSquared);
+			for (uint32_t c = 0; c < 4; c++)
+				qo[c * n] = r[c] * inverseLength;
+		}
+#endif
+	}
+
+	void PoseOps::Blend(const LocalPose& a, const LocalPose& b, float weight, LocalPose& out)
+	{
+		if (out.GetJointCount() != a.GetJointCount())
+			out.Resize(a.GetJointCount());
+
+		Blend(a.GetData(), b.GetData(), weight, out.GetData(), a.GetPaddedJointCount());
+	}
+
+	void PoseOps::LocalToModel(const Skeleton& skeleton, const LocalPose& pose, glm::mat4* outModel)
+	{
+		const float* tx = pose.GetChannel(PoseChannel::TranslationX);
+		const float* ty = pose.GetChannel(PoseChannel::TranslationY);
+		const float* tz = pose.GetChannel(PoseChannel::TranslationZ);
+		const float* rx = pose.GetChannel(PoseChannel::RotationX);
+		const float* ry = pose.GetChannel(PoseChannel::RotationY);
+		const float* rz = pose.GetChannel(PoseChannel::RotationZ);
+		const float* rw = pose.GetChannel(PoseChannel::RotationW);
+		const float* sx = pose.GetChannel(PoseChannel::ScaleX);
+		const float* sy = pose.GetChannel(PoseChannel::ScaleY);
+		const float* sz = pose.GetChannel(PoseChannel::ScaleZ);
+
+		const int32_t* parents = skeleton.GetParents().data();
+		const uint32_t jointCount = (std::min)(skeleton.GetJointCount(), pose.GetJointCount());
+		for (uint32_t i = 0; i < jointCount; i++)
+		{
+			glm::mat4 local = glm::mat4_cast(glm::quat(rw[i], rx[i], ry[i], rz[i]));
+			local[0] *= sx[i];
+			local[1] *= sy[i];
+			local[2] *= sz[i];
+			local[3] = glm::vec4(tx[i], ty[i], tz[i], 1.0f);
+
+			outModel[i] = parents[i] >= 0 ? outModel[parents[i]] * local : local;
+		}
+	}
+
+	void PoseOps::ModelToSkinning(const Skeleton& skeleton, const glm::mat4* model, glm::mat4* outSkinning)
+	{
+		const glm::mat4* inverseBind = skeleton.GetInverseBindMatrices().data();
+		for (uint32_t i = 0; i < skeleton.GetJointCount(); i++)
+			outSkinning[i] = model[i] * inverseBind[i];
+	}
+
+	bool PoseOps::IsSimdEnabled()
+	{
+		return HZ_POSE_SIMD != 0;
+	}
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "../Core.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Hazel {
+
+	// Local transform of one joint relative to its parent
+	struct JointTransform
+	{
+		glm::vec3 Translation = glm::vec3(0.0f);
+		glm::quat Rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+		glm::vec3 Scale = glm::vec3(1.0f);
+
+		glm::mat4 ToMatrix() const;
+	};
+
+	// Component streams of a LocalPose, each GetPaddedJointCount() floats long
+	enum class PoseChannel : uint32_t
+	{
+		TranslationX = 0, TranslationY, TranslationZ,
+		RotationX, RotationY, RotationZ, RotationW,
+		ScaleX, ScaleY, ScaleZ,
+		Count
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about STL types in DLL interface
+#endif
+
+	// Structure-of-arrays local pose. Every component lives in its own stream so
+	// sampling and blending process four joints per SIMD instruction. The joint
+	// count is padded to a multiple of four with identity transforms.
+	class HAZEL_API LocalPose
+	{
+	public:
+		static constexpr uint32_t ChannelCount = static_cast<uint32_t>(PoseChannel::Count);
+		static constexpr uint32_t Lanes = 4;
+
+		LocalPose() = default;
+		explicit LocalPose(uint32_t jointCount) { Resize(jointCount); }
+
+		void Resize(uint32_t jointCount);
+
+		uint32_t GetJointCount() const { return m_JointCount; }
+		uint32_t GetPaddedJointCount() const { return m_PaddedJointCount; }
+
+		float* GetChannel(PoseChannel channel) { return m_Data.data() + static_cast<uint32_t>(channel) * m_PaddedJointCount; }
+		const float* GetChannel(PoseChannel channel) const { return m_Data.data() + static_cast<uint32_t>(channel) * m_PaddedJointCount; }
+
+		// All channels back to back (ChannelCount * GetPaddedJointCount() floats)
+		float* GetData() { return m_Data.data(); }
+		const float* GetData() const { return m_Data.data(); }
+
+		void SetJoint(uint32_t joint, const JointTransform& transform);
+		JointTransform GetJoint(uint32_t joint) const;
+
+		static uint32_t GetPaddedJointCount(uint32_t jointCount) { return (jointCount + Lanes - 1) / Lanes * Lanes; }
+
+	private:
+		std::vector<float> m_Data;
+		uint32_t m_JointCount = 0;
+		uint32_t m_PaddedJointCount = 0;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+	class Skeleton;
+
+	class HAZEL_API PoseOps
+	{
+	public:
+		// out = lerp(a, b, weight) for translation and scale, shortest-path nlerp for
+		// rotations. Operates on raw SoA blocks of ChannelCount * paddedJointCount
+		// floats so clip keyframes and poses share the same code. out may alias a or b.
+		static void Blend(const float* a, const float* b, float weight, float* out, uint32_t paddedJointCount);
+		static void Blend(const LocalPose& a, const LocalPose& b, float weight, LocalPose& out);
+
+		// Concatenates local transforms down the hierarchy (parents precede children)
+		static void LocalToModel(const Skeleton& skeleton, const LocalPose& pose, glm::mat4* outModel);
+
+		// skinning[i] = model[i] * inverseBind[i]
+		static void ModelToSkinning(const Skeleton& skeleton, const glm::mat4* model, glm::mat4* outSkinning);
+
+		// True when Blend runs on SSE; false for the portable scalar path
+		static bool IsSimdEnabled();
+	};
+
+}
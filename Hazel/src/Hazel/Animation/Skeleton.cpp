@@ -0,0 +1,46 @@
+#include "Skeleton.h"
+#include "../Log.h"
+
+namespace Hazel {
+
+	int32_t Skeleton::AddJoint(const std::string& name, int32_t parent, const JointTransform& bindTransform)
+	{
+		uint32_t index = GetJointCount();
+		if (index >= MaxJoints)
+		{
+			HZ_ERROR("Skeleton: cannot add joint '{}', limit is {}", name, MaxJoints);
+			return -1;
+		}
+		if (parent >= static_cast<int32_t>(index) || parent < -1)
+		{
+			HZ_ERROR("Skeleton: joint '{}' must be added after its parent", name);
+			return -1;
+		}
+
+		glm::mat4 local = bindTransform.ToMatrix();
+		glm::mat4 model = parent >= 0 ? m_BindModel[parent] * local : local;
+
+		m_Names.push_back(name);
+		m_Parents.push_back(parent);
+		m_BindModel.push_back(model);
+		m_InverseBindMatrices.push_back(glm::inverse(model));
+
+		// Keep the existing joints when the padded size grows
+		LocalPose bindPose(index + 1);
+		for (uint32_t i = 0; i < index; i++)
+			bindPose.SetJoint(i, m_BindPose.GetJoint(i));
+		bindPose.SetJoint(index, bindTransform);
+		m_BindPose = std::move(bindPose);
+
+		return static_cast<int32_t>(index);
+	}
+
+	int32_t Skeleton::FindJoint(const std::string& name) const
+	{
+		for (size_t i = 0; i < m_Names.size(); i++)
+			if (m_Names[i] == name)
+				return static_cast<int32_t>(i);
+		return -1;
+	}
+
+}
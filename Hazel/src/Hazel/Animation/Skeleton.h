@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../Core.h"
+#include "Pose.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Hazel {
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about STL types in DLL interface
+#endif
+
+	// Joint hierarchy with its bind pose. Joints are stored parents-first, which
+	// AddJoint enforces, so model-space poses are built in a single forward pass.
+	class HAZEL_API Skeleton
+	{
+	public:
+		// Upper bound shared with the GPU bone-matrix buffer
+		static constexpr uint32_t MaxJoints = 128;
+
+		// Returns the new joint index, or -1 if the parent is invalid or the skeleton is full.
+		// The inverse bind matrix is derived from the bind transforms.
+		int32_t AddJoint(const std::string& name, int32_t parent, const JointTransform& bindTransform);
+
+		// Override the derived inverse bind matrix (e.g. with one from an asset file)
+		void SetInverseBindMatrix(uint32_t joint, const glm::mat4& inverseBind) { m_InverseBindMatrices[joint] = inverseBind; }
+
+		uint32_t GetJointCount() const { return static_cast<uint32_t>(m_Parents.size()); }
+		int32_t GetParent(uint32_t joint) const { return m_Parents[joint]; }
+		const std::string& GetJointName(uint32_t joint) const { return m_Names[joint]; }
+		int32_t FindJoint(const std::string& name) const;
+
+		const std::vector<int32_t>& GetParents() const { return m_Parents; }
+		const std::vector<glm::mat4>& GetInverseBindMatrices() const { return m_InverseBindMatrices; }
+		const LocalPose& GetBindPose() const { return m_BindPose; }
+
+	private:
+		std::vector<std::string> m_Names;
+		std::vector<int32_t> m_Parents;
+		std::vector<glm::mat4> m_BindModel;
+		std::vector<glm::mat4> m_InverseBindMatrices;
+		LocalPose m_BindPose;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
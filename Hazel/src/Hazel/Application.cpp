@@ -1,8 +1,19 @@
 #include "Application.h"
 #include "Log.h"
+#include "FramePipeline.h"
+#include "Threading/JobSystem.h"
+#include "Threading/JobBenchmark.h"
+#include "Memory/FrameAllocator.h"
+#include "Memory/MemoryTracker.h"
+#include "Debug/Profiler.h"
 #include "Scripting/ScriptEngine.h"
 #include "ImGui/ImGuiLayer.h"
 #include "Renderer/Renderer.h"
+#include "Renderer/RenderThread.h"
+#include "Renderer/GpuProfiler.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <GLFW/glfw3.h>
 
@@ -12,55 +23,107 @@ namespace Hazel
 
 	static void GLFWErrorCallback(int error, const char* description)
 	{
-		std::string msg = "GLFW Error (" + std::to_string(error) + "): " + std::string(description);
-		HZ_ERROR(msg);
+		HZ_ERROR("GLFW Error ({}): {}", error, description);
 	}
 
-	Application::Application()
+	namespace {
+
+		// Gives a layer that calls OpenGL directly the context for one callback
+		class LayerContextScope
+		{
+		public:
+			LayerContextScope(Application& app, const Layer* layer)
+				: m_App(layer->UsesDirectOpenGL() ? &app : nullptr)
+			{
+				if (m_App)
+					m_App->AcquireRenderContext();
+			}
+
+			~LayerContextScope()
+			{
+				if (m_App)
+					m_App->ReleaseRenderContext();
+			}
+
+		private:
+			Application* m_App;
+		};
+
+		void PushEvent(GLFWwindow* window, const Event& event)
+		{
+			static_cast<Application*>(glfwGetWindowUserPointer(window))->GetEventQueue().Push(event);
+		}
+
+	}
+
+	Application::Application(const ApplicationSettings& settings)
+		: m_Settings(settings)
 	{
+		HZ_MEMORY_TAG(Core);
+
 		s_Instance = this;
 
 		// Initialize logging system
-		Log::Init();
+		Log::Init("Hazel.log");
 		HZ_INFO("Hazel Engine Starting...");
 
-		// Initialize GLFW
-		if (!glfwInit())
-		{
-			HZ_FATAL("Failed to initialize GLFW!");
+		Profiler::SetThreadName("Main Thread");
+
+		// Start the worker pool; this thread becomes worker 0
+		JobSystem::Init();
+
+		// Scratch memory for the frame loop
+		FrameAllocator::Init();
+
+		// The benchmark needs the job system to itself; nothing else starts
+		if (m_Settings.JobBenchmark)
 			return;
-		}
 
 		glfwSetErrorCallback(GLFWErrorCallback);
 
-		// Set OpenGL version hints
-		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+		// Nobody watches a headless run, so it renders as fast as it can
+		if (m_Settings.Headless)
+			m_FrameLimitMode = FrameLimitMode::Uncapped;
 
-		// Create window
-		m_Window = glfwCreateWindow(1920, 1080, "Hazel Editor", nullptr, nullptr);
-		if (!m_Window)
+		if (!CreateMainWindow())
 		{
-			HZ_FATAL("Failed to create GLFW window!");
-			glfwTerminate();
+			m_ExitCode = ExitCode::StartupFailed;
 			return;
 		}
 
 		glfwMakeContextCurrent(m_Window);
-		glfwSwapInterval(1); // Enable vsync
+		glfwSwapInterval(GetSwapInterval());
+
+		// Before ImGuiLayer attaches: its GLFW backend chains to these callbacks
+		InstallEventCallbacks();
 
 		HZ_INFO("GLFW Window created successfully");
 
 		// Initialize renderer (must be done after OpenGL context is created)
-		Renderer::Init();
+		if (!Renderer::Init())
+		{
+			// Without a window no layers attach and Run() reports the failure
+			HZ_FATAL("Failed to initialize the renderer!");
+			glfwDestroyWindow(m_Window);
+			m_Window = nullptr;
+			m_ExitCode = ExitCode::StartupFailed;
+			return;
+		}
 
 		// Initialize scripting engine
 		ScriptEngine::Init();
+
+		m_Pipeline = std::make_unique<FramePipeline>();
 	}
 
 	Application::~Application()
 	{
+		// Take the context back before anything releases GPU objects
+		StopRenderThread();
+
+		// Recorded frames reference GPU objects; drop them while the context is alive
+		m_Pipeline.reset();
+
 		// Shutdown renderer
 		Renderer::Shutdown();
 
@@ -89,12 +152,190 @@ namespace Hazel
 		}
 		glfwTerminate();
 
+		// Stop the worker pool
+		JobSystem::Shutdown();
+
+		FrameAllocator::Shutdown();
+
 		// Shutdown logging
 		Log::Shutdown();
 	}
 
+	ApplicationSettings Application::ParseCommandLine(int argc, char** argv)
+	{
+		ApplicationSettings settings;
+		for (int i = 1; i < argc; i++)
+		{
+			std::string arg = argv[i];
+			size_t equals = arg.find('=');
+			std::string key = arg.substr(0, equals);
+			std::string value = equals == std::string::npos ? std::string() : arg.substr(equals + 1);
+
+			if (key == "--headless")
+				settings.Headless = true;
+			else if (key == "--frames" && !value.empty())
+				settings.FrameCount = std::strtoull(value.c_str(), nullptr, 10);
+			else if (key == "--stats" && !value.empty())
+				settings.StatsPath = value;
+			else if (key == "--max-p95-ms" && !value.empty())
+				settings.MaxFrameTimeP95 = std::strtof(value.c_str(), nullptr);
+			else if (key == "--width" && !value.empty())
+				settings.Width = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+			else if (key == "--height" && !value.empty())
+				settings.Height = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+			else if (key == "--job-benchmark")
+				settings.JobBenchmark = true;
+			else
+				HZ_WARN("Ignoring unknown command line argument {}", arg);
+		}
+		return settings;
+	}
+
+	bool Application::CreateMainWindow()
+	{
+		// The null platform needs no display; it has to be chosen before glfwInit
+		if (m_Settings.Headless)
+		{
+			if (!glfwPlatformSupported(GLFW_PLATFORM_NULL))
+			{
+				HZ_FATAL("Headless mode needs GLFW built with the null platform");
+				return false;
+			}
+			glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+		}
+
+		// Initialize GLFW
+		if (!glfwInit())
+		{
+			HZ_FATAL("Failed to initialize GLFW!");
+			return false;
+		}
+
+		// Set OpenGL version hints
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+		if (!m_Settings.Headless)
+		{
+			m_Window = glfwCreateWindow(m_Settings.Width, m_Settings.Height, m_Settings.Name.c_str(), nullptr, nullptr);
+			if (!m_Window)
+			{
+				HZ_FATAL("Failed to create GLFW window!");
+				glfwTerminate();
+				return false;
+			}
+			return true;
+		}
+
+		// OSMesa renders into client memory; EGL renders into a pbuffer, which
+		// Mesa offers without a display through EGL_PLATFORM=surfaceless
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		const struct { int Api; const char* Name; } contextApis[] = {
+			{ GLFW_OSMESA_CONTEXT_API, "OSMesa" },
+			{ GLFW_EGL_CONTEXT_API, "EGL" }
+		};
+		for (const auto& api : contextApis)
+		{
+			glfwWindowHint(GLFW_CONTEXT_CREATION_API, api.Api);
+			m_Window = glfwCreateWindow(m_Settings.Width, m_Settings.Height, m_Settings.Name.c_str(), nullptr, nullptr);
+			if (m_Window)
+			{
+				HZ_INFO("Headless OpenGL context created through {}", api.Name);
+				return true;
+			}
+			HZ_WARN("Headless OpenGL context through {} is not available", api.Name);
+		}
+
+		HZ_FATAL("Failed to create a headless OpenGL context!");
+		glfwTerminate();
+		return false;
+	}
+
+	void Application::InstallEventCallbacks()
+	{
+		glfwSetWindowUserPointer(m_Window, this);
+
+		glfwSetWindowCloseCallback(m_Window, [](GLFWwindow* window)
+		{
+			PushEvent(window, Event(EventType::WindowClose));
+		});
+
+		glfwSetWindowSizeCallback(m_Window, [](GLFWwindow* window, int width, int height)
+		{
+			Event event(EventType::WindowResize);
+			event.WindowSize = { static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
+			PushEvent(window, event);
+		});
+
+		glfwSetWindowPosCallback(m_Window, [](GLFWwindow* window, int x, int y)
+		{
+			Event event(EventType::WindowMoved);
+			event.WindowPosition = { x, y };
+			PushEvent(window, event);
+		});
+
+		glfwSetWindowFocusCallback(m_Window, [](GLFWwindow* window, int focused)
+		{
+			PushEvent(window, Event(focused ? EventType::WindowFocus : EventType::WindowLostFocus));
+		});
+
+		glfwSetKeyCallback(m_Window, [](GLFWwindow* window, int key, int scancode, int action, int mods)
+		{
+			Event event(action == GLFW_RELEASE ? EventType::KeyReleased : EventType::KeyPressed);
+			event.Key = { key, mods, action == GLFW_REPEAT };
+			PushEvent(window, event);
+		});
+
+		glfwSetCharCallback(m_Window, [](GLFWwindow* window, unsigned int codePoint)
+		{
+			Event event(EventType::KeyTyped);
+			event.Char = { codePoint };
+			PushEvent(window, event);
+		});
+
+		glfwSetMouseButtonCallback(m_Window, [](GLFWwindow* window, int button, int action, int mods)
+		{
+			Event event(action == GLFW_PRESS ? EventType::MouseButtonPressed : EventType::MouseButtonReleased);
+			event.MouseButton = { button, mods };
+			PushEvent(window, event);
+		});
+
+		glfwSetCursorPosCallback(m_Window, [](GLFWwindow* window, double x, double y)
+		{
+			Event event(EventType::MouseMoved);
+			event.MousePosition = { static_cast<float>(x), static_cast<float>(y) };
+			PushEvent(window, event);
+		});
+
+		glfwSetScrollCallback(m_Window, [](GLFWwindow* window, double xOffset, double yOffset)
+		{
+			Event event(EventType::MouseScrolled);
+			event.Scroll = { static_cast<float>(xOffset), static_cast<float>(yOffset) };
+			PushEvent(window, event);
+		});
+	}
+
+	void Application::DispatchEvents()
+	{
+		if (m_EventQueue.GetSize() > 0)
+			m_EventQueue.Dispatch(m_LayerStack);
+	}
+
 	void Application::Run()
 	{
+		if (m_Settings.JobBenchmark)
+		{
+			JobBenchmark::LogResults(JobBenchmark::RunScaling());
+			return;
+		}
+
+		if (!m_Window)
+		{
+			HZ_ERROR("Application::Run() - no window, nothing to run");
+			return;
+		}
+
 		HZ_INFO("Application::Run() - Main loop started");
 
 		// Find ImGuiLayer
@@ -106,54 +347,313 @@ namespace Hazel
 				break;
 		}
 
+		m_Clock.Reset();
 		while (m_Running && !glfwWindowShouldClose(m_Window))
 		{
-			// Calculate delta time
-			float time = (float)glfwGetTime();
-			float deltaTime = time - m_LastFrameTime;
-			m_LastFrameTime = time;
+			int64_t updateStart = FrameClock::Now();
+			double deltaTime = m_Clock.Tick();
+
+			FrameStep step;
+			step.DeltaTime = static_cast<float>(deltaTime);
+			step.FixedSteps = m_FixedTimestep.Advance(deltaTime);
+			step.FixedDeltaTime = static_cast<float>(m_FixedTimestep.GetStep());
+			step.Alpha = m_FixedTimestep.GetAlpha();
+			step.FrameIndex = m_Clock.GetFrameCount();
+
+			// The first frame has no predecessor to measure from
+			if (m_Clock.GetFrameCount() > 1)
+				m_FrameTimes.AddSample(static_cast<float>(deltaTime * 1000.0));
+
+			// Frame memory from two frames ago is recycled. A pipelined simulation
+			// still running may allocate meanwhile; FrameAllocator.h says why
+			// that is safe.
+			FrameAllocator::BeginFrame();
+			MemoryTracker::BeginFrame();
+			Profiler::BeginFrame();
+
+			HZ_PROFILE_SCOPE("Frame");
 
 			// Poll events
-			glfwPollEvents();
+			{
+				HZ_PROFILE_SCOPE("Application::PollEvents");
+				glfwPollEvents();
+			}
+
+			UpdateRenderThread();
+			if (m_RenderThread)
+			{
+				HZ_PROFILE_SCOPE("RenderThread::BeginFrame");
+				m_RenderThread->BeginFrame();
+			}
+			if (m_SwapIntervalDirty)
+				ApplySwapInterval();
+			Renderer::BeginFrame();
+			GpuProfiler::BeginFrame();
+
+			if (m_FrameMode == FrameMode::Pipelined && m_Pipeline->HasPipelinedLayers(m_LayerStack))
+			{
+				RunPipelinedFrame(imguiLayer, step);
+			}
+			else
+			{
+				// Nothing may still be simulating when layers update in place
+				m_Pipeline->Flush();
+				m_FrameStep = step;
+				RunSerialFrame(imguiLayer, step);
+			}
+
+			// Swap buffers; the render thread presents the frames it replays
+			GpuProfiler::EndFrame();
+			m_UpdateTimes.AddSample(static_cast<float>((FrameClock::Now() - updateStart) / 1.0e6));
+
+			{
+				HZ_PROFILE_SCOPE("Application::Present");
+				if (m_RenderThread)
+					m_RenderThread->SubmitFrame();
+				else
+				{
+					glfwSwapBuffers(m_Window);
+					Renderer::OnPresented();
+				}
+			}
+
+			if (m_FrameLimitMode == FrameLimitMode::TargetFps)
+			{
+				HZ_PROFILE_SCOPE("Application::LimitFrameRate");
+				m_FrameLimiter.Wait();
+			}
+
+			if (m_Settings.FrameCount > 0 && m_Clock.GetFrameCount() >= m_Settings.FrameCount)
+				m_Running = false;
+		}
+
+		m_Pipeline->Flush();
+		StopRenderThread();
+
+		HZ_INFO("Application::Run() - Main loop ended");
+		ReportRun();
+	}
+
+	static void WriteSummaryJson(std::ofstream& stream, const char* name, const FrameTimeSummary& summary)
+	{
+		char line[256];
+		std::snprintf(line, sizeof(line),
+		              "  \"%s\": { \"samples\": %u, \"avg_ms\": %.3f, \"p50_ms\": %.3f, \"p95_ms\": %.3f, \"p99_ms\": %.3f, \"max_ms\": %.3f, \"hitches\": %llu }",
+		              name, summary.SampleCount, summary.Average, summary.P50, summary.P95, summary.P99, summary.Max,
+		              static_cast<unsigned long long>(summary.TotalHitches));
+		stream << line;
+	}
+
+	void Application::ReportRun()
+	{
+		FrameTimeSummary frame = m_FrameTimes.GetSummary();
+		FrameTimeSummary update = m_UpdateTimes.GetSummary();
+		RendererStats renderer = Renderer::GetStats();
+
+		HZ_INFO("Run: {} frames in {:.2} s, frame p50 {:.2} / p95 {:.2} / p99 {:.2} / max {:.2} ms, update p95 {:.2} ms, {} hitches",
+		        m_Clock.GetFrameCount(), m_Clock.GetElapsedSeconds(), frame.P50, frame.P95, frame.P99, frame.Max,
+		        update.P95, frame.TotalHitches);
+
+		char line[256];
+
+		if (!m_Settings.StatsPath.empty())
+		{
+			std::ofstream stream(m_Settings.StatsPath, std::ios::trunc);
+			if (stream)
+			{
+				std::snprintf(line, sizeof(line), "{\n  \"frames\": %llu,\n  \"seconds\": %.3f,\n  \"headless\": %s,\n",
+				              static_cast<unsigned long long>(m_Clock.GetFrameCount()), m_Clock.GetElapsedSeconds(),
+				              m_Settings.Headless ? "true" : "false");
+				stream << line;
+				// Percentiles cover the last 600 frames; hitches the whole run
+				WriteSummaryJson(stream, "frame", frame);
+				stream << ",\n";
+				WriteSummaryJson(stream, "update", update);
+				std::snprintf(line, sizeof(line),
+				              ",\n  \"last_frame\": { \"draw_calls\": %u, \"triangles\": %llu, \"gpu_ms\": %.3f }\n}\n",
+				              renderer.DrawCalls, static_cast<unsigned long long>(renderer.Triangles),
+				              GpuProfiler::GetLastFrame().FrameMilliseconds);
+				stream << line;
+			}
 
-			// Clear the screen
-			Renderer::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
-			Renderer::Clear();
+			if (!stream)
+			{
+				HZ_ERROR("Failed to write run statistics to {}", m_Settings.StatsPath);
+				m_ExitCode = ExitCode::StatsWriteFailed;
+				return;
+			}
+			HZ_INFO("Run statistics written to {}", m_Settings.StatsPath);
+		}
 
-			// Update all layers
+		if (m_Settings.MaxFrameTimeP95 > 0.0f && frame.P95 > m_Settings.MaxFrameTimeP95)
+		{
+			HZ_ERROR("Frame time p95 of {:.2} ms is over the {:.2} ms budget", frame.P95, m_Settings.MaxFrameTimeP95);
+			m_ExitCode = ExitCode::OverBudget;
+		}
+	}
+
+	void Application::RunSerialFrame(ImGuiLayer* imguiLayer, const FrameStep& step)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		// Clear the screen
+		Renderer::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
+		Renderer::Clear();
+
+		DispatchEvents();
+
+		// Update all layers
+		{
+			HZ_PROFILE_SCOPE("Layers::OnUpdate");
 			for (Layer* layer : m_LayerStack)
 			{
-				layer->OnUpdate(deltaTime);
+				LayerContextScope context(*this, layer);
+				for (uint32_t i = 0; i < step.FixedSteps; i++)
+					layer->OnFixedUpdate(step.FixedDeltaTime);
+				layer->OnUpdate(step.DeltaTime);
 			}
+		}
 
-			// Start ImGui frame
-			if (imguiLayer)
-				imguiLayer->Begin();
+		// Start ImGui frame
+		if (imguiLayer)
+			imguiLayer->Begin();
 
-			// Render ImGui for all layers
+		// Render ImGui for all layers
+		{
+			HZ_PROFILE_SCOPE("Layers::OnImGuiRender");
 			for (Layer* layer : m_LayerStack)
 			{
+				LayerContextScope context(*this, layer);
 				layer->OnImGuiRender();
 			}
+		}
 
-			// End ImGui frame
-			if (imguiLayer)
-				imguiLayer->End();
+		// End ImGui frame
+		if (imguiLayer)
+			imguiLayer->End();
+	}
+
+	void Application::RunPipelinedFrame(ImGuiLayer* imguiLayer, const FrameStep& step)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		// Sync point: the frame simulated during the previous iteration becomes the one to render
+		m_Pipeline->Sync(m_LayerStack);
+		// Safe to publish now: the simulation that read the previous step has finished
+		m_FrameStep = step;
+		// Events reach the layers between simulations, like the serial path's updates
+		DispatchEvents();
 
-			// Swap buffers
-			glfwSwapBuffers(m_Window);
+		// Build the UI while no simulation is running, so panels see consistent layer state
+		if (imguiLayer)
+			imguiLayer->Begin();
+
+		{
+			HZ_PROFILE_SCOPE("Layers::OnImGuiRender");
+			for (Layer* layer : m_LayerStack)
+			{
+				LayerContextScope context(*this, layer);
+				layer->OnImGuiRender();
+			}
 		}
 
-		HZ_INFO("Application::Run() - Main loop ended");
+		// Simulate the next frame on a worker while this one is submitted
+		m_Pipeline->Kick(m_LayerStack, step);
+
+		Renderer::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
+		Renderer::Clear();
+		m_Pipeline->Render(m_LayerStack, step);
+
+		if (imguiLayer)
+			imguiLayer->End();
+	}
+
+	RenderThread* Application::GetRenderThread() const
+	{
+		return m_RenderThread.get();
+	}
+
+	void Application::AcquireRenderContext()
+	{
+		if (m_RenderThread && m_RenderContextBorrows++ == 0)
+			m_RenderThread->AcquireContext();
+	}
+
+	void Application::ReleaseRenderContext()
+	{
+		if (m_RenderThread && m_RenderContextBorrows > 0 && --m_RenderContextBorrows == 0)
+			m_RenderThread->ReleaseContext();
+	}
+
+	void Application::UpdateRenderThread()
+	{
+		if (m_RenderThreadEnabled && !m_RenderThread && m_Window)
+		{
+			m_RenderThread = std::make_unique<RenderThread>(m_Window, GetSwapInterval());
+			m_RenderThread->Start();
+		}
+		else if (!m_RenderThreadEnabled && m_RenderThread)
+		{
+			StopRenderThread();
+		}
+	}
+
+	void Application::SetFrameLimit(FrameLimitMode mode, double targetFps)
+	{
+		m_FrameLimiter.SetTargetFps(targetFps);
+		if (mode != m_FrameLimitMode)
+		{
+			m_FrameLimitMode = mode;
+			m_SwapIntervalDirty = true;
+		}
+	}
+
+	void Application::ApplySwapInterval()
+	{
+		m_SwapIntervalDirty = false;
+
+		// The swap interval belongs to the context, so it is set on the thread that owns it
+		int interval = GetSwapInterval();
+		if (RenderQueue* queue = Renderer::GetRecordingQueue())
+			queue->Callback([interval]() { glfwSwapInterval(interval); });
+		else
+			glfwSwapInterval(interval);
+	}
+
+	void Application::StopRenderThread()
+	{
+		if (!m_RenderThread)
+			return;
+
+		m_RenderThread->Stop();
+
+		RenderThreadStats stats = m_RenderThread->GetStats();
+		HZ_INFO("Render thread: {} frames, hand-off {:.3} ms avg / {:.3} ms max, replay {:.3} ms, present {:.3} ms, main thread stalled {:.3} ms per frame",
+		        stats.FrameCount, stats.AverageHandOffMs, stats.MaxHandOffMs,
+		        stats.AverageReplayMs, stats.AveragePresentMs, stats.AverageStallMs);
+
+		m_RenderThread.reset();
+		m_RenderContextBorrows = 0;
 	}
 
 	void Application::PushLayer(Layer* layer)
 	{
+		// Without a window the layer could not attach; Run() reports the failure
+		if (!m_Window)
+		{
+			delete layer;
+			return;
+		}
 		m_LayerStack.PushLayer(layer);
 	}
 
 	void Application::PushOverlay(Layer* overlay)
 	{
+		if (!m_Window)
+		{
+			delete overlay;
+			return;
+		}
 		m_LayerStack.PushOverlay(overlay);
 	}
 	
@@ -2,12 +2,62 @@
 #include "Core.h"
 #include "LayerStack.h"
 #include "Events/Event.h"
+#include "Events/EventQueue.h"
+#include "FrameClock.h"
+#include "Debug/FrameTimeHistogram.h"
 #include <memory>
+#include <string>
 
 struct GLFWwindow;
 
 namespace Hazel
 {
+	class FramePipeline;
+	class ImGuiLayer;
+	class RenderThread;
+
+	enum class FrameMode
+	{
+		// Update, render and UI strictly one after another
+		Serial = 0,
+		// Layers that support it simulate frame N+1 on a worker while frame N
+		// renders, adding one frame of latency (see Layer::SupportsPipelinedUpdate)
+		Pipelined = 1
+	};
+
+	// Returned from main() by EntryPoint.h
+	enum class ExitCode : int
+	{
+		Success = 0,
+		// No window or OpenGL context could be created
+		StartupFailed = 1,
+		// The p95 frame time exceeded ApplicationSettings::MaxFrameTimeP95
+		OverBudget = 2,
+		// ApplicationSettings::StatsPath could not be written
+		StatsWriteFailed = 3
+	};
+
+	struct ApplicationSettings
+	{
+		std::string Name = "Hazel Editor";
+		uint32_t Width = 1920;
+		uint32_t Height = 1080;
+
+		// Runs without a display: GLFW's null platform with an OSMesa context
+		// (falling back to EGL), e.g. Mesa llvmpipe on machines without a GPU.
+		// The window is invisible and frames are not limited.
+		bool Headless = false;
+		// Run() returns after this many frames; 0 runs until the window is closed
+		uint64_t FrameCount = 0;
+		// Frame timing summary written as JSON when Run() returns; empty to only log it
+		std::string StatsPath;
+		// Milliseconds; Run() ends with ExitCode::OverBudget when the p95 frame time is higher. 0 disables.
+		float MaxFrameTimeP95 = 0.0f;
+		// Run() logs JobBenchmark::RunScaling() and returns; no window is created.
+		// The benchmark restarts the job system, which nothing else may be using.
+		bool JobBenchmark = false;
+	};
+
 	enum class CursorMode
 	{
 		Normal = 0,
@@ -16,19 +66,36 @@ namespace Hazel
 		Captured = 3
 	};
 
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
 	class HAZEL_API Application
 	{
 	public:
-		Application();
+		Application(const ApplicationSettings& settings = ApplicationSettings());
 		virtual ~Application();
 
 		void Run();
+		int GetExitCode() const { return static_cast<int>(m_ExitCode); }
+
+		// Understands --headless, --frames=N, --stats=PATH, --max-p95-ms=MS,
+		// --width=N, --height=N and --job-benchmark; anything else is logged and ignored
+		static ApplicationSettings ParseCommandLine(int argc, char** argv);
+		const ApplicationSettings& GetSettings() const { return m_Settings; }
+		bool IsHeadless() const { return m_Settings.Headless; }
 
 		void PushLayer(Layer* layer);
 		void PushOverlay(Layer* overlay);
 
 		static Application& Get() { return *s_Instance; }
 		GLFWwindow* GetWindow() const { return m_Window; }
+
+		// Window and input events, filled by GLFW during polling and handed to
+		// Layer::OnEvent once per frame before the layers update. Events pushed
+		// here directly are dispatched the same way.
+		EventQueue& GetEventQueue() { return m_EventQueue; }
 		
 		// Helper function to set cursor position (wraps GLFW call)
 		void SetCursorPosition(double x, double y);
@@ -36,16 +103,88 @@ namespace Hazel
 		// Helper function to control cursor mode
 		void SetCursorMode(CursorMode mode);
 
+		// Takes effect at the start of the next frame
+		void SetFrameMode(FrameMode mode) { m_FrameMode = mode; }
+		FrameMode GetFrameMode() const { return m_FrameMode; }
+
+		// Rate of Layer::OnFixedUpdate; 1/60 s by default
+		void SetFixedTimestep(double seconds) { m_FixedTimestep.SetStep(seconds); }
+		double GetFixedTimestep() const { return m_FixedTimestep.GetStep(); }
+		// Timing of the frame whose layers are being updated. It stays the same
+		// for the whole update, including pipelined OnUpdate calls on workers.
+		const FrameStep& GetFrameStep() const { return m_FrameStep; }
+		// Seconds since Run() started
+		double GetTime() const { return m_Clock.GetElapsedSeconds(); }
+
+		// VSync by default; 'targetFps' is used by FrameLimitMode::TargetFps.
+		// Takes effect at the start of the next frame.
+		void SetFrameLimit(FrameLimitMode mode, double targetFps = 60.0);
+		FrameLimitMode GetFrameLimitMode() const { return m_FrameLimitMode; }
+		double GetTargetFps() const { return m_FrameLimiter.GetTargetFps(); }
+
+		// Moves the OpenGL context to a dedicated render thread: each frame is
+		// recorded into a command buffer on this thread and replayed and presented
+		// there while the next one is recorded. Layers that use OpenGL directly
+		// borrow the context back (see Layer::UsesDirectOpenGL). Takes effect at
+		// the start of the next frame.
+		void SetRenderThreadEnabled(bool enabled) { m_RenderThreadEnabled = enabled; }
+		bool IsRenderThreadEnabled() const { return m_RenderThreadEnabled; }
+		// The running render thread, or nullptr while this thread renders itself
+		RenderThread* GetRenderThread() const;
+
+		// Makes the OpenGL context current on the main thread until the matching
+		// release; calls nest. Does nothing without a render thread.
+		void AcquireRenderContext();
+		void ReleaseRenderContext();
+
+		// Time between consecutive frames, over the last 600 frames
+		const FrameTimeHistogram& GetFrameTimes() const { return m_FrameTimes; }
+		// Time the main thread spent producing each frame, up to presenting it;
+		// the rest of the frame time is spent waiting on vsync or the render thread
+		const FrameTimeHistogram& GetUpdateTimes() const { return m_UpdateTimes; }
+
+	private:
+		void RunSerialFrame(ImGuiLayer* imguiLayer, const FrameStep& step);
+		void RunPipelinedFrame(ImGuiLayer* imguiLayer, const FrameStep& step);
+		void UpdateRenderThread();
+		void ApplySwapInterval();
+		bool CreateMainWindow();
+		void InstallEventCallbacks();
+		void DispatchEvents();
+		void ReportRun();
+		int GetSwapInterval() const { return m_FrameLimitMode == FrameLimitMode::VSync ? 1 : 0; }
+		void StopRenderThread();
+
 	private:
+		ApplicationSettings m_Settings;
+		ExitCode m_ExitCode = ExitCode::Success;
 		LayerStack m_LayerStack;
+		EventQueue m_EventQueue;
+		std::unique_ptr<FramePipeline> m_Pipeline;
+		FrameMode m_FrameMode = FrameMode::Serial;
+		std::unique_ptr<RenderThread> m_RenderThread;
+		bool m_RenderThreadEnabled = false;
+		int m_RenderContextBorrows = 0;
 		bool m_Running = true;
-		float m_LastFrameTime = 0.0f;
+		FrameClock m_Clock;
+		FixedTimestep m_FixedTimestep;
+		FrameStep m_FrameStep;
+		FrameLimitMode m_FrameLimitMode = FrameLimitMode::VSync;
+		FrameLimiter m_FrameLimiter;
+		bool m_SwapIntervalDirty = false;
+		FrameTimeHistogram m_FrameTimes;
+		FrameTimeHistogram m_UpdateTimes;
 		GLFWwindow* m_Window = nullptr;
 
 		static Application* s_Instance;
 	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
 	// To be defined in CLIENT
-	Application* CreateApplication();
+	Application* CreateApplication(const ApplicationSettings& settings);
 }
 
 
@@ -6,4 +6,16 @@
 	#define HAZEL_API __declspec(dllimport)
 #else
 	#define HAZEL_API
-#endif
\ No newline at end of file
+#endif
+
+// Heap allocation tracking (Memory/MemoryTracker.h); build with
+// HZ_DISABLE_MEMORY_TRACKING to compile the hooks out
+#ifndef HZ_DISABLE_MEMORY_TRACKING
+	#define HZ_ENABLE_MEMORY_TRACKING
+#endif
+
+// Scope profiling macros (Debug/Profiler.h); build with HZ_DISABLE_PROFILING
+// to compile them out
+#ifndef HZ_DISABLE_PROFILING
+	#define HZ_ENABLE_PROFILING
+#endif
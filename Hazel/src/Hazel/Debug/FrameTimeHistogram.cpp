@@ -0,0 +1,134 @@
+#include "FrameTimeHistogram.h"
+#include <algorithm>
+#include <limits>
+
+namespace Hazel {
+
+	// A hitch takes this many times the running average, and at least this
+	// much longer, so jitter in very short frames is not reported
+	static constexpr float s_HitchFactor = 1.8f;
+	static constexpr float s_HitchMinimumMs = 4.0f;
+	// Startup frames (shader compiles, first uploads) do not count
+	static constexpr uint64_t s_HitchWarmupSamples = 30;
+
+	FrameTimeHistogram::FrameTimeHistogram(uint32_t windowSize)
+		: m_Samples((std::max)(windowSize, 1u), 0.0f), m_HitchFlags(m_Samples.size(), 0), m_Buckets(s_BucketCount, 0),
+		  m_MaxQueue(m_Samples.size(), 0)
+	{
+	}
+
+	void FrameTimeHistogram::AddSample(float milliseconds)
+	{
+		milliseconds = (std::max)(milliseconds, 0.0f);
+
+		bool hitch = m_SamplesSeen >= s_HitchWarmupSamples &&
+		             milliseconds > m_RunningAverage * s_HitchFactor &&
+		             milliseconds - m_RunningAverage > s_HitchMinimumMs;
+		// Hitches stay out of the average so a burst of them is still reported
+		if (m_SamplesSeen == 0)
+			m_RunningAverage = milliseconds;
+		else if (!hitch)
+			m_RunningAverage += (milliseconds - m_RunningAverage) / 16.0f;
+		// Also the sample's number since Reset(); it lands at m_Next
+		uint64_t sample = m_SamplesSeen++;
+
+		uint32_t capacity = static_cast<uint32_t>(m_Samples.size());
+		if (m_Count == capacity)
+		{
+			// Slide the window past the oldest sample
+			float oldest = m_Samples[m_Next];
+			m_Buckets[GetBucket(oldest)]--;
+			m_Sum -= oldest;
+			m_Hitches -= m_HitchFlags[m_Next];
+		}
+		else
+		{
+			m_Count++;
+		}
+
+		m_Samples[m_Next] = milliseconds;
+		m_HitchFlags[m_Next] = hitch ? 1 : 0;
+		m_Buckets[GetBucket(milliseconds)]++;
+		m_Sum += milliseconds;
+		if (hitch)
+		{
+			m_Hitches++;
+			m_TotalHitches++;
+		}
+
+		// Drop the maximum that left the window, then every queued sample the
+		// new one outlasts and is at least as long as
+		if (m_MaxCount > 0 && m_MaxQueue[m_MaxHead] + capacity <= sample)
+		{
+			m_MaxHead = (m_MaxHead + 1) % capacity;
+			m_MaxCount--;
+		}
+		while (m_MaxCount > 0 && m_Samples[m_MaxQueue[(m_MaxHead + m_MaxCount - 1) % capacity] % capacity] <= milliseconds)
+			m_MaxCount--;
+		m_MaxQueue[(m_MaxHead + m_MaxCount) % capacity] = sample;
+		m_MaxCount++;
+
+		m_Next = (m_Next + 1) % capacity;
+	}
+
+	FrameTimeSummary FrameTimeHistogram::GetSummary() const
+	{
+		FrameTimeSummary summary;
+		summary.SampleCount = m_Count;
+		summary.Hitches = m_Hitches;
+		summary.TotalHitches = m_TotalHitches;
+		if (m_Count == 0)
+			return summary;
+
+		summary.Max = m_Samples[m_MaxQueue[m_MaxHead] % m_Samples.size()];
+
+		summary.Average = static_cast<float>(m_Sum / m_Count);
+		summary.P50 = (std::min)(GetPercentile(0.50f), summary.Max);
+		summary.P95 = (std::min)(GetPercentile(0.95f), summary.Max);
+		summary.P99 = (std::min)(GetPercentile(0.99f), summary.Max);
+		return summary;
+	}
+
+	void FrameTimeHistogram::Reset()
+	{
+		std::fill(m_Samples.begin(), m_Samples.end(), 0.0f);
+		std::fill(m_HitchFlags.begin(), m_HitchFlags.end(), static_cast<uint8_t>(0));
+		std::fill(m_Buckets.begin(), m_Buckets.end(), 0u);
+		m_Next = 0;
+		m_Count = 0;
+		m_Sum = 0.0;
+		m_MaxHead = 0;
+		m_MaxCount = 0;
+		m_RunningAverage = 0.0f;
+		m_SamplesSeen = 0;
+		m_Hitches = 0;
+		m_TotalHitches = 0;
+	}
+
+	uint32_t FrameTimeHistogram::GetBucket(float milliseconds)
+	{
+		return (std::min)(static_cast<uint32_t>(milliseconds / s_BucketWidth), s_BucketCount - 1);
+	}
+
+	float FrameTimeHistogram::GetPercentile(float fraction) const
+	{
+		// Smallest bucket below which at least 'fraction' of the samples fall
+		uint32_t target = static_cast<uint32_t>(fraction * m_Count + 0.5f);
+		target = (std::max)(target, 1u);
+
+		uint32_t seen = 0;
+		for (uint32_t bucket = 0; bucket < s_BucketCount; bucket++)
+		{
+			seen += m_Buckets[bucket];
+			if (seen >= target)
+			{
+				// The last bucket is open-ended; the caller clamps to the maximum
+				if (bucket == s_BucketCount - 1)
+					return (std::numeric_limits<float>::max)();
+				return (bucket + 1) * s_BucketWidth; // Upper edge of the bucket
+			}
+		}
+		return (std::numeric_limits<float>::max)();
+	}
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../Core.h"
+#include <cstdint>
+#include <vector>
+
+namespace Hazel {
+
+	struct FrameTimeSummary
+	{
+		uint32_t SampleCount = 0;
+		// Milliseconds over the window
+		float Average = 0.0f;
+		float P50 = 0.0f;
+		float P95 = 0.0f;
+		float P99 = 0.0f;
+		float Max = 0.0f;
+		// Samples in the window that took far longer than the running average
+		uint32_t Hitches = 0;
+		uint64_t TotalHitches = 0;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
+	// Percentiles over the last 'windowSize' timings. Samples are binned into
+	// fixed 0.125 ms buckets that are updated as the window slides, and the
+	// maximum is kept by a queue of decreasing samples, so adding a sample is
+	// amortized O(1) and a summary costs one pass over the buckets, whatever
+	// the window size. Percentiles are therefore accurate to a bucket; the
+	// maximum is exact. Timings above 128 ms share the last bucket.
+	class HAZEL_API FrameTimeHistogram
+	{
+	public:
+		explicit FrameTimeHistogram(uint32_t windowSize = 600);
+
+		void AddSample(float milliseconds);
+		FrameTimeSummary GetSummary() const;
+		void Reset();
+
+	private:
+		static constexpr uint32_t s_BucketCount = 1024;
+		static constexpr float s_BucketWidth = 0.125f;
+
+		static uint32_t GetBucket(float milliseconds);
+		float GetPercentile(float fraction) const;
+
+	private:
+		std::vector<float> m_Samples;
+		std::vector<uint8_t> m_HitchFlags;
+		uint32_t m_Next = 0;
+		uint32_t m_Count = 0;
+		std::vector<uint32_t> m_Buckets;
+		double m_Sum = 0.0;
+		// Sample numbers (see m_SamplesSeen) of the window's decreasing
+		// maxima, as a ring; the head is the window's maximum
+		std::vector<uint64_t> m_MaxQueue;
+		uint32_t m_MaxHead = 0;
+		uint32_t m_MaxCount = 0;
+
+		// Hitch detection
+		float m_RunningAverage = 0.0f;
+		uint64_t m_SamplesSeen = 0;
+		uint32_t m_Hitches = 0;
+		uint64_t m_TotalHitches = 0;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
@@ -0,0 +1,306 @@
+#include "Profiler.h"
+#include "../Log.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Hazel {
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Thread buffers ///////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	namespace {
+
+		struct ProfileEvent
+		{
+			const char* Name;
+			uint64_t Start;
+			uint64_t End;
+		};
+
+		constexpr size_t s_ChunkEventCount = 8192;
+
+		struct EventChunk
+		{
+			ProfileEvent Events[s_ChunkEventCount];
+			std::atomic<EventChunk*> Next{ nullptr };
+		};
+
+		// Written by its thread only. The exporter reads the first Published
+		// events; chunks are kept across captures and refilled from the head.
+		struct ThreadBuffer
+		{
+			uint32_t ThreadId = 0;
+			char Name[64] = {}; // Guarded by s_RegistryMutex
+
+			uint32_t CaptureId = 0;
+			std::unique_ptr<EventChunk> Head;
+			EventChunk* Tail = nullptr;
+			size_t TailCount = 0;
+
+			std::atomic<uint32_t> PublishedCapture{ 0 };
+			std::atomic<size_t> Published{ 0 };
+
+			~ThreadBuffer()
+			{
+				EventChunk* chunk = Head ? Head->Next.load() : nullptr;
+				while (chunk)
+				{
+					EventChunk* next = chunk->Next.load();
+					delete chunk;
+					chunk = next;
+				}
+			}
+
+			void Reset(uint32_t captureId)
+			{
+				if (!Head)
+					Head = std::make_unique<EventChunk>();
+				Tail = Head.get();
+				TailCount = 0;
+				CaptureId = captureId;
+				Published.store(0, std::memory_order_relaxed);
+				PublishedCapture.store(captureId, std::memory_order_release);
+			}
+
+			void Push(const ProfileEvent& event)
+			{
+				if (TailCount == s_ChunkEventCount)
+				{
+					EventChunk* next = Tail->Next.load(std::memory_order_relaxed);
+					if (!next)
+					{
+						next = new EventChunk();
+						Tail->Next.store(next, std::memory_order_release);
+					}
+					Tail = next;
+					TailCount = 0;
+				}
+
+				Tail->Events[TailCount++] = event;
+				Published.store(Published.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+			}
+		};
+
+		std::mutex s_RegistryMutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> s_Buffers;
+		thread_local ThreadBuffer* t_Buffer = nullptr;
+		// Not tied to a thread; written by whichever thread owns the OpenGL context
+		ThreadBuffer* s_GpuBuffer = nullptr;
+
+		std::atomic<uint32_t> s_CaptureId{ 0 };
+
+		// Capture control; application thread only
+		uint32_t s_LastCaptureId = 0;
+		uint32_t s_PendingFrames = 0;
+		uint32_t s_FramesRemaining = 0;
+		uint32_t s_CapturedFrames = 0;
+		uint64_t s_CaptureStart = 0;
+		std::string s_PendingPath;
+		std::string s_CapturePath;
+
+		ThreadBuffer& GetThreadBuffer()
+		{
+			if (!t_Buffer)
+			{
+				std::lock_guard<std::mutex> lock(s_RegistryMutex);
+				s_Buffers.push_back(std::make_unique<ThreadBuffer>());
+				t_Buffer = s_Buffers.back().get();
+				t_Buffer->ThreadId = static_cast<uint32_t>(s_Buffers.size());
+				std::snprintf(t_Buffer->Name, sizeof(t_Buffer->Name), "Thread %u", t_Buffer->ThreadId);
+			}
+			return *t_Buffer;
+		}
+
+		ThreadBuffer& GetGpuBuffer()
+		{
+			// The context moves between threads only at hand-offs that synchronize them
+			if (!s_GpuBuffer)
+			{
+				std::lock_guard<std::mutex> lock(s_RegistryMutex);
+				s_Buffers.push_back(std::make_unique<ThreadBuffer>());
+				s_GpuBuffer = s_Buffers.back().get();
+				s_GpuBuffer->ThreadId = static_cast<uint32_t>(s_Buffers.size());
+				std::snprintf(s_GpuBuffer->Name, sizeof(s_GpuBuffer->Name), "GPU");
+			}
+			return *s_GpuBuffer;
+		}
+
+		void WriteJsonString(std::ofstream& stream, const char* text)
+		{
+			stream << '"';
+			for (const char* c = text; *c; c++)
+			{
+				if (*c == '"' || *c == '\\')
+					stream << '\\';
+				stream << *c;
+			}
+			stream << '"';
+		}
+
+		bool WriteChromeTrace(const std::string& path, uint32_t captureId, size_t& outEventCount)
+		{
+			std::ofstream stream(path, std::ios::trunc);
+			if (!stream)
+			{
+				HZ_ERROR("Profiler: failed to create {}", path);
+				return false;
+			}
+
+			stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+			bool first = true;
+			outEventCount = 0;
+
+			std::lock_guard<std::mutex> lock(s_RegistryMutex);
+			for (const std::unique_ptr<ThreadBuffer>& buffer : s_Buffers)
+			{
+				if (buffer->PublishedCapture.load(std::memory_order_acquire) != captureId)
+					continue;
+
+				stream << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->ThreadId
+				       << ",\"args\":{\"name\":";
+				WriteJsonString(stream, buffer->Name);
+				stream << "}}";
+				first = false;
+
+				size_t count = buffer->Published.load(std::memory_order_acquire);
+				const EventChunk* chunk = buffer->Head.get();
+				for (size_t i = 0; i < count; i++)
+				{
+					if (i > 0 && i % s_ChunkEventCount == 0)
+						chunk = chunk->Next.load(std::memory_order_acquire);
+
+					const ProfileEvent& event = chunk->Events[i % s_ChunkEventCount];
+					// GPU zones are read back late and may predate the capture
+					if (event.Start < s_CaptureStart)
+						continue;
+
+					char times[96];
+					std::snprintf(times, sizeof(times), "\"ts\":%.3f,\"dur\":%.3f",
+					              (event.Start - s_CaptureStart) / 1000.0, (event.End - event.Start) / 1000.0);
+
+					stream << ",\n{\"name\":";
+					WriteJsonString(stream, event.Name);
+					stream << ",\"cat\":\"scope\",\"ph\":\"X\"," << times << ",\"pid\":0,\"tid\":" << buffer->ThreadId << "}";
+					outEventCount++;
+				}
+			}
+
+			stream << "\n]}\n";
+			return static_cast<bool>(stream);
+		}
+
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Profiler /////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	void Profiler::StartCapture(uint32_t frameCount, const std::string& path)
+	{
+		if (frameCount == 0)
+			return;
+
+		if (IsCapturing())
+		{
+			HZ_WARN("Profiler: a capture is already running");
+			return;
+		}
+
+		s_PendingFrames = frameCount;
+		s_PendingPath = path;
+	}
+
+	void Profiler::StopCapture()
+	{
+		uint32_t captureId = s_CaptureId.exchange(0);
+		if (captureId == 0)
+			return;
+
+		size_t eventCount = 0;
+		if (!WriteChromeTrace(s_CapturePath, captureId, eventCount))
+			return;
+
+		HZ_INFO("Profiler: {} scopes over {} frames written to {}", eventCount, s_CapturedFrames, s_CapturePath);
+	}
+
+	bool Profiler::IsCapturing()
+	{
+		return s_CaptureId.load(std::memory_order_relaxed) != 0 || s_PendingFrames > 0;
+	}
+
+	void Profiler::BeginFrame()
+	{
+		if (s_CaptureId.load(std::memory_order_relaxed) != 0)
+		{
+			s_CapturedFrames++;
+			if (--s_FramesRemaining == 0)
+				StopCapture();
+		}
+
+		if (s_PendingFrames > 0)
+		{
+			s_FramesRemaining = s_PendingFrames;
+			s_PendingFrames = 0;
+			s_CapturedFrames = 0;
+			s_CapturePath = s_PendingPath;
+			s_CaptureStart = Now();
+
+			// 0 means "not capturing", so it is skipped when the id wraps
+			if (++s_LastCaptureId == 0)
+				s_LastCaptureId = 1;
+			s_CaptureId.store(s_LastCaptureId, std::memory_order_release);
+		}
+	}
+
+	void Profiler::SetThreadName(const char* name)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+		std::lock_guard<std::mutex> lock(s_RegistryMutex);
+		std::snprintf(buffer.Name, sizeof(buffer.Name), "%s", name);
+	}
+
+	uint64_t Profiler::Now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	void Profiler::Record(const char* name, uint64_t start, uint64_t end)
+	{
+		uint32_t captureId = s_CaptureId.load(std::memory_order_acquire);
+		if (captureId == 0)
+			return;
+
+		ThreadBuffer& buffer = GetThreadBuffer();
+		if (buffer.CaptureId != captureId)
+			buffer.Reset(captureId);
+
+		buffer.Push({ name, start, end });
+	}
+
+	void Profiler::RecordGpu(const char* name, uint64_t start, uint64_t end)
+	{
+		uint32_t captureId = s_CaptureId.load(std::memory_order_acquire);
+		if (captureId == 0)
+			return;
+
+		ThreadBuffer& buffer = GetGpuBuffer();
+		if (buffer.CaptureId != captureId)
+			buffer.Reset(captureId);
+
+		buffer.Push({ name, start, end });
+	}
+
+	uint32_t Profiler::GetCaptureId()
+	{
+		return s_CaptureId.load(std::memory_order_relaxed);
+	}
+
+}
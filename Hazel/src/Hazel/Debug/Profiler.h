@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../Core.h"
+#include <cstdint>
+#include <string>
+
+namespace Hazel {
+
+	// Scope timings for chrome://tracing (or https://ui.perfetto.dev). Nothing
+	// is recorded until StartCapture(); the capture then covers the requested
+	// number of frames and is written as Chrome trace JSON when the last one
+	// ends.
+	//
+	// Every thread records into its own buffer, which only that thread writes,
+	// so recording takes no locks. Timestamps come from steady_clock (QPC on
+	// Windows). Scope names must outlive the capture: use string literals.
+	//
+	// Build with HZ_DISABLE_PROFILING to compile the HZ_PROFILE_* macros out.
+	class HAZEL_API Profiler
+	{
+	public:
+		// Starts recording at the next frame; 'path' receives the trace
+		static void StartCapture(uint32_t frameCount, const std::string& path = "HazelProfile.json");
+		// Stops early and writes what was recorded
+		static void StopCapture();
+		static bool IsCapturing();
+
+		// Counts captured frames; called by the application once per frame
+		static void BeginFrame();
+
+		// Shown as the thread's row in the trace; the string is copied
+		static void SetThreadName(const char* name);
+
+		static uint64_t Now(); // Nanoseconds
+		static void Record(const char* name, uint64_t start, uint64_t end);
+		// Adds a zone to the "GPU" row; times already converted to Now()'s
+		// clock. Called by GpuProfiler on the thread that owns the context.
+		static void RecordGpu(const char* name, uint64_t start, uint64_t end);
+		// Identifies the capture a scope started in; 0 when none is running
+		static uint32_t GetCaptureId();
+	};
+
+	class ProfileScope
+	{
+	public:
+		explicit ProfileScope(const char* name)
+			: m_Name(name), m_CaptureId(Profiler::GetCaptureId())
+		{
+			if (m_CaptureId)
+				m_Start = Profiler::Now();
+		}
+
+		~ProfileScope()
+		{
+			// A scope that outlives its capture is dropped
+			if (m_CaptureId && m_CaptureId == Profiler::GetCaptureId())
+				Profiler::Record(m_Name, m_Start, Profiler::Now());
+		}
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+	private:
+		const char* m_Name;
+		uint32_t m_CaptureId;
+		uint64_t m_Start = 0;
+	};
+
+}
+
+#define HZ_PROFILE_CONCAT_INNER(a, b) a##b
+#define HZ_PROFILE_CONCAT(a, b) HZ_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef _MSC_VER
+	#define HZ_FUNCTION_NAME __FUNCTION__
+#else
+	#define HZ_FUNCTION_NAME __PRETTY_FUNCTION__
+#endif
+
+#ifdef HZ_ENABLE_PROFILING
+	#define HZ_PROFILE_SCOPE(name) ::Hazel::ProfileScope HZ_PROFILE_CONCAT(hzProfileScope, __LINE__)(name)
+	#define HZ_PROFILE_FUNCTION() HZ_PROFILE_SCOPE(HZ_FUNCTION_NAME)
+#else
+	#define HZ_PROFILE_SCOPE(name)
+	#define HZ_PROFILE_FUNCTION()
+#endif
@@ -1,13 +1,19 @@
 #pragma once
 
+#include "Memory/MemoryTracker.h"
+
 #ifdef HZ_PLATFORM_WINDOWS
+// The application's allocations go through the same tracker as the engine's
+HZ_MEMORY_TRACKER_OPERATORS
+#endif // HZ_PLATFORM_WINDOWS
 
-extern Hazel::Application* Hazel::CreateApplication();
+extern Hazel::Application* Hazel::CreateApplication(const Hazel::ApplicationSettings& settings);
 
+// Exits with Hazel::ExitCode, so scripted runs (--headless --frames=N) can check the result
 int main(int argc, char** argv) {
-	auto app = Hazel::CreateApplication();
+	auto app = Hazel::CreateApplication(Hazel::Application::ParseCommandLine(argc, argv));
 	app->Run();
+	int exitCode = app->GetExitCode();
 	delete app;
+	return exitCode;
 }
-
-#endif // HZ_PLATFORM_WINDOWS
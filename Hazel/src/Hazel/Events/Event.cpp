@@ -0,0 +1,65 @@
+#include "Event.h"
+#include <cstdio>
+
+namespace Hazel {
+
+	const char* Event::GetName(EventType type)
+	{
+		switch (type)
+		{
+			case EventType::WindowClose:         return "WindowClose";
+			case EventType::WindowResize:        return "WindowResize";
+			case EventType::WindowFocus:         return "WindowFocus";
+			case EventType::WindowLostFocus:     return "WindowLostFocus";
+			case EventType::WindowMoved:         return "WindowMoved";
+			case EventType::AppTick:             return "AppTick";
+			case EventType::AppUpdate:           return "AppUpdate";
+			case EventType::AppRender:           return "AppRender";
+			case EventType::KeyPressed:          return "KeyPressed";
+			case EventType::KeyReleased:         return "KeyReleased";
+			case EventType::KeyTyped:            return "KeyTyped";
+			case EventType::MouseButtonPressed:  return "MouseButtonPressed";
+			case EventType::MouseButtonReleased: return "MouseButtonReleased";
+			case EventType::MouseMoved:          return "MouseMoved";
+			case EventType::MouseScrolled:       return "MouseScrolled";
+			default:                             return "None";
+		}
+	}
+
+	std::string Event::ToString() const
+	{
+		char text[96];
+		switch (Type)
+		{
+			case EventType::WindowResize:
+				std::snprintf(text, sizeof(text), "WindowResize: %ux%u", WindowSize.Width, WindowSize.Height);
+				break;
+			case EventType::WindowMoved:
+				std::snprintf(text, sizeof(text), "WindowMoved: %d, %d", WindowPosition.X, WindowPosition.Y);
+				break;
+			case EventType::KeyPressed:
+				std::snprintf(text, sizeof(text), "KeyPressed: %d%s", Key.Code, Key.Repeat ? " (repeat)" : "");
+				break;
+			case EventType::KeyReleased:
+				std::snprintf(text, sizeof(text), "KeyReleased: %d", Key.Code);
+				break;
+			case EventType::KeyTyped:
+				std::snprintf(text, sizeof(text), "KeyTyped: U+%04X", Char.CodePoint);
+				break;
+			case EventType::MouseButtonPressed:
+			case EventType::MouseButtonReleased:
+				std::snprintf(text, sizeof(text), "%s: %d", GetName(), MouseButton.Button);
+				break;
+			case EventType::MouseMoved:
+				std::snprintf(text, sizeof(text), "MouseMoved: %.1f, %.1f", MousePosition.X, MousePosition.Y);
+				break;
+			case EventType::MouseScrolled:
+				std::snprintf(text, sizeof(text), "MouseScrolled: %.2f, %.2f", Scroll.XOffset, Scroll.YOffset);
+				break;
+			default:
+				return GetName();
+		}
+		return text;
+	}
+
+}
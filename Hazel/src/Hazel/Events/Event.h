@@ -1,12 +1,12 @@
 #pragma once
 
 #include "../Core.h"
+#include <cstdint>
 #include <string>
-#include <functional>
 
 namespace Hazel {
 
-	enum class EventType
+	enum class EventType : uint8_t
 	{
 		None = 0,
 		WindowClose, WindowResize, WindowFocus, WindowLostFocus, WindowMoved,
@@ -25,24 +25,68 @@ namespace Hazel {
 		EventCategoryMouseButton = 1 << 4
 	};
 
-	class HAZEL_API Event
+	// A plain value: the type selects which member of the payload union is
+	// valid. Key codes, buttons and modifier bits are GLFW's; positions are in
+	// window coordinates.
+	struct HAZEL_API Event
 	{
-	public:
-		virtual ~Event() = default;
-
+		EventType Type = EventType::None;
 		bool Handled = false;
 
-		virtual EventType GetEventType() const = 0;
-		virtual const char* GetName() const = 0;
-		virtual int GetCategoryFlags() const = 0;
-		virtual std::string ToString() const { return GetName(); }
+		union
+		{
+			struct { uint32_t Width, Height; } WindowSize; // WindowResize
+			struct { int32_t X, Y; } WindowPosition;       // WindowMoved
+			struct { int32_t Code, Mods; bool Repeat; } Key; // KeyPressed, KeyReleased
+			struct { uint32_t CodePoint; } Char;           // KeyTyped
+			struct { int32_t Button, Mods; } MouseButton;  // MouseButtonPressed, MouseButtonReleased
+			struct { float X, Y; } MousePosition;          // MouseMoved
+			struct { float XOffset, YOffset; } Scroll;     // MouseScrolled
+		};
+
+		Event() : Key{} {}
+		explicit Event(EventType type) : Type(type), Key{} {}
 
-		inline bool IsInCategory(EventCategory category)
+		const char* GetName() const { return GetName(Type); }
+		int GetCategoryFlags() const { return GetCategoryFlags(Type); }
+		bool IsInCategory(EventCategory category) const { return (GetCategoryFlags() & category) != 0; }
+		std::string ToString() const;
+
+		static const char* GetName(EventType type);
+
+		static int GetCategoryFlags(EventType type)
 		{
-			return GetCategoryFlags() & category;
+			switch (type)
+			{
+				case EventType::WindowClose:
+				case EventType::WindowResize:
+				case EventType::WindowFocus:
+				case EventType::WindowLostFocus:
+				case EventType::WindowMoved:
+				case EventType::AppTick:
+				case EventType::AppUpdate:
+				case EventType::AppRender:
+					return EventCategoryApplication;
+				case EventType::KeyPressed:
+				case EventType::KeyReleased:
+				case EventType::KeyTyped:
+					return EventCategoryInput | EventCategoryKeyboard;
+				case EventType::MouseButtonPressed:
+				case EventType::MouseButtonReleased:
+					return EventCategoryInput | EventCategoryMouse | EventCategoryMouseButton;
+				case EventType::MouseMoved:
+				case EventType::MouseScrolled:
+					return EventCategoryInput | EventCategoryMouse;
+				default:
+					return None;
+			}
 		}
 	};
 
+	// Routes an event to the handler registered for its type:
+	//   EventDispatcher dispatcher(event);
+	//   dispatcher.Dispatch(EventType::KeyPressed, [](Event& e) { return e.Key.Code == GLFW_KEY_F; });
+	// A handler returning true marks the event handled.
 	class EventDispatcher
 	{
 	public:
@@ -51,12 +95,13 @@ namespace Hazel {
 		{
 		}
 
-		template<typename T, typename F>
-		bool Dispatch(const F& func)
+		template<typename F>
+		bool Dispatch(EventType type, const F& func)
 		{
-			if (m_Event.GetEventType() == T::GetStaticType())
+			if (m_Event.Type == type)
 			{
-				m_Event.Handled = func(static_cast<T&>(m_Event));
+				if (func(m_Event))
+					m_Event.Handled = true;
 				return true;
 			}
 			return false;
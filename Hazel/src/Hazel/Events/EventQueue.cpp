@@ -0,0 +1,77 @@
+#include "EventQueue.h"
+#include "../LayerStack.h"
+#include "../Debug/Profiler.h"
+#include "../Memory/MemoryTracker.h"
+#include <utility>
+
+namespace Hazel {
+
+	EventQueue::EventQueue(size_t capacity)
+	{
+		HZ_MEMORY_TAG(Core);
+		m_Events.reserve(capacity);
+		m_Dispatching.reserve(capacity);
+	}
+
+	void EventQueue::Push(const Event& event)
+	{
+		if (!m_Events.empty() && m_Events.back().Type == event.Type)
+		{
+			Event& previous = m_Events.back();
+			switch (event.Type)
+			{
+				case EventType::MouseMoved:
+					previous.MousePosition = event.MousePosition;
+					m_Coalesced++;
+					return;
+				case EventType::MouseScrolled:
+					previous.Scroll.XOffset += event.Scroll.XOffset;
+					previous.Scroll.YOffset += event.Scroll.YOffset;
+					m_Coalesced++;
+					return;
+				case EventType::WindowResize:
+					previous.WindowSize = event.WindowSize;
+					m_Coalesced++;
+					return;
+				default:
+					break;
+			}
+		}
+
+		m_Events.push_back(event);
+	}
+
+	void EventQueue::Dispatch(LayerStack& layers)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		// Handlers may push; those events go to the next frame
+		std::swap(m_Events, m_Dispatching);
+		m_Stats.Dispatched = static_cast<uint32_t>(m_Dispatching.size());
+		m_Stats.Coalesced = m_Coalesced;
+		m_Stats.Handled = 0;
+		m_Coalesced = 0;
+
+		for (Event& event : m_Dispatching)
+		{
+			for (auto it = layers.rbegin(); it != layers.rend(); ++it)
+			{
+				(*it)->OnEvent(event);
+				if (event.Handled)
+				{
+					m_Stats.Handled++;
+					break;
+				}
+			}
+		}
+
+		m_Dispatching.clear();
+	}
+
+	void EventQueue::Clear()
+	{
+		m_Events.clear();
+		m_Coalesced = 0;
+	}
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../Core.h"
+#include "Event.h"
+#include <cstdint>
+#include <vector>
+
+namespace Hazel {
+
+	class LayerStack;
+
+	struct EventQueueStats
+	{
+		// Events offered to layers by the last Dispatch()
+		uint32_t Dispatched = 0;
+		// Events merged into their predecessor while that frame was queued
+		uint32_t Coalesced = 0;
+		// Of Dispatched, those a layer marked handled
+		uint32_t Handled = 0;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about STL types in DLL interface
+#endif
+
+	// Collects a frame's worth of events and hands them to the layers in one
+	// go. Storage is two buffers that keep their capacity, so after the first
+	// few frames queueing never allocates; events pushed while dispatching
+	// wait for the next frame.
+	//
+	// A push that repeats the previous event's type is merged into it for
+	// MouseMoved and WindowResize (the latest value wins) and MouseScrolled
+	// (offsets add up). Only direct neighbours merge, so the order relative
+	// to button and key events is kept.
+	//
+	// Single-threaded: the GLFW callbacks and the frame loop share the main thread.
+	class HAZEL_API EventQueue
+	{
+	public:
+		explicit EventQueue(size_t capacity = 256);
+
+		void Push(const Event& event);
+
+		// Offers each queued event to the layers top-down (overlays first)
+		// until one marks it handled, then empties the queue
+		void Dispatch(LayerStack& layers);
+		void Clear();
+
+		size_t GetSize() const { return m_Events.size(); }
+		const EventQueueStats& GetStats() const { return m_Stats; }
+
+	private:
+		std::vector<Event> m_Events;
+		std::vector<Event> m_Dispatching;
+		uint32_t m_Coalesced = 0;
+		EventQueueStats m_Stats;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
@@ -0,0 +1,137 @@
+#include "FrameClock.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace Hazel {
+
+	/////////////////////////////////////////////////////////////////////////////
+	// FrameClock ///////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	FrameClock::FrameClock()
+	{
+		Reset();
+	}
+
+	double FrameClock::Tick()
+	{
+		int64_t now = Now();
+		m_Delta = m_FrameCount == 0 ? 0.0 : (now - m_LastTick) / 1.0e9;
+		m_LastTick = now;
+		m_FrameCount++;
+		return m_Delta;
+	}
+
+	void FrameClock::Reset()
+	{
+		m_Start = Now();
+		m_LastTick = m_Start;
+		m_Delta = 0.0;
+		m_FrameCount = 0;
+	}
+
+	double FrameClock::GetElapsedSeconds() const
+	{
+		return (Now() - m_Start) / 1.0e9;
+	}
+
+	int64_t FrameClock::Now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// FixedTimestep ////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	FixedTimestep::FixedTimestep(double stepSeconds, uint32_t maxStepsPerFrame)
+		: m_Step(stepSeconds > 0.0 ? stepSeconds : 1.0 / 60.0), m_MaxSteps((std::max)(maxStepsPerFrame, 1u))
+	{
+	}
+
+	uint32_t FixedTimestep::Advance(double deltaSeconds)
+	{
+		m_Accumulator += (std::max)(deltaSeconds, 0.0);
+
+		uint32_t steps = 0;
+		while (m_Accumulator >= m_Step && steps < m_MaxSteps)
+		{
+			m_Accumulator -= m_Step;
+			steps++;
+		}
+
+		if (m_Accumulator >= m_Step)
+		{
+			uint64_t dropped = static_cast<uint64_t>(m_Accumulator / m_Step);
+			m_DroppedSteps += dropped;
+			m_Accumulator -= dropped * m_Step;
+		}
+
+		return steps;
+	}
+
+	float FixedTimestep::GetAlpha() const
+	{
+		return static_cast<float>(m_Accumulator / m_Step);
+	}
+
+	void FixedTimestep::SetStep(double stepSeconds)
+	{
+		if (stepSeconds <= 0.0)
+			return;
+
+		// Keep the fraction of a step already accumulated
+		m_Accumulator = m_Accumulator / m_Step * stepSeconds;
+		m_Step = stepSeconds;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// FrameLimiter /////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	void FrameLimiter::SetTargetFps(double fps)
+	{
+		if (fps <= 0.0)
+			return;
+
+		m_TargetFps = fps;
+		Reset();
+	}
+
+	void FrameLimiter::Wait()
+	{
+		int64_t period = static_cast<int64_t>(1.0e9 / m_TargetFps);
+		int64_t now = FrameClock::Now();
+
+		// Deadlines advance by whole periods so the rate does not drift; after
+		// falling a full period behind, the schedule restarts from now
+		if (m_Deadline == 0 || now - m_Deadline > period)
+		{
+			m_Deadline = now + period;
+			return;
+		}
+
+		while (m_Deadline - now > m_SleepSlack)
+		{
+			int64_t request = (std::min)(m_Deadline - now - m_SleepSlack, period);
+			std::this_thread::sleep_for(std::chrono::nanoseconds(request));
+
+			int64_t after = FrameClock::Now();
+			int64_t overshoot = (after - now) - request;
+			// Grows at once, shrinks slowly
+			if (overshoot > m_SleepSlack)
+				m_SleepSlack = overshoot;
+			else
+				m_SleepSlack -= (m_SleepSlack - (std::max)(overshoot, int64_t(0))) / 64;
+			now = after;
+		}
+
+		while (FrameClock::Now() < m_Deadline)
+			std::this_thread::yield();
+
+		m_Deadline += period;
+	}
+
+}
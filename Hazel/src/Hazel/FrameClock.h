@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Core.h"
+#include <cstdint>
+
+namespace Hazel {
+
+	// What one iteration of the frame loop advances
+	struct FrameStep
+	{
+		// Seconds since the previous frame, as passed to Layer::OnUpdate
+		float DeltaTime = 0.0f;
+		// Layer::OnFixedUpdate calls run this frame, each advancing FixedDeltaTime
+		uint32_t FixedSteps = 0;
+		float FixedDeltaTime = 0.0f;
+		// How far the frame lies between the last fixed step and the next, in
+		// [0, 1]; render fixed-step state as lerp(previous, current, Alpha)
+		float Alpha = 0.0f;
+		uint64_t FrameIndex = 0;
+	};
+
+	// Frame timing on a 64-bit nanosecond counter (steady_clock, QPC on
+	// Windows), so deltas stay exact however long the application runs.
+	class HAZEL_API FrameClock
+	{
+	public:
+		FrameClock();
+
+		// Starts the next frame and returns the seconds since the previous one
+		// (0 for the first frame after a Reset())
+		double Tick();
+		void Reset();
+
+		double GetDeltaSeconds() const { return m_Delta; }
+		// Since construction or the last Reset()
+		double GetElapsedSeconds() const;
+		uint64_t GetFrameCount() const { return m_FrameCount; }
+
+		static int64_t Now(); // Nanoseconds
+
+	private:
+		int64_t m_Start = 0;
+		int64_t m_LastTick = 0;
+		double m_Delta = 0.0;
+		uint64_t m_FrameCount = 0;
+	};
+
+	// Splits frame time into fixed simulation steps
+	class HAZEL_API FixedTimestep
+	{
+	public:
+		explicit FixedTimestep(double stepSeconds = 1.0 / 60.0, uint32_t maxStepsPerFrame = 8);
+
+		// Adds a frame's time and returns the steps it completes. After a long
+		// stall at most maxStepsPerFrame are run and the rest of the backlog is
+		// dropped, so the simulation does not spiral trying to catch up.
+		uint32_t Advance(double deltaSeconds);
+		// Fraction of a step accumulated since the last one
+		float GetAlpha() const;
+
+		void SetStep(double stepSeconds);
+		double GetStep() const { return m_Step; }
+		uint64_t GetDroppedSteps() const { return m_DroppedSteps; }
+
+	private:
+		double m_Step;
+		uint32_t m_MaxSteps;
+		double m_Accumulator = 0.0;
+		uint64_t m_DroppedSteps = 0;
+	};
+
+	enum class FrameLimitMode
+	{
+		// Presentation waits for the display's vertical blank
+		VSync = 0,
+		// No vsync and no waiting; for benchmarking
+		Uncapped = 1,
+		// No vsync; the limiter holds frames to a target rate
+		TargetFps = 2
+	};
+
+	// Paces frames to a target rate. It sleeps while the deadline is further
+	// away than the scheduler's observed oversleep, then spins for the rest,
+	// so frames land on time even with a coarse system timer.
+	class HAZEL_API FrameLimiter
+	{
+	public:
+		void SetTargetFps(double fps);
+		double GetTargetFps() const { return m_TargetFps; }
+
+		// Blocks until the current frame's slot is over
+		void Wait();
+		// Forgets the schedule, e.g. after switching modes
+		void Reset() { m_Deadline = 0; }
+
+	private:
+		double m_TargetFps = 60.0;
+		int64_t m_Deadline = 0;
+		// Worst recent overshoot of a sleep; starts pessimistic
+		int64_t m_SleepSlack = 2000000;
+	};
+
+}
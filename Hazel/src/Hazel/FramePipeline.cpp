@@ -0,0 +1,106 @@
+#include "FramePipeline.h"
+#include "Application.h"
+#include "Renderer/Renderer.h"
+#include "Debug/Profiler.h"
+#include <algorithm>
+
+namespace Hazel {
+
+	FramePipeline::~FramePipeline()
+	{
+		Flush();
+	}
+
+	bool FramePipeline::HasPipelinedLayers(const LayerStack& layers) const
+	{
+		return std::any_of(layers.begin(), layers.end(), [](const Layer* layer) { return layer->SupportsPipelinedUpdate(); });
+	}
+
+	void FramePipeline::Sync(const LayerStack& layers)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		JobSystem::Wait(m_Simulation);
+
+		// Drop queues of layers that left the stack; their GPU references go with them
+		for (auto it = m_Frames.begin(); it != m_Frames.end();)
+		{
+			if (std::find(layers.begin(), layers.end(), it->first) == layers.end())
+				it = m_Frames.erase(it);
+			else
+				++it;
+		}
+
+		m_RecordIndex ^= 1;
+	}
+
+	void FramePipeline::Kick(LayerStack& layers, const FrameStep& step)
+	{
+		// Queues are created here, on the calling thread, so the job never touches the map's structure
+		for (Layer* layer : layers)
+		{
+			if (layer->SupportsPipelinedUpdate() && m_Frames.find(layer) == m_Frames.end())
+				m_Frames.emplace(layer, std::make_unique<LayerFrames>());
+		}
+
+		m_SimulationStep = step;
+		JobSystem::Run([this, &layers]()
+		{
+			HZ_PROFILE_SCOPE("FramePipeline::Simulate");
+			const FrameStep& step = m_SimulationStep;
+			for (Layer* layer : layers)
+			{
+				if (!layer->SupportsPipelinedUpdate())
+					continue;
+
+				Renderer::BeginRecording(m_Frames.at(layer)->Queues[m_RecordIndex]);
+				for (uint32_t i = 0; i < step.FixedSteps; i++)
+					layer->OnFixedUpdate(step.FixedDeltaTime);
+				layer->OnUpdate(step.DeltaTime);
+				Renderer::EndRecording();
+			}
+		}, &m_Simulation);
+	}
+
+	void FramePipeline::Render(LayerStack& layers, const FrameStep& step)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		uint32_t renderIndex = m_RecordIndex ^ 1;
+
+		for (Layer* layer : layers)
+		{
+			if (!layer->SupportsPipelinedUpdate())
+			{
+				bool directOpenGL = layer->UsesDirectOpenGL();
+				if (directOpenGL)
+					Application::Get().AcquireRenderContext();
+				for (uint32_t i = 0; i < step.FixedSteps; i++)
+					layer->OnFixedUpdate(step.FixedDeltaTime);
+				layer->OnUpdate(step.DeltaTime);
+				if (directOpenGL)
+					Application::Get().ReleaseRenderContext();
+				continue;
+			}
+
+			auto it = m_Frames.find(layer);
+			if (it == m_Frames.end())
+				continue;
+
+			// With a render thread the frame is being recorded too: copy the
+			// layer's commands into it, since the layer records over its queue
+			// again before the render thread is guaranteed to be done with it
+			RenderQueue& queue = it->second->Queues[renderIndex];
+			if (RenderQueue* frame = Renderer::GetRecordingQueue())
+				frame->Append(queue);
+			else
+				queue.Execute();
+		}
+	}
+
+	void FramePipeline::Flush()
+	{
+		JobSystem::Wait(m_Simulation);
+	}
+
+}
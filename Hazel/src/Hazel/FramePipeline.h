@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Core.h"
+#include "LayerStack.h"
+#include "FrameClock.h"
+#include "Renderer/RenderQueue.h"
+#include "Threading/JobSystem.h"
+#include <memory>
+#include <unordered_map>
+
+namespace Hazel {
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
+	// Overlaps simulation with rendering. Every layer that supports pipelined
+	// updates owns two RenderQueues: while frame N's queue is replayed on the
+	// render thread, OnUpdate for frame N+1 records into the other one on a
+	// worker. Sync() is the hand-off point where the two swap roles, so rendered
+	// output lags the simulation by exactly one frame.
+	class HAZEL_API FramePipeline
+	{
+	public:
+		FramePipeline() = default;
+		~FramePipeline();
+
+		FramePipeline(const FramePipeline&) = delete;
+		FramePipeline& operator=(const FramePipeline&) = delete;
+
+		bool HasPipelinedLayers(const LayerStack& layers) const;
+
+		// Waits for the simulation started by Kick() and makes what it recorded the frame to render
+		void Sync(const LayerStack& layers);
+		// Starts OnFixedUpdate and OnUpdate of every pipelined layer on the job system
+		void Kick(LayerStack& layers, const FrameStep& step);
+		// In layer order: replays the recorded frame of pipelined layers (or copies
+		// it into the frame the calling thread records for the render thread) and
+		// runs OnFixedUpdate and OnUpdate of the others on the calling thread
+		void Render(LayerStack& layers, const FrameStep& step);
+
+		// Waits for any simulation in flight
+		void Flush();
+
+	private:
+		struct LayerFrames
+		{
+			RenderQueue Queues[2];
+		};
+
+		std::unordered_map<Layer*, std::unique_ptr<LayerFrames>> m_Frames;
+		uint32_t m_RecordIndex = 0;
+		JobCounter m_Simulation;
+		// Read by the simulation job; only written while none is in flight
+		FrameStep m_SimulationStep;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
@@ -1,20 +1,80 @@
 #include "ImGuiLayer.h"
 #include "../Log.h"
 #include "../Application.h"
+#include "../Memory/MemoryTracker.h"
+#include "../Debug/Profiler.h"
+#include "../Renderer/Renderer.h"
+#include "../Renderer/RenderQueue.h"
+#include "../Renderer/GpuProfiler.h"
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
 #include <GLFW/glfw3.h>
+#include <cstring>
 
 namespace Hazel {
 
+	struct ImGuiLayer::DrawDataSnapshot
+	{
+		ImDrawData DrawData;
+		// Owned copies of the frame's draw lists, reused from frame to frame
+		ImVector<ImDrawList*> Lists;
+
+		~DrawDataSnapshot()
+		{
+			for (ImDrawList* list : Lists)
+				IM_DELETE(list);
+		}
+
+		template<typename T>
+		static void CopyVector(ImVector<T>& destination, const ImVector<T>& source)
+		{
+			// resize() keeps the capacity; operator= would reallocate
+			destination.resize(source.Size);
+			if (source.Size > 0)
+				std::memcpy(destination.Data, source.Data, source.size_in_bytes());
+		}
+
+		void Capture(const ImDrawData& source)
+		{
+			while (Lists.Size < source.CmdListsCount)
+				Lists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+
+			DrawData.Clear();
+			DrawData.Valid = source.Valid;
+			DrawData.DisplayPos = source.DisplayPos;
+			DrawData.DisplaySize = source.DisplaySize;
+			DrawData.FramebufferScale = source.FramebufferScale;
+			DrawData.TotalVtxCount = source.TotalVtxCount;
+			DrawData.TotalIdxCount = source.TotalIdxCount;
+			// Texture requests are served on the main thread before the capture
+			DrawData.Textures = nullptr;
+
+			for (int i = 0; i < source.CmdListsCount; i++)
+			{
+				const ImDrawList* sourceList = source.CmdLists[i];
+				ImDrawList* list = Lists[i];
+				CopyVector(list->CmdBuffer, sourceList->CmdBuffer);
+				CopyVector(list->IdxBuffer, sourceList->IdxBuffer);
+				CopyVector(list->VtxBuffer, sourceList->VtxBuffer);
+				list->Flags = sourceList->Flags;
+				DrawData.CmdLists.push_back(list);
+			}
+			DrawData.CmdListsCount = source.CmdListsCount;
+		}
+	};
+
 	ImGuiLayer::ImGuiLayer()
 		: Layer("ImGuiLayer")
 	{
 	}
 
+	ImGuiLayer::~ImGuiLayer() = default;
+
 	void ImGuiLayer::OnAttach()
 	{
+		HZ_MEMORY_TAG(ImGui);
+
 		HZ_INFO("ImGuiLayer::OnAttach - Initializing ImGui");
 		
 		// Setup Dear ImGui context
@@ -26,7 +86,9 @@ namespace Hazel {
 		// Enable Docking and Multi-Viewport features (requires ImGui docking branch)
 		// Note: These flags are only available in ImGui docking branch, not in the standard release
 		io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;         // Enable Docking
-		io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;       // Enable Multi-Viewport / Platform Windows
+		// Platform windows would be pointless (and invisible) without a display
+		if (!Application::Get().IsHeadless())
+			io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;   // Enable Multi-Viewport / Platform Windows
 
 		// Setup Dear ImGui style - Dark theme like Unity
 		ImGui::StyleColorsDark();
@@ -43,6 +105,13 @@ namespace Hazel {
 		GLFWwindow* window = Application::Get().GetWindow();
 		ImGui_ImplGlfw_InitForOpenGL(window, true);
 		ImGui_ImplOpenGL3_Init("#version 330");
+		// Create the renderer objects now, while this thread has the context;
+		// with a render thread, NewFrame() would otherwise create them without one
+		ImGui_ImplOpenGL3_CreateDeviceObjects();
+
+		m_ViewportsEnabled = (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) != 0;
+		for (auto& snapshot : m_Snapshots)
+			snapshot = std::make_unique<DrawDataSnapshot>();
 
 		HZ_INFO("ImGui initialized successfully");
 	}
@@ -52,6 +121,8 @@ namespace Hazel {
 		HZ_INFO("ImGuiLayer::OnDetach");
 		
 		// Cleanup
+		for (auto& snapshot : m_Snapshots)
+			snapshot.reset();
 		ImGui_ImplOpenGL3_Shutdown();
 		ImGui_ImplGlfw_Shutdown();
 		ImGui::DestroyContext();
@@ -63,8 +134,41 @@ namespace Hazel {
 		// The Begin/End methods are called by the application main loop
 	}
 
+	void ImGuiLayer::OnEvent(Event& event)
+	{
+		if (!m_BlockEvents)
+			return;
+
+		// Reflects the previous frame's UI, the latest ImGui can know about
+		ImGuiIO& io = ImGui::GetIO();
+		if ((event.IsInCategory(EventCategoryMouse) && io.WantCaptureMouse) ||
+		    (event.IsInCategory(EventCategoryKeyboard) && io.WantCaptureKeyboard))
+		{
+			event.Handled = true;
+		}
+	}
+
 	void ImGuiLayer::Begin()
 	{
+		HZ_PROFILE_FUNCTION();
+
+		// Platform windows render on the main thread from End(), so they are
+		// unavailable while a render thread owns the context
+		ImGuiIO& io = ImGui::GetIO();
+		bool viewports = m_ViewportsEnabled && !Application::Get().GetRenderThread();
+		if (viewports != ((io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) != 0))
+		{
+			if (viewports)
+			{
+				io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
+			}
+			else
+			{
+				io.ConfigFlags &= ~ImGuiConfigFlags_ViewportsEnable;
+				ImGui::DestroyPlatformWindows();
+			}
+		}
+
 		// Start the Dear ImGui frame
 		ImGui_ImplOpenGL3_NewFrame();
 		ImGui_ImplGlfw_NewFrame();
@@ -73,6 +177,9 @@ namespace Hazel {
 
 	void ImGuiLayer::End()
 	{
+		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_TAG(ImGui);
+
 		// Rendering
 		ImGuiIO& io = ImGui::GetIO();
 		GLFWwindow* window = Application::Get().GetWindow();
@@ -81,7 +188,46 @@ namespace Hazel {
 		io.DisplaySize = ImVec2((float)display_w, (float)display_h);
 
 		ImGui::Render();
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		ImDrawData* drawData = ImGui::GetDrawData();
+
+		if (Renderer::GetRecordingQueue())
+		{
+			// The render thread owns the context. Texture requests (font atlas
+			// uploads) are rare and touch data ImGui owns, so they are served
+			// here with the context borrowed; the draw lists are copied so the
+			// next frame can be built while this one is drawn.
+			bool textureRequests = false;
+			if (drawData->Textures)
+			{
+				for (ImTextureData* texture : *drawData->Textures)
+					textureRequests |= texture->Status != ImTextureStatus_OK;
+			}
+			if (textureRequests)
+			{
+				Application::Get().AcquireRenderContext();
+				for (ImTextureData* texture : *drawData->Textures)
+				{
+					if (texture->Status != ImTextureStatus_OK)
+						ImGui_ImplOpenGL3_UpdateTexture(texture);
+				}
+				Application::Get().ReleaseRenderContext();
+			}
+
+			m_SnapshotIndex ^= 1;
+			DrawDataSnapshot* snapshot = m_Snapshots[m_SnapshotIndex].get();
+			snapshot->Capture(*drawData);
+			HZ_PROFILE_GPU("ImGui");
+			Renderer::GetRecordingQueue()->Callback([snapshot]()
+			{
+				ImGui_ImplOpenGL3_RenderDrawData(&snapshot->DrawData);
+			});
+			return;
+		}
+
+		{
+			HZ_PROFILE_GPU("ImGui");
+			ImGui_ImplOpenGL3_RenderDrawData(drawData);
+		}
 
 		// Update and Render additional Platform Windows
 		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
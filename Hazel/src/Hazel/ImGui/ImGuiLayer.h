@@ -1,30 +1,56 @@
 #pragma once
 
 #include "../Layer.h"
+#include <cstdint>
+#include <memory>
 
 // Forward declare ImGui context
 struct ImGuiContext;
 
 namespace Hazel {
 
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
 	class HAZEL_API ImGuiLayer : public Layer
 	{
 	public:
 		ImGuiLayer();
-		~ImGuiLayer() = default;
+		~ImGuiLayer();
 
 		virtual void OnAttach() override;
 		virtual void OnDetach() override;
 		virtual void OnImGuiRender() override;
+		// Marks mouse and keyboard events handled while ImGui wants that input
+		virtual void OnEvent(Event& event) override;
+		// Begin() and End() record their rendering when a render thread runs
+		virtual bool UsesDirectOpenGL() const override { return false; }
 
 		void Begin();
 		void End();
 
+		// When false, every event reaches the layers below
+		void SetBlockEvents(bool block) { m_BlockEvents = block; }
+
 		// Get the ImGui context for sharing across DLL boundary
 		static ImGuiContext* GetContext();
 
 	private:
+		// Copy of a frame's draw data that the render thread draws while the
+		// next frame is built; two of them alternate
+		struct DrawDataSnapshot;
+
 		float m_Time = 0.0f;
+		bool m_BlockEvents = true;
+		bool m_ViewportsEnabled = false;
+		std::unique_ptr<DrawDataSnapshot> m_Snapshots[2];
+		uint32_t m_SnapshotIndex = 0;
 	};
 
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
 }
@@ -20,9 +20,29 @@ namespace Hazel {
 		virtual void OnAttach() {}
 		virtual void OnDetach() {}
 		virtual void OnUpdate(float deltaTime) {}
+		// Runs Application::GetFrameStep().FixedSteps times per frame (possibly
+		// zero), right before OnUpdate and on the same thread
+		virtual void OnFixedUpdate(float fixedDeltaTime) {}
 		virtual void OnImGuiRender() {}
+		// Called on the main thread once per queued event, top of the stack
+		// first, before OnUpdate of the frame; set event.Handled to stop it
+		// reaching the layers below. No simulation runs meanwhile, but the
+		// OpenGL context is not acquired for it.
 		virtual void OnEvent(Event& event) {}
 
+		// In FrameMode::Pipelined, layers returning true have OnUpdate run on a
+		// worker thread while the previous frame is rendered, with their Renderer
+		// calls recorded into a RenderQueue. Such an OnUpdate must not call
+		// OpenGL, GLFW or ImGui directly, and its draws appear one frame later.
+		virtual bool SupportsPipelinedUpdate() const { return false; }
+
+		// With the render thread enabled, Renderer calls are recorded and the
+		// OpenGL context lives on that thread. Layers returning true here call
+		// OpenGL directly (framebuffers, buffer mapping) and get the context
+		// back for OnUpdate and OnImGuiRender, which stalls until the render
+		// thread has caught up.
+		virtual bool UsesDirectOpenGL() const { return !SupportsPipelinedUpdate(); }
+
 		inline const std::string& GetName() const { return m_DebugName; }
 
 	protected:
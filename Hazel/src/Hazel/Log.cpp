@@ -1,89 +1,470 @@
 #include "Log.h"
-#include <iostream>
+#include "LogHistory.h"
+#include "Memory/MemoryTracker.h"
+#include "Debug/Profiler.h"
+#include <atomic>
 #include <chrono>
-#include <iomanip>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <thread>
 
 namespace Hazel {
 
-	std::vector<LogMessage> Log::s_Messages;
 	bool Log::s_Initialized = false;
+	std::atomic<int> Log::s_Level{ static_cast<int>(LogLevel::Trace) };
 
-	void Log::Init()
+	/////////////////////////////////////////////////////////////////////////////
+	// Record queue /////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	namespace {
+
+		constexpr uint64_t s_QueueCapacity = 4096;
+		constexpr uint64_t s_QueueMask = s_QueueCapacity - 1;
+		constexpr size_t s_SlotSize = 256;
+
+		struct LogRecord
+		{
+			int64_t Time; // system_clock nanoseconds
+			const char* Format; // Null when Data is finished text
+			unsigned char* HeapData; // Used instead of Data when the record does not fit
+			uint32_t Size;
+			LogLevel Level;
+			unsigned char Data[Log::InlineArgumentSize];
+		};
+
+		// Bounded queue after Vyukov: a slot is free for position p when its
+		// sequence is p, and holds a record when it is p + 1. Producers claim
+		// positions with one fetch_add, so they never retry against each other.
+		struct alignas(64) LogSlot
+		{
+			std::atomic<uint64_t> Sequence{ 0 };
+			LogRecord Record;
+		};
+		static_assert(sizeof(LogSlot) == s_SlotSize, "Log slots should stay one size");
+
+		struct LogData
+		{
+			LogSlot Slots[s_QueueCapacity];
+			alignas(64) std::atomic<uint64_t> Head{ 0 };
+			// Advanced by the writer once a batch is out
+			alignas(64) std::atomic<uint64_t> Tail{ 0 };
+
+			std::thread Writer;
+			bool Running = true; // Guarded by WakeMutex
+			bool WakeRequested = false;
+			std::mutex WakeMutex;
+			std::condition_variable WakeCondition;
+
+			std::mutex FlushMutex;
+			std::condition_variable FlushCondition;
+
+			FILE* File = nullptr;
+		};
+
+		LogData* s_Data = nullptr;
+
+		// Serializes the output while no writer thread runs
+		std::mutex s_OutputMutex;
+
+		LogHistory& GetMutableHistory()
+		{
+			static LogHistory s_History;
+			return s_History;
+		}
+
+		// Without a pending wake-up the writer looks for records this often
+		constexpr auto s_WriterInterval = std::chrono::milliseconds(5);
+
+		int64_t Now()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::system_clock::now().time_since_epoch()).count();
+		}
+
+		template<typename T>
+		T ReadValue(const unsigned char*& cursor)
+		{
+			T value;
+			std::memcpy(&value, cursor, sizeof(T));
+			cursor += sizeof(T);
+			return value;
+		}
+
+		// Appends the next argument; false once the arguments run out
+		bool AppendArgument(std::string& out, const unsigned char*& cursor, const unsigned char* end, int precision)
+		{
+			if (cursor >= end)
+				return false;
+
+			char buffer[64];
+			LogArguments::Type type = static_cast<LogArguments::Type>(*cursor++);
+			switch (type)
+			{
+			case LogArguments::Type::Bool:
+				out += *cursor++ ? "true" : "false";
+				return true;
+			case LogArguments::Type::Char:
+				out += static_cast<char>(*cursor++);
+				return true;
+			case LogArguments::Type::Int:
+				std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(ReadValue<int64_t>(cursor)));
+				break;
+			case LogArguments::Type::UInt:
+				std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(ReadValue<uint64_t>(cursor)));
+				break;
+			case LogArguments::Type::Float:
+				if (precision >= 0)
+					std::snprintf(buffer, sizeof(buffer), "%.*f", precision, ReadValue<double>(cursor));
+				else
+					std::snprintf(buffer, sizeof(buffer), "%g", ReadValue<double>(cursor));
+				break;
+			case LogArguments::Type::Pointer:
+				std::snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(ReadValue<uint64_t>(cursor)));
+				break;
+			case LogArguments::Type::String:
+			{
+				uint32_t length = ReadValue<uint32_t>(cursor);
+				out.append(reinterpret_cast<const char*>(cursor), length);
+				cursor += length;
+				return true;
+			}
+			default:
+				cursor = end;
+				return false;
+			}
+
+			out += buffer;
+			return true;
+		}
+
+		// Replaces {} and {:.N} in 'format' with the captured arguments; {{ and }} are literal braces
+		void FormatRecord(std::string& out, const char* format, const unsigned char* data, size_t size)
+		{
+			const unsigned char* cursor = data;
+			const unsigned char* end = data + size;
+			for (const char* c = format; *c; c++)
+			{
+				if ((c[0] == '{' && c[1] == '{') || (c[0] == '}' && c[1] == '}'))
+				{
+					out += *c++;
+					continue;
+				}
+
+				const char* close = c[0] == '{' ? std::strchr(c, '}') : nullptr;
+				if (!close)
+				{
+					out += *c;
+					continue;
+				}
+
+				int precision = -1;
+				if (c[1] == ':' && c[2] == '.')
+					precision = std::atoi(c + 3);
+
+				if (!AppendArgument(out, cursor, end, precision))
+					out.append(c, close + 1);
+				c = close;
+			}
+		}
+
+		void WakeWriter(LogData& data)
+		{
+			{
+				std::lock_guard<std::mutex> lock(data.WakeMutex);
+				data.WakeRequested = true;
+			}
+			data.WakeCondition.notify_one();
+		}
+
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Log //////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	void Log::Init(const std::string& filePath)
 	{
-		if (!s_Initialized)
+		if (s_Initialized)
+			return;
+
+		HZ_MEMORY_TAG(Log);
+
+		s_Data = new LogData();
+		for (uint64_t i = 0; i < s_QueueCapacity; i++)
+			s_Data->Slots[i].Sequence.store(i, std::memory_order_relaxed);
+
+		bool fileFailed = false;
+		if (!filePath.empty())
 		{
-			s_Initialized = true;
-			Info("Hazel Logging System Initialized");
+			s_Data->File = std::fopen(filePath.c_str(), "w");
+			fileFailed = s_Data->File == nullptr;
 		}
+
+		s_Data->Writer = std::thread(&Log::WriterMain);
+		s_Initialized = true;
+
+		Info("Hazel Logging System Initialized");
+		if (fileFailed)
+			Warn("Failed to open log file " + filePath);
 	}
 
 	void Log::Shutdown()
 	{
-		if (s_Initialized)
+		if (!s_Initialized)
+			return;
+
+		Info("Hazel Logging System Shutdown");
+
+		// The writer drains the queue before it exits
 		{
-			Info("Hazel Logging System Shutdown");
-			s_Initialized = false;
+			std::lock_guard<std::mutex> lock(s_Data->WakeMutex);
+			s_Data->Running = false;
 		}
+		s_Data->WakeCondition.notify_one();
+		s_Data->Writer.join();
+
+		if (s_Data->File)
+			std::fclose(s_Data->File);
+
+		s_Initialized = false;
+		delete s_Data;
+		s_Data = nullptr;
 	}
 
 	void Log::Trace(const std::string& message)
 	{
-		AddLogMessage(LogLevel::Trace, message);
+		if (IsEnabled(LogLevel::Trace))
+			AddRecord(LogLevel::Trace, nullptr, message.data(), message.size());
 	}
 
 	void Log::Info(const std::string& message)
 	{
-		AddLogMessage(LogLevel::Info, message);
+		if (IsEnabled(LogLevel::Info))
+			AddRecord(LogLevel::Info, nullptr, message.data(), message.size());
 	}
 
 	void Log::Warn(const std::string& message)
 	{
-		AddLogMessage(LogLevel::Warn, message);
+		if (IsEnabled(LogLevel::Warn))
+			AddRecord(LogLevel::Warn, nullptr, message.data(), message.size());
 	}
 
 	void Log::Error(const std::string& message)
 	{
-		AddLogMessage(LogLevel::Error, message);
+		if (IsEnabled(LogLevel::Error))
+			AddRecord(LogLevel::Error, nullptr, message.data(), message.size());
 	}
 
 	void Log::Fatal(const std::string& message)
 	{
-		AddLogMessage(LogLevel::Fatal, message);
+		AddRecord(LogLevel::Fatal, nullptr, message.data(), message.size());
+	}
+
+	void Log::Flush()
+	{
+		LogData* data = s_Data;
+		if (!data)
+		{
+			std::fflush(stdout);
+			return;
+		}
+
+		uint64_t target = data->Head.load(std::memory_order_acquire);
+		WakeWriter(*data);
+
+		std::unique_lock<std::mutex> lock(data->FlushMutex);
+		data->FlushCondition.wait(lock, [data, target]()
+		{
+			return data->Tail.load(std::memory_order_acquire) >= target;
+		});
+	}
+
+	const LogHistory& Log::GetHistory()
+	{
+		return GetMutableHistory();
 	}
 
-	void Log::AddLogMessage(LogLevel level, const std::string& message)
+	void Log::ClearMessages()
 	{
-		std::string timestamp = GetTimestamp();
-		const char* levelStr = LogLevelToString(level);
-
-		// Store message
-		LogMessage logMsg;
-		logMsg.level = level;
-		logMsg.message = message;
-		logMsg.timestamp = timestamp;
-		s_Messages.push_back(logMsg);
-
-		// Console output
-		std::cout << "[" << timestamp << "] [" << levelStr << "] " << message << std::endl;
+		GetMutableHistory().Clear();
+	}
+
+	void Log::FormatTimestamp(int64_t time, char (&buffer)[16])
+	{
+		// The local time is only converted when the second changes
+		static thread_local int64_t t_LastSecond = -1;
+		static thread_local char t_SecondText[16] = {};
+
+		int64_t second = time / 1000000000;
+		if (second != t_LastSecond)
+		{
+			t_LastSecond = second;
+			std::time_t seconds = static_cast<std::time_t>(second);
+			std::tm tm;
+			#ifdef _WIN32
+				localtime_s(&tm, &seconds);
+			#else
+				localtime_r(&seconds, &tm);
+			#endif
+			std::strftime(t_SecondText, sizeof(t_SecondText), "%H:%M:%S", &tm);
+		}
+
+		std::snprintf(buffer, sizeof(buffer), "%s.%03d", t_SecondText, static_cast<int>(time / 1000000 % 1000));
+	}
+
+	void Log::AddRecord(LogLevel level, const char* format, const void* data, size_t size)
+	{
+		int64_t time = Now();
+		LogData* queue = s_Data;
+		if (!queue)
+		{
+			HZ_MEMORY_TAG(Log);
+
+			// No writer thread: format and write right here
+			char timestamp[16];
+			FormatTimestamp(time, timestamp);
+			std::string message;
+			if (format)
+				FormatRecord(message, format, static_cast<const unsigned char*>(data), size);
+			else
+				message.assign(static_cast<const char*>(data), size);
+
+			std::lock_guard<std::mutex> lock(s_OutputMutex);
+			std::printf("[%s] [%s] %s\n", timestamp, LogLevelToString(level), message.c_str());
+			GetMutableHistory().Append(level, time, message.data(), message.size());
+			return;
+		}
+
+		// Claim a position; its slot is free once the writer has taken the
+		// record from one lap earlier
+		uint64_t position = queue->Head.fetch_add(1, std::memory_order_relaxed);
+		LogSlot* slot = &queue->Slots[position & s_QueueMask];
+		while (slot->Sequence.load(std::memory_order_acquire) != position)
+		{
+			// Full: wait for the writer rather than lose the message
+			WakeWriter(*queue);
+			std::this_thread::yield();
+		}
+
+		LogRecord& record = slot->Record;
+		record.Time = time;
+		record.Format = format;
+		record.Level = level;
+		record.Size = static_cast<uint32_t>(size);
+		record.HeapData = nullptr;
+		if (size <= InlineArgumentSize)
+		{
+			if (size > 0)
+				std::memcpy(record.Data, data, size);
+		}
+		else
+		{
+			HZ_MEMORY_TAG(Log);
+			record.HeapData = new unsigned char[size];
+			std::memcpy(record.HeapData, data, size);
+		}
+		slot->Sequence.store(position + 1, std::memory_order_release);
+
+		// Otherwise the writer picks the record up on its next round
+		if (level >= LogLevel::Error || position - queue->Tail.load(std::memory_order_relaxed) >= s_QueueCapacity / 2)
+			WakeWriter(*queue);
+
+		if (level == LogLevel::Fatal)
+			Flush();
 	}
 
-	std::string Log::GetTimestamp()
+	void Log::WriterMain()
 	{
-		auto now = std::chrono::system_clock::now();
-		auto time = std::chrono::system_clock::to_time_t(now);
-		auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-			now.time_since_epoch()) % 1000;
-
-		std::stringstream ss;
-		std::tm tm;
-		#ifdef _WIN32
-			localtime_s(&tm, &time);
-		#else
-			localtime_r(&time, &tm);
-		#endif
-		ss << std::put_time(&tm, "%H:%M:%S");
-		ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-		return ss.str();
+		HZ_MEMORY_TAG(Log);
+		Profiler::SetThreadName("Log Writer");
+
+		LogData& data = *s_Data;
+		uint64_t tail = data.Tail.load(std::memory_order_relaxed);
+		std::string batch;
+		std::string text;
+		LogHistory& history = GetMutableHistory();
+
+		for (;;)
+		{
+			batch.clear();
+
+			// Take every record that is ready, in order
+			for (;;)
+			{
+				LogSlot& slot = data.Slots[tail & s_QueueMask];
+				if (slot.Sequence.load(std::memory_order_acquire) != tail + 1)
+					break;
+
+				LogRecord& record = slot.Record;
+				const unsigned char* data = record.HeapData ? record.HeapData : record.Data;
+				text.clear();
+				if (record.Format)
+					FormatRecord(text, record.Format, data, record.Size);
+				else
+					text.assign(reinterpret_cast<const char*>(data), record.Size);
+
+				char timestamp[16];
+				FormatTimestamp(record.Time, timestamp);
+
+				batch += '[';
+				batch += timestamp;
+				batch += "] [";
+				batch += LogLevelToString(record.Level);
+				batch += "] ";
+				batch += text;
+				batch += '\n';
+				history.Append(record.Level, record.Time, text.data(), text.size());
+
+				delete[] record.HeapData;
+				record.HeapData = nullptr;
+				slot.Sequence.store(tail + s_QueueCapacity, std::memory_order_release);
+				tail++;
+			}
+
+			if (!batch.empty())
+			{
+				std::fwrite(batch.data(), 1, batch.size(), stdout);
+				std::fflush(stdout);
+				if (data.File)
+				{
+					std::fwrite(batch.data(), 1, batch.size(), data.File);
+					std::fflush(data.File);
+				}
+
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(data.FlushMutex);
+				data.Tail.store(tail, std::memory_order_release);
+			}
+			data.FlushCondition.notify_all();
+
+			if (!batch.empty())
+				continue;
+
+			std::unique_lock<std::mutex> lock(data.WakeMutex);
+			if (!data.Running)
+			{
+				// Producers are gone once Shutdown() runs; only a claimed slot
+				// that is still being filled can be left
+				if (data.Head.load(std::memory_order_acquire) == tail)
+					break;
+				lock.unlock();
+				std::this_thread::yield();
+				continue;
+			}
+
+			data.WakeCondition.wait_for(lock, s_WriterInterval, [&data]()
+			{
+				return data.WakeRequested || !data.Running;
+			});
+			data.WakeRequested = false;
+		}
 	}
 
 	const char* Log::LogLevelToString(LogLevel level)
@@ -1,13 +1,20 @@
 #pragma once
 
 #include "Core.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 #include <sstream>
 
 namespace Hazel {
 
+	class LogHistory;
+
 	enum class LogLevel
 	{
 		Trace = 0,
@@ -22,36 +29,169 @@ namespace Hazel {
 	#pragma warning(disable: 4251) // Disable warning about STL types in DLL interface
 #endif
 
-	struct LogMessage
-	{
-		LogLevel level;
-		std::string message;
-		std::string timestamp;
-	};
+	// Binary form of the arguments of a format-string log call. Each argument
+	// is a type byte followed by its value; strings are copied with a 32-bit
+	// length, everything else widened to 8 bytes. Decoded on the writer thread.
+	namespace LogArguments {
+
+		enum class Type : uint8_t
+		{
+			Bool,
+			Char,
+			Int,
+			UInt,
+			Float,
+			String,
+			Pointer
+		};
+
+		template<typename T>
+		struct Unsupported : std::false_type {};
+
+		template<typename T>
+		size_t Size(const T& value)
+		{
+			using Decayed = std::decay_t<T>;
+			if constexpr (std::is_same_v<Decayed, bool> || std::is_same_v<Decayed, char>)
+				return 2;
+			else if constexpr (std::is_same_v<Decayed, const char*> || std::is_same_v<Decayed, char*>)
+				return 5 + (value ? std::strlen(value) : 0);
+			else if constexpr (std::is_same_v<Decayed, std::string> || std::is_same_v<Decayed, std::string_view>)
+				return 5 + value.size();
+			else if constexpr (std::is_arithmetic_v<Decayed> || std::is_enum_v<Decayed> || std::is_pointer_v<Decayed>)
+				return 9;
+			else
+				static_assert(Unsupported<T>::value, "Log arguments must be numbers, enums, pointers or strings");
+		}
+
+		inline unsigned char* WriteString(unsigned char* out, const char* text, size_t length)
+		{
+			uint32_t length32 = static_cast<uint32_t>(length);
+			*out++ = static_cast<unsigned char>(Type::String);
+			std::memcpy(out, &length32, sizeof(length32));
+			std::memcpy(out + sizeof(length32), text, length);
+			return out + sizeof(length32) + length;
+		}
 
+		template<typename Value>
+		unsigned char* WriteValue(unsigned char* out, Type type, Value value)
+		{
+			static_assert(sizeof(Value) == 8, "Log values are widened to 8 bytes");
+			*out++ = static_cast<unsigned char>(type);
+			std::memcpy(out, &value, sizeof(value));
+			return out + sizeof(value);
+		}
+
+		template<typename T>
+		unsigned char* Write(unsigned char* out, const T& value)
+		{
+			using Decayed = std::decay_t<T>;
+			if constexpr (std::is_same_v<Decayed, bool> || std::is_same_v<Decayed, char>)
+			{
+				out[0] = static_cast<unsigned char>(std::is_same_v<Decayed, bool> ? Type::Bool : Type::Char);
+				out[1] = static_cast<unsigned char>(value);
+				return out + 2;
+			}
+			else if constexpr (std::is_same_v<Decayed, const char*> || std::is_same_v<Decayed, char*>)
+				return WriteString(out, value ? value : "", value ? std::strlen(value) : 0);
+			else if constexpr (std::is_same_v<Decayed, std::string> || std::is_same_v<Decayed, std::string_view>)
+				return WriteString(out, value.data(), value.size());
+			else if constexpr (std::is_enum_v<Decayed>)
+				return WriteValue(out, Type::Int, static_cast<int64_t>(value));
+			else if constexpr (std::is_floating_point_v<Decayed>)
+				return WriteValue(out, Type::Float, static_cast<double>(value));
+			else if constexpr (std::is_signed_v<Decayed>)
+				return WriteValue(out, Type::Int, static_cast<int64_t>(value));
+			else if constexpr (std::is_unsigned_v<Decayed>)
+				return WriteValue(out, Type::UInt, static_cast<uint64_t>(value));
+			else
+				return WriteValue(out, Type::Pointer, reinterpret_cast<uint64_t>(static_cast<const void*>(value)));
+		}
+
+	}
+
+	// Call sites copy the message into a fixed-size slot of a lock-free
+	// multi-producer queue and return; a background thread formats the
+	// records and writes them to the console and the log file in batches.
+	// Records larger than a slot are copied to the heap instead.
+	//
+	// The HZ_* macros take a format string literal with {} placeholders
+	// ({:.N} for N decimals). Only the arguments are captured, in binary, and
+	// the text is built on the writer thread. Calls below the runtime level
+	// return before any argument is evaluated; levels below
+	// HZ_LOG_COMPILE_LEVEL are compiled out.
+	//
+	// Before Init() and after Shutdown() messages are written synchronously.
+	// Fatal messages are flushed before the call returns.
 	class HAZEL_API Log
 	{
 	public:
-		static void Init();
+		// Argument bytes that fit in a queue slot; larger records use the heap
+		static constexpr size_t InlineArgumentSize = 216;
+
+		// 'filePath' also receives every message; empty for console only
+		static void Init(const std::string& filePath = std::string());
 		static void Shutdown();
 
+		// Messages below 'level' are dropped at the call site
+		static void SetLevel(LogLevel level) { s_Level.store(static_cast<int>(level), std::memory_order_relaxed); }
+		static LogLevel GetLevel() { return static_cast<LogLevel>(s_Level.load(std::memory_order_relaxed)); }
+		static bool IsEnabled(LogLevel level) { return static_cast<int>(level) >= s_Level.load(std::memory_order_relaxed); }
+
+		// Already formatted text, e.g. from a library callback
 		static void Trace(const std::string& message);
 		static void Info(const std::string& message);
 		static void Warn(const std::string& message);
 		static void Error(const std::string& message);
 		static void Fatal(const std::string& message);
 
-		static const std::vector<LogMessage>& GetMessages() { return s_Messages; }
-		static void ClearMessages() { s_Messages.clear(); }
+		// Used by the HZ_* macros; 'format' must be a string literal
+		template<typename... Args>
+		static void Write(LogLevel level, const char* format, const Args&... args)
+		{
+			if constexpr (sizeof...(Args) == 0)
+			{
+				AddRecord(level, format, nullptr, 0);
+			}
+			else
+			{
+				size_t size = (LogArguments::Size(args) + ...);
+				if (size <= InlineArgumentSize)
+				{
+					unsigned char buffer[InlineArgumentSize];
+					unsigned char* out = buffer;
+					((out = LogArguments::Write(out, args)), ...);
+					AddRecord(level, format, buffer, size);
+				}
+				else
+				{
+					std::vector<unsigned char> buffer(size);
+					unsigned char* out = buffer.data();
+					((out = LogArguments::Write(out, args)), ...);
+					AddRecord(level, format, buffer.data(), size);
+				}
+			}
+		}
+
+		// Blocks until every message logged before the call has been written
+		static void Flush();
+
+		// The most recent messages, for the editor console
+		static const LogHistory& GetHistory();
+		static void ClearMessages();
+
+		// "HH:MM:SS.mmm" in local time
+		static void FormatTimestamp(int64_t time, char (&buffer)[16]);
 
 	private:
-		static void AddLogMessage(LogLevel level, const std::string& message);
-		static std::string GetTimestamp();
+		// 'format' is null when 'data' holds finished text
+		static void AddRecord(LogLevel level, const char* format, const void* data, size_t size);
+		static void WriterMain();
 		static const char* LogLevelToString(LogLevel level);
 
 	private:
-		static std::vector<LogMessage> s_Messages;
 		static bool s_Initialized;
+		static std::atomic<int> s_Level;
 	};
 
 #ifdef _MSC_VER
@@ -60,9 +200,49 @@ namespace Hazel {
 
 }
 
+#define HZ_LOG_LEVEL_TRACE 0
+#define HZ_LOG_LEVEL_INFO  1
+#define HZ_LOG_LEVEL_WARN  2
+#define HZ_LOG_LEVEL_ERROR 3
+#define HZ_LOG_LEVEL_FATAL 4
+
+// Calls below this level are compiled out, arguments included
+#ifndef HZ_LOG_COMPILE_LEVEL
+	#ifdef _DEBUG
+		#define HZ_LOG_COMPILE_LEVEL HZ_LOG_LEVEL_TRACE
+	#else
+		#define HZ_LOG_COMPILE_LEVEL HZ_LOG_LEVEL_INFO
+	#endif
+#endif
+
+// HZ_LOG(Warn, "Texture {} is {}x{}", name, width, height)
+#define HZ_LOG(level, format, ...) \
+	do { if (::Hazel::Log::IsEnabled(::Hazel::LogLevel::level)) ::Hazel::Log::Write(::Hazel::LogLevel::level, "" format, ##__VA_ARGS__); } while (false)
+#define HZ_LOG_DISABLED() do {} while (false)
+
 // Convenience macros
-#define HZ_TRACE(...)    ::Hazel::Log::Trace(__VA_ARGS__)
-#define HZ_INFO(...)     ::Hazel::Log::Info(__VA_ARGS__)
-#define HZ_WARN(...)     ::Hazel::Log::Warn(__VA_ARGS__)
-#define HZ_ERROR(...)    ::Hazel::Log::Error(__VA_ARGS__)
-#define HZ_FATAL(...)    ::Hazel::Log::Fatal(__VA_ARGS__)
+#if HZ_LOG_COMPILE_LEVEL <= HZ_LOG_LEVEL_TRACE
+	#define HZ_TRACE(format, ...) HZ_LOG(Trace, format, ##__VA_ARGS__)
+#else
+	#define HZ_TRACE(format, ...) HZ_LOG_DISABLED()
+#endif
+
+#if HZ_LOG_COMPILE_LEVEL <= HZ_LOG_LEVEL_INFO
+	#define HZ_INFO(format, ...) HZ_LOG(Info, format, ##__VA_ARGS__)
+#else
+	#define HZ_INFO(format, ...) HZ_LOG_DISABLED()
+#endif
+
+#if HZ_LOG_COMPILE_LEVEL <= HZ_LOG_LEVEL_WARN
+	#define HZ_WARN(format, ...) HZ_LOG(Warn, format, ##__VA_ARGS__)
+#else
+	#define HZ_WARN(format, ...) HZ_LOG_DISABLED()
+#endif
+
+#if HZ_LOG_COMPILE_LEVEL <= HZ_LOG_LEVEL_ERROR
+	#define HZ_ERROR(format, ...) HZ_LOG(Error, format, ##__VA_ARGS__)
+#else
+	#define HZ_ERROR(format, ...) HZ_LOG_DISABLED()
+#endif
+
+#define HZ_FATAL(format, ...) HZ_LOG(Fatal, format, ##__VA_ARGS__)
@@ -0,0 +1,94 @@
+#include "LogHistory.h"
+#include "Memory/MemoryTracker.h"
+#include <cstring>
+
+namespace Hazel {
+
+	LogHistory::LogHistory(uint32_t entryCapacity, size_t textCapacity)
+		: m_EntryCapacity(entryCapacity), m_TextCapacity(textCapacity)
+	{
+	}
+
+	void LogHistory::Append(LogLevel level, int64_t time, const char* text, size_t length)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (!m_Records)
+		{
+			HZ_MEMORY_TAG(Log);
+			m_Records.reset(new Record[m_EntryCapacity]);
+			m_Text.reset(new char[m_TextCapacity]);
+		}
+
+		if (length > m_TextCapacity / 4)
+			length = m_TextCapacity / 4;
+
+		// Text never wraps inside a line, so the tail of the ring is skipped instead
+		size_t offset = static_cast<size_t>(m_TextEnd % m_TextCapacity);
+		if (offset + length > m_TextCapacity)
+			m_TextEnd += m_TextCapacity - offset;
+
+		uint64_t textEnd = m_TextEnd + length;
+		while (m_Begin < m_End &&
+		       (m_End - m_Begin >= m_EntryCapacity || m_Records[m_Begin % m_EntryCapacity].TextOffset + m_TextCapacity < textEnd))
+		{
+			DropOldest();
+		}
+
+		std::memcpy(m_Text.get() + m_TextEnd % m_TextCapacity, text, length);
+
+		Record& record = m_Records[m_End % m_EntryCapacity];
+		record.TextOffset = m_TextEnd;
+		record.Time = time;
+		record.Length = static_cast<uint32_t>(length);
+		record.Level = level;
+
+		m_TextEnd = textEnd;
+		m_End++;
+		m_LevelCounts[static_cast<uint32_t>(level)]++;
+	}
+
+	void LogHistory::Clear()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Begin = m_End;
+		for (uint64_t& count : m_LevelCounts)
+			count = 0;
+	}
+
+	uint64_t LogHistory::GetBegin() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return m_Begin;
+	}
+
+	uint64_t LogHistory::GetEnd() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return m_End;
+	}
+
+	uint64_t LogHistory::GetLevelCount(LogLevel level) const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return m_LevelCounts[static_cast<uint32_t>(level)];
+	}
+
+	void LogHistory::GetEntry(uint64_t sequence, LogEntry& entry) const
+	{
+		const Record& record = m_Records[sequence % m_EntryCapacity];
+		entry.Sequence = sequence;
+		entry.Time = record.Time;
+		entry.Level = record.Level;
+		entry.LevelBit = LogLevelBit(record.Level);
+		entry.Text = m_Text.get() + record.TextOffset % m_TextCapacity;
+		entry.Length = record.Length;
+	}
+
+	void LogHistory::DropOldest()
+	{
+		m_LevelCounts[static_cast<uint32_t>(m_Records[m_Begin % m_EntryCapacity].Level)]--;
+		m_Begin++;
+	}
+
+}
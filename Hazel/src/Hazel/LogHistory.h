@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Core.h"
+#include "Log.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace Hazel {
+
+	// Filters combine these per level, e.g. LogLevelBit(Warn) | LogLevelBit(Error)
+	inline uint32_t LogLevelBit(LogLevel level) { return 1u << static_cast<uint32_t>(level); }
+	constexpr uint32_t LogLevelAll = 0x1F;
+	constexpr uint32_t LogLevelCount = 5;
+
+	// A retained log line. Text is not null-terminated and only valid inside
+	// the LogHistory::ForEach callback that received it.
+	struct LogEntry
+	{
+		uint64_t Sequence = 0;
+		int64_t Time = 0; // system_clock nanoseconds
+		LogLevel Level = LogLevel::Trace;
+		uint32_t LevelBit = 0;
+		const char* Text = nullptr;
+		uint32_t Length = 0;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
+	// The most recent log lines in fixed memory: a ring of small entries and a
+	// ring of text bytes, both allocated with the first line. Every line gets
+	// the next sequence number; once either ring wraps, the oldest lines are
+	// dropped, so the retained lines are always [GetBegin(), GetEnd()).
+	//
+	// Appended by the log writer thread; any thread may read.
+	class HAZEL_API LogHistory
+	{
+	public:
+		explicit LogHistory(uint32_t entryCapacity = 1u << 18, size_t textCapacity = 16u << 20);
+
+		LogHistory(const LogHistory&) = delete;
+		LogHistory& operator=(const LogHistory&) = delete;
+
+		// Lines longer than a quarter of the text ring are cut
+		void Append(LogLevel level, int64_t time, const char* text, size_t length);
+		// Drops every line; sequence numbers keep counting
+		void Clear();
+
+		uint64_t GetBegin() const;
+		uint64_t GetEnd() const;
+		// Retained lines of 'level'
+		uint64_t GetLevelCount(LogLevel level) const;
+
+		// Calls func(const LogEntry&) for each retained line in [begin, end)
+		template<typename Func>
+		void ForEach(uint64_t begin, uint64_t end, Func&& func) const
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			LogEntry entry;
+			for (uint64_t sequence = begin < m_Begin ? m_Begin : begin; sequence < end && sequence < m_End; sequence++)
+			{
+				GetEntry(sequence, entry);
+				func(entry);
+			}
+		}
+
+		// Calls func(const LogEntry&) for each listed line that is still retained
+		template<typename Func>
+		void ForEachOf(const uint64_t* sequences, size_t count, Func&& func) const
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			LogEntry entry;
+			for (size_t i = 0; i < count; i++)
+			{
+				if (sequences[i] < m_Begin || sequences[i] >= m_End)
+					continue;
+				GetEntry(sequences[i], entry);
+				func(entry);
+			}
+		}
+
+	private:
+		struct Record
+		{
+			uint64_t TextOffset; // Into the endless byte stream the text ring wraps
+			int64_t Time;
+			uint32_t Length;
+			LogLevel Level;
+		};
+
+		// m_Mutex held and 'sequence' retained
+		void GetEntry(uint64_t sequence, LogEntry& entry) const;
+		void DropOldest();
+
+	private:
+		mutable std::mutex m_Mutex;
+
+		uint32_t m_EntryCapacity;
+		size_t m_TextCapacity;
+		std::unique_ptr<Record[]> m_Records;
+		std::unique_ptr<char[]> m_Text;
+
+		uint64_t m_Begin = 0;
+		uint64_t m_End = 0;
+		uint64_t m_TextEnd = 0;
+		uint64_t m_LevelCounts[LogLevelCount] = {};
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
@@ -0,0 +1,183 @@
+#include "MappedFile.h"
+#include "Log.h"
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace Hazel {
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+	{
+		MoveFrom(other);
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Close();
+			MoveFrom(other);
+		}
+		return *this;
+	}
+
+	void MappedFile::MoveFrom(MappedFile& other)
+	{
+		m_Data = other.m_Data;
+		m_Size = other.m_Size;
+		m_Path = std::move(other.m_Path);
+		other.m_Data = nullptr;
+		other.m_Size = 0;
+
+#ifdef _WIN32
+		m_FileHandle = other.m_FileHandle;
+		m_MappingHandle = other.m_MappingHandle;
+		other.m_FileHandle = nullptr;
+		other.m_MappingHandle = nullptr;
+#else
+		m_FileDescriptor = other.m_FileDescriptor;
+		other.m_FileDescriptor = -1;
+#endif
+	}
+
+#ifdef _WIN32
+
+	bool MappedFile::Open(const std::string& path)
+	{
+		Close();
+
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		                          OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			HZ_ERROR("MappedFile: failed to open {}", path);
+			return false;
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			HZ_ERROR("MappedFile: empty or unreadable file {}", path);
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping)
+		{
+			HZ_ERROR("MappedFile: failed to create file mapping for {}", path);
+			CloseHandle(file);
+			return false;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!data)
+		{
+			HZ_ERROR("MappedFile: failed to map view of {}", path);
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_FileHandle = file;
+		m_MappingHandle = mapping;
+		m_Data = static_cast<const unsigned char*>(data);
+		m_Size = static_cast<size_t>(size.QuadPart);
+		m_Path = path;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+		if (m_MappingHandle)
+			CloseHandle(m_MappingHandle);
+		if (m_FileHandle)
+			CloseHandle(m_FileHandle);
+
+		m_Data = nullptr;
+		m_Size = 0;
+		m_MappingHandle = nullptr;
+		m_FileHandle = nullptr;
+	}
+
+	void MappedFile::Prefetch() const
+	{
+		// FILE_FLAG_SEQUENTIAL_SCAN already enables aggressive read-ahead on Windows
+	}
+
+#else
+
+	bool MappedFile::Open(const std::string& path)
+	{
+		Close();
+
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			HZ_ERROR("MappedFile: failed to open {}", path);
+			return false;
+		}
+
+		struct stat info;
+		if (fstat(fd, &info) != 0 || info.st_size == 0)
+		{
+			HZ_ERROR("MappedFile: empty or unreadable file {}", path);
+			close(fd);
+			return false;
+		}
+
+		void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED)
+		{
+			HZ_ERROR("MappedFile: mmap failed for {}", path);
+			close(fd);
+			return false;
+		}
+
+		m_FileDescriptor = fd;
+		m_Data = static_cast<const unsigned char*>(data);
+		m_Size = static_cast<size_t>(info.st_size);
+		m_Path = path;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+			munmap(const_cast<unsigned char*>(m_Data), m_Size);
+		if (m_FileDescriptor >= 0)
+			close(m_FileDescriptor);
+
+		m_Data = nullptr;
+		m_Size = 0;
+		m_FileDescriptor = -1;
+	}
+
+	void MappedFile::Prefetch() const
+	{
+		if (m_Data)
+			madvise(const_cast<unsigned char*>(m_Data), m_Size, MADV_WILLNEED);
+	}
+
+#endif
+
+}
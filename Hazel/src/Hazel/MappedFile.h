@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Core.h"
+#include <cstddef>
+#include <string>
+
+namespace Hazel {
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about STL types in DLL interface
+#endif
+
+	// Read-only memory mapping of a whole file.
+	// The mapping stays valid until Close() or destruction; pointers into it
+	// can be handed straight to GPU uploads without an intermediate copy.
+	class HAZEL_API MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		bool Open(const std::string& path);
+		void Close();
+
+		// Hints the OS to start reading the whole file in ahead of access
+		void Prefetch() const;
+
+		bool IsOpen() const { return m_Data != nullptr; }
+		const unsigned char* GetData() const { return m_Data; }
+		size_t GetSize() const { return m_Size; }
+		const std::string& GetPath() const { return m_Path; }
+
+	private:
+		void MoveFrom(MappedFile& other);
+
+	private:
+		const unsigned char* m_Data = nullptr;
+		size_t m_Size = 0;
+		std::string m_Path;
+
+#ifdef _WIN32
+		void* m_FileHandle = nullptr;
+		void* m_MappingHandle = nullptr;
+#else
+		int m_FileDescriptor = -1;
+#endif
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
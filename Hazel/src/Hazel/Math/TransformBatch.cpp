@@ -0,0 +1,145 @@
+#include "TransformBatch.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define HZ_TRANSFORM_SIMD 1
+	#include <emmintrin.h>
+#else
+	#define HZ_TRANSFORM_SIMD 0
+#endif
+
+namespace Hazel {
+
+	// One transform at a time; the tail of a batch and the non-SIMD build
+	static void ComposeOne(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale,
+	                       glm::mat4& outMatrix, glm::mat3* outNormal)
+	{
+		float xx = rotation.x * rotation.x, yy = rotation.y * rotation.y, zz = rotation.z * rotation.z;
+		float xy = rotation.x * rotation.y, xz = rotation.x * rotation.z, yz = rotation.y * rotation.z;
+		float wx = rotation.w * rotation.x, wy = rotation.w * rotation.y, wz = rotation.w * rotation.z;
+
+		glm::vec3 c0(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy));
+		glm::vec3 c1(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx));
+		glm::vec3 c2(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy));
+
+		outMatrix[0] = glm::vec4(c0 * scale.x, 0.0f);
+		outMatrix[1] = glm::vec4(c1 * scale.y, 0.0f);
+		outMatrix[2] = glm::vec4(c2 * scale.z, 0.0f);
+		outMatrix[3] = glm::vec4(position, 1.0f);
+
+		if (outNormal)
+		{
+			(*outNormal)[0] = c0 / scale.x;
+			(*outNormal)[1] = c1 / scale.y;
+			(*outNormal)[2] = c2 / scale.z;
+		}
+	}
+
+	void TransformBatch::Compose(const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+	                             size_t count, glm::mat4* outMatrices, glm::mat3* outNormals)
+	{
+		size_t i = 0;
+
+#if HZ_TRANSFORM_SIMD
+		static_assert(sizeof(glm::quat) == 16 && sizeof(glm::vec3) == 12 && sizeof(glm::mat4) == 64, "Unexpected glm layout");
+
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 two = _mm_set1_ps(2.0f);
+		const __m128 zero = _mm_setzero_ps();
+
+		for (; i + Width <= count; i += Width)
+		{
+			// Four quaternions (x, y, z, w each, as glm stores them without
+			// GLM_FORCE_QUAT_DATA_WXYZ) transposed into one register per component
+			__m128 qx = _mm_loadu_ps(&rotations[i].x);
+			__m128 qy = _mm_loadu_ps(&rotations[i + 1].x);
+			__m128 qz = _mm_loadu_ps(&rotations[i + 2].x);
+			__m128 qw = _mm_loadu_ps(&rotations[i + 3].x);
+			_MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+
+			const glm::vec3* p = positions + i;
+			const glm::vec3* s = scales + i;
+			__m128 px = _mm_setr_ps(p[0].x, p[1].x, p[2].x, p[3].x);
+			__m128 py = _mm_setr_ps(p[0].y, p[1].y, p[2].y, p[3].y);
+			__m128 pz = _mm_setr_ps(p[0].z, p[1].z, p[2].z, p[3].z);
+			__m128 sx = _mm_setr_ps(s[0].x, s[1].x, s[2].x, s[3].x);
+			__m128 sy = _mm_setr_ps(s[0].y, s[1].y, s[2].y, s[3].y);
+			__m128 sz = _mm_setr_ps(s[0].z, s[1].z, s[2].z, s[3].z);
+
+			__m128 xx = _mm_mul_ps(qx, qx), yy = _mm_mul_ps(qy, qy), zz = _mm_mul_ps(qz, qz);
+			__m128 xy = _mm_mul_ps(qx, qy), xz = _mm_mul_ps(qx, qz), yz = _mm_mul_ps(qy, qz);
+			__m128 wx = _mm_mul_ps(qw, qx), wy = _mm_mul_ps(qw, qy), wz = _mm_mul_ps(qw, qz);
+
+			// Rotation columns
+			__m128 r00 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)));
+			__m128 r10 = _mm_mul_ps(two, _mm_add_ps(xy, wz));
+			__m128 r20 = _mm_mul_ps(two, _mm_sub_ps(xz, wy));
+			__m128 r01 = _mm_mul_ps(two, _mm_sub_ps(xy, wz));
+			__m128 r11 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)));
+			__m128 r21 = _mm_mul_ps(two, _mm_add_ps(yz, wx));
+			__m128 r02 = _mm_mul_ps(two, _mm_add_ps(xz, wy));
+			__m128 r12 = _mm_mul_ps(two, _mm_sub_ps(yz, wx));
+			__m128 r22 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)));
+
+			// Back to one matrix column per register, four transforms at once
+			__m128 m00 = _mm_mul_ps(r00, sx), m01 = _mm_mul_ps(r10, sx), m02 = _mm_mul_ps(r20, sx), m03 = zero;
+			__m128 m10 = _mm_mul_ps(r01, sy), m11 = _mm_mul_ps(r11, sy), m12 = _mm_mul_ps(r21, sy), m13 = zero;
+			__m128 m20 = _mm_mul_ps(r02, sz), m21 = _mm_mul_ps(r12, sz), m22 = _mm_mul_ps(r22, sz), m23 = zero;
+			__m128 m30 = px, m31 = py, m32 = pz, m33 = one;
+			_MM_TRANSPOSE4_PS(m00, m01, m02, m03);
+			_MM_TRANSPOSE4_PS(m10, m11, m12, m13);
+			_MM_TRANSPOSE4_PS(m20, m21, m22, m23);
+			_MM_TRANSPOSE4_PS(m30, m31, m32, m33);
+
+			float* out = &outMatrices[i][0][0];
+			_mm_storeu_ps(out + 0, m00);  _mm_storeu_ps(out + 4, m10);  _mm_storeu_ps(out + 8, m20);  _mm_storeu_ps(out + 12, m30);
+			_mm_storeu_ps(out + 16, m01); _mm_storeu_ps(out + 20, m11); _mm_storeu_ps(out + 24, m21); _mm_storeu_ps(out + 28, m31);
+			_mm_storeu_ps(out + 32, m02); _mm_storeu_ps(out + 36, m12); _mm_storeu_ps(out + 40, m22); _mm_storeu_ps(out + 44, m32);
+			_mm_storeu_ps(out + 48, m03); _mm_storeu_ps(out + 52, m13); _mm_storeu_ps(out + 56, m23); _mm_storeu_ps(out + 60, m33);
+
+			if (outNormals)
+			{
+				// R * S^-1, from the same rotation columns
+				__m128 ix = _mm_div_ps(one, sx), iy = _mm_div_ps(one, sy), iz = _mm_div_ps(one, sz);
+				__m128 n00 = _mm_mul_ps(r00, ix), n01 = _mm_mul_ps(r10, ix), n02 = _mm_mul_ps(r20, ix), n03 = zero;
+				__m128 n10 = _mm_mul_ps(r01, iy), n11 = _mm_mul_ps(r11, iy), n12 = _mm_mul_ps(r21, iy), n13 = zero;
+				__m128 n20 = _mm_mul_ps(r02, iz), n21 = _mm_mul_ps(r12, iz), n22 = _mm_mul_ps(r22, iz), n23 = zero;
+				_MM_TRANSPOSE4_PS(n00, n01, n02, n03);
+				_MM_TRANSPOSE4_PS(n10, n11, n12, n13);
+				_MM_TRANSPOSE4_PS(n20, n21, n22, n23);
+
+				// mat3 columns are 12 bytes; write through a 16-byte aligned block
+				alignas(16) float columns[Width][3][4];
+				_mm_store_ps(columns[0][0], n00); _mm_store_ps(columns[0][1], n10); _mm_store_ps(columns[0][2], n20);
+				_mm_store_ps(columns[1][0], n01); _mm_store_ps(columns[1][1], n11); _mm_store_ps(columns[1][2], n21);
+				_mm_store_ps(columns[2][0], n02); _mm_store_ps(columns[2][1], n12); _mm_store_ps(columns[2][2], n22);
+				_mm_store_ps(columns[3][0], n03); _mm_store_ps(columns[3][1], n13); _mm_store_ps(columns[3][2], n23);
+				for (size_t lane = 0; lane < Width; lane++)
+				{
+					for (int column = 0; column < 3; column++)
+						std::memcpy(&outNormals[i + lane][column][0], columns[lane][column], 3 * sizeof(float));
+				}
+			}
+		}
+#endif
+
+		for (; i < count; i++)
+			ComposeOne(positions[i], rotations[i], scales[i], outMatrices[i], outNormals ? &outNormals[i] : nullptr);
+	}
+
+	glm::quat TransformBatch::EulerToQuat(const glm::vec3& degrees)
+	{
+		glm::vec3 half = glm::radians(degrees) * 0.5f;
+		float cx = std::cos(half.x), sx = std::sin(half.x);
+		float cy = std::cos(half.y), sy = std::sin(half.y);
+		float cz = std::cos(half.z), sz = std::sin(half.z);
+
+		// qX * qY * qZ, multiplied out
+		return glm::quat(cx * cy * cz - sx * sy * sz,
+		                 sx * cy * cz + cx * sy * sz,
+		                 cx * sy * cz - sx * cy * sz,
+		                 cx * cy * sz + sx * sy * cz);
+	}
+
+}
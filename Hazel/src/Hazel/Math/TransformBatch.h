@@ -0,0 +1,35 @@
+#pragma once
+
+#include "../Core.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstddef>
+
+namespace Hazel {
+
+	// Position/rotation/scale triples to matrices, several at a time. Each
+	// transform also gets its normal matrix, the inverse transpose of the
+	// upper 3x3, which for T * R * S is simply R * S^-1 and costs no inversion.
+	class HAZEL_API TransformBatch
+	{
+	public:
+		// Lanes of the SIMD kernel; Compose() handles any count
+		static constexpr size_t Width = 4;
+
+		// outMatrices[i] = translate(positions[i]) * mat4_cast(rotations[i]) * scale(scales[i]);
+		// outNormals[i] = its normal matrix, skipped when outNormals is null.
+		// Rotations must be unit quaternions and scales non-zero.
+		static void Compose(const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+		                    size_t count, glm::mat4* outMatrices, glm::mat3* outNormals);
+
+		// Euler angles in degrees, applied X, then Y, then Z (rotateX * rotateY * rotateZ)
+		static glm::quat EulerToQuat(const glm::vec3& degrees);
+
+		// Inverse transpose of an arbitrary matrix's upper 3x3
+		static glm::mat3 GetNormalMatrix(const glm::mat4& transform)
+		{
+			return glm::transpose(glm::inverse(glm::mat3(transform)));
+		}
+	};
+
+}
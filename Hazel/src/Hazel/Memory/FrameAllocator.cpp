@@ -0,0 +1,202 @@
+#include "FrameAllocator.h"
+#include "../Log.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+
+namespace Hazel {
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Arena ////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	namespace {
+
+		constexpr size_t s_ArenaAlignment = 64;
+
+		struct OverflowBlock
+		{
+			void* Memory;
+			size_t Alignment;
+		};
+
+		struct Arena
+		{
+			unsigned char* Data = nullptr;
+			size_t Capacity = 0;
+			std::atomic<size_t> Offset{ 0 };
+
+			// Heap fallback once the arena is full
+			std::mutex OverflowMutex;
+			std::vector<OverflowBlock> Overflow;
+			std::atomic<uint32_t> OverflowCount{ 0 };
+			std::atomic<size_t> OverflowBytes{ 0 };
+
+			void* Allocate(size_t size, size_t alignment)
+			{
+				uintptr_t base = reinterpret_cast<uintptr_t>(Data);
+				size_t offset = Offset.load(std::memory_order_relaxed);
+				while (true)
+				{
+					size_t aligned = ((base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+					size_t next = aligned + size;
+					if (next > Capacity)
+						break;
+					if (Offset.compare_exchange_weak(offset, next, std::memory_order_relaxed))
+						return Data + aligned;
+				}
+
+				void* memory = ::operator new(size, std::align_val_t(alignment));
+				{
+					std::lock_guard<std::mutex> lock(OverflowMutex);
+					Overflow.push_back({ memory, alignment });
+				}
+				OverflowCount.fetch_add(1, std::memory_order_relaxed);
+				OverflowBytes.fetch_add(size, std::memory_order_relaxed);
+				return memory;
+			}
+
+			void Reset()
+			{
+				for (const OverflowBlock& block : Overflow)
+					::operator delete(block.Memory, std::align_val_t(block.Alignment));
+				Overflow.clear();
+				Offset.store(0, std::memory_order_relaxed);
+				OverflowCount.store(0, std::memory_order_relaxed);
+				OverflowBytes.store(0, std::memory_order_relaxed);
+			}
+		};
+
+		class FrameMemoryResource : public std::pmr::memory_resource
+		{
+		protected:
+			void* do_allocate(size_t bytes, size_t alignment) override
+			{
+				return FrameAllocator::Allocate(bytes, alignment);
+			}
+
+			void do_deallocate(void*, size_t, size_t) override
+			{
+				// Released with the arena
+			}
+
+			bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+			{
+				return this == &other;
+			}
+		};
+
+	}
+
+	struct FrameAllocatorData
+	{
+		Arena Arenas[2];
+		std::atomic<Arena*> Current{ nullptr };
+		FrameMemoryResource Resource;
+
+		FrameAllocatorStats LastFrame;
+		size_t PeakBytes = 0;
+		// Overflow is logged again only once it exceeds this (twice the last one logged)
+		size_t OverflowReportThreshold = 0;
+	};
+
+	static FrameAllocatorData* s_Data = nullptr;
+
+	/////////////////////////////////////////////////////////////////////////////
+	// FrameAllocator ///////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	void FrameAllocator::Init(size_t capacity)
+	{
+		if (s_Data)
+		{
+			HZ_WARN("FrameAllocator already initialized");
+			return;
+		}
+
+		s_Data = new FrameAllocatorData();
+		capacity = (capacity + s_ArenaAlignment - 1) & ~(s_ArenaAlignment - 1);
+		for (Arena& arena : s_Data->Arenas)
+		{
+			arena.Data = static_cast<unsigned char*>(::operator new(capacity, std::align_val_t(s_ArenaAlignment)));
+			arena.Capacity = capacity;
+		}
+		s_Data->Current.store(&s_Data->Arenas[0]);
+		s_Data->LastFrame.Capacity = capacity;
+
+		HZ_INFO("FrameAllocator initialized with 2 x {} KB", capacity / 1024);
+	}
+
+	void FrameAllocator::Shutdown()
+	{
+		if (!s_Data)
+			return;
+
+		for (Arena& arena : s_Data->Arenas)
+		{
+			arena.Reset();
+			::operator delete(arena.Data, std::align_val_t(s_ArenaAlignment));
+		}
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	bool FrameAllocator::IsInitialized()
+	{
+		return s_Data != nullptr;
+	}
+
+	void FrameAllocator::BeginFrame()
+	{
+		if (!s_Data)
+			return;
+
+		Arena* finished = s_Data->Current.load();
+		FrameAllocatorStats& stats = s_Data->LastFrame;
+		stats.BytesUsed = finished->Offset.load();
+		stats.Capacity = finished->Capacity;
+		stats.OverflowAllocations = finished->OverflowCount.load();
+		stats.OverflowBytes = finished->OverflowBytes.load();
+		s_Data->PeakBytes = (std::max)(s_Data->PeakBytes, stats.BytesUsed + stats.OverflowBytes);
+		stats.PeakBytes = s_Data->PeakBytes;
+
+		if (stats.OverflowBytes > s_Data->OverflowReportThreshold)
+		{
+			s_Data->OverflowReportThreshold = stats.OverflowBytes * 2;
+
+			HZ_WARN("FrameAllocator: {} allocations ({} KB) did not fit into the {} KB arena and used the heap",
+			        stats.OverflowAllocations, stats.OverflowBytes / 1024, stats.Capacity / 1024);
+		}
+
+		Arena* next = finished == &s_Data->Arenas[0] ? &s_Data->Arenas[1] : &s_Data->Arenas[0];
+		next->Reset();
+		s_Data->Current.store(next);
+	}
+
+	void* FrameAllocator::Allocate(size_t size, size_t alignment)
+	{
+		if (!s_Data)
+			return ::operator new(size, std::align_val_t(alignment));
+
+		return s_Data->Current.load(std::memory_order_acquire)->Allocate(size, alignment);
+	}
+
+	std::pmr::memory_resource* FrameAllocator::GetResource()
+	{
+		if (!s_Data)
+			return std::pmr::new_delete_resource();
+
+		return &s_Data->Resource;
+	}
+
+	FrameAllocatorStats FrameAllocator::GetStats()
+	{
+		if (!s_Data)
+			return {};
+
+		return s_Data->LastFrame;
+	}
+
+}
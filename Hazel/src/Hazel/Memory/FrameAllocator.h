@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../Core.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Hazel {
+
+	struct FrameAllocatorStats
+	{
+		// Arena bytes handed out during the frame, including alignment padding
+		size_t BytesUsed = 0;
+		size_t Capacity = 0;
+		// Highest BytesUsed of any frame since Init()
+		size_t PeakBytes = 0;
+		// Allocations that did not fit into the arena and went to the heap
+		uint32_t OverflowAllocations = 0;
+		size_t OverflowBytes = 0;
+	};
+
+	// Bump allocator for data that lives for a frame. Allocation is an atomic
+	// add on a pointer and nothing is freed individually: BeginFrame() recycles
+	// a whole arena at once. There are two arenas used in turns, so memory
+	// allocated during frame N stays valid until frame N + 2 begins - long
+	// enough to hand data to the next frame (or the render thread replaying it).
+	//
+	// Allocate() may be called from any thread, also while BeginFrame() runs
+	// (the pipelined run loop's simulation does). BeginFrame() only empties the
+	// idle arena, which no allocation has used since the previous BeginFrame(),
+	// and then publishes it with one atomic store. An allocation racing that
+	// store lands in the arena of the frame that is ending: it stays valid until
+	// the next BeginFrame() rather than the one after, and may be missing from
+	// that frame's stats. Requests that do not fit fall back to the heap and are
+	// freed with the arena; they show up in GetStats() and the log, which is the
+	// cue to raise the capacity.
+	//
+	// Before Init() (or after Shutdown()) GetResource() is the regular heap, so
+	// code using frame containers also works in tools that never start it.
+	// Allocate() and New() have nobody to free their memory then; it leaks.
+	class HAZEL_API FrameAllocator
+	{
+	public:
+		// capacity is per arena; two are reserved
+		static void Init(size_t capacity = 8 * 1024 * 1024);
+		static void Shutdown();
+		static bool IsInitialized();
+
+		// Switches to the arena of two frames ago and empties it
+		static void BeginFrame();
+
+		static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		// For trivially destructible types only: destructors never run
+		template<typename T, typename... Args>
+		static T* New(Args&&... args)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "Frame memory is released without running destructors");
+			return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		template<typename T>
+		static T* NewArray(size_t count)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "Frame memory is released without running destructors");
+			T* items = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+			for (size_t i = 0; i < count; i++)
+				new (items + i) T();
+			return items;
+		}
+
+		// std::pmr resource over the current arena; deallocation is a no-op
+		static std::pmr::memory_resource* GetResource();
+
+		// Statistics of the last completed frame
+		static FrameAllocatorStats GetStats();
+	};
+
+	// Transient containers. Their destructors may still run (and do nothing
+	// for the storage), but they must not outlive the frame after the one that
+	// created them.
+	template<typename T>
+	using FrameVector = std::pmr::vector<T>;
+	using FrameString = std::pmr::string;
+
+	template<typename T>
+	FrameVector<T> MakeFrameVector(size_t reserve = 0)
+	{
+		FrameVector<T> vector(FrameAllocator::GetResource());
+		vector.reserve(reserve);
+		return vector;
+	}
+
+}
@@ -0,0 +1,285 @@
+#include "MemoryTracker.h"
+#include "../Log.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
+// The engine's own global new/delete
+HZ_MEMORY_TRACKER_OPERATORS
+
+namespace Hazel {
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Counters /////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	namespace {
+
+		constexpr size_t s_TagCount = static_cast<size_t>(MemoryTag::Count);
+		// Threads beyond this share slots, which stays correct, just slower
+		constexpr uint32_t s_SlotCount = 32;
+
+		// Stored right in front of every allocation
+		struct AllocationHeader
+		{
+			uint64_t Size;
+			uint32_t Offset; // From the start of the malloc block to the user pointer
+			MemoryTag Tag;
+		};
+
+		constexpr size_t s_HeaderSize = 16;
+		// What malloc guarantees on the platforms Hazel targets
+		constexpr size_t s_MallocAlignment = 2 * sizeof(void*);
+		static_assert(sizeof(AllocationHeader) <= s_HeaderSize, "Allocation header outgrew its slot");
+
+		struct TagCounters
+		{
+			std::atomic<int64_t> Bytes{ 0 };
+			// Highest Bytes since the last BeginFrame()
+			std::atomic<int64_t> PeakBytes{ 0 };
+			std::atomic<int64_t> Allocations{ 0 };
+			std::atomic<uint64_t> TotalAllocations{ 0 };
+			std::atomic<uint64_t> TotalBytes{ 0 };
+		};
+
+		// One per thread (modulo s_SlotCount) so threads do not share cache lines
+		struct alignas(64) CounterSlot
+		{
+			TagCounters Tags[s_TagCount];
+		};
+
+		// Frame-boundary view of a tag; guarded by s_HistoryMutex
+		struct TagHistory
+		{
+			int64_t PeakBytes = 0;
+			uint64_t LastTotalAllocations = 0;
+			uint64_t LastTotalBytes = 0;
+			uint64_t FrameAllocations = 0;
+			uint64_t FrameBytes = 0;
+			double AverageFrameAllocations = 0.0;
+			bool Spike = false;
+			uint64_t LastSpikeReport = 0;
+			size_t Budget = 0;
+			bool OverBudget = false;
+		};
+
+		// Everything here is constant-initialized: operator new runs during
+		// static initialization, before any constructor of this file could
+		CounterSlot s_Slots[s_SlotCount];
+		std::atomic<uint32_t> s_NextSlot{ 0 };
+		thread_local int t_Slot = -1;
+		thread_local MemoryTag t_Tag = MemoryTag::Untagged;
+
+		std::mutex s_HistoryMutex;
+		TagHistory s_History[s_TagCount];
+		uint64_t s_FrameIndex = 0;
+
+		// A frame spikes when it allocates this many times the tag's running
+		// average, plus a floor so rarely allocating tags do not flag every burst
+		constexpr double s_SpikeFactor = 4.0;
+		constexpr uint64_t s_SpikeFloor = 256;
+		constexpr uint64_t s_SpikeWarmupFrames = 60;
+		constexpr uint64_t s_SpikeReportInterval = 300;
+
+		TagCounters& GetCounters(MemoryTag tag)
+		{
+			int slot = t_Slot;
+			if (slot < 0)
+			{
+				slot = static_cast<int>(s_NextSlot.fetch_add(1, std::memory_order_relaxed) % s_SlotCount);
+				t_Slot = slot;
+			}
+			return s_Slots[slot].Tags[static_cast<size_t>(tag)];
+		}
+
+		struct CounterTotals
+		{
+			int64_t Bytes = 0;
+			int64_t PeakBytes = 0; // Sum of the slot maxima
+			int64_t Allocations = 0;
+			uint64_t TotalAllocations = 0;
+			uint64_t TotalBytes = 0;
+		};
+
+		CounterTotals SumCounters(size_t tag)
+		{
+			CounterTotals totals;
+			for (const CounterSlot& slot : s_Slots)
+			{
+				const TagCounters& counters = slot.Tags[tag];
+				totals.Bytes += counters.Bytes.load(std::memory_order_relaxed);
+				totals.PeakBytes += counters.PeakBytes.load(std::memory_order_relaxed);
+				totals.Allocations += counters.Allocations.load(std::memory_order_relaxed);
+				totals.TotalAllocations += counters.TotalAllocations.load(std::memory_order_relaxed);
+				totals.TotalBytes += counters.TotalBytes.load(std::memory_order_relaxed);
+			}
+			return totals;
+		}
+
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// MemoryTracker ////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	void* MemoryTracker::Allocate(size_t size, size_t alignment)
+	{
+		size_t padding = alignment > s_MallocAlignment ? alignment - 1 : 0;
+		unsigned char* block = static_cast<unsigned char*>(std::malloc(size + s_HeaderSize + padding));
+		if (!block)
+			throw std::bad_alloc();
+
+		uintptr_t user = reinterpret_cast<uintptr_t>(block) + s_HeaderSize;
+		user = (user + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+
+		AllocationHeader* header = reinterpret_cast<AllocationHeader*>(user - s_HeaderSize);
+		header->Size = size;
+		header->Offset = static_cast<uint32_t>(user - reinterpret_cast<uintptr_t>(block));
+		header->Tag = t_Tag;
+
+#ifdef HZ_ENABLE_MEMORY_TRACKING
+		TagCounters& counters = GetCounters(header->Tag);
+		int64_t bytes = counters.Bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+		// Only contended when threads share a slot
+		int64_t peak = counters.PeakBytes.load(std::memory_order_relaxed);
+		while (bytes > peak && !counters.PeakBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed))
+		{
+		}
+		counters.Allocations.fetch_add(1, std::memory_order_relaxed);
+		counters.TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+		counters.TotalBytes.fetch_add(size, std::memory_order_relaxed);
+#endif
+
+		return reinterpret_cast<void*>(user);
+	}
+
+	void MemoryTracker::Free(void* memory)
+	{
+		if (!memory)
+			return;
+
+		const AllocationHeader* header = reinterpret_cast<const AllocationHeader*>(static_cast<unsigned char*>(memory) - s_HeaderSize);
+
+#ifdef HZ_ENABLE_MEMORY_TRACKING
+		// Charged back to the allocating tag; the counters of this thread's slot may go negative
+		TagCounters& counters = GetCounters(header->Tag);
+		counters.Bytes.fetch_sub(static_cast<int64_t>(header->Size), std::memory_order_relaxed);
+		counters.Allocations.fetch_sub(1, std::memory_order_relaxed);
+#endif
+
+		std::free(static_cast<unsigned char*>(memory) - header->Offset);
+	}
+
+	MemoryTag MemoryTracker::GetCurrentTag()
+	{
+		return t_Tag;
+	}
+
+	MemoryTag MemoryTracker::SetCurrentTag(MemoryTag tag)
+	{
+		MemoryTag previous = t_Tag;
+		t_Tag = tag;
+		return previous;
+	}
+
+	void MemoryTracker::SetBudget(MemoryTag tag, size_t bytes)
+	{
+		std::lock_guard<std::mutex> lock(s_HistoryMutex);
+		TagHistory& history = s_History[static_cast<size_t>(tag)];
+		history.Budget = bytes;
+		history.OverBudget = false;
+	}
+
+	void MemoryTracker::BeginFrame()
+	{
+		if (!IsEnabled())
+			return;
+
+		std::lock_guard<std::mutex> lock(s_HistoryMutex);
+		s_FrameIndex++;
+
+		for (size_t tag = 0; tag < s_TagCount; tag++)
+		{
+			CounterTotals totals = SumCounters(tag);
+			TagHistory& history = s_History[tag];
+			const char* name = GetTagName(static_cast<MemoryTag>(tag));
+
+			// Restart each slot's maximum from its live bytes; the exchange keeps
+			// allocations racing with it in one frame or the other
+			int64_t framePeak = 0;
+			for (CounterSlot& slot : s_Slots)
+			{
+				TagCounters& counters = slot.Tags[tag];
+				framePeak += counters.PeakBytes.exchange(counters.Bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+
+			history.FrameAllocations = totals.TotalAllocations - history.LastTotalAllocations;
+			history.FrameBytes = totals.TotalBytes - history.LastTotalBytes;
+			history.LastTotalAllocations = totals.TotalAllocations;
+			history.LastTotalBytes = totals.TotalBytes;
+			history.PeakBytes = (std::max)(history.PeakBytes, (std::max)(framePeak, totals.Bytes));
+
+			double threshold = history.AverageFrameAllocations * s_SpikeFactor + s_SpikeFloor;
+			history.Spike = s_FrameIndex > s_SpikeWarmupFrames && history.FrameAllocations > threshold;
+			if (history.Spike && (history.LastSpikeReport == 0 || s_FrameIndex - history.LastSpikeReport >= s_SpikeReportInterval))
+			{
+				history.LastSpikeReport = s_FrameIndex;
+
+				HZ_WARN("Memory: {} allocated {} times ({} KB) in one frame, usually {:.0}",
+				        name, history.FrameAllocations, history.FrameBytes / 1024, history.AverageFrameAllocations);
+			}
+			// Spikes are left out of the average so one does not hide the next
+			if (!history.Spike)
+				history.AverageFrameAllocations += (history.FrameAllocations - history.AverageFrameAllocations) / 16.0;
+
+			bool overBudget = history.Budget > 0 && totals.Bytes > static_cast<int64_t>(history.Budget);
+			if (overBudget && !history.OverBudget)
+			{
+				HZ_WARN("Memory: {} holds {} KB, over its budget of {} KB", name, totals.Bytes / 1024, history.Budget / 1024);
+			}
+			history.OverBudget = overBudget;
+		}
+	}
+
+	MemoryTagStats MemoryTracker::GetStats(MemoryTag tag)
+	{
+		MemoryTagStats stats;
+		if (!IsEnabled() || tag >= MemoryTag::Count)
+			return stats;
+
+		CounterTotals totals = SumCounters(static_cast<size_t>(tag));
+		stats.CurrentBytes = totals.Bytes;
+		stats.CurrentAllocations = totals.Allocations;
+		stats.TotalAllocations = totals.TotalAllocations;
+
+		std::lock_guard<std::mutex> lock(s_HistoryMutex);
+		const TagHistory& history = s_History[static_cast<size_t>(tag)];
+		stats.PeakBytes = (std::max)(history.PeakBytes, (std::max)(totals.PeakBytes, totals.Bytes));
+		stats.FrameAllocations = history.FrameAllocations;
+		stats.FrameBytes = history.FrameBytes;
+		stats.Spike = history.Spike;
+		stats.Budget = history.Budget;
+		stats.OverBudget = history.OverBudget;
+		return stats;
+	}
+
+	const char* MemoryTracker::GetTagName(MemoryTag tag)
+	{
+		switch (tag)
+		{
+			case MemoryTag::Untagged:  return "Untagged";
+			case MemoryTag::Core:      return "Core";
+			case MemoryTag::Log:       return "Log";
+			case MemoryTag::Renderer:  return "Renderer";
+			case MemoryTag::Scene:     return "Scene";
+			case MemoryTag::Scripting: return "Scripting";
+			case MemoryTag::Animation: return "Animation";
+			case MemoryTag::ImGui:     return "ImGui";
+			case MemoryTag::Jobs:      return "Jobs";
+			default:                   return "Unknown";
+		}
+	}
+
+}
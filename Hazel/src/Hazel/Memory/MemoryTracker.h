@@ -0,0 +1,140 @@
+#pragma once
+
+#include "../Core.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace Hazel {
+
+	// Subsystem an allocation is charged to. The calling thread's current tag
+	// is set with HZ_MEMORY_TAG() and travels with jobs it submits.
+	enum class MemoryTag : uint8_t
+	{
+		Untagged = 0,
+		Core,
+		Log,
+		Renderer,
+		Scene,
+		Scripting,
+		Animation,
+		ImGui,
+		Jobs,
+		Count
+	};
+
+	struct MemoryTagStats
+	{
+		// Live allocations charged to the tag right now
+		int64_t CurrentBytes = 0;
+		int64_t CurrentAllocations = 0;
+		// Highest CurrentBytes so far, including spikes inside a frame. It is
+		// tracked per thread, so it can overstate the peak by what threads held
+		// at different moments of the same frame.
+		int64_t PeakBytes = 0;
+		uint64_t TotalAllocations = 0;
+
+		// Allocations made during the last completed frame
+		uint64_t FrameAllocations = 0;
+		uint64_t FrameBytes = 0;
+		// The last frame allocated far more often than the tag usually does
+		bool Spike = false;
+
+		// 0 when the tag has no budget
+		size_t Budget = 0;
+		bool OverBudget = false;
+	};
+
+	// Counts every heap allocation made through global new/delete, per tag.
+	// Each allocation carries a small header with its size and tag, so a free
+	// is charged back to the tag that allocated, on whatever thread it happens.
+	// Counters are striped per thread and only summed when statistics are read,
+	// so the hooks cost a few uncontended atomic adds.
+	//
+	// Each slot also keeps the running maximum of its live bytes, which
+	// sum to a bound on the tag's peak. Per-frame counts, spikes and budgets
+	// are evaluated in BeginFrame(), which the application calls once per
+	// frame and which folds the slot maxima into the tag's peak.
+	//
+	// Build with HZ_DISABLE_MEMORY_TRACKING to compile the hooks out; the API
+	// stays available and reports nothing.
+	class HAZEL_API MemoryTracker
+	{
+	public:
+		static constexpr bool IsEnabled()
+		{
+#ifdef HZ_ENABLE_MEMORY_TRACKING
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		// Used by the global operator new/delete of every module
+		static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+		static void Free(void* memory);
+
+		static MemoryTag GetCurrentTag();
+		// Returns the previous tag
+		static MemoryTag SetCurrentTag(MemoryTag tag);
+
+		// Warns once the tag's live bytes exceed 'bytes'; 0 removes the budget
+		static void SetBudget(MemoryTag tag, size_t bytes);
+
+		// Closes the statistics of the previous frame
+		static void BeginFrame();
+
+		static MemoryTagStats GetStats(MemoryTag tag);
+		static const char* GetTagName(MemoryTag tag);
+	};
+
+	// Charges allocations of the current thread to 'tag' until the end of the scope
+	class MemoryTagScope
+	{
+	public:
+		explicit MemoryTagScope(MemoryTag tag)
+			: m_Previous(MemoryTracker::SetCurrentTag(tag))
+		{
+		}
+
+		~MemoryTagScope()
+		{
+			MemoryTracker::SetCurrentTag(m_Previous);
+		}
+
+		MemoryTagScope(const MemoryTagScope&) = delete;
+		MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+	private:
+		MemoryTag m_Previous;
+	};
+
+}
+
+#define HZ_MEMORY_TAG_CONCAT_INNER(a, b) a##b
+#define HZ_MEMORY_TAG_CONCAT(a, b) HZ_MEMORY_TAG_CONCAT_INNER(a, b)
+
+#ifdef HZ_ENABLE_MEMORY_TRACKING
+	// HZ_MEMORY_TAG(Renderer); charges the rest of the scope to MemoryTag::Renderer
+	#define HZ_MEMORY_TAG(tag) ::Hazel::MemoryTagScope HZ_MEMORY_TAG_CONCAT(hzMemoryTag, __LINE__)(::Hazel::MemoryTag::tag)
+
+	// Replaces the global new/delete of the module it is expanded in. Hazel
+	// expands it once; applications get it through EntryPoint.h, so memory can
+	// be allocated in one module and freed in the other.
+	#define HZ_MEMORY_TRACKER_OPERATORS \
+		void* operator new(size_t size) { return ::Hazel::MemoryTracker::Allocate(size); } \
+		void* operator new[](size_t size) { return ::Hazel::MemoryTracker::Allocate(size); } \
+		void* operator new(size_t size, std::align_val_t alignment) { return ::Hazel::MemoryTracker::Allocate(size, static_cast<size_t>(alignment)); } \
+		void* operator new[](size_t size, std::align_val_t alignment) { return ::Hazel::MemoryTracker::Allocate(size, static_cast<size_t>(alignment)); } \
+		void operator delete(void* memory) noexcept { ::Hazel::MemoryTracker::Free(memory); } \
+		void operator delete[](void* memory) noexcept { ::Hazel::MemoryTracker::Free(memory); } \
+		void operator delete(void* memory, size_t) noexcept { ::Hazel::MemoryTracker::Free(memory); } \
+		void operator delete[](void* memory, size_t) noexcept { ::Hazel::MemoryTracker::Free(memory); } \
+		void operator delete(void* memory, std::align_val_t) noexcept { ::Hazel::MemoryTracker::Free(memory); } \
+		void operator delete[](void* memory, std::align_val_t) noexcept { ::Hazel::MemoryTracker::Free(memory); } \
+		void operator delete(void* memory, size_t, std::align_val_t) noexcept { ::Hazel::MemoryTracker::Free(memory); } \
+		void operator delete[](void* memory, size_t, std::align_val_t) noexcept { ::Hazel::MemoryTracker::Free(memory); }
+#else
+	#define HZ_MEMORY_TAG(tag)
+	#define HZ_MEMORY_TRACKER_OPERATORS
+#endif
@@ -1,5 +1,6 @@
 #include "Buffer.h"
 #include "OpenGLLoader.h"
+#include "Renderer.h"
 #include "../Log.h"
 
 namespace Hazel {
@@ -9,10 +10,20 @@ namespace Hazel {
 	/////////////////////////////////////////////////////////////////////////////
 
 	VertexBuffer::VertexBuffer(float* vertices, unsigned int size)
+		: m_Size(size)
 	{
 		glGenBuffers(1, &m_RendererID);
 		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+		Renderer::GetFrameCounters().BufferBytesUploaded += size;
+	}
+
+	VertexBuffer::VertexBuffer(unsigned int size)
+		: m_Size(size)
+	{
+		glGenBuffers(1, &m_RendererID);
+		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STATIC_DRAW);
 	}
 
 	VertexBuffer::~VertexBuffer()
@@ -30,16 +41,53 @@ namespace Hazel {
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
+	void* VertexBuffer::Map()
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		return glMapBufferRange(GL_ARRAY_BUFFER, 0, m_Size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	}
+
+	void VertexBuffer::Unmap()
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		if (glUnmapBuffer(GL_ARRAY_BUFFER) == GL_FALSE)
+			HZ_WARN("VertexBuffer contents were corrupted while mapped");
+		// The mapping invalidates the whole buffer, so all of it counts as written
+		Renderer::GetFrameCounters().BufferBytesUploaded += m_Size;
+	}
+
+	void VertexBuffer::SetData(const void* data, unsigned int size)
+	{
+		if (size > m_Size)
+		{
+			HZ_WARN("VertexBuffer::SetData - data larger than buffer, truncating");
+			size = m_Size;
+		}
+
+		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+		Renderer::GetFrameCounters().BufferBytesUploaded += size;
+	}
+
 	/////////////////////////////////////////////////////////////////////////////
 	// IndexBuffer //////////////////////////////////////////////////////////////
 	/////////////////////////////////////////////////////////////////////////////
 
 	IndexBuffer::IndexBuffer(unsigned int* indices, unsigned int count)
-		: m_Count(count)
+		: m_Count(count), m_DrawCount(count)
 	{
 		glGenBuffers(1, &m_RendererID);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
 		glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), indices, GL_STATIC_DRAW);
+		Renderer::GetFrameCounters().BufferBytesUploaded += count * sizeof(unsigned int);
+	}
+
+	IndexBuffer::IndexBuffer(unsigned int count)
+		: m_Count(count), m_DrawCount(count)
+	{
+		glGenBuffers(1, &m_RendererID);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), nullptr, GL_STATIC_DRAW);
 	}
 
 	IndexBuffer::~IndexBuffer()
@@ -57,6 +105,33 @@ namespace Hazel {
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
 
+	void IndexBuffer::SetDrawRange(unsigned int firstIndex, unsigned int count, unsigned int vertexCount)
+	{
+		if (firstIndex > m_Count || count > m_Count - firstIndex)
+		{
+			HZ_WARN("IndexBuffer::SetDrawRange - range exceeds buffer, ignoring");
+			return;
+		}
+
+		m_FirstIndex = firstIndex;
+		m_DrawCount = count;
+		m_DrawVertexCount = vertexCount;
+	}
+
+	unsigned int* IndexBuffer::Map()
+	{
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		return static_cast<unsigned int*>(glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, m_Count * sizeof(unsigned int),
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+	}
+
+	void IndexBuffer::Unmap()
+	{
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		if (glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER) == GL_FALSE)
+			HZ_WARN("IndexBuffer contents were corrupted while mapped");
+	}
+
 	/////////////////////////////////////////////////////////////////////////////
 	// VertexArray //////////////////////////////////////////////////////////////
 	/////////////////////////////////////////////////////////////////////////////
@@ -93,6 +168,7 @@ namespace Hazel {
 	void VertexArray::Bind() const
 	{
 		glBindVertexArray(m_RendererID);
+		Renderer::GetFrameCounters().VertexArrayBinds++;
 	}
 
 	void VertexArray::Unbind() const
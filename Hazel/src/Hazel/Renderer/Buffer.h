@@ -76,6 +76,12 @@ namespace Hazel {
 			CalculateOffsetsAndStride();
 		}
 
+		BufferLayout(const std::vector<BufferElement>& elements)
+			: m_Elements(elements)
+		{
+			CalculateOffsetsAndStride();
+		}
+
 		inline unsigned int GetStride() const { return m_Stride; }
 		inline const std::vector<BufferElement>& GetElements() const { return m_Elements; }
 
@@ -111,16 +117,29 @@ namespace Hazel {
 	{
 	public:
 		VertexBuffer(float* vertices, unsigned int size);
+		// Allocates uninitialized storage, to be filled through Map()
+		VertexBuffer(unsigned int size);
 		~VertexBuffer();
 
 		void Bind() const;
 		void Unbind() const;
 
+		// Maps the whole buffer for writing (previous contents are discarded).
+		// Returns nullptr if the driver refuses the mapping.
+		void* Map();
+		void Unmap();
+
+		// Overwrites the first 'size' bytes of the buffer
+		void SetData(const void* data, unsigned int size);
+
+		unsigned int GetSize() const { return m_Size; }
+
 		const BufferLayout& GetLayout() const { return m_Layout; }
 		void SetLayout(const BufferLayout& layout) { m_Layout = layout; }
 
 	private:
 		unsigned int m_RendererID;
+		unsigned int m_Size = 0;
 		BufferLayout m_Layout;
 	};
 
@@ -128,16 +147,35 @@ namespace Hazel {
 	{
 	public:
 		IndexBuffer(unsigned int* indices, unsigned int count);
+		// Allocates uninitialized storage for count indices, to be filled through Map()
+		IndexBuffer(unsigned int count);
 		~IndexBuffer();
 
 		void Bind() const;
 		void Unbind() const;
 
-		unsigned int GetCount() const { return m_Count; }
+		// Maps the whole buffer for writing; binds GL_ELEMENT_ARRAY_BUFFER, so the
+		// owning vertex array (or none) should be bound when calling this
+		unsigned int* Map();
+		void Unmap();
+
+		// Number of indices drawn and the first index drawn (see SetDrawRange)
+		unsigned int GetCount() const { return m_DrawCount; }
+		unsigned int GetFirstIndex() const { return m_FirstIndex; }
+		unsigned int GetCapacity() const { return m_Count; }
+		// Distinct vertices the drawn indices reference, as given to
+		// SetDrawRange; 0 until then. Only feeds RendererStats.
+		unsigned int GetVertexCount() const { return m_DrawVertexCount; }
+
+		// Restricts draws to a sub-range, e.g. one LOD in a buffer holding several
+		void SetDrawRange(unsigned int firstIndex, unsigned int count, unsigned int vertexCount);
 
 	private:
 		unsigned int m_RendererID;
 		unsigned int m_Count;
+		unsigned int m_FirstIndex = 0;
+		unsigned int m_DrawCount = 0;
+		unsigned int m_DrawVertexCount = 0;
 	};
 
 	class HAZEL_API VertexArray
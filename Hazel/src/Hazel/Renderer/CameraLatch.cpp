@@ -0,0 +1,30 @@
+#include "CameraLatch.h"
+
+namespace Hazel {
+
+	void CameraLatch::Publish(const glm::mat4& view, int64_t inputTime)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_View = view;
+		m_InputTime = inputTime;
+		m_Published = true;
+	}
+
+	bool CameraLatch::Resolve(glm::mat4& view, int64_t& inputTime) const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (!m_Published)
+			return false;
+
+		view = m_View;
+		inputTime = m_InputTime;
+		return true;
+	}
+
+	void CameraLatch::Reset()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Published = false;
+	}
+
+}
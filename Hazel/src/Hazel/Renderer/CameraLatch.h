@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../Core.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <mutex>
+
+namespace Hazel {
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
+	// The newest view matrix for a scene, read by the renderer right before the
+	// scene's draws are issued rather than when they are submitted. Input
+	// handling publishes a view together with the time its input was sampled;
+	// a frame recorded for the render thread or a pipelined update then still
+	// shows the newest camera when it is replayed (see Renderer::BeginScene).
+	//
+	// Any thread may publish or resolve.
+	class HAZEL_API CameraLatch
+	{
+	public:
+		// 'inputTime' is FrameClock::Now() when the input behind 'view' was read
+		void Publish(const glm::mat4& view, int64_t inputTime);
+		// False until something is published
+		bool Resolve(glm::mat4& view, int64_t& inputTime) const;
+		void Reset();
+
+	private:
+		mutable std::mutex m_Mutex;
+		glm::mat4 m_View = glm::mat4(1.0f);
+		int64_t m_InputTime = 0;
+		bool m_Published = false;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
@@ -1,5 +1,6 @@
 #include "Framebuffer.h"
 #include "OpenGLLoader.h"
+#include "Renderer.h"
 #include "../Log.h"
 
 namespace Hazel {
@@ -14,6 +15,7 @@ namespace Hazel {
 		// Create color attachment texture
 		glGenTextures(1, &m_ColorAttachment);
 		glBindTexture(GL_TEXTURE_2D, m_ColorAttachment);
+		Renderer::GetFrameCounters().TextureBinds++;
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -65,6 +67,7 @@ namespace Hazel {
 
 		// Recreate color attachment
 		glBindTexture(GL_TEXTURE_2D, m_ColorAttachment);
+		Renderer::GetFrameCounters().TextureBinds++;
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
 
 		// Recreate depth attachment
@@ -0,0 +1,328 @@
+#include "GpuProfiler.h"
+#include "OpenGLLoader.h"
+#include "Renderer.h"
+#include "RenderQueue.h"
+#include "../Log.h"
+#include "../Memory/MemoryTracker.h"
+#include <cstdio>
+#include <mutex>
+
+namespace Hazel {
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Query sets ///////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	namespace {
+
+		// Frames that may be in flight before one goes unmeasured
+		constexpr uint32_t s_QuerySetCount = 4;
+		constexpr uint32_t s_MaxZones = 128;
+		constexpr uint32_t s_MaxDepth = 16;
+		// Frame start and end, then a start and end per zone
+		constexpr uint32_t s_QueriesPerSet = 2 + 2 * s_MaxZones;
+		// The GPU and CPU clocks drift apart slowly; the offset is measured again this often
+		constexpr uint64_t s_CalibrationInterval = 600;
+
+		struct ZoneRecord
+		{
+			const char* Name;
+			uint32_t Depth;
+			uint32_t BeginQuery;
+			uint32_t EndQuery;
+		};
+
+		struct QuerySet
+		{
+			GLuint Queries[s_QueriesPerSet] = {};
+			ZoneRecord Zones[s_MaxZones];
+			uint32_t ZoneCount = 0;
+			uint32_t QueryCount = 0;
+			uint64_t FrameIndex = 0;
+			bool InFlight = false;
+		};
+
+	}
+
+	// Everything but the results is touched by the context thread only
+	struct GpuProfilerData
+	{
+		bool Supported = false;
+		QuerySet Sets[s_QuerySetCount];
+
+		uint64_t FrameIndex = 0;
+		QuerySet* Recording = nullptr;
+		int32_t ZoneStack[s_MaxDepth] = {}; // Zone indices; -1 for zones beyond s_MaxZones
+		uint32_t Depth = 0;
+		bool WarnedUnbalanced = false;
+
+		// CPU time = GPU time + offset, both in nanoseconds
+		int64_t GpuToCpuOffset = 0;
+		uint64_t LastCalibration = 0;
+
+		GpuFrameResult Resolved; // Reused to fill LastFrame without reallocating
+
+		std::mutex ResultMutex;
+		GpuFrameResult LastFrame;
+		uint64_t SkippedFrames = 0;
+	};
+
+	static GpuProfilerData* s_Data = nullptr;
+
+	static void Calibrate()
+	{
+		GLint64 gpuTime = 0;
+		glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+		s_Data->GpuToCpuOffset = static_cast<int64_t>(Profiler::Now()) - gpuTime;
+		s_Data->LastCalibration = s_Data->FrameIndex;
+	}
+
+	// Reads back a set whose frame has finished on the GPU; false while it has not
+	static bool Resolve(QuerySet& set)
+	{
+		GLint available = 0;
+		glGetQueryObjectiv(set.Queries[set.QueryCount - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available)
+			return false;
+
+		GLuint64 timestamps[s_QueriesPerSet];
+		for (uint32_t i = 0; i < set.QueryCount; i++)
+			glGetQueryObjectui64v(set.Queries[i], GL_QUERY_RESULT, &timestamps[i]);
+		set.InFlight = false;
+
+		GpuFrameResult& result = s_Data->Resolved;
+		result.FrameIndex = set.FrameIndex;
+		result.FrameMilliseconds = static_cast<float>((timestamps[set.QueryCount - 1] - timestamps[0]) / 1.0e6);
+		result.Zones.clear();
+		for (uint32_t i = 0; i < set.ZoneCount; i++)
+		{
+			const ZoneRecord& zone = set.Zones[i];
+			float milliseconds = static_cast<float>((timestamps[zone.EndQuery] - timestamps[zone.BeginQuery]) / 1.0e6);
+			result.Zones.push_back({ zone.Name, zone.Depth, milliseconds });
+		}
+
+		if (Profiler::GetCaptureId())
+		{
+			int64_t offset = s_Data->GpuToCpuOffset;
+			Profiler::RecordGpu("GPU Frame", timestamps[0] + offset, timestamps[set.QueryCount - 1] + offset);
+			for (uint32_t i = 0; i < set.ZoneCount; i++)
+			{
+				const ZoneRecord& zone = set.Zones[i];
+				Profiler::RecordGpu(zone.Name, timestamps[zone.BeginQuery] + offset, timestamps[zone.EndQuery] + offset);
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(s_Data->ResultMutex);
+		uint64_t skipped = s_Data->LastFrame.SkippedFrames;
+		s_Data->LastFrame = result;
+		s_Data->LastFrame.SkippedFrames = skipped;
+		return true;
+	}
+
+	static void BeginZoneNow(const char* name)
+	{
+		QuerySet* set = s_Data->Recording;
+		if (!set)
+			return;
+
+		if (s_Data->Depth < s_MaxDepth)
+		{
+			int32_t index = -1;
+			if (set->ZoneCount < s_MaxZones)
+			{
+				index = static_cast<int32_t>(set->ZoneCount++);
+				ZoneRecord& zone = set->Zones[index];
+				zone.Name = name;
+				zone.Depth = s_Data->Depth;
+				zone.BeginQuery = set->QueryCount++;
+				zone.EndQuery = zone.BeginQuery;
+				glQueryCounter(set->Queries[zone.BeginQuery], GL_TIMESTAMP);
+			}
+			s_Data->ZoneStack[s_Data->Depth] = index;
+		}
+		s_Data->Depth++;
+	}
+
+	static void EndZoneNow()
+	{
+		QuerySet* set = s_Data->Recording;
+		if (!set || s_Data->Depth == 0)
+			return;
+
+		s_Data->Depth--;
+		if (s_Data->Depth >= s_MaxDepth || s_Data->ZoneStack[s_Data->Depth] < 0)
+			return;
+
+		ZoneRecord& zone = set->Zones[s_Data->ZoneStack[s_Data->Depth]];
+		zone.EndQuery = set->QueryCount++;
+		glQueryCounter(set->Queries[zone.EndQuery], GL_TIMESTAMP);
+	}
+
+	static void BeginFrameNow()
+	{
+		s_Data->FrameIndex++;
+		if (s_Data->FrameIndex - s_Data->LastCalibration >= s_CalibrationInterval)
+			Calibrate();
+
+		// Read back finished frames, oldest first (the set about to be reused);
+		// a frame cannot finish before the one ahead of it
+		for (uint32_t i = 0; i < s_QuerySetCount; i++)
+		{
+			QuerySet& set = s_Data->Sets[(s_Data->FrameIndex + i) % s_QuerySetCount];
+			if (set.InFlight && !Resolve(set))
+				break;
+		}
+
+		QuerySet& set = s_Data->Sets[s_Data->FrameIndex % s_QuerySetCount];
+		s_Data->Depth = 0;
+		if (set.InFlight)
+		{
+			// The GPU is more than a ring behind; waiting would stall the CPU
+			s_Data->Recording = nullptr;
+			std::lock_guard<std::mutex> lock(s_Data->ResultMutex);
+			s_Data->LastFrame.SkippedFrames++;
+			return;
+		}
+
+		set.FrameIndex = s_Data->FrameIndex;
+		set.ZoneCount = 0;
+		set.QueryCount = 1;
+		glQueryCounter(set.Queries[0], GL_TIMESTAMP);
+		s_Data->Recording = &set;
+	}
+
+	static void EndFrameNow()
+	{
+		QuerySet* set = s_Data->Recording;
+		if (!set)
+			return;
+
+		if (s_Data->Depth > 0 && !s_Data->WarnedUnbalanced)
+		{
+			s_Data->WarnedUnbalanced = true;
+			HZ_WARN("GpuProfiler: zones were still open at the end of the frame");
+		}
+		while (s_Data->Depth > 0)
+			EndZoneNow();
+
+		glQueryCounter(set->Queries[set->QueryCount++], GL_TIMESTAMP);
+		set->InFlight = true;
+		s_Data->Recording = nullptr;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// GpuProfiler //////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	void GpuProfiler::Init()
+	{
+		HZ_MEMORY_TAG(Renderer);
+
+		if (s_Data)
+			return;
+
+		s_Data = new GpuProfilerData();
+
+		GLint counterBits = 0;
+		if (glGenQueries && glQueryCounter && glGetQueryiv && glGetQueryObjectiv && glGetQueryObjectui64v && glGetInteger64v)
+			glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &counterBits);
+		if (counterBits == 0)
+		{
+			HZ_WARN("GpuProfiler: timestamp queries are not supported, GPU timings are disabled");
+			return;
+		}
+
+		for (QuerySet& set : s_Data->Sets)
+			glGenQueries(s_QueriesPerSet, set.Queries);
+		Calibrate();
+		s_Data->Supported = true;
+
+		HZ_INFO("GpuProfiler initialized ({}-bit timestamps)", counterBits);
+	}
+
+	void GpuProfiler::Shutdown()
+	{
+		if (!s_Data)
+			return;
+
+		if (s_Data->Supported)
+		{
+			for (QuerySet& set : s_Data->Sets)
+				glDeleteQueries(s_QueriesPerSet, set.Queries);
+		}
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	bool GpuProfiler::IsSupported()
+	{
+		return s_Data && s_Data->Supported;
+	}
+
+	void GpuProfiler::BeginFrame()
+	{
+		if (!IsSupported())
+			return;
+
+		if (RenderQueue* queue = Renderer::GetRecordingQueue())
+		{
+			queue->Callback([]() { BeginFrameNow(); });
+			return;
+		}
+
+		BeginFrameNow();
+	}
+
+	void GpuProfiler::EndFrame()
+	{
+		if (!IsSupported())
+			return;
+
+		if (RenderQueue* queue = Renderer::GetRecordingQueue())
+		{
+			queue->Callback([]() { EndFrameNow(); });
+			return;
+		}
+
+		EndFrameNow();
+	}
+
+	void GpuProfiler::BeginZone(const char* name)
+	{
+		if (!IsSupported())
+			return;
+
+		if (RenderQueue* queue = Renderer::GetRecordingQueue())
+		{
+			queue->Callback([name]() { BeginZoneNow(name); });
+			return;
+		}
+
+		BeginZoneNow(name);
+	}
+
+	void GpuProfiler::EndZone()
+	{
+		if (!IsSupported())
+			return;
+
+		if (RenderQueue* queue = Renderer::GetRecordingQueue())
+		{
+			queue->Callback([]() { EndZoneNow(); });
+			return;
+		}
+
+		EndZoneNow();
+	}
+
+	GpuFrameResult GpuProfiler::GetLastFrame()
+	{
+		if (!IsSupported())
+			return {};
+
+		std::lock_guard<std::mutex> lock(s_Data->ResultMutex);
+		return s_Data->LastFrame;
+	}
+
+}
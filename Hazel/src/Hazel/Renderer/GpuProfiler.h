@@ -0,0 +1,91 @@
+#pragma once
+
+#include "../Core.h"
+#include "../Debug/Profiler.h"
+#include <cstdint>
+#include <vector>
+
+namespace Hazel {
+
+	struct GpuZoneResult
+	{
+		const char* Name = nullptr;
+		uint32_t Depth = 0; // 0 for zones opened directly inside the frame
+		float Milliseconds = 0.0f;
+	};
+
+	struct GpuFrameResult
+	{
+		// Application frame the timings belong to; 0 until one was read back
+		uint64_t FrameIndex = 0;
+		float FrameMilliseconds = 0.0f;
+		std::vector<GpuZoneResult> Zones;
+		// Frames not measured because all query sets were still in flight
+		uint64_t SkippedFrames = 0;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
+	// GPU time of named zones, measured with GL_TIMESTAMP queries
+	// (ARB_timer_query, core in OpenGL 3.3). Each frame writes into one of a
+	// ring of query sets, which is read back a few frames later once the GPU
+	// reports it available, so the CPU never waits on a result. When every set
+	// is still in flight the frame goes unmeasured instead.
+	//
+	// Zones may nest. While a thread records into a RenderQueue, the calls are
+	// recorded too and take effect where the queue is replayed, on the thread
+	// that owns the context. Read back zones also appear in the "GPU" row of
+	// a Profiler capture, shifted onto the CPU clock.
+	//
+	// Zone names must outlive the readback: use string literals.
+	class HAZEL_API GpuProfiler
+	{
+	public:
+		// Called by Renderer::Init/Shutdown with the context current
+		static void Init();
+		static void Shutdown();
+		// False when the driver has no timestamp counter; all calls are then ignored
+		static bool IsSupported();
+
+		// Called by the application around each frame
+		static void BeginFrame();
+		static void EndFrame();
+
+		static void BeginZone(const char* name);
+		static void EndZone();
+
+		// Latest frame that was read back
+		static GpuFrameResult GetLastFrame();
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+	class GpuProfileScope
+	{
+	public:
+		explicit GpuProfileScope(const char* name)
+		{
+			GpuProfiler::BeginZone(name);
+		}
+
+		~GpuProfileScope()
+		{
+			GpuProfiler::EndZone();
+		}
+
+		GpuProfileScope(const GpuProfileScope&) = delete;
+		GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+	};
+
+}
+
+#ifdef HZ_ENABLE_PROFILING
+	#define HZ_PROFILE_GPU(name) ::Hazel::GpuProfileScope HZ_PROFILE_CONCAT(hzGpuProfileScope, __LINE__)(name)
+#else
+	#define HZ_PROFILE_GPU(name)
+#endif
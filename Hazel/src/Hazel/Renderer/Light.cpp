@@ -1,5 +1,6 @@
 #include "Light.h"
 #include <glm/gtc/type_ptr.hpp>
+#include <cstdio>
 
 namespace Hazel {
 
@@ -8,6 +9,77 @@ namespace Hazel {
 	{
 	}
 
+	LightData Light::GetData() const
+	{
+		LightData data;
+		data.Type = m_Type;
+		data.Color = m_Color;
+		data.Intensity = m_Intensity;
+		return data;
+	}
+
+	namespace {
+
+		// Builds "u_PointLights[2].color" style names on the stack; Upload() runs
+		// for every light of every draw
+		class UniformName
+		{
+		public:
+			UniformName(const char* array, int index)
+			{
+				m_PrefixLength = std::snprintf(m_Buffer, sizeof(m_Buffer), "%s[%d].", array, index);
+			}
+
+			const char* operator()(const char* member)
+			{
+				std::snprintf(m_Buffer + m_PrefixLength, sizeof(m_Buffer) - m_PrefixLength, "%s", member);
+				return m_Buffer;
+			}
+
+		private:
+			char m_Buffer[64];
+			int m_PrefixLength;
+		};
+
+	}
+
+	void Light::Upload(const LightData& light, const std::shared_ptr<Shader>& shader, int index)
+	{
+		switch (light.Type)
+		{
+			case LightType::Directional:
+			{
+				UniformName name("u_DirectionalLights", index);
+				shader->SetFloat3(name("direction"), light.Direction);
+				shader->SetFloat3(name("color"), light.Color);
+				shader->SetFloat(name("intensity"), light.Intensity);
+				break;
+			}
+			case LightType::Point:
+			{
+				UniformName name("u_PointLights", index);
+				shader->SetFloat3(name("position"), light.Position);
+				shader->SetFloat3(name("color"), light.Color);
+				shader->SetFloat(name("intensity"), light.Intensity);
+				shader->SetFloat(name("constant"), light.Constant);
+				shader->SetFloat(name("linear"), light.Linear);
+				shader->SetFloat(name("quadratic"), light.Quadratic);
+				break;
+			}
+			case LightType::Spot:
+			{
+				UniformName name("u_SpotLights", index);
+				shader->SetFloat3(name("position"), light.Position);
+				shader->SetFloat3(name("direction"), light.Direction);
+				shader->SetFloat3(name("color"), light.Color);
+				shader->SetFloat(name("intensity"), light.Intensity);
+				shader->SetFloat(name("innerCutOff"), glm::cos(glm::radians(light.InnerCutOff)));
+				shader->SetFloat(name("outerCutOff"), glm::cos(glm::radians(light.OuterCutOff)));
+				break;
+			}
+		}
+	}
+
 	/////////////////////////////////////////////////////////////////////////////
 	// DirectionalLight /////////////////////////////////////////////////////////
 	/////////////////////////////////////////////////////////////////////////////
@@ -17,12 +89,11 @@ namespace Hazel {
 	{
 	}
 
-	void DirectionalLight::UploadToShader(const std::shared_ptr<Shader>& shader, int index)
+	LightData DirectionalLight::GetData() const
 	{
-		std::string prefix = "u_DirectionalLights[" + std::to_string(index) + "]";
-		shader->SetFloat3(prefix + ".direction", m_Direction);
-		shader->SetFloat3(prefix + ".color", m_Color);
-		shader->SetFloat(prefix + ".intensity", m_Intensity);
+		LightData data = Light::GetData();
+		data.Direction = m_Direction;
+		return data;
 	}
 
 	/////////////////////////////////////////////////////////////////////////////
@@ -34,15 +105,14 @@ namespace Hazel {
 	{
 	}
 
-	void PointLight::UploadToShader(const std::shared_ptr<Shader>& shader, int index)
+	LightData PointLight::GetData() const
 	{
-		std::string prefix = "u_PointLights[" + std::to_string(index) + "]";
-		shader->SetFloat3(prefix + ".position", m_Position);
-		shader->SetFloat3(prefix + ".color", m_Color);
-		shader->SetFloat(prefix + ".intensity", m_Intensity);
-		shader->SetFloat(prefix + ".constant", m_Constant);
-		shader->SetFloat(prefix + ".linear", m_Linear);
-		shader->SetFloat(prefix + ".quadratic", m_Quadratic);
+		LightData data = Light::GetData();
+		data.Position = m_Position;
+		data.Constant = m_Constant;
+		data.Linear = m_Linear;
+		data.Quadratic = m_Quadratic;
+		return data;
 	}
 
 	/////////////////////////////////////////////////////////////////////////////
@@ -54,15 +124,14 @@ namespace Hazel {
 	{
 	}
 
-	void SpotLight::UploadToShader(const std::shared_ptr<Shader>& shader, int index)
+	LightData SpotLight::GetData() const
 	{
-		std::string prefix = "u_SpotLights[" + std::to_string(index) + "]";
-		shader->SetFloat3(prefix + ".position", m_Position);
-		shader->SetFloat3(prefix + ".direction", m_Direction);
-		shader->SetFloat3(prefix + ".color", m_Color);
-		shader->SetFloat(prefix + ".intensity", m_Intensity);
-		shader->SetFloat(prefix + ".innerCutOff", glm::cos(glm::radians(m_InnerCutOff)));
-		shader->SetFloat(prefix + ".outerCutOff", glm::cos(glm::radians(m_OuterCutOff)));
+		LightData data = Light::GetData();
+		data.Position = m_Position;
+		data.Direction = m_Direction;
+		data.InnerCutOff = m_InnerCutOff;
+		data.OuterCutOff = m_OuterCutOff;
+		return data;
 	}
 
 }
@@ -14,6 +14,22 @@ namespace Hazel {
 		Spot = 2
 	};
 
+	// Plain-data copy of a light, as uploaded to shaders. Render command
+	// buffers store these instead of the Light objects themselves.
+	struct LightData
+	{
+		LightType Type = LightType::Directional;
+		glm::vec3 Color = { 1.0f, 1.0f, 1.0f };
+		float Intensity = 1.0f;
+		glm::vec3 Position = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 Direction = { 0.0f, -1.0f, 0.0f };
+		float Constant = 1.0f;
+		float Linear = 0.09f;
+		float Quadratic = 0.032f;
+		float InnerCutOff = 12.5f; // Degrees
+		float OuterCutOff = 17.5f;
+	};
+
 #ifdef _MSC_VER
 	#pragma warning(push)
 	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
@@ -32,7 +48,12 @@ namespace Hazel {
 		float GetIntensity() const { return m_Intensity; }
 		LightType GetType() const { return m_Type; }
 
-		virtual void UploadToShader(const std::shared_ptr<Shader>& shader, int index) = 0;
+		// Copy of the light as it is now, for render data that outlives this frame
+		virtual LightData GetData() const;
+
+		void UploadToShader(const std::shared_ptr<Shader>& shader, int index) const { Upload(GetData(), shader, index); }
+		// Uploads 'light' as element 'index' of the shader's array for its type
+		static void Upload(const LightData& light, const std::shared_ptr<Shader>& shader, int index);
 
 	protected:
 		LightType m_Type;
@@ -48,7 +69,7 @@ namespace Hazel {
 		void SetDirection(const glm::vec3& direction) { m_Direction = glm::normalize(direction); }
 		const glm::vec3& GetDirection() const { return m_Direction; }
 
-		virtual void UploadToShader(const std::shared_ptr<Shader>& shader, int index) override;
+		virtual LightData GetData() const override;
 
 	private:
 		glm::vec3 m_Direction = { 0.0f, -1.0f, 0.0f };
@@ -69,7 +90,7 @@ namespace Hazel {
 
 		const glm::vec3& GetPosition() const { return m_Position; }
 
-		virtual void UploadToShader(const std::shared_ptr<Shader>& shader, int index) override;
+		virtual LightData GetData() const override;
 
 	private:
 		glm::vec3 m_Position = { 0.0f, 0.0f, 0.0f };
@@ -94,7 +115,7 @@ namespace Hazel {
 		const glm::vec3& GetPosition() const { return m_Position; }
 		const glm::vec3& GetDirection() const { return m_Direction; }
 
-		virtual void UploadToShader(const std::shared_ptr<Shader>& shader, int index) override;
+		virtual LightData GetData() const override;
 
 	private:
 		glm::vec3 m_Position = { 0.0f, 0.0f, 0.0f };
@@ -8,12 +8,17 @@ namespace Hazel {
 	}
 
 	void Material::Bind()
+	{
+		Bind(m_Properties);
+	}
+
+	void Material::Bind(const MaterialProperties& properties)
 	{
 		m_Shader->Bind();
-		m_Shader->SetFloat4("u_Material.color", m_Color);
-		m_Shader->SetFloat("u_Material.shininess", m_Shininess);
-		m_Shader->SetFloat("u_Material.metallic", m_Metallic);
-		m_Shader->SetFloat("u_Material.roughness", m_Roughness);
+		m_Shader->SetFloat4("u_Material.color", properties.Color);
+		m_Shader->SetFloat("u_Material.shininess", properties.Shininess);
+		m_Shader->SetFloat("u_Material.metallic", properties.Metallic);
+		m_Shader->SetFloat("u_Material.roughness", properties.Roughness);
 	}
 
 }
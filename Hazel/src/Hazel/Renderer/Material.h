@@ -7,6 +7,16 @@
 
 namespace Hazel {
 
+	// Plain values a material uploads; copied into render packets so a recorded
+	// draw is unaffected by later edits to the material
+	struct MaterialProperties
+	{
+		glm::vec4 Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+		float Shininess = 32.0f;
+		float Metallic = 0.0f;
+		float Roughness = 0.5f;
+	};
+
 #ifdef _MSC_VER
 	#pragma warning(push)
 	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
@@ -18,18 +28,21 @@ namespace Hazel {
 		Material(const std::shared_ptr<Shader>& shader);
 
 		void Bind();
+		// Binds the shader with a snapshot of properties instead of the current ones
+		void Bind(const MaterialProperties& properties);
 		
 		// Set material properties
-		void SetColor(const glm::vec4& color) { m_Color = color; }
-		void SetShininess(float shininess) { m_Shininess = shininess; }
-		void SetMetallic(float metallic) { m_Metallic = metallic; }
-		void SetRoughness(float roughness) { m_Roughness = roughness; }
+		void SetColor(const glm::vec4& color) { m_Properties.Color = color; }
+		void SetShininess(float shininess) { m_Properties.Shininess = shininess; }
+		void SetMetallic(float metallic) { m_Properties.Metallic = metallic; }
+		void SetRoughness(float roughness) { m_Properties.Roughness = roughness; }
 
 		// Get material properties
-		const glm::vec4& GetColor() const { return m_Color; }
-		float GetShininess() const { return m_Shininess; }
-		float GetMetallic() const { return m_Metallic; }
-		float GetRoughness() const { return m_Roughness; }
+		const glm::vec4& GetColor() const { return m_Properties.Color; }
+		float GetShininess() const { return m_Properties.Shininess; }
+		float GetMetallic() const { return m_Properties.Metallic; }
+		float GetRoughness() const { return m_Properties.Roughness; }
+		const MaterialProperties& GetProperties() const { return m_Properties; }
 
 		std::shared_ptr<Shader> GetShader() const { return m_Shader; }
 
@@ -37,10 +50,7 @@ namespace Hazel {
 		std::shared_ptr<Shader> m_Shader;
 		
 		// Material properties
-		glm::vec4 m_Color = { 1.0f, 1.0f, 1.0f, 1.0f };
-		float m_Shininess = 32.0f;
-		float m_Metallic = 0.0f;
-		float m_Roughness = 0.5f;
+		MaterialProperties m_Properties;
 	};
 
 #ifdef _MSC_VER
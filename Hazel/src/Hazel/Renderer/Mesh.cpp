@@ -0,0 +1,116 @@
+#include "Mesh.h"
+#include "../Log.h"
+
+namespace Hazel {
+
+	Mesh::Mesh(const MeshData& data)
+		: Mesh(data.Vertices.data(), static_cast<unsigned int>(data.Vertices.size() * sizeof(float)),
+		       data.Indices.data(), static_cast<unsigned int>(data.Indices.size()),
+		       GetDefaultLayout())
+	{
+	}
+
+	Mesh::Mesh(const float* vertices, unsigned int vertexBytes,
+	           const unsigned int* indices, unsigned int indexCount,
+	           const BufferLayout& layout)
+		: m_IndexCount(indexCount)
+	{
+		unsigned int stride = layout.GetStride();
+		m_VertexCount = stride > 0 ? vertexBytes / stride : 0;
+		m_SizeInBytes = static_cast<size_t>(vertexBytes) + static_cast<size_t>(indexCount) * sizeof(unsigned int);
+
+		m_VertexArray = std::make_shared<VertexArray>();
+
+		m_VertexBuffer = std::make_shared<VertexBuffer>(const_cast<float*>(vertices), vertexBytes);
+		m_VertexBuffer->SetLayout(layout);
+		m_VertexArray->AddVertexBuffer(m_VertexBuffer.get());
+
+		m_IndexBuffer = std::make_shared<IndexBuffer>(const_cast<unsigned int*>(indices), indexCount);
+		m_VertexArray->SetIndexBuffer(m_IndexBuffer.get());
+
+		m_LODs.push_back({ 0, indexCount, 0.0f, m_VertexCount });
+		SelectLOD(0);
+	}
+
+	Mesh::Mesh(unsigned int vertexBytes, unsigned int indexCount, const BufferLayout& layout)
+		: m_IndexCount(indexCount)
+	{
+		unsigned int stride = layout.GetStride();
+		m_VertexCount = stride > 0 ? vertexBytes / stride : 0;
+		m_SizeInBytes = static_cast<size_t>(vertexBytes) + static_cast<size_t>(indexCount) * sizeof(unsigned int);
+
+		m_VertexArray = std::make_shared<VertexArray>();
+
+		m_VertexBuffer = std::make_shared<VertexBuffer>(vertexBytes);
+		m_VertexBuffer->SetLayout(layout);
+		m_VertexArray->AddVertexBuffer(m_VertexBuffer.get());
+
+		m_IndexBuffer = std::make_shared<IndexBuffer>(indexCount);
+		m_VertexArray->SetIndexBuffer(m_IndexBuffer.get());
+
+		m_LODs.push_back({ 0, indexCount, 0.0f, m_VertexCount });
+		SelectLOD(0);
+	}
+
+	std::shared_ptr<Mesh> Mesh::Create(const MeshSize& size, const BufferLayout& layout,
+	                                   const std::function<void(float* vertices, unsigned int* indices)>& fill)
+	{
+		std::shared_ptr<Mesh> mesh(new Mesh(size.GetVertexBytes(), size.IndexCount, layout));
+
+		// Keep the mesh's own vertex array bound so mapping the index buffer
+		// doesn't change another vertex array's element binding
+		mesh->m_VertexArray->Bind();
+		float* vertices = static_cast<float*>(mesh->m_VertexBuffer->Map());
+		unsigned int* indices = mesh->m_IndexBuffer->Map();
+
+		if (vertices && indices)
+		{
+			fill(vertices, indices);
+			mesh->m_VertexBuffer->Unmap();
+			mesh->m_IndexBuffer->Unmap();
+			mesh->m_VertexArray->Unbind();
+			return mesh;
+		}
+
+		if (vertices)
+			mesh->m_VertexBuffer->Unmap();
+		if (indices)
+			mesh->m_IndexBuffer->Unmap();
+		mesh->m_VertexArray->Unbind();
+
+		HZ_WARN("Mesh: buffer mapping failed, falling back to a staging copy");
+		MeshData staging;
+		staging.Vertices.resize(size.GetVertexFloatCount());
+		staging.Indices.resize(size.IndexCount);
+		fill(staging.Vertices.data(), staging.Indices.data());
+		return std::make_shared<Mesh>(staging.Vertices.data(), size.GetVertexBytes(),
+		                              staging.Indices.data(), size.IndexCount, layout);
+	}
+
+	void Mesh::SetLODs(const std::vector<MeshLOD>& lods)
+	{
+		if (lods.empty())
+			return;
+
+		m_LODs = lods;
+		SelectLOD(0);
+	}
+
+	void Mesh::SelectLOD(size_t lod)
+	{
+		if (lod >= m_LODs.size())
+			lod = m_LODs.size() - 1;
+
+		m_SelectedLOD = lod;
+		m_IndexBuffer->SetDrawRange(m_LODs[lod].FirstIndex, m_LODs[lod].IndexCount, m_LODs[lod].VertexCount);
+	}
+
+	BufferLayout Mesh::GetDefaultLayout()
+	{
+		return {
+			{ ShaderDataType::Float3, "a_Position" },
+			{ ShaderDataType::Float3, "a_Normal" }
+		};
+	}
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../Core.h"
+#include "Buffer.h"
+#include "MeshGenerator.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Hazel {
+
+	// Index range of one level of detail inside a mesh's index buffer
+	struct MeshLOD
+	{
+		unsigned int FirstIndex = 0;
+		unsigned int IndexCount = 0;
+		float Error = 0.0f; // Simplification error relative to the mesh bounds
+		unsigned int VertexCount = 0; // Distinct vertices the range references
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
+	// GPU-resident mesh: owns the vertex array together with the vertex and
+	// index buffers it references, so the three are always released together
+	class HAZEL_API Mesh
+	{
+	public:
+		// Uploads MeshData using the default position/normal layout
+		Mesh(const MeshData& data);
+		Mesh(const float* vertices, unsigned int vertexBytes,
+		     const unsigned int* indices, unsigned int indexCount,
+		     const BufferLayout& layout);
+		~Mesh() = default;
+
+		// Allocates GPU buffers of exactly 'size' and lets 'fill' write vertices and
+		// indices straight into the mapped buffers, avoiding any CPU-side copy.
+		// Falls back to a staging copy if the driver refuses to map.
+		static std::shared_ptr<Mesh> Create(const MeshSize& size, const BufferLayout& layout,
+		                                    const std::function<void(float* vertices, unsigned int* indices)>& fill);
+
+		// Default layout produced by MeshGenerator: [position.xyz, normal.xyz]
+		static BufferLayout GetDefaultLayout();
+
+		const std::shared_ptr<VertexArray>& GetVertexArray() const { return m_VertexArray; }
+		unsigned int GetIndexCount() const { return m_IndexCount; }
+		unsigned int GetVertexCount() const { return m_VertexCount; }
+
+		// Approximate GPU memory held by the vertex and index buffers
+		size_t GetSizeInBytes() const { return m_SizeInBytes; }
+
+		// Levels of detail sharing this mesh's vertex buffer; LOD 0 is the full mesh
+		void SetLODs(const std::vector<MeshLOD>& lods);
+		const std::vector<MeshLOD>& GetLODs() const { return m_LODs; }
+		void SelectLOD(size_t lod);
+		size_t GetSelectedLOD() const { return m_SelectedLOD; }
+
+	private:
+		// Allocates uninitialized buffers (see Create)
+		Mesh(unsigned int vertexBytes, unsigned int indexCount, const BufferLayout& layout);
+
+	private:
+		// Buffers are declared first so the vertex array referencing them is destroyed first
+		std::shared_ptr<VertexBuffer> m_VertexBuffer;
+		std::shared_ptr<IndexBuffer> m_IndexBuffer;
+		std::shared_ptr<VertexArray> m_VertexArray;
+
+		unsigned int m_VertexCount = 0;
+		unsigned int m_IndexCount = 0;
+		size_t m_SizeInBytes = 0;
+
+		std::vector<MeshLOD> m_LODs;
+		size_t m_SelectedLOD = 0;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
@@ -0,0 +1,250 @@
+#include "MeshCache.h"
+#include "../Log.h"
+#include "../Memory/MemoryTracker.h"
+#include <cstdio>
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+namespace Hazel {
+
+	/////////////////////////////////////////////////////////////////////////////
+	// MeshKey //////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	MeshKey MeshKey::Cube(float size)
+	{
+		MeshKey key;
+		key.Primitive = MeshPrimitive::Cube;
+		key.Size = size;
+		return key;
+	}
+
+	MeshKey MeshKey::Sphere(float radius, int segments)
+	{
+		MeshKey key;
+		key.Primitive = MeshPrimitive::Sphere;
+		key.Size = 0.0f;
+		key.Radius = radius;
+		key.Segments = segments;
+		return key;
+	}
+
+	MeshKey MeshKey::Capsule(float height, float radius, int segments)
+	{
+		MeshKey key;
+		key.Primitive = MeshPrimitive::Capsule;
+		key.Size = height;
+		key.Radius = radius;
+		key.Segments = segments;
+		return key;
+	}
+
+	size_t MeshKey::Hash() const
+	{
+		size_t hash = std::hash<int>()(static_cast<int>(Primitive));
+		auto combine = [&hash](size_t value)
+		{
+			hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+		};
+		combine(std::hash<float>()(Size));
+		combine(std::hash<float>()(Radius));
+		combine(std::hash<int>()(Segments));
+		return hash;
+	}
+
+	std::string MeshKey::ToString() const
+	{
+		char buffer[96];
+		switch (Primitive)
+		{
+			case MeshPrimitive::Cube:
+				snprintf(buffer, sizeof(buffer), "Cube(size=%g)", Size);
+				break;
+			case MeshPrimitive::Sphere:
+				snprintf(buffer, sizeof(buffer), "Sphere(r=%g, seg=%d)", Radius, Segments);
+				break;
+			case MeshPrimitive::Capsule:
+				snprintf(buffer, sizeof(buffer), "Capsule(h=%g, r=%g, seg=%d)", Size, Radius, Segments);
+				break;
+			default:
+				snprintf(buffer, sizeof(buffer), "Unknown");
+				break;
+		}
+		return buffer;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// MeshCache ////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	struct MeshKeyHasher
+	{
+		size_t operator()(const MeshKey& key) const { return key.Hash(); }
+	};
+
+	struct MeshCacheEntry
+	{
+		std::shared_ptr<Mesh> CachedMesh;
+		std::list<MeshKey>::iterator LRUPosition;
+	};
+
+	struct MeshCacheData
+	{
+		std::unordered_map<MeshKey, MeshCacheEntry, MeshKeyHasher> Entries;
+		std::list<MeshKey> LRU; // Most recently used at the front
+		size_t UnusedCapacity = 16;
+		MeshCacheStats Stats;
+	};
+
+	static MeshCacheData s_CacheData;
+
+	static bool IsUnused(const MeshCacheEntry& entry)
+	{
+		// The cache's own reference is the only one left
+		return entry.CachedMesh.use_count() == 1;
+	}
+
+	static std::shared_ptr<Mesh> CreateMesh(const MeshKey& key)
+	{
+		// Generators write straight into the mapped GPU buffers
+		switch (key.Primitive)
+		{
+			case MeshPrimitive::Cube:
+				return Mesh::Create(MeshGenerator::GetCubeSize(), Mesh::GetDefaultLayout(),
+					[&key](float* vertices, unsigned int* indices)
+					{
+						MeshGenerator::GenerateCube(key.Size, vertices, indices);
+					});
+			case MeshPrimitive::Sphere:
+				return Mesh::Create(MeshGenerator::GetSphereSize(key.Segments), Mesh::GetDefaultLayout(),
+					[&key](float* vertices, unsigned int* indices)
+					{
+						MeshGenerator::GenerateSphere(key.Radius, key.Segments, vertices, indices);
+					});
+			case MeshPrimitive::Capsule:
+				return Mesh::Create(MeshGenerator::GetCapsuleSize(key.Segments), Mesh::GetDefaultLayout(),
+					[&key](float* vertices, unsigned int* indices)
+					{
+						MeshGenerator::GenerateCapsule(key.Size, key.Radius, key.Segments, vertices, indices);
+					});
+		}
+		return nullptr;
+	}
+
+	std::shared_ptr<Mesh> MeshCache::Get(const MeshKey& key)
+	{
+		HZ_MEMORY_TAG(Renderer);
+
+		auto it = s_CacheData.Entries.find(key);
+		if (it != s_CacheData.Entries.end())
+		{
+			// Hit: move to the front of the LRU list
+			s_CacheData.LRU.splice(s_CacheData.LRU.begin(), s_CacheData.LRU, it->second.LRUPosition);
+			s_CacheData.Stats.Hits++;
+			return it->second.CachedMesh;
+		}
+
+		s_CacheData.Stats.Misses++;
+
+		auto mesh = CreateMesh(key);
+		if (!mesh)
+			return nullptr;
+
+		s_CacheData.LRU.push_front(key);
+		MeshCacheEntry entry;
+		entry.CachedMesh = mesh;
+		entry.LRUPosition = s_CacheData.LRU.begin();
+		s_CacheData.Entries.emplace(key, entry);
+		s_CacheData.Stats.ResidentBytes += mesh->GetSizeInBytes();
+
+		HZ_TRACE("MeshCache: generated {}", key.ToString());
+
+		// New entries may push older, unused ones over the capacity
+		Trim();
+
+		return mesh;
+	}
+
+	void MeshCache::SetUnusedCapacity(size_t capacity)
+	{
+		s_CacheData.UnusedCapacity = capacity;
+		Trim();
+	}
+
+	size_t MeshCache::GetUnusedCapacity()
+	{
+		return s_CacheData.UnusedCapacity;
+	}
+
+	void MeshCache::Trim()
+	{
+		size_t unused = 0;
+		for (const auto& pair : s_CacheData.Entries)
+		{
+			if (IsUnused(pair.second))
+				unused++;
+		}
+
+		// Walk from least to most recently used, evicting unused entries
+		auto it = s_CacheData.LRU.end();
+		while (unused > s_CacheData.UnusedCapacity && it != s_CacheData.LRU.begin())
+		{
+			--it;
+			auto entryIt = s_CacheData.Entries.find(*it);
+			if (!IsUnused(entryIt->second))
+				continue;
+
+			s_CacheData.Stats.ResidentBytes -= entryIt->second.CachedMesh->GetSizeInBytes();
+			s_CacheData.Stats.Evictions++;
+			s_CacheData.Entries.erase(entryIt);
+			it = s_CacheData.LRU.erase(it);
+			unused--;
+		}
+	}
+
+	void MeshCache::Clear()
+	{
+		s_CacheData.Entries.clear();
+		s_CacheData.LRU.clear();
+		s_CacheData.Stats.ResidentBytes = 0;
+	}
+
+	MeshCacheStats MeshCache::GetStats()
+	{
+		MeshCacheStats stats = s_CacheData.Stats;
+		stats.ResidentMeshes = s_CacheData.Entries.size();
+		stats.UnusedMeshes = 0;
+		for (const auto& pair : s_CacheData.Entries)
+		{
+			if (IsUnused(pair.second))
+				stats.UnusedMeshes++;
+		}
+		return stats;
+	}
+
+	void MeshCache::ResetStats()
+	{
+		s_CacheData.Stats.Hits = 0;
+		s_CacheData.Stats.Misses = 0;
+		s_CacheData.Stats.Evictions = 0;
+	}
+
+	std::vector<MeshCacheEntryInfo> MeshCache::GetEntries()
+	{
+		std::vector<MeshCacheEntryInfo> entries;
+		entries.reserve(s_CacheData.LRU.size());
+		for (const MeshKey& key : s_CacheData.LRU)
+		{
+			const MeshCacheEntry& entry = s_CacheData.Entries.at(key);
+
+			MeshCacheEntryInfo info;
+			info.Name = key.ToString();
+			info.References = entry.CachedMesh.use_count() - 1;
+			info.SizeInBytes = entry.CachedMesh->GetSizeInBytes();
+			entries.push_back(info);
+		}
+		return entries;
+	}
+
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "../Core.h"
+#include "Mesh.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Hazel {
+
+	// Generator used to build a cached mesh
+	enum class MeshPrimitive
+	{
+		Cube = 0,
+		Sphere,
+		Capsule
+	};
+
+	// Identifies a procedural mesh by generator and parameters, e.g. Sphere(r=0.5, seg=32)
+	struct MeshKey
+	{
+		MeshPrimitive Primitive = MeshPrimitive::Cube;
+		float Size = 1.0f;    // Cube: edge length, Capsule: cylinder height
+		float Radius = 0.0f;  // Sphere/Capsule radius
+		int Segments = 0;     // Sphere/Capsule tessellation
+
+		static MeshKey Cube(float size = 1.0f);
+		static MeshKey Sphere(float radius = 0.5f, int segments = 32);
+		static MeshKey Capsule(float height = 1.0f, float radius = 0.5f, int segments = 32);
+
+		bool operator==(const MeshKey& other) const
+		{
+			return Primitive == other.Primitive && Size == other.Size &&
+			       Radius == other.Radius && Segments == other.Segments;
+		}
+
+		size_t Hash() const;
+		std::string ToString() const;
+	};
+
+	struct MeshCacheStats
+	{
+		uint64_t Hits = 0;
+		uint64_t Misses = 0;
+		uint64_t Evictions = 0;
+		size_t ResidentMeshes = 0;
+		size_t UnusedMeshes = 0;
+		size_t ResidentBytes = 0;
+
+		float GetHitRate() const
+		{
+			uint64_t total = Hits + Misses;
+			return total > 0 ? static_cast<float>(Hits) / static_cast<float>(total) : 0.0f;
+		}
+	};
+
+	// Per-entry information for debug UIs
+	struct MeshCacheEntryInfo
+	{
+		std::string Name;
+		long References = 0;  // Outstanding handles held outside the cache
+		size_t SizeInBytes = 0;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
+	// Process-wide registry of procedural meshes shared across layers.
+	// Meshes are generated and uploaded once per unique MeshKey and handed out as
+	// shared handles. An entry is "unused" once the cache holds the only reference;
+	// unused entries are kept around for reuse and evicted least-recently-used first
+	// once there are more than the configured capacity.
+	// Must only be used from the thread that owns the OpenGL context.
+	class HAZEL_API MeshCache
+	{
+	public:
+		static std::shared_ptr<Mesh> Get(const MeshKey& key);
+
+		static std::shared_ptr<Mesh> GetCube(float size = 1.0f) { return Get(MeshKey::Cube(size)); }
+		static std::shared_ptr<Mesh> GetSphere(float radius = 0.5f, int segments = 32) { return Get(MeshKey::Sphere(radius, segments)); }
+		static std::shared_ptr<Mesh> GetCapsule(float height = 1.0f, float radius = 0.5f, int segments = 32) { return Get(MeshKey::Capsule(height, radius, segments)); }
+
+		// Maximum number of unused meshes kept resident before LRU eviction kicks in
+		static void SetUnusedCapacity(size_t capacity);
+		static size_t GetUnusedCapacity();
+
+		// Evicts unused meshes beyond the unused capacity (called automatically on misses)
+		static void Trim();
+		// Drops every cached reference; meshes still held by callers stay alive until released
+		static void Clear();
+
+		static MeshCacheStats GetStats();
+		static void ResetStats();
+		static std::vector<MeshCacheEntryInfo> GetEntries();
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
@@ -0,0 +1,664 @@
+#include "MeshFile.h"
+#include "../Log.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace Hazel {
+
+	namespace {
+
+		constexpr uint32_t SectionIndex(MeshFileSectionType type)
+		{
+			return static_cast<uint32_t>(type);
+		}
+
+		uint64_t AlignOffset(uint64_t offset)
+		{
+			return (offset + MeshFileAlignment - 1) & ~static_cast<uint64_t>(MeshFileAlignment - 1);
+		}
+
+		// Strided view over the position attribute of an interleaved vertex blob
+		struct PositionReader
+		{
+			const unsigned char* Base;
+			unsigned int Stride;
+			unsigned int Offset;
+
+			glm::vec3 operator[](uint32_t vertex) const
+			{
+				glm::vec3 position;
+				std::memcpy(&position, Base + static_cast<size_t>(vertex) * Stride + Offset, sizeof(position));
+				return position;
+			}
+		};
+
+		struct Bounds
+		{
+			glm::vec3 Min = glm::vec3(0.0f);
+			glm::vec3 Max = glm::vec3(0.0f);
+			glm::vec3 Center = glm::vec3(0.0f);
+			float Radius = 0.0f;
+		};
+
+		template<typename VertexRange>
+		Bounds ComputeBounds(const PositionReader& positions, const VertexRange& vertices)
+		{
+			Bounds bounds;
+			bool first = true;
+			for (uint32_t vertex : vertices)
+			{
+				glm::vec3 p = positions[vertex];
+				bounds.Min = first ? p : glm::min(bounds.Min, p);
+				bounds.Max = first ? p : glm::max(bounds.Max, p);
+				first = false;
+			}
+
+			bounds.Center = (bounds.Min + bounds.Max) * 0.5f;
+			float radiusSquared = 0.0f;
+			for (uint32_t vertex : vertices)
+			{
+				glm::vec3 d = positions[vertex] - bounds.Center;
+				radiusSquared = std::max(radiusSquared, glm::dot(d, d));
+			}
+			bounds.Radius = std::sqrt(radiusSquared);
+			return bounds;
+		}
+
+		// Counting range so ComputeBounds can walk every vertex without an index list
+		struct VertexSequence
+		{
+			struct Iterator
+			{
+				uint32_t Value;
+				uint32_t operator*() const { return Value; }
+				Iterator& operator++() { ++Value; return *this; }
+				bool operator!=(const Iterator& other) const { return Value != other.Value; }
+			};
+
+			uint32_t Count;
+			Iterator begin() const { return { 0 }; }
+			Iterator end() const { return { Count }; }
+		};
+
+		// Vertex-clustering simplification: snaps every vertex to the most central
+		// vertex of its grid cell and drops the triangles that collapse. The LOD
+		// keeps referencing the original vertex blob, so only indices are added.
+		void SimplifyByClustering(const PositionReader& positions, uint32_t vertexCount, const Bounds& bounds,
+		                          const unsigned int* indices, uint32_t indexCount, float cellSize,
+		                          std::vector<uint32_t>& result)
+		{
+			struct Cell
+			{
+				glm::vec3 Sum = glm::vec3(0.0f);
+				uint32_t Count = 0;
+				uint32_t Representative = 0;
+				float BestDistance = std::numeric_limits<float>::max();
+			};
+
+			std::vector<uint64_t> cellKeys(vertexCount);
+			std::unordered_map<uint64_t, Cell> cells;
+			cells.reserve(vertexCount / 4 + 1);
+
+			float inverseCell = 1.0f / cellSize;
+			for (uint32_t v = 0; v < vertexCount; v++)
+			{
+				glm::vec3 p = positions[v];
+				glm::vec3 cell = glm::floor((p - bounds.Min) * inverseCell);
+				uint64_t key = (static_cast<uint64_t>(cell.x) & 0x1FFFFF)
+				             | ((static_cast<uint64_t>(cell.y) & 0x1FFFFF) << 21)
+				             | ((static_cast<uint64_t>(cell.z) & 0x1FFFFF) << 42);
+				cellKeys[v] = key;
+
+				Cell& entry = cells[key];
+				entry.Sum += p;
+				entry.Count++;
+			}
+
+			for (uint32_t v = 0; v < vertexCount; v++)
+			{
+				Cell& entry = cells[cellKeys[v]];
+				glm::vec3 d = positions[v] - entry.Sum / static_cast<float>(entry.Count);
+				float distance = glm::dot(d, d);
+				if (distance < entry.BestDistance)
+				{
+					entry.Representative = v;
+					entry.BestDistance = distance;
+				}
+			}
+
+			result.clear();
+			for (uint32_t i = 0; i + 2 < indexCount; i += 3)
+			{
+				uint32_t a = cells[cellKeys[indices[i + 0]]].Representative;
+				uint32_t b = cells[cellKeys[indices[i + 1]]].Representative;
+				uint32_t c = cells[cellKeys[indices[i + 2]]].Representative;
+				if (a == b || b == c || a == c)
+					continue;
+
+				result.push_back(a);
+				result.push_back(b);
+				result.push_back(c);
+			}
+		}
+
+		void BuildLODs(const PositionReader& positions, uint32_t vertexCount, const Bounds& bounds,
+		               const unsigned int* indices, uint32_t indexCount, const MeshFileWriteOptions& options,
+		               std::vector<uint32_t>& allIndices, std::vector<MeshFileLOD>& lods)
+		{
+			allIndices.assign(indices, indices + indexCount);
+			lods.push_back({ 0, indexCount, 0.0f, 0 });
+
+			glm::vec3 extent = bounds.Max - bounds.Min;
+			float maxExtent = std::max(extent.x, std::max(extent.y, extent.z));
+			float diagonal = glm::length(extent);
+			if (maxExtent <= 0.0f || options.MaxLODs <= 1)
+				return;
+
+			// Surfaces hold roughly sqrt(n) vertices along an edge; start there and coarsen
+			float gridResolution = std::max(2.0f, std::sqrt(static_cast<float>(vertexCount)));
+			std::vector<uint32_t> simplified;
+			uint32_t previousIndexCount = indexCount;
+
+			while (lods.size() < options.MaxLODs)
+			{
+				uint32_t target = static_cast<uint32_t>(previousIndexCount / 3 * options.LODTriangleRatio) * 3;
+				if (target < 12)
+					break;
+
+				// Coarsen the grid until the triangle budget is met
+				float cellSize = maxExtent / gridResolution;
+				do
+				{
+					SimplifyByClustering(positions, vertexCount, bounds, indices, indexCount, cellSize, simplified);
+					if (simplified.size() <= target)
+						break;
+					gridResolution *= 0.75f;
+					cellSize = maxExtent / gridResolution;
+				} while (gridResolution >= 1.0f);
+
+				if (simplified.empty() || simplified.size() >= previousIndexCount)
+					break;
+
+				MeshFileLOD lod;
+				lod.IndexOffset = static_cast<uint32_t>(allIndices.size());
+				lod.IndexCount = static_cast<uint32_t>(simplified.size());
+				lod.Error = diagonal > 0.0f ? cellSize / diagonal : 0.0f;
+				lod.Reserved = 0;
+				lods.push_back(lod);
+				allIndices.insert(allIndices.end(), simplified.begin(), simplified.end());
+
+				previousIndexCount = lod.IndexCount;
+				gridResolution *= 0.75f;
+			}
+		}
+
+		// Greedy meshlet builder: walks LOD 0 triangles in order and starts a new
+		// meshlet whenever the vertex or triangle limit would be exceeded
+		void BuildMeshlets(const PositionReader& positions, uint32_t vertexCount,
+		                   const unsigned int* indices, uint32_t indexCount, const MeshFileWriteOptions& options,
+		                   std::vector<MeshFileMeshlet>& meshlets, std::vector<uint32_t>& meshletVertices,
+		                   std::vector<uint8_t>& meshletTriangles)
+		{
+			const uint32_t maxVertices = std::min(std::max(options.MeshletMaxVertices, 3u), 256u);
+			const uint32_t maxTriangles = std::max(options.MeshletMaxTriangles, 1u);
+			const uint32_t unassigned = ~0u;
+
+			std::vector<uint32_t> localIndex(vertexCount, unassigned);
+			MeshFileMeshlet current = {};
+
+			auto flush = [&]()
+			{
+				if (current.TriangleCount == 0)
+					return;
+
+				struct Range
+				{
+					const uint32_t* First;
+					const uint32_t* Last;
+					const uint32_t* begin() const { return First; }
+					const uint32_t* end() const { return Last; }
+				};
+				const uint32_t* first = meshletVertices.data() + current.VertexOffset;
+				Bounds bounds = ComputeBounds(positions, Range{ first, first + current.VertexCount });
+				current.Center[0] = bounds.Center.x;
+				current.Center[1] = bounds.Center.y;
+				current.Center[2] = bounds.Center.z;
+				current.Radius = bounds.Radius;
+				meshlets.push_back(current);
+
+				for (uint32_t i = 0; i < current.VertexCount; i++)
+					localIndex[first[i]] = unassigned;
+
+				current = {};
+				current.VertexOffset = static_cast<uint32_t>(meshletVertices.size());
+				current.TriangleOffset = static_cast<uint32_t>(meshletTriangles.size() / 3);
+			};
+
+			for (uint32_t i = 0; i + 2 < indexCount; i += 3)
+			{
+				const unsigned int* triangle = indices + i;
+				uint32_t newVertices = 0;
+				for (int k = 0; k < 3; k++)
+					newVertices += localIndex[triangle[k]] == unassigned ? 1 : 0;
+
+				if (current.VertexCount + newVertices > maxVertices || current.TriangleCount + 1 > maxTriangles)
+					flush();
+
+				for (int k = 0; k < 3; k++)
+				{
+					uint32_t vertex = triangle[k];
+					if (localIndex[vertex] == unassigned)
+					{
+						localIndex[vertex] = current.VertexCount++;
+						meshletVertices.push_back(vertex);
+					}
+					meshletTriangles.push_back(static_cast<uint8_t>(localIndex[vertex]));
+				}
+				current.TriangleCount++;
+			}
+			flush();
+		}
+
+		// Distinct vertices among 'count' indices; 'seen' is scratch space
+		unsigned int CountVertices(const uint32_t* indices, uint32_t count, std::vector<bool>& seen)
+		{
+			std::fill(seen.begin(), seen.end(), false);
+			unsigned int vertices = 0;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				uint32_t index = indices[i];
+				if (index < seen.size() && !seen[index])
+				{
+					seen[index] = true;
+					vertices++;
+				}
+			}
+			return vertices;
+		}
+
+		bool WriteBlob(std::ofstream& stream, const void* data, uint64_t size, uint64_t offset)
+		{
+			static const char zeros[MeshFileAlignment] = {};
+
+			uint64_t position = static_cast<uint64_t>(stream.tellp());
+			if (offset > position)
+				stream.write(zeros, static_cast<std::streamsize>(offset - position));
+			if (size > 0)
+				stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+			return stream.good();
+		}
+
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Reading //////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	bool MeshFile::Open(const std::string& path)
+	{
+		Close();
+
+		if (!m_File.Open(path))
+			return false;
+
+		m_Header = reinterpret_cast<const MeshFileHeader*>(m_File.GetData());
+		if (!Validate())
+		{
+			Close();
+			return false;
+		}
+
+		// Start pulling the blobs in while the caller sets up the upload
+		m_File.Prefetch();
+		return true;
+	}
+
+	void MeshFile::Close()
+	{
+		m_Header = nullptr;
+		m_File.Close();
+	}
+
+	bool MeshFile::Validate() const
+	{
+		const std::string& path = m_File.GetPath();
+		const uint64_t fileSize = m_File.GetSize();
+
+		if (fileSize < sizeof(MeshFileHeader) || m_Header->Magic != MeshFileMagic)
+		{
+			HZ_ERROR("MeshFile: {} is not a .hmesh file", path);
+			return false;
+		}
+		if (m_Header->Version != MeshFileVersion || m_Header->HeaderSize != sizeof(MeshFileHeader))
+		{
+			HZ_ERROR("MeshFile: {} has unsupported version {}", path, m_Header->Version);
+			return false;
+		}
+		if (m_Header->AttributeCount == 0 || m_Header->AttributeCount > MeshFileMaxAttributes || m_Header->VertexStride == 0)
+		{
+			HZ_ERROR("MeshFile: {} has an invalid vertex layout", path);
+			return false;
+		}
+
+		// Every attribute type must be known and the offsets must be exactly what
+		// BufferLayout computes, otherwise the blob can't be bound as-is
+		for (uint32_t i = 0; i < m_Header->AttributeCount; i++)
+		{
+			uint32_t type = m_Header->Attributes[i].Type;
+			if (type == static_cast<uint32_t>(ShaderDataType::None) || type > static_cast<uint32_t>(ShaderDataType::Bool))
+			{
+				HZ_ERROR("MeshFile: {} has an unknown attribute type", path);
+				return false;
+			}
+		}
+
+		BufferLayout layout = GetLayout();
+		if (layout.GetStride() != m_Header->VertexStride)
+		{
+			HZ_ERROR("MeshFile: {} vertex stride does not match its attributes", path);
+			return false;
+		}
+		for (uint32_t i = 0; i < m_Header->AttributeCount; i++)
+		{
+			if (layout.GetElements()[i].Offset != m_Header->Attributes[i].Offset)
+			{
+				HZ_ERROR("MeshFile: {} attribute offsets do not match BufferLayout packing", path);
+				return false;
+			}
+		}
+
+		const uint64_t expectedSizes[] = {
+			static_cast<uint64_t>(m_Header->VertexCount) * m_Header->VertexStride,
+			static_cast<uint64_t>(m_Header->IndexCount) * sizeof(uint32_t),
+			static_cast<uint64_t>(m_Header->LODCount) * sizeof(MeshFileLOD),
+			static_cast<uint64_t>(m_Header->MeshletCount) * sizeof(MeshFileMeshlet),
+		};
+
+		for (uint32_t i = 0; i < SectionIndex(MeshFileSectionType::Count); i++)
+		{
+			// Checked before the empty skip, so counts always have data behind them
+			const MeshFileSection& section = m_Header->Sections[i];
+			if (i < sizeof(expectedSizes) / sizeof(expectedSizes[0]) && section.Size != expectedSizes[i])
+			{
+				HZ_ERROR("MeshFile: {} section size does not match its header counts", path);
+				return false;
+			}
+			if (section.Size == 0)
+				continue;
+
+			if (section.Offset % MeshFileAlignment != 0 || section.Offset < sizeof(MeshFileHeader) ||
+			    section.Offset > fileSize || section.Size > fileSize - section.Offset)
+			{
+				HZ_ERROR("MeshFile: {} has a truncated or misaligned section", path);
+				return false;
+			}
+		}
+
+		// Buffer uploads take 32-bit sizes
+		if (expectedSizes[0] > 0xFFFFFFFFull || expectedSizes[1] > 0xFFFFFFFFull)
+		{
+			HZ_ERROR("MeshFile: {} is too large for a single mesh", path);
+			return false;
+		}
+
+		// LOD table is tiny, check ranges so SelectLOD can trust it. Index values
+		// themselves are not scanned; that would defeat the zero-parse load.
+		const MeshFileLOD* lods = GetLODs();
+		for (uint32_t i = 0; i < m_Header->LODCount; i++)
+		{
+			if (lods[i].IndexOffset > m_Header->IndexCount || lods[i].IndexCount > m_Header->IndexCount - lods[i].IndexOffset)
+			{
+				HZ_ERROR("MeshFile: {} has an out-of-range LOD", path);
+				return false;
+			}
+		}
+
+		// The meshlet blobs have no counts of their own; every range the
+		// meshlet table references must lie inside them
+		uint64_t meshletVertexCount = m_Header->Sections[SectionIndex(MeshFileSectionType::MeshletVertices)].Size / sizeof(uint32_t);
+		uint64_t meshletTriangleCount = m_Header->Sections[SectionIndex(MeshFileSectionType::MeshletTriangles)].Size / 3;
+		const MeshFileMeshlet* meshlets = GetMeshlets();
+		for (uint32_t i = 0; i < m_Header->MeshletCount; i++)
+		{
+			if (static_cast<uint64_t>(meshlets[i].VertexOffset) + meshlets[i].VertexCount > meshletVertexCount ||
+			    static_cast<uint64_t>(meshlets[i].TriangleOffset) + meshlets[i].TriangleCount > meshletTriangleCount)
+			{
+				HZ_ERROR("MeshFile: {} has an out-of-range meshlet", path);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	const unsigned char* MeshFile::GetSection(MeshFileSectionType type) const
+	{
+		const MeshFileSection& section = m_Header->Sections[SectionIndex(type)];
+		return section.Size > 0 ? m_File.GetData() + section.Offset : nullptr;
+	}
+
+	BufferLayout MeshFile::GetLayout() const
+	{
+		std::vector<BufferElement> elements;
+		elements.reserve(m_Header->AttributeCount);
+		for (uint32_t i = 0; i < m_Header->AttributeCount; i++)
+		{
+			const MeshFileAttribute& attribute = m_Header->Attributes[i];
+			std::string name(attribute.Name, strnlen(attribute.Name, sizeof(attribute.Name)));
+			elements.emplace_back(static_cast<ShaderDataType>(attribute.Type), name, attribute.Normalized != 0);
+		}
+		return BufferLayout(elements);
+	}
+
+	const void* MeshFile::GetVertexData() const
+	{
+		return GetSection(MeshFileSectionType::Vertices);
+	}
+
+	size_t MeshFile::GetVertexDataSize() const
+	{
+		return static_cast<size_t>(m_Header->Sections[SectionIndex(MeshFileSectionType::Vertices)].Size);
+	}
+
+	const uint32_t* MeshFile::GetIndices() const
+	{
+		return reinterpret_cast<const uint32_t*>(GetSection(MeshFileSectionType::Indices));
+	}
+
+	const MeshFileLOD* MeshFile::GetLODs() const
+	{
+		return reinterpret_cast<const MeshFileLOD*>(GetSection(MeshFileSectionType::LODs));
+	}
+
+	const MeshFileMeshlet* MeshFile::GetMeshlets() const
+	{
+		return reinterpret_cast<const MeshFileMeshlet*>(GetSection(MeshFileSectionType::Meshlets));
+	}
+
+	const uint32_t* MeshFile::GetMeshletVertices() const
+	{
+		return reinterpret_cast<const uint32_t*>(GetSection(MeshFileSectionType::MeshletVertices));
+	}
+
+	const uint8_t* MeshFile::GetMeshletTriangles() const
+	{
+		return GetSection(MeshFileSectionType::MeshletTriangles);
+	}
+
+	std::shared_ptr<Mesh> MeshFile::CreateMesh() const
+	{
+		if (!IsOpen())
+			return nullptr;
+
+		// glBufferData reads straight out of the mapping; pages fault in as the driver copies
+		auto mesh = std::make_shared<Mesh>(static_cast<const float*>(GetVertexData()),
+		                                   static_cast<unsigned int>(GetVertexDataSize()),
+		                                   GetIndices(), m_Header->IndexCount, GetLayout());
+
+		if (m_Header->LODCount > 0)
+		{
+			std::vector<MeshLOD> lods;
+			lods.reserve(m_Header->LODCount);
+			const MeshFileLOD* fileLODs = GetLODs();
+			std::vector<bool> seen(m_Header->VertexCount);
+			for (uint32_t i = 0; i < m_Header->LODCount; i++)
+			{
+				const MeshFileLOD& lod = fileLODs[i];
+				lods.push_back({ lod.IndexOffset, lod.IndexCount, lod.Error,
+				                 CountVertices(GetIndices() + lod.IndexOffset, lod.IndexCount, seen) });
+			}
+			mesh->SetLODs(lods);
+		}
+
+		return mesh;
+	}
+
+	std::shared_ptr<Mesh> MeshFile::Load(const std::string& path)
+	{
+		MeshFile file;
+		if (!file.Open(path))
+			return nullptr;
+
+		return file.CreateMesh();
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Writing //////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	bool MeshFile::Write(const std::string& path, const MeshData& data, const MeshFileWriteOptions& options)
+	{
+		return Write(path, data.Vertices.data(), static_cast<unsigned int>(data.Vertices.size() / MeshSize::FloatsPerVertex),
+		             Mesh::GetDefaultLayout(), data.Indices.data(), static_cast<unsigned int>(data.Indices.size()), options);
+	}
+
+	bool MeshFile::Write(const std::string& path, const void* vertices, unsigned int vertexCount,
+	                     const BufferLayout& layout, const unsigned int* indices, unsigned int indexCount,
+	                     const MeshFileWriteOptions& options)
+	{
+		const auto& elements = layout.GetElements();
+		if (elements.empty() || elements.size() > MeshFileMaxAttributes)
+		{
+			HZ_ERROR("MeshFile::Write - layout must have between 1 and {} attributes", MeshFileMaxAttributes);
+			return false;
+		}
+
+		// Prefer an attribute called *Position*, otherwise the first Float3
+		const BufferElement* position = nullptr;
+		for (const auto& element : elements)
+		{
+			if (element.Type != ShaderDataType::Float3)
+				continue;
+			if (!position || element.Name.find("Position") != std::string::npos)
+				position = &element;
+			if (element.Name.find("Position") != std::string::npos)
+				break;
+		}
+		if (!position)
+		{
+			HZ_ERROR("MeshFile::Write - layout has no Float3 position attribute");
+			return false;
+		}
+
+		for (uint32_t i = 0; i < indexCount; i++)
+		{
+			if (indices[i] >= vertexCount)
+			{
+				HZ_ERROR("MeshFile::Write - index out of range");
+				return false;
+			}
+		}
+
+		MeshFileHeader header;
+		std::memset(&header, 0, sizeof(header));
+		header.Magic = MeshFileMagic;
+		header.Version = MeshFileVersion;
+		header.HeaderSize = sizeof(MeshFileHeader);
+		header.VertexStride = layout.GetStride();
+		header.AttributeCount = static_cast<uint32_t>(elements.size());
+		header.VertexCount = vertexCount;
+
+		for (size_t i = 0; i < elements.size(); i++)
+		{
+			MeshFileAttribute& attribute = header.Attributes[i];
+			attribute.Type = static_cast<uint32_t>(elements[i].Type);
+			attribute.Offset = elements[i].Offset;
+			attribute.Normalized = elements[i].Normalized ? 1 : 0;
+			if (elements[i].Name.size() >= sizeof(attribute.Name))
+				HZ_WARN("MeshFile::Write - attribute name '{}' truncated", elements[i].Name);
+			std::strncpy(attribute.Name, elements[i].Name.c_str(), sizeof(attribute.Name) - 1);
+		}
+
+		PositionReader positions{ static_cast<const unsigned char*>(vertices), layout.GetStride(), position->Offset };
+		Bounds bounds = ComputeBounds(positions, VertexSequence{ vertexCount });
+		for (int i = 0; i < 3; i++)
+		{
+			header.BoundsMin[i] = bounds.Min[i];
+			header.BoundsMax[i] = bounds.Max[i];
+			header.BoundingSphere[i] = bounds.Center[i];
+		}
+		header.BoundingSphere[3] = bounds.Radius;
+
+		std::vector<uint32_t> allIndices;
+		std::vector<MeshFileLOD> lods;
+		BuildLODs(positions, vertexCount, bounds, indices, indexCount, options, allIndices, lods);
+		header.IndexCount = static_cast<uint32_t>(allIndices.size());
+		header.LODCount = static_cast<uint32_t>(lods.size());
+
+		std::vector<MeshFileMeshlet> meshlets;
+		std::vector<uint32_t> meshletVertices;
+		std::vector<uint8_t> meshletTriangles;
+		if (options.BuildMeshlets)
+			BuildMeshlets(positions, vertexCount, indices, indexCount, options, meshlets, meshletVertices, meshletTriangles);
+		header.MeshletCount = static_cast<uint32_t>(meshlets.size());
+
+		const void* blobs[] = {
+			vertices, allIndices.data(), lods.data(),
+			meshlets.data(), meshletVertices.data(), meshletTriangles.data()
+		};
+		const uint64_t sizes[] = {
+			static_cast<uint64_t>(vertexCount) * layout.GetStride(),
+			allIndices.size() * sizeof(uint32_t),
+			lods.size() * sizeof(MeshFileLOD),
+			meshlets.size() * sizeof(MeshFileMeshlet),
+			meshletVertices.size() * sizeof(uint32_t),
+			meshletTriangles.size()
+		};
+
+		uint64_t offset = sizeof(MeshFileHeader);
+		for (uint32_t i = 0; i < SectionIndex(MeshFileSectionType::Count); i++)
+		{
+			offset = AlignOffset(offset);
+			header.Sections[i].Offset = offset;
+			header.Sections[i].Size = sizes[i];
+			offset += sizes[i];
+		}
+
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		if (!stream)
+		{
+			HZ_ERROR("MeshFile::Write - failed to create {}", path);
+			return false;
+		}
+
+		bool ok = WriteBlob(stream, &header, sizeof(header), 0);
+		for (uint32_t i = 0; ok && i < SectionIndex(MeshFileSectionType::Count); i++)
+			ok = WriteBlob(stream, blobs[i], sizes[i], header.Sections[i].Offset);
+
+		if (!ok)
+		{
+			HZ_ERROR("MeshFile::Write - failed writing {}", path);
+			return false;
+		}
+
+		HZ_INFO("MeshFile: wrote {} ({} vertices, {} LODs, {} meshlets)", path, vertexCount, lods.size(), meshlets.size());
+		return true;
+	}
+
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "../Core.h"
+#include "../MappedFile.h"
+#include "Buffer.h"
+#include "Mesh.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Hazel {
+
+	// .hmesh - GPU-ready mesh container
+	//
+	// The file is a fixed header followed by 16-byte aligned blobs. The vertex
+	// blob is interleaved exactly as described by the stored BufferLayout and the
+	// index blob is uint32, so both can be handed to the GPU straight from the
+	// memory mapping. All values are little-endian.
+	//
+	//   MeshFileHeader
+	//   Vertices          VertexCount * VertexStride bytes
+	//   Indices           uint32[IndexCount], every LOD concatenated (LOD 0 first)
+	//   LODs              MeshFileLOD[LODCount]
+	//   Meshlets          MeshFileMeshlet[MeshletCount] (built from LOD 0)
+	//   MeshletVertices   uint32 indices into the vertex blob
+	//   MeshletTriangles  uint8 triplets of meshlet-local vertex indices
+
+	static constexpr uint32_t MeshFileMagic = 0x48534D48; // "HMSH"
+	static constexpr uint32_t MeshFileVersion = 1;
+	static constexpr uint32_t MeshFileMaxAttributes = 8;
+	static constexpr uint32_t MeshFileAlignment = 16;
+
+	enum class MeshFileSectionType : uint32_t
+	{
+		Vertices = 0, Indices, LODs, Meshlets, MeshletVertices, MeshletTriangles, Count
+	};
+
+	struct MeshFileAttribute
+	{
+		uint32_t Type;       // ShaderDataType
+		uint32_t Offset;     // Byte offset inside a vertex
+		uint32_t Normalized;
+		char Name[20];       // Null-terminated shader attribute name
+	};
+
+	struct MeshFileLOD
+	{
+		uint32_t IndexOffset; // First index inside the index blob
+		uint32_t IndexCount;
+		float Error;          // Simplification error relative to the bounds diagonal
+		uint32_t Reserved;
+	};
+
+	struct MeshFileMeshlet
+	{
+		uint32_t VertexOffset;   // Into the MeshletVertices blob
+		uint32_t TriangleOffset; // Into the MeshletTriangles blob, in triangles
+		uint32_t VertexCount;
+		uint32_t TriangleCount;
+		float Center[3];         // Bounding sphere
+		float Radius;
+	};
+
+	struct MeshFileSection
+	{
+		uint64_t Offset;
+		uint64_t Size;
+	};
+
+	struct MeshFileHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t HeaderSize;
+		uint32_t Flags;
+
+		uint32_t VertexStride;
+		uint32_t AttributeCount;
+		uint32_t VertexCount;
+		uint32_t IndexCount;
+
+		uint32_t LODCount;
+		uint32_t MeshletCount;
+		uint32_t Reserved[2];
+
+		float BoundsMin[3];
+		float BoundsMax[3];
+		float BoundingSphere[4]; // center.xyz, radius
+		uint32_t Padding[2];
+
+		MeshFileAttribute Attributes[MeshFileMaxAttributes];
+		MeshFileSection Sections[static_cast<uint32_t>(MeshFileSectionType::Count)];
+	};
+
+	static_assert(sizeof(MeshFileAttribute) == 32, "MeshFileAttribute layout changed");
+	static_assert(sizeof(MeshFileLOD) == 16, "MeshFileLOD layout changed");
+	static_assert(sizeof(MeshFileMeshlet) == 32, "MeshFileMeshlet layout changed");
+	static_assert(sizeof(MeshFileHeader) == 448, "MeshFileHeader layout changed");
+	static_assert(sizeof(MeshFileHeader) % MeshFileAlignment == 0, "Header must keep blobs aligned");
+
+	struct MeshFileWriteOptions
+	{
+		unsigned int MaxLODs = 4;          // Including LOD 0
+		float LODTriangleRatio = 0.5f;     // Target triangle ratio between consecutive LODs
+		bool BuildMeshlets = true;
+		unsigned int MeshletMaxVertices = 64;
+		unsigned int MeshletMaxTriangles = 124;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about STL types in DLL interface
+#endif
+
+	// Reader for .hmesh files. Open() maps the file and validates the header;
+	// every accessor afterwards points straight into the mapping, so nothing is
+	// parsed or copied on the CPU before the GPU upload.
+	class HAZEL_API MeshFile
+	{
+	public:
+		MeshFile() = default;
+
+		bool Open(const std::string& path);
+		void Close();
+		bool IsOpen() const { return m_Header != nullptr; }
+
+		const MeshFileHeader& GetHeader() const { return *m_Header; }
+		BufferLayout GetLayout() const;
+
+		const void* GetVertexData() const;
+		size_t GetVertexDataSize() const;
+		const uint32_t* GetIndices() const;
+		uint32_t GetIndexCount() const { return m_Header->IndexCount; }
+
+		const MeshFileLOD* GetLODs() const;
+		uint32_t GetLODCount() const { return m_Header->LODCount; }
+
+		const MeshFileMeshlet* GetMeshlets() const;
+		uint32_t GetMeshletCount() const { return m_Header->MeshletCount; }
+		const uint32_t* GetMeshletVertices() const;
+		const uint8_t* GetMeshletTriangles() const;
+
+		// Uploads the vertex and index blobs directly from the mapping
+		std::shared_ptr<Mesh> CreateMesh() const;
+
+		// Convenience: open, upload and unmap in one go
+		static std::shared_ptr<Mesh> Load(const std::string& path);
+
+		// Writes an interleaved mesh as .hmesh, generating bounds, LODs and meshlets.
+		// The layout must contain a Float3 position attribute.
+		static bool Write(const std::string& path, const void* vertices, unsigned int vertexCount,
+		                  const BufferLayout& layout, const unsigned int* indices, unsigned int indexCount,
+		                  const MeshFileWriteOptions& options = MeshFileWriteOptions());
+		static bool Write(const std::string& path, const MeshData& data,
+		                  const MeshFileWriteOptions& options = MeshFileWriteOptions());
+
+	private:
+		bool Validate() const;
+		const unsigned char* GetSection(MeshFileSectionType type) const;
+
+	private:
+		MappedFile m_File;
+		const MeshFileHeader* m_Header = nullptr;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
@@ -1,4 +1,6 @@
 #include "MeshGenerator.h"
+#include "../Threading/JobSystem.h"
+#include <algorithm>
 #include <cmath>
 
 namespace Hazel {
@@ -6,13 +8,188 @@ namespace Hazel {
 	// Use a portable definition of PI
 	constexpr double PI = 3.14159265358979323846;
 
-	MeshData MeshGenerator::CreateCube(float size)
+	// Below this many vertices per job, scheduling costs more than it saves
+	static constexpr int s_MinVerticesPerJob = 16384;
+
+	// Runs func(begin, end) over row ranges of [0, rowCount) on the job system,
+	// sized so each range holds at least s_MinVerticesPerJob vertices. Each row
+	// must write a disjoint output range.
+	template<typename Func>
+	static void ParallelForRows(int rowCount, int verticesPerRow, const Func& func)
+	{
+		size_t minRows = static_cast<size_t>((std::max)(s_MinVerticesPerJob / (std::max)(verticesPerRow, 1), 1));
+		JobSystem::ParallelFor(static_cast<size_t>(rowCount), minRows, [&func](size_t begin, size_t end)
+		{
+			func(static_cast<int>(begin), static_cast<int>(end));
+		});
+	}
+
+	static int ClampSegments(int segments)
+	{
+		return (std::max)(segments, 3);
+	}
+
+	// cos/sin of k * 2PI / segments for k = 0..segments using the angle-addition
+	// recurrence, so only one sin/cos pair is evaluated per ring instead of per vertex
+	static void BuildUnitCircle(int segments, float* cosTable, float* sinTable)
+	{
+		const double step = 2.0 * PI / segments;
+		const double cosStep = std::cos(step);
+		const double sinStep = std::sin(step);
+
+		double c = 1.0;
+		double s = 0.0;
+		for (int k = 0; k < segments; k++)
+		{
+			cosTable[k] = static_cast<float>(c);
+			sinTable[k] = static_cast<float>(s);
+
+			double next = c * cosStep - s * sinStep;
+			s = s * cosStep + c * sinStep;
+			c = next;
+		}
+
+		// Close the seam exactly
+		cosTable[segments] = 1.0f;
+		sinTable[segments] = 0.0f;
+	}
+
+	// Writes one latitude ring (segments + 1 vertices) of a sphere
+	static void WriteRing(float* out, float sinTheta, float cosTheta, float radius, float yOffset,
+	                      const float* cosPhi, const float* sinPhi, int segments)
+	{
+		for (int lon = 0; lon <= segments; lon++)
+		{
+			float x = cosPhi[lon] * sinTheta;
+			float y = cosTheta;
+			float z = sinPhi[lon] * sinTheta;
+
+			// Position
+			out[0] = x * radius;
+			out[1] = y * radius + yOffset;
+			out[2] = z * radius;
+
+			// Normal (same as position for unit sphere)
+			out[3] = x;
+			out[4] = y;
+			out[5] = z;
+			out += MeshSize::FloatsPerVertex;
+		}
+	}
+
+	// Writes the two triangles of every quad between ring 'row' and 'row + 1'
+	static void WriteGridRowIndices(unsigned int* out, unsigned int baseVertex, int row, int quadsPerRow)
+	{
+		unsigned int stride = static_cast<unsigned int>(quadsPerRow) + 1;
+		for (int col = 0; col < quadsPerRow; col++)
+		{
+			unsigned int first = baseVertex + row * stride + col;
+			unsigned int second = first + stride;
+
+			out[0] = first;
+			out[1] = second;
+			out[2] = first + 1;
+
+			out[3] = second;
+			out[4] = second + 1;
+			out[5] = first + 1;
+			out += 6;
+		}
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Sizes ////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	MeshSize MeshGenerator::GetCubeSize()
+	{
+		MeshSize size;
+		size.VertexCount = 24;
+		size.IndexCount = 36;
+		return size;
+	}
+
+	MeshSize MeshGenerator::GetSphereSize(int segments)
+	{
+		segments = ClampSegments(segments);
+
+		MeshSize size;
+		size.VertexCount = static_cast<unsigned int>((segments + 1) * (segments + 1));
+		size.IndexCount = static_cast<unsigned int>(segments * segments * 6);
+		return size;
+	}
+
+	MeshSize MeshGenerator::GetCapsuleSize(int segments)
+	{
+		segments = ClampSegments(segments);
+		int hemisphereSegments = segments / 2;
+
+		MeshSize size;
+		size.VertexCount = static_cast<unsigned int>((segments + 1) * 2 + 2 * (hemisphereSegments + 1) * (segments + 1));
+		size.IndexCount = static_cast<unsigned int>(segments * 6 + 2 * hemisphereSegments * segments * 6);
+		return size;
+	}
+
+	MeshSize MeshGenerator::GetTerrainSize(const TerrainSettings& settings)
+	{
+		int resolution = (std::max)(settings.Resolution, 1);
+
+		MeshSize size;
+		size.VertexCount = static_cast<unsigned int>((resolution + 1) * (resolution + 1));
+		size.IndexCount = static_cast<unsigned int>(resolution * resolution * 6);
+		return size;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// MeshData wrappers ////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	static MeshData AllocateMeshData(const MeshSize& size)
 	{
 		MeshData meshData;
+		meshData.Vertices.resize(size.GetVertexFloatCount());
+		meshData.Indices.resize(size.IndexCount);
+		return meshData;
+	}
+
+	MeshData MeshGenerator::CreateCube(float size)
+	{
+		MeshData meshData = AllocateMeshData(GetCubeSize());
+		GenerateCube(size, meshData.Vertices.data(), meshData.Indices.data());
+		return meshData;
+	}
+
+	MeshData MeshGenerator::CreateSphere(float radius, int segments)
+	{
+		MeshData meshData = AllocateMeshData(GetSphereSize(segments));
+		GenerateSphere(radius, segments, meshData.Vertices.data(), meshData.Indices.data());
+		return meshData;
+	}
+
+	MeshData MeshGenerator::CreateCapsule(float height, float radius, int segments)
+	{
+		MeshData meshData = AllocateMeshData(GetCapsuleSize(segments));
+		GenerateCapsule(height, radius, segments, meshData.Vertices.data(), meshData.Indices.data());
+		return meshData;
+	}
+
+	MeshData MeshGenerator::CreateTerrain(const TerrainSettings& settings)
+	{
+		MeshData meshData = AllocateMeshData(GetTerrainSize(settings));
+		GenerateTerrain(settings, meshData.Vertices.data(), meshData.Indices.data());
+		return meshData;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Generators ///////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	void MeshGenerator::GenerateCube(float size, float* vertices, unsigned int* indices)
+	{
 		float halfSize = size * 0.5f;
 
 		// Cube vertices with positions and normals
-		float vertices[] = {
+		const float cubeVertices[] = {
 			// Front face (Z+)
 			-halfSize, -halfSize,  halfSize,  0.0f,  0.0f,  1.0f,
 			 halfSize, -halfSize,  halfSize,  0.0f,  0.0f,  1.0f,
@@ -50,7 +227,7 @@ namespace Hazel {
 			-halfSize,  halfSize,  halfSize,  0.0f,  1.0f,  0.0f,
 		};
 
-		unsigned int indices[] = {
+		const unsigned int cubeIndices[] = {
 			0, 1, 2, 2, 3, 0,       // front
 			4, 5, 6, 6, 7, 4,       // back
 			8, 9, 10, 10, 11, 8,    // left
@@ -59,207 +236,226 @@ namespace Hazel {
 			20, 21, 22, 22, 23, 20  // top
 		};
 
-		meshData.Vertices.assign(vertices, vertices + sizeof(vertices) / sizeof(float));
-		meshData.Indices.assign(indices, indices + sizeof(indices) / sizeof(unsigned int));
-
-		return meshData;
+		std::copy(std::begin(cubeVertices), std::end(cubeVertices), vertices);
+		std::copy(std::begin(cubeIndices), std::end(cubeIndices), indices);
 	}
 
-	MeshData MeshGenerator::CreateSphere(float radius, int segments)
+	void MeshGenerator::GenerateSphere(float radius, int segments, float* vertices, unsigned int* indices)
 	{
-		MeshData meshData;
+		segments = ClampSegments(segments);
+		const int ringFloats = (segments + 1) * MeshSize::FloatsPerVertex;
 
-		// Generate sphere using UV sphere method
-		for (int lat = 0; lat <= segments; lat++)
-		{
-			float theta = lat * PI / segments;
-			float sinTheta = sin(theta);
-			float cosTheta = cos(theta);
-
-			for (int lon = 0; lon <= segments; lon++)
-			{
-				float phi = lon * 2.0f * PI / segments;
-				float sinPhi = sin(phi);
-				float cosPhi = cos(phi);
-
-				float x = cosPhi * sinTheta;
-				float y = cosTheta;
-				float z = sinPhi * sinTheta;
-
-				// Position
-				meshData.Vertices.push_back(x * radius);
-				meshData.Vertices.push_back(y * radius);
-				meshData.Vertices.push_back(z * radius);
-
-				// Normal (same as position for unit sphere)
-				meshData.Vertices.push_back(x);
-				meshData.Vertices.push_back(y);
-				meshData.Vertices.push_back(z);
-			}
-		}
+		std::vector<float> circle((segments + 1) * 2);
+		float* cosPhi = circle.data();
+		float* sinPhi = circle.data() + segments + 1;
+		BuildUnitCircle(segments, cosPhi, sinPhi);
 
-		// Generate indices
-		for (int lat = 0; lat < segments; lat++)
+		// Generate sphere using UV sphere method, one latitude ring per row
+		ParallelForRows(segments + 1, segments + 1, [&](int begin, int end)
 		{
-			for (int lon = 0; lon < segments; lon++)
+			for (int lat = begin; lat < end; lat++)
 			{
-				int first = (lat * (segments + 1)) + lon;
-				int second = first + segments + 1;
+				double theta = lat * PI / segments;
+				WriteRing(vertices + lat * ringFloats,
+				          static_cast<float>(std::sin(theta)), static_cast<float>(std::cos(theta)),
+				          radius, 0.0f, cosPhi, sinPhi, segments);
 
-				meshData.Indices.push_back(first);
-				meshData.Indices.push_back(second);
-				meshData.Indices.push_back(first + 1);
-
-				meshData.Indices.push_back(second);
-				meshData.Indices.push_back(second + 1);
-				meshData.Indices.push_back(first + 1);
+				if (lat < segments)
+					WriteGridRowIndices(indices + lat * segments * 6, 0, lat, segments);
 			}
-		}
-
-		return meshData;
+		});
 	}
 
-	MeshData MeshGenerator::CreateCapsule(float height, float radius, int segments)
+	void MeshGenerator::GenerateCapsule(float height, float radius, int segments, float* vertices, unsigned int* indices)
 	{
-		MeshData meshData;
-
-		float halfHeight = height * 0.5f;
-
-		// Generate cylinder portion
+		segments = ClampSegments(segments);
+		const int hemisphereSegments = segments / 2;
+		const int ringFloats = (segments + 1) * MeshSize::FloatsPerVertex;
+		const float halfHeight = height * 0.5f;
+
+		std::vector<float> circle((segments + 1) * 2);
+		float* cosPhi = circle.data();
+		float* sinPhi = circle.data() + segments + 1;
+		BuildUnitCircle(segments, cosPhi, sinPhi);
+
+		// Generate cylinder portion (top and bottom vertex interleaved per column)
+		float* out = vertices;
 		for (int i = 0; i <= segments; i++)
 		{
-			float angle = i * 2.0f * PI / segments;
-			float x = cos(angle);
-			float z = sin(angle);
+			float x = cosPhi[i];
+			float z = sinPhi[i];
 
 			// Top circle vertex
-			meshData.Vertices.push_back(x * radius);
-			meshData.Vertices.push_back(halfHeight);
-			meshData.Vertices.push_back(z * radius);
-			meshData.Vertices.push_back(x);
-			meshData.Vertices.push_back(0.0f);
-			meshData.Vertices.push_back(z);
+			out[0] = x * radius; out[1] = halfHeight;  out[2] = z * radius;
+			out[3] = x;          out[4] = 0.0f;        out[5] = z;
 
 			// Bottom circle vertex
-			meshData.Vertices.push_back(x * radius);
-			meshData.Vertices.push_back(-halfHeight);
-			meshData.Vertices.push_back(z * radius);
-			meshData.Vertices.push_back(x);
-			meshData.Vertices.push_back(0.0f);
-			meshData.Vertices.push_back(z);
+			out[6] = x * radius; out[7] = -halfHeight; out[8] = z * radius;
+			out[9] = x;          out[10] = 0.0f;       out[11] = z;
+			out += MeshSize::FloatsPerVertex * 2;
 		}
 
 		// Generate cylinder indices
+		unsigned int* indexOut = indices;
 		for (int i = 0; i < segments; i++)
 		{
-			int topLeft = i * 2;
-			int bottomLeft = i * 2 + 1;
-			int topRight = ((i + 1) % (segments + 1)) * 2;
-			int bottomRight = ((i + 1) % (segments + 1)) * 2 + 1;
-
-			meshData.Indices.push_back(topLeft);
-			meshData.Indices.push_back(bottomLeft);
-			meshData.Indices.push_back(topRight);
-
-			meshData.Indices.push_back(topRight);
-			meshData.Indices.push_back(bottomLeft);
-			meshData.Indices.push_back(bottomRight);
+			unsigned int topLeft = i * 2;
+			unsigned int bottomLeft = i * 2 + 1;
+			unsigned int topRight = ((i + 1) % (segments + 1)) * 2;
+			unsigned int bottomRight = ((i + 1) % (segments + 1)) * 2 + 1;
+
+			indexOut[0] = topLeft;
+			indexOut[1] = bottomLeft;
+			indexOut[2] = topRight;
+
+			indexOut[3] = topRight;
+			indexOut[4] = bottomLeft;
+			indexOut[5] = bottomRight;
+			indexOut += 6;
 		}
 
-		int cylinderVertexCount = (segments + 1) * 2;
+		const unsigned int cylinderVertexCount = (segments + 1) * 2;
+		const unsigned int hemisphereVertexCount = (hemisphereSegments + 1) * (segments + 1);
+		const int hemisphereRows = hemisphereSegments + 1;
+		const int hemisphereIndexCount = hemisphereSegments * segments * 6;
 
-		// Generate top hemisphere
-		int hemisphereSegments = segments / 2;
-		for (int lat = 0; lat <= hemisphereSegments; lat++)
-		{
-			float theta = lat * PI * 0.5f / hemisphereSegments;
-			float sinTheta = sin(theta);
-			float cosTheta = cos(theta);
-
-			for (int lon = 0; lon <= segments; lon++)
-			{
-				float phi = lon * 2.0f * PI / segments;
-				float sinPhi = sin(phi);
-				float cosPhi = cos(phi);
-
-				float x = cosPhi * sinTheta;
-				float y = cosTheta;
-				float z = sinPhi * sinTheta;
-
-				meshData.Vertices.push_back(x * radius);
-				meshData.Vertices.push_back(y * radius + halfHeight);
-				meshData.Vertices.push_back(z * radius);
-				meshData.Vertices.push_back(x);
-				meshData.Vertices.push_back(y);
-				meshData.Vertices.push_back(z);
-			}
-		}
+		float* hemisphereVertices = vertices + cylinderVertexCount * MeshSize::FloatsPerVertex;
+		unsigned int* hemisphereIndices = indices + segments * 6;
 
-		// Generate top hemisphere indices
-		for (int lat = 0; lat < hemisphereSegments; lat++)
+		// Both hemispheres are generated as one row range: top rows first, then bottom
+		ParallelForRows(hemisphereRows * 2, segments + 1, [&](int begin, int end)
 		{
-			for (int lon = 0; lon < segments; lon++)
+			for (int row = begin; row < end; row++)
 			{
-				int first = cylinderVertexCount + (lat * (segments + 1)) + lon;
-				int second = first + segments + 1;
+				bool bottom = row >= hemisphereRows;
+				int lat = bottom ? row - hemisphereRows : row;
+
+				double theta = lat * PI * 0.5 / hemisphereSegments;
+				float sinTheta = static_cast<float>(std::sin(theta));
+				float cosTheta = static_cast<float>(std::cos(theta));
+
+				WriteRing(hemisphereVertices + row * ringFloats, sinTheta,
+				          bottom ? -cosTheta : cosTheta, radius,
+				          bottom ? -halfHeight : halfHeight, cosPhi, sinPhi, segments);
+
+				if (lat < hemisphereSegments)
+				{
+					unsigned int baseVertex = cylinderVertexCount + (bottom ? hemisphereVertexCount : 0);
+					unsigned int* rowIndices = hemisphereIndices + (bottom ? hemisphereIndexCount : 0) + lat * segments * 6;
+					WriteGridRowIndices(rowIndices, baseVertex, lat, segments);
+				}
+			}
+		});
+	}
 
-				meshData.Indices.push_back(first);
-				meshData.Indices.push_back(second);
-				meshData.Indices.push_back(first + 1);
+	/////////////////////////////////////////////////////////////////////////////
+	// Terrain //////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
 
-				meshData.Indices.push_back(second);
-				meshData.Indices.push_back(second + 1);
-				meshData.Indices.push_back(first + 1);
-			}
-		}
+	// Integer lattice hash mapped to [0, 1)
+	static float LatticeValue(int x, int z, uint32_t seed)
+	{
+		uint32_t h = seed;
+		h ^= static_cast<uint32_t>(x) * 0x27d4eb2du;
+		h ^= static_cast<uint32_t>(z) * 0x165667b1u;
+		h = (h ^ (h >> 15)) * 0x85ebca6bu;
+		h = (h ^ (h >> 13)) * 0xc2b2ae35u;
+		h ^= h >> 16;
+		return static_cast<float>(h & 0x00ffffffu) / static_cast<float>(0x01000000u);
+	}
 
-		int topHemisphereVertexCount = (hemisphereSegments + 1) * (segments + 1);
+	static float ValueNoise(float x, float z, uint32_t seed)
+	{
+		float fx = std::floor(x);
+		float fz = std::floor(z);
+		int ix = static_cast<int>(fx);
+		int iz = static_cast<int>(fz);
+
+		// Smoothstep fade
+		float tx = x - fx;
+		float tz = z - fz;
+		tx = tx * tx * (3.0f - 2.0f * tx);
+		tz = tz * tz * (3.0f - 2.0f * tz);
+
+		float v00 = LatticeValue(ix, iz, seed);
+		float v10 = LatticeValue(ix + 1, iz, seed);
+		float v01 = LatticeValue(ix, iz + 1, seed);
+		float v11 = LatticeValue(ix + 1, iz + 1, seed);
+
+		float a = v00 + (v10 - v00) * tx;
+		float b = v01 + (v11 - v01) * tx;
+		return a + (b - a) * tz;
+	}
 
-		// Generate bottom hemisphere
-		for (int lat = 0; lat <= hemisphereSegments; lat++)
+	static float FractalNoise(float x, float z, const TerrainSettings& settings)
+	{
+		float sum = 0.0f;
+		float amplitude = 1.0f;
+		float frequency = settings.Frequency;
+		float norm = 0.0f;
+		for (int octave = 0; octave < settings.Octaves; octave++)
 		{
-			float theta = lat * PI * 0.5f / hemisphereSegments;
-			float sinTheta = sin(theta);
-			float cosTheta = cos(theta);
+			sum += amplitude * (ValueNoise(x * frequency, z * frequency, settings.Seed + octave) * 2.0f - 1.0f);
+			norm += amplitude;
+			amplitude *= 0.5f;
+			frequency *= 2.0f;
+		}
+		return norm > 0.0f ? sum / norm : 0.0f;
+	}
 
-			for (int lon = 0; lon <= segments; lon++)
+	void MeshGenerator::GenerateTerrain(const TerrainSettings& settings, float* vertices, unsigned int* indices)
+	{
+		const int resolution = (std::max)(settings.Resolution, 1);
+		const int side = resolution + 1;
+		const float step = settings.Size / resolution;
+		const float origin = -settings.Size * 0.5f;
+
+		// Heights are kept in a side buffer: the output may be write-only mapped memory
+		std::vector<float> heights(static_cast<size_t>(side) * side);
+		ParallelForRows(side, side, [&](int begin, int end)
+		{
+			for (int z = begin; z < end; z++)
 			{
-				float phi = lon * 2.0f * PI / segments;
-				float sinPhi = sin(phi);
-				float cosPhi = cos(phi);
-
-				float x = cosPhi * sinTheta;
-				float y = -cosTheta;
-				float z = sinPhi * sinTheta;
-
-				meshData.Vertices.push_back(x * radius);
-				meshData.Vertices.push_back(y * radius - halfHeight);
-				meshData.Vertices.push_back(z * radius);
-				meshData.Vertices.push_back(x);
-				meshData.Vertices.push_back(y);
-				meshData.Vertices.push_back(z);
+				float worldZ = origin + z * step;
+				for (int x = 0; x < side; x++)
+				{
+					float worldX = origin + x * step;
+					heights[z * side + x] = FractalNoise(worldX, worldZ, settings) * settings.HeightScale;
+				}
 			}
-		}
+		});
 
-		// Generate bottom hemisphere indices
-		for (int lat = 0; lat < hemisphereSegments; lat++)
+		ParallelForRows(side, side, [&](int begin, int end)
 		{
-			for (int lon = 0; lon < segments; lon++)
+			for (int z = begin; z < end; z++)
 			{
-				int first = cylinderVertexCount + topHemisphereVertexCount + (lat * (segments + 1)) + lon;
-				int second = first + segments + 1;
-
-				meshData.Indices.push_back(first);
-				meshData.Indices.push_back(second);
-				meshData.Indices.push_back(first + 1);
-
-				meshData.Indices.push_back(second);
-				meshData.Indices.push_back(second + 1);
-				meshData.Indices.push_back(first + 1);
+				float* out = vertices + static_cast<size_t>(z) * side * MeshSize::FloatsPerVertex;
+				int z0 = (std::max)(z - 1, 0);
+				int z1 = (std::min)(z + 1, resolution);
+
+				for (int x = 0; x < side; x++)
+				{
+					int x0 = (std::max)(x - 1, 0);
+					int x1 = (std::min)(x + 1, resolution);
+
+					// Central differences (one-sided at the borders)
+					float dhdx = (heights[z * side + x1] - heights[z * side + x0]) / ((x1 - x0) * step);
+					float dhdz = (heights[z1 * side + x] - heights[z0 * side + x]) / ((z1 - z0) * step);
+					glm::vec3 normal = glm::normalize(glm::vec3(-dhdx, 1.0f, -dhdz));
+
+					out[0] = origin + x * step;
+					out[1] = heights[z * side + x];
+					out[2] = origin + z * step;
+					out[3] = normal.x;
+					out[4] = normal.y;
+					out[5] = normal.z;
+					out += MeshSize::FloatsPerVertex;
+				}
+
+				if (z < resolution)
+					WriteGridRowIndices(indices + static_cast<size_t>(z) * resolution * 6, 0, z, resolution);
 			}
-		}
-
-		return meshData;
+		});
 	}
 
 }
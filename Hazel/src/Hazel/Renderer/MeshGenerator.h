@@ -2,6 +2,7 @@
 
 #include "../Core.h"
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <vector>
 
 namespace Hazel {
@@ -12,6 +13,31 @@ namespace Hazel {
 		std::vector<unsigned int> Indices;
 	};
 
+	// Exact output size of a generator, known before any geometry is produced
+	struct MeshSize
+	{
+		unsigned int VertexCount = 0;
+		unsigned int IndexCount = 0;
+
+		// Every generator emits [position.xyz, normal.xyz] per vertex
+		static constexpr unsigned int FloatsPerVertex = 6;
+
+		unsigned int GetVertexFloatCount() const { return VertexCount * FloatsPerVertex; }
+		unsigned int GetVertexBytes() const { return GetVertexFloatCount() * sizeof(float); }
+		unsigned int GetIndexBytes() const { return IndexCount * sizeof(unsigned int); }
+	};
+
+	// Heightfield terrain parameters (fractal value noise)
+	struct TerrainSettings
+	{
+		float Size = 100.0f;       // World-space edge length, centered on the origin
+		int Resolution = 256;      // Quads per edge
+		float HeightScale = 10.0f;
+		float Frequency = 0.02f;   // Noise frequency in cycles per world unit
+		int Octaves = 5;
+		uint32_t Seed = 1337;
+	};
+
 	class HAZEL_API MeshGenerator
 	{
 	public:
@@ -27,6 +53,23 @@ namespace Hazel {
 		// height: height of the cylindrical portion
 		// radius: radius of the cylinder and hemispheres
 		static MeshData CreateCapsule(float height = 1.0f, float radius = 0.5f, int segments = 32);
+
+		// Generate a heightfield terrain in the XZ plane
+		static MeshData CreateTerrain(const TerrainSettings& settings);
+
+		// Exact vertex/index counts for each generator
+		static MeshSize GetCubeSize();
+		static MeshSize GetSphereSize(int segments);
+		static MeshSize GetCapsuleSize(int segments);
+		static MeshSize GetTerrainSize(const TerrainSettings& settings);
+
+		// Write a mesh straight into caller-provided storage (for example a mapped
+		// GPU buffer). vertices/indices must hold exactly Get*Size() elements.
+		// Large meshes are split into row ranges generated on worker threads.
+		static void GenerateCube(float size, float* vertices, unsigned int* indices);
+		static void GenerateSphere(float radius, int segments, float* vertices, unsigned int* indices);
+		static void GenerateCapsule(float height, float radius, int segments, float* vertices, unsigned int* indices);
+		static void GenerateTerrain(const TerrainSettings& settings, float* vertices, unsigned int* indices);
 	};
 
 }
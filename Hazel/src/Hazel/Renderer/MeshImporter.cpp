@@ -0,0 +1,1217 @@
+#include "MeshImporter.h"
+#include "../Log.h"
+#include "../MappedFile.h"
+#include "../Memory/MemoryTracker.h"
+#include "../Debug/Profiler.h"
+#include "../Threading/JobSystem.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Hazel {
+
+	namespace {
+
+		// Below this many bytes per chunk, splitting an OBJ costs more than it saves
+		constexpr size_t s_MinBytesPerChunk = 1 << 20;
+
+		// Runs func(i) for every i in [0, count) on the job system, one index per job
+		template<typename Func>
+		void ParallelForEach(size_t count, const Func& func)
+		{
+			JobSystem::ParallelFor(count, 1, [&func](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+					func(i);
+			});
+		}
+
+		std::string GetExtension(const std::string& path)
+		{
+			size_t dot = path.find_last_of('.');
+			if (dot == std::string::npos || path.find_first_of("/\\", dot) != std::string::npos)
+				return "";
+
+			std::string extension = path.substr(dot);
+			std::transform(extension.begin(), extension.end(), extension.begin(),
+			               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			return extension;
+		}
+
+		std::string GetDirectory(const std::string& path)
+		{
+			size_t slash = path.find_last_of("/\\");
+			return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+		}
+
+		void WriteVertex(MeshData& data, const glm::vec3& position, const glm::vec3& normal)
+		{
+			data.Vertices.insert(data.Vertices.end(), { position.x, position.y, position.z, normal.x, normal.y, normal.z });
+		}
+
+		// Area-weighted smooth normals for every vertex flagged in 'missing'
+		void GenerateMissingNormals(MeshData& data, const std::vector<uint8_t>& missing)
+		{
+			if (std::find(missing.begin(), missing.end(), 1) == missing.end())
+				return;
+
+			float* vertices = data.Vertices.data();
+			for (size_t i = 0; i + 2 < data.Indices.size(); i += 3)
+			{
+				unsigned int a = data.Indices[i], b = data.Indices[i + 1], c = data.Indices[i + 2];
+				glm::vec3 pa = glm::make_vec3(vertices + a * 6);
+				glm::vec3 pb = glm::make_vec3(vertices + b * 6);
+				glm::vec3 pc = glm::make_vec3(vertices + c * 6);
+				glm::vec3 faceNormal = glm::cross(pb - pa, pc - pa); // Length is twice the area
+
+				for (unsigned int vertex : { a, b, c })
+				{
+					if (!missing[vertex])
+						continue;
+					vertices[vertex * 6 + 3] += faceNormal.x;
+					vertices[vertex * 6 + 4] += faceNormal.y;
+					vertices[vertex * 6 + 5] += faceNormal.z;
+				}
+			}
+
+			for (size_t v = 0; v < missing.size(); v++)
+			{
+				if (!missing[v])
+					continue;
+
+				float* normal = vertices + v * 6 + 3;
+				glm::vec3 n = glm::make_vec3(normal);
+				float length = glm::length(n);
+				n = length > 0.0f ? n / length : glm::vec3(0.0f, 1.0f, 0.0f);
+				normal[0] = n.x;
+				normal[1] = n.y;
+				normal[2] = n.z;
+			}
+		}
+
+		void FinishImport(const std::string& path, const MeshData& data, size_t sourceBytes,
+		                  std::chrono::steady_clock::time_point start, MeshImportStats* outStats)
+		{
+			MeshImportStats stats;
+			stats.SourceBytes = sourceBytes;
+			stats.VertexCount = data.Vertices.size() / MeshSize::FloatsPerVertex;
+			stats.TriangleCount = data.Indices.size() / 3;
+			stats.Milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			HZ_INFO("MeshImporter: {} - {} vertices, {} triangles, {:.2} MB in {:.2} ms ({:.1} MB/s)",
+			        path, stats.VertexCount, stats.TriangleCount,
+			        stats.SourceBytes / (1024.0 * 1024.0), stats.Milliseconds, stats.GetThroughputMBps());
+
+			if (outStats)
+				*outStats = stats;
+		}
+
+		/////////////////////////////////////////////////////////////////////////////
+		// OBJ //////////////////////////////////////////////////////////////////////
+		/////////////////////////////////////////////////////////////////////////////
+
+		enum ObjCornerFlags : uint8_t
+		{
+			ObjPositionRelative = 1 << 0,
+			ObjNormalRelative   = 1 << 1,
+			ObjHasNormal        = 1 << 2
+		};
+
+		// Face corner as written in the file. Negative (relative) indices are stored
+		// relative to the start of the chunk until the chunk's base is known.
+		struct ObjCorner
+		{
+			int32_t Position;
+			int32_t Normal;
+			uint8_t Flags;
+		};
+
+		struct ObjChunk
+		{
+			const char* Begin = nullptr;
+			const char* End = nullptr;
+
+			std::vector<float> Positions;
+			std::vector<float> Normals;
+			std::vector<ObjCorner> Corners; // Triangulated, three per triangle
+
+			size_t PositionBase = 0;
+			size_t NormalBase = 0;
+			const char* ErrorAt = nullptr;
+		};
+
+		bool IsBlank(char c)
+		{
+			return c == ' ' || c == '\t';
+		}
+
+		const char* SkipBlanks(const char* p, const char* end)
+		{
+			while (p < end && IsBlank(*p))
+				p++;
+			return p;
+		}
+
+		bool ParseFloats(const char* p, const char* end, float* out, int count, std::vector<float>& target)
+		{
+			for (int i = 0; i < count; i++)
+			{
+				p = SkipBlanks(p, end);
+				if (p < end && *p == '+')
+					p++;
+				auto result = std::from_chars(p, end, out[i]);
+				if (result.ec != std::errc())
+					return false;
+				p = result.ptr;
+			}
+			target.insert(target.end(), out, out + count);
+			return true;
+		}
+
+		bool ParseObjIndex(const char*& p, const char* end, size_t localCount, int32_t& outIndex, bool& outRelative)
+		{
+			int value = 0;
+			auto result = std::from_chars(p, end, value);
+			if (result.ec != std::errc() || value == 0)
+				return false;
+
+			p = result.ptr;
+			outRelative = value < 0;
+			outIndex = value > 0 ? value - 1 : static_cast<int32_t>(localCount) + value;
+			return true;
+		}
+
+		bool ParseObjFace(const char* p, const char* end, ObjChunk& chunk)
+		{
+			ObjCorner first = {}, previous = {};
+			int cornerCount = 0;
+
+			while (true)
+			{
+				p = SkipBlanks(p, end);
+				if (p >= end || *p == '\r' || *p == '#')
+					break;
+
+				ObjCorner corner = {};
+				bool relative = false;
+				if (!ParseObjIndex(p, end, chunk.Positions.size() / 3, corner.Position, relative))
+					return false;
+				corner.Flags |= relative ? ObjPositionRelative : 0;
+
+				if (p < end && *p == '/')
+				{
+					p++;
+					// Texture coordinates are not part of MeshData; skip them
+					if (p < end && *p != '/')
+					{
+						int ignored;
+						auto result = std::from_chars(p, end, ignored);
+						if (result.ec != std::errc())
+							return false;
+						p = result.ptr;
+					}
+
+					if (p < end && *p == '/')
+					{
+						p++;
+						if (!ParseObjIndex(p, end, chunk.Normals.size() / 3, corner.Normal, relative))
+							return false;
+						corner.Flags |= ObjHasNormal | (relative ? ObjNormalRelative : 0);
+					}
+				}
+
+				if (p < end && !IsBlank(*p) && *p != '\r')
+					return false;
+
+				// Fan-triangulate polygons
+				if (cornerCount == 0)
+					first = corner;
+				else if (cornerCount >= 2)
+					chunk.Corners.insert(chunk.Corners.end(), { first, previous, corner });
+				previous = corner;
+				cornerCount++;
+			}
+
+			return cornerCount >= 3;
+		}
+
+		void ParseObjChunk(ObjChunk& chunk)
+		{
+			float values[3];
+			const char* p = chunk.Begin;
+			while (p < chunk.End)
+			{
+				const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', chunk.End - p));
+				if (!lineEnd)
+					lineEnd = chunk.End;
+
+				const char* line = SkipBlanks(p, lineEnd);
+				bool ok = true;
+				if (lineEnd - line >= 2 && IsBlank(line[1]))
+				{
+					if (line[0] == 'v')
+						ok = ParseFloats(line + 2, lineEnd, values, 3, chunk.Positions);
+					else if (line[0] == 'f')
+						ok = ParseObjFace(line + 2, lineEnd, chunk);
+				}
+				else if (lineEnd - line >= 3 && line[0] == 'v' && line[1] == 'n' && IsBlank(line[2]))
+				{
+					ok = ParseFloats(line + 3, lineEnd, values, 3, chunk.Normals);
+				}
+
+				if (!ok)
+				{
+					chunk.ErrorAt = line;
+					return;
+				}
+
+				p = lineEnd + 1;
+			}
+		}
+
+		bool ResolveObjIndex(int32_t index, bool relative, size_t base, size_t count, uint32_t& outIndex)
+		{
+			int64_t resolved = relative ? static_cast<int64_t>(base) + index : index;
+			if (resolved < 0 || static_cast<size_t>(resolved) >= count)
+				return false;
+
+			outIndex = static_cast<uint32_t>(resolved);
+			return true;
+		}
+
+		/////////////////////////////////////////////////////////////////////////////
+		// JSON (just enough for glTF) //////////////////////////////////////////////
+		/////////////////////////////////////////////////////////////////////////////
+
+		struct JsonValue
+		{
+			enum class Type { Null, Bool, Number, String, Array, Object };
+
+			Type Kind = Type::Null;
+			bool Bool = false;
+			double Number = 0.0;
+			std::string String;
+			std::vector<JsonValue> Array;
+			std::vector<std::pair<std::string, JsonValue>> Object;
+
+			const JsonValue* Find(const char* key) const
+			{
+				for (const auto& member : Object)
+					if (member.first == key)
+						return &member.second;
+				return nullptr;
+			}
+
+			double GetNumber(const char* key, double fallback) const
+			{
+				const JsonValue* value = Find(key);
+				return value && value->Kind == Type::Number ? value->Number : fallback;
+			}
+
+			int GetInt(const char* key, int fallback) const
+			{
+				return static_cast<int>(GetNumber(key, fallback));
+			}
+
+			const std::vector<JsonValue>& GetArray(const char* key) const
+			{
+				static const std::vector<JsonValue> empty;
+				const JsonValue* value = Find(key);
+				return value && value->Kind == Type::Array ? value->Array : empty;
+			}
+		};
+
+		class JsonParser
+		{
+		public:
+			JsonParser(const char* begin, const char* end)
+				: m_Cursor(begin), m_End(end)
+			{
+			}
+
+			bool Parse(JsonValue& out)
+			{
+				if (!ParseValue(out, 0))
+					return false;
+				SkipWhitespace();
+				return m_Cursor == m_End;
+			}
+
+		private:
+			static constexpr int s_MaxDepth = 128;
+
+			void SkipWhitespace()
+			{
+				while (m_Cursor < m_End && (*m_Cursor == ' ' || *m_Cursor == '\t' || *m_Cursor == '\n' || *m_Cursor == '\r'))
+					m_Cursor++;
+			}
+
+			bool Consume(const char* literal)
+			{
+				size_t length = std::strlen(literal);
+				if (static_cast<size_t>(m_End - m_Cursor) < length || std::memcmp(m_Cursor, literal, length) != 0)
+					return false;
+				m_Cursor += length;
+				return true;
+			}
+
+			bool ParseValue(JsonValue& out, int depth)
+			{
+				SkipWhitespace();
+				if (m_Cursor >= m_End || depth > s_MaxDepth)
+					return false;
+
+				switch (*m_Cursor)
+				{
+					case '{': return ParseObject(out, depth);
+					case '[': return ParseArray(out, depth);
+					case '"': out.Kind = JsonValue::Type::String; return ParseString(out.String);
+					case 't': out.Kind = JsonValue::Type::Bool; out.Bool = true; return Consume("true");
+					case 'f': out.Kind = JsonValue::Type::Bool; out.Bool = false; return Consume("false");
+					case 'n': out.Kind = JsonValue::Type::Null; return Consume("null");
+				}
+
+				out.Kind = JsonValue::Type::Number;
+				auto result = std::from_chars(m_Cursor, m_End, out.Number);
+				if (result.ec != std::errc())
+					return false;
+				m_Cursor = result.ptr;
+				return true;
+			}
+
+			bool ParseObject(JsonValue& out, int depth)
+			{
+				out.Kind = JsonValue::Type::Object;
+				m_Cursor++;
+				SkipWhitespace();
+				if (m_Cursor < m_End && *m_Cursor == '}')
+				{
+					m_Cursor++;
+					return true;
+				}
+
+				while (true)
+				{
+					SkipWhitespace();
+					std::string key;
+					if (m_Cursor >= m_End || *m_Cursor != '"' || !ParseString(key))
+						return false;
+
+					SkipWhitespace();
+					if (m_Cursor >= m_End || *m_Cursor++ != ':')
+						return false;
+
+					out.Object.emplace_back(std::move(key), JsonValue());
+					if (!ParseValue(out.Object.back().second, depth + 1))
+						return false;
+
+					SkipWhitespace();
+					if (m_Cursor >= m_End)
+						return false;
+					if (*m_Cursor == '}')
+					{
+						m_Cursor++;
+						return true;
+					}
+					if (*m_Cursor++ != ',')
+						return false;
+				}
+			}
+
+			bool ParseArray(JsonValue& out, int depth)
+			{
+				out.Kind = JsonValue::Type::Array;
+				m_Cursor++;
+				SkipWhitespace();
+				if (m_Cursor < m_End && *m_Cursor == ']')
+				{
+					m_Cursor++;
+					return true;
+				}
+
+				while (true)
+				{
+					out.Array.emplace_back();
+					if (!ParseValue(out.Array.back(), depth + 1))
+						return false;
+
+					SkipWhitespace();
+					if (m_Cursor >= m_End)
+						return false;
+					if (*m_Cursor == ']')
+					{
+						m_Cursor++;
+						return true;
+					}
+					if (*m_Cursor++ != ',')
+						return false;
+				}
+			}
+
+			bool ParseString(std::string& out)
+			{
+				m_Cursor++; // Opening quote
+				while (m_Cursor < m_End)
+				{
+					char c = *m_Cursor++;
+					if (c == '"')
+						return true;
+					if (c != '\\')
+					{
+						out += c;
+						continue;
+					}
+
+					if (m_Cursor >= m_End)
+						return false;
+					char escape = *m_Cursor++;
+					switch (escape)
+					{
+						case '"': case '\\': case '/': out += escape; break;
+						case 'b': out += '\b'; break;
+						case 'f': out += '\f'; break;
+						case 'n': out += '\n'; break;
+						case 'r': out += '\r'; break;
+						case 't': out += '\t'; break;
+						case 'u':
+						{
+							unsigned int codePoint = 0;
+							if (m_End - m_Cursor < 4 || std::from_chars(m_Cursor, m_Cursor + 4, codePoint, 16).ptr != m_Cursor + 4)
+								return false;
+							m_Cursor += 4;
+							AppendUtf8(out, codePoint);
+							break;
+						}
+						default: return false;
+					}
+				}
+				return false;
+			}
+
+			static void AppendUtf8(std::string& out, unsigned int codePoint)
+			{
+				// Surrogate halves are encoded individually; only asset names and URIs
+				// go through here, so exact handling of astral characters doesn't matter
+				if (codePoint < 0x80)
+				{
+					out += static_cast<char>(codePoint);
+				}
+				else if (codePoint < 0x800)
+				{
+					out += static_cast<char>(0xC0 | (codePoint >> 6));
+					out += static_cast<char>(0x80 | (codePoint & 0x3F));
+				}
+				else
+				{
+					out += static_cast<char>(0xE0 | (codePoint >> 12));
+					out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+					out += static_cast<char>(0x80 | (codePoint & 0x3F));
+				}
+			}
+
+		private:
+			const char* m_Cursor;
+			const char* m_End;
+		};
+
+		/////////////////////////////////////////////////////////////////////////////
+		// glTF /////////////////////////////////////////////////////////////////////
+		/////////////////////////////////////////////////////////////////////////////
+
+		constexpr uint32_t s_GlbMagic = 0x46546C67;     // "glTF"
+		constexpr uint32_t s_GlbChunkJson = 0x4E4F534A; // "JSON"
+		constexpr uint32_t s_GlbChunkBin = 0x004E4942;  // "BIN\0"
+
+		constexpr int s_GltfUnsignedByte = 5121;
+		constexpr int s_GltfUnsignedShort = 5123;
+		constexpr int s_GltfUnsignedInt = 5125;
+		constexpr int s_GltfFloat = 5126;
+		constexpr int s_GltfTriangles = 4;
+
+		struct GltfBuffer
+		{
+			const unsigned char* Data = nullptr;
+			size_t Size = 0;
+		};
+
+		// Strided, bounds-checked view of an accessor's elements
+		struct GltfAccessor
+		{
+			const unsigned char* Data = nullptr;
+			size_t Stride = 0;
+			size_t Count = 0;
+			int ComponentType = 0;
+			int ComponentCount = 0;
+		};
+
+		struct GltfDocument
+		{
+			JsonValue Json;
+			std::vector<GltfBuffer> Buffers;
+
+			// Storage behind Buffers
+			std::vector<MappedFile> ExternalFiles;
+			std::vector<std::vector<unsigned char>> DecodedBuffers;
+			size_t SourceBytes = 0;
+		};
+
+		// One primitive placed in the scene by a node
+		struct GltfPrimitiveInstance
+		{
+			const JsonValue* Primitive;
+			glm::mat4 Transform;
+		};
+
+		// Decoded, transformed primitive, produced on a worker thread
+		struct GltfDecodedPrimitive
+		{
+			std::vector<glm::vec3> Positions;
+			std::vector<glm::vec3> Normals; // Empty when the primitive has none
+			std::vector<uint32_t> Indices;
+			std::string Error;
+		};
+
+		int ComponentSize(int componentType)
+		{
+			switch (componentType)
+			{
+				case 5120: case 5121: return 1; // BYTE, UNSIGNED_BYTE
+				case 5122: case 5123: return 2; // SHORT, UNSIGNED_SHORT
+				case 5125: case 5126: return 4; // UNSIGNED_INT, FLOAT
+			}
+			return 0;
+		}
+
+		int ComponentCount(const std::string& type)
+		{
+			if (type == "SCALAR") return 1;
+			if (type == "VEC2") return 2;
+			if (type == "VEC3") return 3;
+			if (type == "VEC4") return 4;
+			if (type == "MAT2") return 4;
+			if (type == "MAT3") return 9;
+			if (type == "MAT4") return 16;
+			return 0;
+		}
+
+		bool DecodeBase64(const char* begin, const char* end, std::vector<unsigned char>& out)
+		{
+			static const auto table = []()
+			{
+				std::array<int8_t, 256> values;
+				values.fill(-1);
+				const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+				for (int i = 0; i < 64; i++)
+					values[static_cast<unsigned char>(alphabet[i])] = static_cast<int8_t>(i);
+				return values;
+			}();
+
+			out.clear();
+			out.reserve((end - begin) / 4 * 3);
+
+			uint32_t accumulator = 0;
+			int bits = 0;
+			for (const char* p = begin; p < end && *p != '='; p++)
+			{
+				int8_t value = table[static_cast<unsigned char>(*p)];
+				if (value < 0)
+					return false;
+
+				accumulator = (accumulator << 6) | static_cast<uint32_t>(value);
+				bits += 6;
+				if (bits >= 8)
+				{
+					bits -= 8;
+					out.push_back(static_cast<unsigned char>((accumulator >> bits) & 0xFF));
+				}
+			}
+			return true;
+		}
+
+		std::string DecodeUri(const std::string& uri)
+		{
+			std::string decoded;
+			decoded.reserve(uri.size());
+			for (size_t i = 0; i < uri.size(); i++)
+			{
+				unsigned int value = 0;
+				if (uri[i] == '%' && i + 2 < uri.size() &&
+				    std::from_chars(uri.data() + i + 1, uri.data() + i + 3, value, 16).ptr == uri.data() + i + 3)
+				{
+					decoded += static_cast<char>(value);
+					i += 2;
+				}
+				else
+				{
+					decoded += uri[i];
+				}
+			}
+			return decoded;
+		}
+
+		bool LoadGltfDocument(const std::string& path, const MappedFile& file, GltfDocument& doc)
+		{
+			const unsigned char* data = file.GetData();
+			const size_t size = file.GetSize();
+			doc.SourceBytes = size;
+
+			const char* jsonBegin = reinterpret_cast<const char*>(data);
+			const char* jsonEnd = jsonBegin + size;
+			GltfBuffer glbBinary;
+
+			uint32_t magic = 0;
+			if (size >= 4)
+				std::memcpy(&magic, data, 4);
+
+			if (magic == s_GlbMagic)
+			{
+				// 12-byte header, then chunks of [length, type, payload]
+				uint32_t header[3];
+				if (size < 20)
+					return false;
+				std::memcpy(header, data, sizeof(header));
+				if (header[1] != 2 || header[2] > size)
+				{
+					HZ_ERROR("MeshImporter: {} is not a glTF 2.0 binary", path);
+					return false;
+				}
+
+				size_t offset = 12;
+				jsonBegin = jsonEnd = nullptr;
+				while (offset + 8 <= header[2])
+				{
+					uint32_t chunk[2];
+					std::memcpy(chunk, data + offset, sizeof(chunk));
+					offset += 8;
+					if (chunk[0] > header[2] - offset)
+						return false;
+
+					if (chunk[1] == s_GlbChunkJson && !jsonBegin)
+					{
+						jsonBegin = reinterpret_cast<const char*>(data + offset);
+						jsonEnd = jsonBegin + chunk[0];
+					}
+					else if (chunk[1] == s_GlbChunkBin && !glbBinary.Data)
+					{
+						glbBinary = { data + offset, chunk[0] };
+					}
+					offset += (chunk[0] + 3) & ~3u;
+				}
+
+				if (!jsonBegin)
+				{
+					HZ_ERROR("MeshImporter: {} has no JSON chunk", path);
+					return false;
+				}
+			}
+
+			JsonParser parser(jsonBegin, jsonEnd);
+			if (!parser.Parse(doc.Json) || doc.Json.Kind != JsonValue::Type::Object)
+			{
+				HZ_ERROR("MeshImporter: {} contains invalid JSON", path);
+				return false;
+			}
+
+			const auto& buffers = doc.Json.GetArray("buffers");
+			doc.Buffers.resize(buffers.size());
+			doc.DecodedBuffers.reserve(buffers.size());
+			doc.ExternalFiles.reserve(buffers.size());
+
+			for (size_t i = 0; i < buffers.size(); i++)
+			{
+				const JsonValue* uri = buffers[i].Find("uri");
+				if (!uri || uri->Kind != JsonValue::Type::String)
+				{
+					// Buffer 0 without a uri is the GLB binary chunk
+					if (i != 0 || !glbBinary.Data)
+					{
+						HZ_ERROR("MeshImporter: {} buffer {} has no data", path, i);
+						return false;
+					}
+					doc.Buffers[i] = glbBinary;
+					continue;
+				}
+
+				const std::string& value = uri->String;
+				if (value.compare(0, 5, "data:") == 0)
+				{
+					size_t comma = value.find(',');
+					if (comma == std::string::npos || value.rfind(";base64", comma) == std::string::npos)
+					{
+						HZ_ERROR("MeshImporter: {} uses an unsupported data URI", path);
+						return false;
+					}
+
+					doc.DecodedBuffers.emplace_back();
+					if (!DecodeBase64(value.data() + comma + 1, value.data() + value.size(), doc.DecodedBuffers.back()))
+					{
+						HZ_ERROR("MeshImporter: {} has a malformed base64 buffer", path);
+						return false;
+					}
+					doc.Buffers[i] = { doc.DecodedBuffers.back().data(), doc.DecodedBuffers.back().size() };
+				}
+				else
+				{
+					doc.ExternalFiles.emplace_back();
+					MappedFile& external = doc.ExternalFiles.back();
+					if (!external.Open(GetDirectory(path) + DecodeUri(value)))
+						return false;
+
+					external.Prefetch();
+					doc.Buffers[i] = { external.GetData(), external.GetSize() };
+					doc.SourceBytes += external.GetSize();
+				}
+
+				size_t declaredLength = static_cast<size_t>(buffers[i].GetNumber("byteLength", 0.0));
+				if (declaredLength > doc.Buffers[i].Size)
+				{
+					HZ_ERROR("MeshImporter: {} buffer {} is shorter than declared", path, i);
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		bool GetAccessor(const GltfDocument& doc, int index, GltfAccessor& out)
+		{
+			const auto& accessors = doc.Json.GetArray("accessors");
+			const auto& views = doc.Json.GetArray("bufferViews");
+			if (index < 0 || static_cast<size_t>(index) >= accessors.size())
+				return false;
+
+			const JsonValue& accessor = accessors[index];
+			const JsonValue* type = accessor.Find("type");
+			out.ComponentType = accessor.GetInt("componentType", 0);
+			out.ComponentCount = type ? ComponentCount(type->String) : 0;
+			out.Count = static_cast<size_t>(accessor.GetNumber("count", 0.0));
+
+			size_t elementSize = static_cast<size_t>(ComponentSize(out.ComponentType)) * out.ComponentCount;
+			int viewIndex = accessor.GetInt("bufferView", -1);
+			if (elementSize == 0 || accessor.Find("sparse") || viewIndex < 0 || static_cast<size_t>(viewIndex) >= views.size())
+				return false;
+
+			const JsonValue& view = views[viewIndex];
+			int bufferIndex = view.GetInt("buffer", -1);
+			if (bufferIndex < 0 || static_cast<size_t>(bufferIndex) >= doc.Buffers.size())
+				return false;
+
+			const GltfBuffer& buffer = doc.Buffers[bufferIndex];
+			size_t viewOffset = static_cast<size_t>(view.GetNumber("byteOffset", 0.0));
+			size_t viewLength = static_cast<size_t>(view.GetNumber("byteLength", 0.0));
+			size_t accessorOffset = static_cast<size_t>(accessor.GetNumber("byteOffset", 0.0));
+			out.Stride = static_cast<size_t>(view.GetNumber("byteStride", 0.0));
+			if (out.Stride == 0)
+				out.Stride = elementSize;
+
+			if (viewOffset > buffer.Size || viewLength > buffer.Size - viewOffset || out.Stride < elementSize)
+				return false;
+			if (out.Count > 0 && (accessorOffset > viewLength ||
+			    (out.Count - 1) * out.Stride + elementSize > viewLength - accessorOffset))
+				return false;
+
+			out.Data = buffer.Data + viewOffset + accessorOffset;
+			return true;
+		}
+
+		glm::mat4 GetNodeTransform(const JsonValue& node)
+		{
+			const auto& matrix = node.GetArray("matrix");
+			if (matrix.size() == 16)
+			{
+				glm::mat4 result;
+				for (int i = 0; i < 16; i++)
+					result[i / 4][i % 4] = static_cast<float>(matrix[i].Number); // Column-major, like glm
+				return result;
+			}
+
+			glm::mat4 result(1.0f);
+			const auto& translation = node.GetArray("translation");
+			if (translation.size() == 3)
+				result = glm::translate(result, glm::vec3(translation[0].Number, translation[1].Number, translation[2].Number));
+
+			const auto& rotation = node.GetArray("rotation");
+			if (rotation.size() == 4)
+			{
+				// glTF stores quaternions as [x, y, z, w]
+				glm::quat q(static_cast<float>(rotation[3].Number), static_cast<float>(rotation[0].Number),
+				            static_cast<float>(rotation[1].Number), static_cast<float>(rotation[2].Number));
+				result *= glm::mat4_cast(q);
+			}
+
+			const auto& scale = node.GetArray("scale");
+			if (scale.size() == 3)
+				result = glm::scale(result, glm::vec3(scale[0].Number, scale[1].Number, scale[2].Number));
+
+			return result;
+		}
+
+		void CollectMeshInstances(const GltfDocument& doc, int nodeIndex, const glm::mat4& parent, int depth,
+		                          std::vector<GltfPrimitiveInstance>& out)
+		{
+			const auto& nodes = doc.Json.GetArray("nodes");
+			const auto& meshes = doc.Json.GetArray("meshes");
+			if (nodeIndex < 0 || static_cast<size_t>(nodeIndex) >= nodes.size() || depth > 64)
+				return;
+
+			const JsonValue& node = nodes[nodeIndex];
+			glm::mat4 world = parent * GetNodeTransform(node);
+
+			int meshIndex = node.GetInt("mesh", -1);
+			if (meshIndex >= 0 && static_cast<size_t>(meshIndex) < meshes.size())
+			{
+				for (const auto& primitive : meshes[meshIndex].GetArray("primitives"))
+					out.push_back({ &primitive, world });
+			}
+
+			for (const auto& child : node.GetArray("children"))
+				CollectMeshInstances(doc, static_cast<int>(child.Number), world, depth + 1, out);
+		}
+
+		void DecodePrimitive(const GltfDocument& doc, const GltfPrimitiveInstance& instance, GltfDecodedPrimitive& out)
+		{
+			const JsonValue& primitive = *instance.Primitive;
+			if (primitive.GetInt("mode", s_GltfTriangles) != s_GltfTriangles)
+				return; // Points and lines have nothing to render as a mesh
+
+			const JsonValue* attributes = primitive.Find("attributes");
+			const JsonValue* position = attributes ? attributes->Find("POSITION") : nullptr;
+			const JsonValue* normal = attributes ? attributes->Find("NORMAL") : nullptr;
+
+			GltfAccessor positions;
+			if (!position || !GetAccessor(doc, static_cast<int>(position->Number), positions) ||
+			    positions.ComponentType != s_GltfFloat || positions.ComponentCount != 3)
+			{
+				out.Error = "primitive has no float3 POSITION accessor";
+				return;
+			}
+
+			GltfAccessor normals;
+			bool hasNormals = normal && GetAccessor(doc, static_cast<int>(normal->Number), normals) &&
+			                  normals.ComponentType == s_GltfFloat && normals.ComponentCount == 3 &&
+			                  normals.Count == positions.Count;
+
+			glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(instance.Transform)));
+			out.Positions.resize(positions.Count);
+			for (size_t i = 0; i < positions.Count; i++)
+			{
+				glm::vec3 p;
+				std::memcpy(&p, positions.Data + i * positions.Stride, sizeof(p));
+				out.Positions[i] = glm::vec3(instance.Transform * glm::vec4(p, 1.0f));
+			}
+
+			if (hasNormals)
+			{
+				out.Normals.resize(normals.Count);
+				for (size_t i = 0; i < normals.Count; i++)
+				{
+					glm::vec3 n;
+					std::memcpy(&n, normals.Data + i * normals.Stride, sizeof(n));
+					n = normalMatrix * n;
+					float length = glm::length(n);
+					out.Normals[i] = length > 0.0f ? n / length : n;
+				}
+			}
+
+			int indicesIndex = primitive.GetInt("indices", -1);
+			if (indicesIndex < 0)
+			{
+				out.Indices.resize(positions.Count - positions.Count % 3);
+				for (size_t i = 0; i < out.Indices.size(); i++)
+					out.Indices[i] = static_cast<uint32_t>(i);
+			}
+			else
+			{
+				GltfAccessor indices;
+				if (!GetAccessor(doc, indicesIndex, indices) || indices.ComponentCount != 1)
+				{
+					out.Error = "invalid index accessor";
+					return;
+				}
+
+				out.Indices.resize(indices.Count - indices.Count % 3);
+				for (size_t i = 0; i < out.Indices.size(); i++)
+				{
+					const unsigned char* element = indices.Data + i * indices.Stride;
+					uint32_t value = 0;
+					switch (indices.ComponentType)
+					{
+						case s_GltfUnsignedByte:  value = *element; break;
+						case s_GltfUnsignedShort: { uint16_t v; std::memcpy(&v, element, 2); value = v; break; }
+						case s_GltfUnsignedInt:   std::memcpy(&value, element, 4); break;
+						default: out.Error = "unsupported index type"; return;
+					}
+
+					if (value >= positions.Count)
+					{
+						out.Error = "index out of range";
+						return;
+					}
+					out.Indices[i] = value;
+				}
+			}
+
+			// Mirroring transforms flip the winding; swap to keep triangles front-facing
+			if (glm::determinant(glm::mat3(instance.Transform)) < 0.0f)
+			{
+				for (size_t i = 0; i + 2 < out.Indices.size(); i += 3)
+					std::swap(out.Indices[i + 1], out.Indices[i + 2]);
+			}
+		}
+
+		// Exact-match key for welding glTF vertices by value
+		struct VertexKey
+		{
+			uint32_t Bits[6];
+			bool HasNormal;
+
+			bool operator==(const VertexKey& other) const
+			{
+				return HasNormal == other.HasNormal && std::memcmp(Bits, other.Bits, sizeof(Bits)) == 0;
+			}
+		};
+
+		struct VertexKeyHash
+		{
+			size_t operator()(const VertexKey& key) const
+			{
+				uint64_t hash = key.HasNormal ? 0x9E3779B97F4A7C15ull : 0;
+				for (uint32_t bits : key.Bits)
+					hash = (hash ^ bits) * 0x100000001B3ull;
+				return static_cast<size_t>(hash ^ (hash >> 29));
+			}
+		};
+
+	}
+
+	bool MeshImporter::Import(const std::string& path, MeshData& outData, MeshImportStats* outStats)
+	{
+		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_TAG(Renderer);
+
+		std::string extension = GetExtension(path);
+		if (extension == ".obj")
+			return ImportOBJ(path, outData, outStats);
+		if (extension == ".gltf" || extension == ".glb")
+			return ImportGLTF(path, outData, outStats);
+
+		HZ_ERROR("MeshImporter: unsupported file type '{}' ({})", extension, path);
+		return false;
+	}
+
+	bool MeshImporter::ImportOBJ(const std::string& path, MeshData& outData, MeshImportStats* outStats)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		MappedFile file;
+		if (!file.Open(path))
+			return false;
+		file.Prefetch();
+
+		const char* begin = reinterpret_cast<const char*>(file.GetData());
+		const char* end = begin + file.GetSize();
+
+		// Split at line boundaries into roughly equal chunks, one or more per thread
+		size_t chunkCount = (std::max)(static_cast<size_t>(1), file.GetSize() / s_MinBytesPerChunk);
+		chunkCount = (std::min)(chunkCount, static_cast<size_t>(JobSystem::GetThreadCount()) * 4);
+
+		std::vector<ObjChunk> chunks;
+		chunks.reserve(chunkCount);
+		const char* chunkBegin = begin;
+		for (size_t i = 1; i <= chunkCount && chunkBegin < end; i++)
+		{
+			const char* chunkEnd = i == chunkCount ? end : begin + file.GetSize() / chunkCount * i;
+			if (chunkEnd < chunkBegin)
+				chunkEnd = chunkBegin;
+			const char* newline = static_cast<const char*>(std::memchr(chunkEnd, '\n', end - chunkEnd));
+			chunkEnd = newline ? newline + 1 : end;
+
+			chunks.emplace_back();
+			chunks.back().Begin = chunkBegin;
+			chunks.back().End = chunkEnd;
+			chunkBegin = chunkEnd;
+		}
+
+		ParallelForEach(chunks.size(), [&](size_t i) { ParseObjChunk(chunks[i]); });
+
+		// Prefix sums give each chunk the global index of its first position/normal
+		size_t positionCount = 0, normalCount = 0, cornerCount = 0;
+		for (auto& chunk : chunks)
+		{
+			if (chunk.ErrorAt)
+			{
+				HZ_ERROR("MeshImporter: {} is malformed near byte {}", path, chunk.ErrorAt - begin);
+				return false;
+			}
+
+			chunk.PositionBase = positionCount;
+			chunk.NormalBase = normalCount;
+			positionCount += chunk.Positions.size() / 3;
+			normalCount += chunk.Normals.size() / 3;
+			cornerCount += chunk.Corners.size();
+		}
+
+		std::vector<float> positions, normals;
+		positions.reserve(positionCount * 3);
+		normals.reserve(normalCount * 3);
+		for (const auto& chunk : chunks)
+		{
+			positions.insert(positions.end(), chunk.Positions.begin(), chunk.Positions.end());
+			normals.insert(normals.end(), chunk.Normals.begin(), chunk.Normals.end());
+		}
+
+		// Weld corners sharing the same position/normal pair. Corners without a
+		// normal weld by position alone so generated normals come out smooth.
+		outData.Vertices.clear();
+		outData.Indices.clear();
+		outData.Indices.reserve(cornerCount);
+
+		std::unordered_map<uint64_t, uint32_t> welded;
+		welded.reserve(positionCount + positionCount / 2);
+		std::vector<uint8_t> missingNormals;
+
+		for (const auto& chunk : chunks)
+		{
+			for (const ObjCorner& corner : chunk.Corners)
+			{
+				uint32_t position = 0, normal = 0;
+				bool hasNormal = (corner.Flags & ObjHasNormal) != 0;
+				if (!ResolveObjIndex(corner.Position, (corner.Flags & ObjPositionRelative) != 0,
+				                     chunk.PositionBase, positionCount, position) ||
+				    (hasNormal && !ResolveObjIndex(corner.Normal, (corner.Flags & ObjNormalRelative) != 0,
+				                                   chunk.NormalBase, normalCount, normal)))
+				{
+					HZ_ERROR("MeshImporter: {} references a vertex that does not exist", path);
+					return false;
+				}
+
+				uint64_t key = (static_cast<uint64_t>(position) << 32) | (hasNormal ? normal + 1ull : 0ull);
+				auto [it, inserted] = welded.try_emplace(key, static_cast<uint32_t>(missingNormals.size()));
+				if (inserted)
+				{
+					glm::vec3 p = glm::make_vec3(&positions[position * 3]);
+					glm::vec3 n = hasNormal ? glm::make_vec3(&normals[normal * 3]) : glm::vec3(0.0f);
+					WriteVertex(outData, p, n);
+					missingNormals.push_back(hasNormal ? 0 : 1);
+				}
+				outData.Indices.push_back(it->second);
+			}
+		}
+
+		if (outData.Indices.empty())
+		{
+			HZ_ERROR("MeshImporter: {} contains no faces", path);
+			return false;
+		}
+
+		GenerateMissingNormals(outData, missingNormals);
+		FinishImport(path, outData, file.GetSize(), start, outStats);
+		return true;
+	}
+
+	bool MeshImporter::ImportGLTF(const std::string& path, MeshData& outData, MeshImportStats* outStats)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		MappedFile file;
+		if (!file.Open(path))
+			return false;
+
+		GltfDocument doc;
+		if (!LoadGltfDocument(path, file, doc))
+			return false;
+
+		// Place primitives through the node hierarchy of the default scene. Files
+		// without scenes are libraries of meshes; import every mesh untransformed.
+		std::vector<GltfPrimitiveInstance> instances;
+		const auto& scenes = doc.Json.GetArray("scenes");
+		if (!scenes.empty())
+		{
+			int sceneIndex = doc.Json.GetInt("scene", 0);
+			if (sceneIndex < 0 || static_cast<size_t>(sceneIndex) >= scenes.size())
+				sceneIndex = 0;
+			for (const auto& node : scenes[sceneIndex].GetArray("nodes"))
+				CollectMeshInstances(doc, static_cast<int>(node.Number), glm::mat4(1.0f), 0, instances);
+		}
+		else
+		{
+			for (const auto& mesh : doc.Json.GetArray("meshes"))
+				for (const auto& primitive : mesh.GetArray("primitives"))
+					instances.push_back({ &primitive, glm::mat4(1.0f) });
+		}
+
+		std::vector<GltfDecodedPrimitive> decoded(instances.size());
+		ParallelForEach(instances.size(), [&](size_t i) { DecodePrimitive(doc, instances[i], decoded[i]); });
+
+		outData.Vertices.clear();
+		outData.Indices.clear();
+
+		std::unordered_map<VertexKey, uint32_t, VertexKeyHash> welded;
+		std::vector<uint8_t> missingNormals;
+		std::vector<uint32_t> remap;
+
+		for (const auto& primitive : decoded)
+		{
+			if (!primitive.Error.empty())
+			{
+				HZ_ERROR("MeshImporter: {} - {}", path, primitive.Error);
+				return false;
+			}
+
+			bool hasNormals = !primitive.Normals.empty();
+			remap.resize(primitive.Positions.size());
+			for (size_t i = 0; i < primitive.Positions.size(); i++)
+			{
+				const glm::vec3& p = primitive.Positions[i];
+				glm::vec3 n = hasNormals ? primitive.Normals[i] : glm::vec3(0.0f);
+
+				VertexKey key;
+				std::memcpy(key.Bits, &p, sizeof(p));
+				std::memcpy(key.Bits + 3, &n, sizeof(n));
+				key.HasNormal = hasNormals;
+
+				auto [it, inserted] = welded.try_emplace(key, static_cast<uint32_t>(missingNormals.size()));
+				if (inserted)
+				{
+					WriteVertex(outData, p, n);
+					missingNormals.push_back(hasNormals ? 0 : 1);
+				}
+				remap[i] = it->second;
+			}
+
+			for (uint32_t index : primitive.Indices)
+				outData.Indices.push_back(remap[index]);
+		}
+
+		if (outData.Indices.empty())
+		{
+			HZ_ERROR("MeshImporter: {} contains no triangle geometry", path);
+			return false;
+		}
+
+		GenerateMissingNormals(outData, missingNormals);
+		FinishImport(path, outData, doc.SourceBytes, start, outStats);
+		return true;
+	}
+
+	std::shared_ptr<Mesh> MeshImporter::Load(const std::string& path)
+	{
+		MeshData data;
+		if (!Import(path, data))
+			return nullptr;
+
+		return std::make_shared<Mesh>(data);
+	}
+
+}
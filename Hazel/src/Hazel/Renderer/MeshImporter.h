@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../Core.h"
+#include "Mesh.h"
+#include "MeshGenerator.h"
+#include <memory>
+#include <string>
+
+namespace Hazel {
+
+	// Timing of the last import, logged after every successful import
+	struct MeshImportStats
+	{
+		size_t SourceBytes = 0;   // Bytes read from disk (including external .bin buffers)
+		size_t VertexCount = 0;   // After welding
+		size_t TriangleCount = 0;
+		double Milliseconds = 0.0;
+
+		double GetThroughputMBps() const
+		{
+			return Milliseconds > 0.0 ? (SourceBytes / (1024.0 * 1024.0)) / (Milliseconds / 1000.0) : 0.0;
+		}
+	};
+
+	// Imports OBJ and glTF 2.0 (.gltf with embedded or external buffers, and .glb)
+	// into MeshData using the default [position.xyz, normal.xyz] layout.
+	// All primitives of a file are merged into one mesh with node transforms applied.
+	// Identical vertices are welded and normals are generated where the source has none.
+	class HAZEL_API MeshImporter
+	{
+	public:
+		// Picks the importer from the file extension
+		static bool Import(const std::string& path, MeshData& outData, MeshImportStats* outStats = nullptr);
+
+		static bool ImportOBJ(const std::string& path, MeshData& outData, MeshImportStats* outStats = nullptr);
+		static bool ImportGLTF(const std::string& path, MeshData& outData, MeshImportStats* outStats = nullptr);
+
+		// Import and upload in one go; returns nullptr on failure
+		static std::shared_ptr<Mesh> Load(const std::string& path);
+	};
+
+}
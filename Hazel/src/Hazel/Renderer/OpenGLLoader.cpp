@@ -1,4 +1,5 @@
 #include "OpenGLLoader.h"
+#include <cstddef>
 
 // Function pointer definitions
 HAZEL_API PFNGLDEPTHFUNCPROC glad_glDepthFunc = NULL;
@@ -6,6 +7,7 @@ HAZEL_API PFNGLBLENDFUNCPROC glad_glBlendFunc = NULL;
 HAZEL_API PFNGLUNIFORM1FPROC glad_glUniform1f = NULL;
 HAZEL_API PFNGLUNIFORM3FPROC glad_glUniform3f = NULL;
 HAZEL_API PFNGLUNIFORM4FPROC glad_glUniform4f = NULL;
+HAZEL_API PFNGLUNIFORMMATRIX3FVPROC glad_glUniformMatrix3fv = NULL;
 HAZEL_API PFNGLGENFRAMEBUFFERSPROC glad_glGenFramebuffers = NULL;
 HAZEL_API PFNGLBINDFRAMEBUFFERPROC glad_glBindFramebuffer = NULL;
 HAZEL_API PFNGLFRAMEBUFFERTEXTURE2DPROC glad_glFramebufferTexture2D = NULL;
@@ -16,24 +18,49 @@ HAZEL_API PFNGLFRAMEBUFFERRENDERBUFFERPROC glad_glFramebufferRenderbuffer = NULL
 HAZEL_API PFNGLCHECKFRAMEBUFFERSTATUSPROC glad_glCheckFramebufferStatus = NULL;
 HAZEL_API PFNGLDELETEFRAMEBUFFERSPROC glad_glDeleteFramebuffers = NULL;
 HAZEL_API PFNGLDELETERENDERBUFFERSPROC glad_glDeleteRenderbuffers = NULL;
+HAZEL_API PFNGLMAPBUFFERRANGEPROC glad_glMapBufferRange = NULL;
+HAZEL_API PFNGLUNMAPBUFFERPROC glad_glUnmapBuffer = NULL;
+HAZEL_API PFNGLBINDBUFFERRANGEPROC glad_glBindBufferRange = NULL;
+HAZEL_API PFNGLGETUNIFORMBLOCKINDEXPROC glad_glGetUniformBlockIndex = NULL;
+HAZEL_API PFNGLUNIFORMBLOCKBINDINGPROC glad_glUniformBlockBinding = NULL;
+HAZEL_API PFNGLGENQUERIESPROC glad_glGenQueries = NULL;
+HAZEL_API PFNGLDELETEQUERIESPROC glad_glDeleteQueries = NULL;
+HAZEL_API PFNGLQUERYCOUNTERPROC glad_glQueryCounter = NULL;
+HAZEL_API PFNGLGETQUERYIVPROC glad_glGetQueryiv = NULL;
+HAZEL_API PFNGLGETQUERYOBJECTIVPROC glad_glGetQueryObjectiv = NULL;
+HAZEL_API PFNGLGETQUERYOBJECTUI64VPROC glad_glGetQueryObjectui64v = NULL;
+HAZEL_API PFNGLGETINTEGER64VPROC glad_glGetInteger64v = NULL;
 
-HAZEL_API void HazelOpenGLInit()
+HAZEL_API void HazelOpenGLInit(GL3WGetProcAddressProc getProcAddress)
 {
-	// Use ImGui's OpenGL loader to get function pointers
+	// Resolve through the same function as ImGui's OpenGL loader
 	// This works cross-platform and handles extension loading properly
-	glad_glDepthFunc = (PFNGLDEPTHFUNCPROC)imgl3wGetProcAddress("glDepthFunc");
-	glad_glBlendFunc = (PFNGLBLENDFUNCPROC)imgl3wGetProcAddress("glBlendFunc");
-	glad_glUniform1f = (PFNGLUNIFORM1FPROC)imgl3wGetProcAddress("glUniform1f");
-	glad_glUniform3f = (PFNGLUNIFORM3FPROC)imgl3wGetProcAddress("glUniform3f");
-	glad_glUniform4f = (PFNGLUNIFORM4FPROC)imgl3wGetProcAddress("glUniform4f");
-	glad_glGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)imgl3wGetProcAddress("glGenFramebuffers");
-	glad_glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)imgl3wGetProcAddress("glBindFramebuffer");
-	glad_glFramebufferTexture2D = (PFNGLFRAMEBUFFERTEXTURE2DPROC)imgl3wGetProcAddress("glFramebufferTexture2D");
-	glad_glGenRenderbuffers = (PFNGLGENRENDERBUFFERSPROC)imgl3wGetProcAddress("glGenRenderbuffers");
-	glad_glBindRenderbuffer = (PFNGLBINDRENDERBUFFERPROC)imgl3wGetProcAddress("glBindRenderbuffer");
-	glad_glRenderbufferStorage = (PFNGLRENDERBUFFERSTORAGEPROC)imgl3wGetProcAddress("glRenderbufferStorage");
-	glad_glFramebufferRenderbuffer = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)imgl3wGetProcAddress("glFramebufferRenderbuffer");
-	glad_glCheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)imgl3wGetProcAddress("glCheckFramebufferStatus");
-	glad_glDeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)imgl3wGetProcAddress("glDeleteFramebuffers");
-	glad_glDeleteRenderbuffers = (PFNGLDELETERENDERBUFFERSPROC)imgl3wGetProcAddress("glDeleteRenderbuffers");
+	glad_glDepthFunc = (PFNGLDEPTHFUNCPROC)getProcAddress("glDepthFunc");
+	glad_glBlendFunc = (PFNGLBLENDFUNCPROC)getProcAddress("glBlendFunc");
+	glad_glUniform1f = (PFNGLUNIFORM1FPROC)getProcAddress("glUniform1f");
+	glad_glUniform3f = (PFNGLUNIFORM3FPROC)getProcAddress("glUniform3f");
+	glad_glUniform4f = (PFNGLUNIFORM4FPROC)getProcAddress("glUniform4f");
+	glad_glUniformMatrix3fv = (PFNGLUNIFORMMATRIX3FVPROC)getProcAddress("glUniformMatrix3fv");
+	glad_glGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)getProcAddress("glGenFramebuffers");
+	glad_glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)getProcAddress("glBindFramebuffer");
+	glad_glFramebufferTexture2D = (PFNGLFRAMEBUFFERTEXTURE2DPROC)getProcAddress("glFramebufferTexture2D");
+	glad_glGenRenderbuffers = (PFNGLGENRENDERBUFFERSPROC)getProcAddress("glGenRenderbuffers");
+	glad_glBindRenderbuffer = (PFNGLBINDRENDERBUFFERPROC)getProcAddress("glBindRenderbuffer");
+	glad_glRenderbufferStorage = (PFNGLRENDERBUFFERSTORAGEPROC)getProcAddress("glRenderbufferStorage");
+	glad_glFramebufferRenderbuffer = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)getProcAddress("glFramebufferRenderbuffer");
+	glad_glCheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)getProcAddress("glCheckFramebufferStatus");
+	glad_glDeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)getProcAddress("glDeleteFramebuffers");
+	glad_glDeleteRenderbuffers = (PFNGLDELETERENDERBUFFERSPROC)getProcAddress("glDeleteRenderbuffers");
+	glad_glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)getProcAddress("glMapBufferRange");
+	glad_glUnmapBuffer = (PFNGLUNMAPBUFFERPROC)getProcAddress("glUnmapBuffer");
+	glad_glBindBufferRange = (PFNGLBINDBUFFERRANGEPROC)getProcAddress("glBindBufferRange");
+	glad_glGetUniformBlockIndex = (PFNGLGETUNIFORMBLOCKINDEXPROC)getProcAddress("glGetUniformBlockIndex");
+	glad_glUniformBlockBinding = (PFNGLUNIFORMBLOCKBINDINGPROC)getProcAddress("glUniformBlockBinding");
+	glad_glGenQueries = (PFNGLGENQUERIESPROC)getProcAddress("glGenQueries");
+	glad_glDeleteQueries = (PFNGLDELETEQUERIESPROC)getProcAddress("glDeleteQueries");
+	glad_glQueryCounter = (PFNGLQUERYCOUNTERPROC)getProcAddress("glQueryCounter");
+	glad_glGetQueryiv = (PFNGLGETQUERYIVPROC)getProcAddress("glGetQueryiv");
+	glad_glGetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC)getProcAddress("glGetQueryObjectiv");
+	glad_glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)getProcAddress("glGetQueryObjectui64v");
+	glad_glGetInteger64v = (PFNGLGETINTEGER64VPROC)getProcAddress("glGetInteger64v");
 }
@@ -0,0 +1,185 @@
+#include "ParallelDrawList.h"
+#include "Renderer.h"
+#include "../Math/TransformBatch.h"
+#include "../Threading/JobSystem.h"
+#include "../Memory/MemoryTracker.h"
+#include "../Debug/Profiler.h"
+#include <cstring>
+
+namespace Hazel {
+
+	/////////////////////////////////////////////////////////////////////////////
+	// ThreadList ///////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	void ParallelDrawList::ThreadList::Clear()
+	{
+		Packets.clear();
+		References.clear();
+		LastVertexArray = nullptr;
+		LastMaterial = nullptr;
+	}
+
+	void ParallelDrawList::ThreadList::Add(const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<Material>& material, const DrawPacket& packet)
+	{
+		if (vertexArray.get() != LastVertexArray)
+		{
+			References.push_back(vertexArray);
+			LastVertexArray = vertexArray.get();
+		}
+		if (material.get() != LastMaterial)
+		{
+			References.push_back(material);
+			LastMaterial = material.get();
+		}
+
+		Packets.push_back(packet);
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// ParallelDrawList /////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	void ParallelDrawList::Reset()
+	{
+		// The job system may have been restarted with another thread count
+		size_t threadCount = JobSystem::IsInitialized() ? JobSystem::GetThreadCount() : 0;
+		if (m_Lists.size() != threadCount)
+			m_Lists.resize(threadCount);
+
+		for (ThreadList& list : m_Lists)
+			list.Clear();
+		m_ExternalList.Clear();
+	}
+
+	void ParallelDrawList::Submit(const std::shared_ptr<VertexArray>& vertexArray,
+	                              const std::shared_ptr<Material>& material,
+	                              const MaterialProperties& properties,
+	                              const glm::mat4& transform,
+	                              const glm::mat3& normalMatrix,
+	                              float depth)
+	{
+		HZ_MEMORY_TAG(Renderer);
+
+		const IndexBuffer* indexBuffer = vertexArray->GetIndexBuffer();
+
+		DrawPacket packet;
+		packet.SortKey = MakeSortKey(material.get(), vertexArray.get(), depth);
+		packet.VertexArrayPtr = vertexArray.get();
+		packet.MaterialPtr = material.get();
+		packet.Properties = properties;
+		packet.Transform = transform;
+		packet.NormalMatrix = normalMatrix;
+		packet.FirstIndex = indexBuffer->GetFirstIndex();
+		packet.IndexCount = indexBuffer->GetCount();
+		packet.VertexCount = indexBuffer->GetVertexCount();
+
+		int threadIndex = JobSystem::GetThreadIndex();
+		if (threadIndex >= 0 && static_cast<size_t>(threadIndex) < m_Lists.size())
+		{
+			m_Lists[threadIndex].Add(vertexArray, material, packet);
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_ExternalMutex);
+		m_ExternalList.Add(vertexArray, material, packet);
+	}
+
+	void ParallelDrawList::Submit(const std::shared_ptr<VertexArray>& vertexArray,
+	                              const std::shared_ptr<Material>& material,
+	                              const MaterialProperties& properties,
+	                              const glm::mat4& transform,
+	                              float depth)
+	{
+		Submit(vertexArray, material, properties, transform, TransformBatch::GetNormalMatrix(transform), depth);
+	}
+
+	size_t ParallelDrawList::GetDrawCount() const
+	{
+		size_t count = m_ExternalList.Packets.size();
+		for (const ThreadList& list : m_Lists)
+			count += list.Packets.size();
+		return count;
+	}
+
+	uint64_t ParallelDrawList::MakeSortKey(const Material* material, const VertexArray* vertexArray, float depth)
+	{
+		// Only grouping matters for the objects, so their addresses are folded
+		// into 16 bits each; a collision costs a state change, not correctness
+		auto fold = [](const void* pointer)
+		{
+			uint64_t value = reinterpret_cast<uintptr_t>(pointer) >> 4;
+			value ^= value >> 16;
+			value ^= value >> 32;
+			return value & 0xFFFF;
+		};
+
+		// Non-negative floats order the same as their bit patterns
+		depth = depth > 0.0f ? depth : 0.0f;
+		uint32_t depthBits;
+		std::memcpy(&depthBits, &depth, sizeof(depthBits));
+
+		return (fold(material) << 48) | (fold(vertexArray) << 32) | depthBits;
+	}
+
+	void ParallelDrawList::Sort()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		m_Order.clear();
+		for (uint32_t list = 0; list <= m_Lists.size(); list++)
+		{
+			const ThreadList& source = list < m_Lists.size() ? m_Lists[list] : m_ExternalList;
+			for (uint32_t i = 0; i < source.Packets.size(); i++)
+				m_Order.push_back({ source.Packets[i].SortKey, list, i });
+		}
+
+		// LSD radix sort, a byte per pass. Passes over bytes that every key
+		// shares (typically the high material bits) are skipped.
+		size_t count = m_Order.size();
+		m_SortScratch.resize(count);
+		for (uint32_t shift = 0; shift < 64; shift += 8)
+		{
+			size_t histogram[256] = {};
+			for (const SortEntry& entry : m_Order)
+				histogram[(entry.Key >> shift) & 0xFF]++;
+
+			if (histogram[(m_Order.empty() ? 0 : m_Order[0].Key >> shift) & 0xFF] == count)
+				continue;
+
+			size_t offset = 0;
+			for (size_t& bucket : histogram)
+			{
+				size_t bucketCount = bucket;
+				bucket = offset;
+				offset += bucketCount;
+			}
+
+			for (const SortEntry& entry : m_Order)
+				m_SortScratch[histogram[(entry.Key >> shift) & 0xFF]++] = entry;
+			m_Order.swap(m_SortScratch);
+		}
+	}
+
+	void ParallelDrawList::Flush()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		Sort();
+
+		m_Sorted.clear();
+		for (const SortEntry& entry : m_Order)
+		{
+			const ThreadList& source = entry.List < m_Lists.size() ? m_Lists[entry.List] : m_ExternalList;
+			m_Sorted.push_back(&source.Packets[entry.Index]);
+		}
+
+		m_References.assign(m_ExternalList.References.begin(), m_ExternalList.References.end());
+		for (const ThreadList& list : m_Lists)
+			m_References.insert(m_References.end(), list.References.begin(), list.References.end());
+
+		Renderer::SubmitPackets(m_Sorted.data(), m_Sorted.size(), m_References);
+		m_References.clear();
+	}
+
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "../Core.h"
+#include "RenderQueue.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Hazel {
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
+	// Draws recorded by many jobs at once. Every job system thread appends to
+	// its own list, so Submit() takes no locks and shares no cache lines with
+	// other threads; Flush() merges the lists, sorts the packets by key with a
+	// radix sort and hands them to the Renderer in that order, from one thread.
+	//
+	//   list.Reset();
+	//   JobSystem::ParallelFor(count, 256, [&](size_t begin, size_t end) { ... list.Submit(...); });
+	//   Renderer::BeginScene(camera);
+	//   list.Flush();
+	//
+	// Threads the job system does not own may submit too, through a locked list.
+	class HAZEL_API ParallelDrawList
+	{
+	public:
+		ParallelDrawList() = default;
+		ParallelDrawList(const ParallelDrawList&) = delete;
+		ParallelDrawList& operator=(const ParallelDrawList&) = delete;
+
+		// Empties the lists, keeping their memory. Call while no job submits.
+		void Reset();
+
+		// 'depth' orders draws sharing a material and mesh front to back.
+		// 'normalMatrix' is the inverse transpose of the transform's upper 3x3,
+		// e.g. from TransformSystem; the overloads without it compute one.
+		void Submit(const std::shared_ptr<VertexArray>& vertexArray,
+		            const std::shared_ptr<Material>& material,
+		            const MaterialProperties& properties,
+		            const glm::mat4& transform,
+		            const glm::mat3& normalMatrix,
+		            float depth = 0.0f);
+		void Submit(const std::shared_ptr<VertexArray>& vertexArray,
+		            const std::shared_ptr<Material>& material,
+		            const MaterialProperties& properties,
+		            const glm::mat4& transform,
+		            float depth = 0.0f);
+		void Submit(const std::shared_ptr<VertexArray>& vertexArray,
+		            const std::shared_ptr<Material>& material,
+		            const glm::mat4& transform,
+		            float depth = 0.0f)
+		{
+			Submit(vertexArray, material, material->GetProperties(), transform, depth);
+		}
+
+		// Sorts everything submitted since Reset() and passes it to the Renderer:
+		// recorded into the calling thread's queue, or drawn. Call while no job submits.
+		void Flush();
+
+		size_t GetDrawCount() const;
+
+		// Groups draws by material, then mesh, then front to back
+		static uint64_t MakeSortKey(const Material* material, const VertexArray* vertexArray, float depth);
+
+	private:
+		struct alignas(64) ThreadList
+		{
+			std::vector<DrawPacket> Packets;
+			// Keep the submitted objects alive until the flush; consecutive
+			// submissions of the same objects add one reference
+			std::vector<std::shared_ptr<const void>> References;
+			const void* LastVertexArray = nullptr;
+			const void* LastMaterial = nullptr;
+
+			void Clear();
+			void Add(const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<Material>& material, const DrawPacket& packet);
+		};
+
+		struct SortEntry
+		{
+			uint64_t Key;
+			uint32_t List;
+			uint32_t Index;
+		};
+
+		void Sort();
+
+	private:
+		std::vector<ThreadList> m_Lists;
+		// For threads outside the job system
+		ThreadList m_ExternalList;
+		std::mutex m_ExternalMutex;
+
+		// Flush() scratch, kept to avoid allocating every frame
+		std::vector<SortEntry> m_Order;
+		std::vector<SortEntry> m_SortScratch;
+		std::vector<const DrawPacket*> m_Sorted;
+		std::vector<std::shared_ptr<const void>> m_References;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
@@ -0,0 +1,284 @@
+#include "RenderQueue.h"
+#include "Renderer.h"
+#include "OpenGLLoader.h"
+#include "../Math/TransformBatch.h"
+#include "../Memory/MemoryTracker.h"
+#include "../Debug/Profiler.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Hazel {
+
+	// First allocation of a queue; roughly a few hundred draws
+	static constexpr size_t s_InitialCapacity = 64 * 1024;
+
+	void RenderQueue::Clear()
+	{
+		// Keep capacity: a queue is refilled every frame with a similar amount of work
+		m_Size = 0;
+		m_CommandCount = 0;
+		m_DrawCount = 0;
+		m_Lights.clear();
+		m_LightsDirty = true;
+		m_References.clear();
+		m_LastVertexArray = nullptr;
+		m_LastMaterial = nullptr;
+	}
+
+	void RenderQueue::Reserve(size_t capacity)
+	{
+		HZ_MEMORY_TAG(Renderer);
+
+		if (capacity <= m_Capacity)
+			return;
+
+		size_t newCapacity = (std::max)({ capacity, m_Capacity * 2, s_InitialCapacity });
+		std::unique_ptr<unsigned char[]> data(new unsigned char[newCapacity]);
+		if (m_Size > 0)
+			std::memcpy(data.get(), m_Data.get(), m_Size);
+
+		m_Data = std::move(data);
+		m_Capacity = newCapacity;
+	}
+
+	void* RenderQueue::Push(CommandType type, size_t payloadSize)
+	{
+		static_assert(sizeof(CommandHeader) <= s_HeaderSize, "Command header outgrew its slot");
+		static_assert(sizeof(CallbackCommand) <= s_CallbackHeaderSize, "Callback header outgrew its slot");
+
+		size_t size = s_HeaderSize + AlignUp(payloadSize);
+		Reserve(m_Size + size);
+
+		unsigned char* command = m_Data.get() + m_Size;
+		CommandHeader* header = reinterpret_cast<CommandHeader*>(command);
+		header->Type = type;
+		header->Size = static_cast<uint32_t>(size);
+
+		m_Size += size;
+		m_CommandCount++;
+		return command + s_HeaderSize;
+	}
+
+	void RenderQueue::KeepAlive(const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<Material>& material)
+	{
+		if (vertexArray.get() != m_LastVertexArray)
+		{
+			m_References.push_back(vertexArray);
+			m_LastVertexArray = vertexArray.get();
+		}
+		if (material.get() != m_LastMaterial)
+		{
+			m_References.push_back(material);
+			m_LastMaterial = material.get();
+		}
+	}
+
+	void RenderQueue::KeepAlive(const std::vector<std::shared_ptr<const void>>& references)
+	{
+		m_References.insert(m_References.end(), references.begin(), references.end());
+		m_LastVertexArray = nullptr;
+		m_LastMaterial = nullptr;
+	}
+
+	void RenderQueue::SetClearColor(const glm::vec4& color)
+	{
+		*static_cast<glm::vec4*>(Push(CommandType::SetClearColor, sizeof(glm::vec4))) = color;
+	}
+
+	void RenderQueue::ClearFramebuffer()
+	{
+		Push(CommandType::ClearFramebuffer, 0);
+	}
+
+	void RenderQueue::BeginScene(const glm::mat4& view, const glm::mat4& projection, const CameraLatch* latch)
+	{
+		SceneCommand* scene = static_cast<SceneCommand*>(Push(CommandType::BeginScene, sizeof(SceneCommand)));
+		scene->View = view;
+		scene->Projection = projection;
+		scene->Latch = latch;
+	}
+
+	void RenderQueue::ClearLights()
+	{
+		m_Lights.clear();
+		m_LightsDirty = true;
+	}
+
+	void RenderQueue::AddLight(const std::shared_ptr<Light>& light)
+	{
+		m_Lights.push_back(light);
+		m_LightsDirty = true;
+	}
+
+	void RenderQueue::Draw(const std::shared_ptr<VertexArray>& vertexArray,
+	                       const std::shared_ptr<Material>& material,
+	                       const glm::mat4& transform)
+	{
+		KeepAlive(vertexArray, material);
+
+		// The index range is captured too: selecting another LOD later must not
+		// change what this frame draws
+		const IndexBuffer* indexBuffer = vertexArray->GetIndexBuffer();
+
+		DrawPacket packet;
+		packet.VertexArrayPtr = vertexArray.get();
+		packet.MaterialPtr = material.get();
+		packet.Properties = material->GetProperties();
+		packet.Transform = transform;
+		packet.NormalMatrix = TransformBatch::GetNormalMatrix(transform);
+		packet.FirstIndex = indexBuffer->GetFirstIndex();
+		packet.IndexCount = indexBuffer->GetCount();
+		packet.VertexCount = indexBuffer->GetVertexCount();
+		Draw(packet);
+	}
+
+	void RenderQueue::Draw(const DrawPacket& packet)
+	{
+		if (m_LightsDirty)
+		{
+			// Lights are captured as the first draw after a change sees them
+			size_t payloadSize = AlignUp(sizeof(SetLightsCommand)) + m_Lights.size() * sizeof(LightData);
+			unsigned char* payload = static_cast<unsigned char*>(Push(CommandType::SetLights, payloadSize));
+			reinterpret_cast<SetLightsCommand*>(payload)->Count = static_cast<uint32_t>(m_Lights.size());
+
+			LightData* lights = reinterpret_cast<LightData*>(payload + AlignUp(sizeof(SetLightsCommand)));
+			for (size_t i = 0; i < m_Lights.size(); i++)
+				lights[i] = m_Lights[i]->GetData();
+
+			m_LightsDirty = false;
+		}
+
+		*static_cast<DrawPacket*>(Push(CommandType::Draw, sizeof(DrawPacket))) = packet;
+		m_DrawCount++;
+	}
+
+	void RenderQueue::UploadBuffer(unsigned int target, unsigned int buffer, size_t offset, const void* data, size_t size)
+	{
+		unsigned char* payload = static_cast<unsigned char*>(Push(CommandType::UploadBuffer, AlignUp(sizeof(UploadCommand)) + size));
+
+		UploadCommand* command = reinterpret_cast<UploadCommand*>(payload);
+		command->Target = target;
+		command->Buffer = buffer;
+		command->Offset = offset;
+		command->Size = size;
+		std::memcpy(payload + AlignUp(sizeof(UploadCommand)), data, size);
+	}
+
+	void RenderQueue::BindBufferRange(unsigned int target, unsigned int index, unsigned int buffer, size_t offset, size_t size)
+	{
+		BindCommand* command = static_cast<BindCommand*>(Push(CommandType::BindBufferRange, sizeof(BindCommand)));
+		command->Target = target;
+		command->Index = index;
+		command->Buffer = buffer;
+		command->Offset = offset;
+		command->Size = size;
+	}
+
+	void RenderQueue::Append(const RenderQueue& other)
+	{
+		if (other.m_Size > 0)
+		{
+			Reserve(m_Size + other.m_Size);
+			std::memcpy(m_Data.get() + m_Size, other.m_Data.get(), other.m_Size);
+			m_Size += other.m_Size;
+		}
+
+		m_CommandCount += other.m_CommandCount;
+		m_DrawCount += other.m_DrawCount;
+		m_References.insert(m_References.end(), other.m_References.begin(), other.m_References.end());
+		m_LastVertexArray = other.m_LastVertexArray;
+		m_LastMaterial = other.m_LastMaterial;
+
+		// The appended commands may have replaced the lights in effect at replay
+		m_LightsDirty = true;
+	}
+
+	void RenderQueue::Execute()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		const glm::mat4* viewProjection = nullptr;
+		glm::mat4 sceneViewProjection;
+		const LightData* lights = nullptr;
+		uint32_t lightCount = 0;
+
+		const unsigned char* command = m_Data.get();
+		const unsigned char* end = command + m_Size;
+		while (command < end)
+		{
+			const CommandHeader* header = reinterpret_cast<const CommandHeader*>(command);
+			const unsigned char* payload = command + s_HeaderSize;
+			command += header->Size;
+
+			switch (header->Type)
+			{
+				case CommandType::SetClearColor:
+				{
+					const glm::vec4& color = *reinterpret_cast<const glm::vec4*>(payload);
+					glClearColor(color.r, color.g, color.b, color.a);
+					break;
+				}
+				case CommandType::ClearFramebuffer:
+				{
+					glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+					break;
+				}
+				case CommandType::BeginScene:
+				{
+					// A latched camera is read now, as late as the draws allow
+					const SceneCommand& scene = *reinterpret_cast<const SceneCommand*>(payload);
+					sceneViewProjection = Renderer::SetCamera(scene.View, scene.Projection, scene.Latch);
+					viewProjection = &sceneViewProjection;
+					Renderer::SetSceneState();
+					break;
+				}
+				case CommandType::SetLights:
+				{
+					lightCount = reinterpret_cast<const SetLightsCommand*>(payload)->Count;
+					lights = reinterpret_cast<const LightData*>(payload + AlignUp(sizeof(SetLightsCommand)));
+					break;
+				}
+				case CommandType::Draw:
+				{
+					if (!viewProjection)
+						break;
+
+					const DrawPacket& draw = *reinterpret_cast<const DrawPacket*>(payload);
+					Renderer::DrawIndexed(*draw.VertexArrayPtr, *draw.MaterialPtr, draw.Properties,
+					                      *viewProjection, draw.Transform, &draw.NormalMatrix, lights, lightCount,
+					                      draw.FirstIndex, draw.IndexCount, draw.VertexCount);
+					break;
+				}
+				case CommandType::UploadBuffer:
+				{
+					const UploadCommand& upload = *reinterpret_cast<const UploadCommand*>(payload);
+					glBindBuffer(upload.Target, upload.Buffer);
+					glBufferSubData(upload.Target, upload.Offset, upload.Size, payload + AlignUp(sizeof(UploadCommand)));
+					Renderer::GetFrameCounters().BufferBytesUploaded += upload.Size;
+					glBindBuffer(upload.Target, 0);
+					break;
+				}
+				case CommandType::BindBufferRange:
+				{
+					const BindCommand& binding = *reinterpret_cast<const BindCommand*>(payload);
+					glBindBufferRange(binding.Target, binding.Index, binding.Buffer,
+					                  static_cast<GLintptr>(binding.Offset), static_cast<GLsizeiptr>(binding.Size));
+					break;
+				}
+				case CommandType::Callback:
+				{
+					const CallbackCommand& callback = *reinterpret_cast<const CallbackCommand*>(payload);
+					callback.Invoke(const_cast<unsigned char*>(payload) + s_CallbackHeaderSize);
+					break;
+				}
+			}
+		}
+
+		// Release on the thread that owns the context: a recording may hold the
+		// last reference to a vertex array
+		m_References.clear();
+		m_LastVertexArray = nullptr;
+		m_LastMaterial = nullptr;
+	}
+
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "../Core.h"
+#include "Buffer.h"
+#include "Material.h"
+#include "Light.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Hazel {
+
+	// One draw without its scene state (view-projection, lights), which comes
+	// from the scene it is submitted into. The objects are referenced by raw
+	// pointer; whoever records the packet keeps them alive.
+	struct DrawPacket
+	{
+		uint64_t SortKey = 0;
+		const VertexArray* VertexArrayPtr = nullptr;
+		Material* MaterialPtr = nullptr;
+		MaterialProperties Properties;
+		glm::mat4 Transform = glm::mat4(1.0f);
+		glm::mat3 NormalMatrix = glm::mat3(1.0f); // Inverse transpose of Transform's upper 3x3
+		uint32_t FirstIndex = 0;
+		uint32_t IndexCount = 0;
+		uint32_t VertexCount = 0; // Referenced by the index range, for statistics
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
+	// Rendering recorded as a linear command buffer: each command is a small
+	// header followed by its plain-data payload, written back to back into one
+	// byte array. Everything a draw depends on (view-projection, lights,
+	// material properties, transform, index range, buffer contents) is copied
+	// at record time, so the simulation may keep changing the scene while a
+	// recorded frame is executed; only a scene's CameraLatch is read during
+	// execution, on purpose. Clear() keeps the memory, so once a queue has
+	// seen a typical frame, recording into it does not allocate.
+	//
+	// Recording makes no OpenGL calls and may happen on any thread; Execute()
+	// must run on the thread that owns the context. Vertex arrays and materials
+	// are kept alive until the queue is executed or cleared; other GPU objects
+	// (buffers named by id) must outlive it.
+	class CameraLatch;
+
+	class HAZEL_API RenderQueue
+	{
+	public:
+		RenderQueue() = default;
+		RenderQueue(const RenderQueue&) = delete;
+		RenderQueue& operator=(const RenderQueue&) = delete;
+
+		void Clear();
+		bool IsEmpty() const { return m_Size == 0; }
+		size_t GetCommandCount() const { return m_CommandCount; }
+		size_t GetDrawCount() const { return m_DrawCount; }
+		// Bytes of command data recorded
+		size_t GetSize() const { return m_Size; }
+
+		void SetClearColor(const glm::vec4& color);
+		void ClearFramebuffer();
+
+		// A non-null 'latch' replaces 'view' with its latest view during Execute()
+		void BeginScene(const glm::mat4& view, const glm::mat4& projection, const CameraLatch* latch);
+		void ClearLights();
+		void AddLight(const std::shared_ptr<Light>& light);
+		void Draw(const std::shared_ptr<VertexArray>& vertexArray,
+		          const std::shared_ptr<Material>& material,
+		          const glm::mat4& transform);
+
+		// Copies 'data' now; the upload itself happens during Execute()
+		void UploadBuffer(unsigned int target, unsigned int buffer, size_t offset, const void* data, size_t size);
+		void BindBufferRange(unsigned int target, unsigned int index, unsigned int buffer, size_t offset, size_t size);
+
+		// Calls 'func' on the executing thread, in order with the other commands.
+		// It is copied into the buffer, so it must be trivially copyable: capture
+		// plain values and pointers to data that outlives the execution.
+		template<typename Func>
+		void Callback(const Func& func)
+		{
+			static_assert(std::is_trivially_copyable<Func>::value, "RenderQueue callbacks are stored as plain bytes");
+			static_assert(alignof(Func) <= s_Alignment, "RenderQueue callback is over-aligned");
+
+			unsigned char* payload = static_cast<unsigned char*>(Push(CommandType::Callback, s_CallbackHeaderSize + sizeof(Func)));
+			reinterpret_cast<CallbackCommand*>(payload)->Invoke = [](void* data) { (*static_cast<Func*>(data))(); };
+			new (payload + s_CallbackHeaderSize) Func(func);
+		}
+
+		// Appends a copy of everything recorded into 'other'
+		void Append(const RenderQueue& other);
+
+		// Replays the recorded commands in order, then drops the references the
+		// queue held. Execute a recording once.
+		void Execute();
+
+	private:
+		enum class CommandType : uint32_t
+		{
+			SetClearColor = 0,
+			ClearFramebuffer,
+			BeginScene,
+			SetLights,
+			Draw,
+			UploadBuffer,
+			BindBufferRange,
+			Callback
+		};
+
+		static constexpr size_t s_Alignment = alignof(std::max_align_t);
+
+		static constexpr size_t AlignUp(size_t size) { return (size + s_Alignment - 1) & ~(s_Alignment - 1); }
+
+		struct CommandHeader
+		{
+			CommandType Type;
+			uint32_t Size; // Header and payload, aligned
+		};
+
+		struct SceneCommand
+		{
+			glm::mat4 View;
+			glm::mat4 Projection;
+			const CameraLatch* Latch;
+		};
+
+		struct SetLightsCommand
+		{
+			uint32_t Count; // LightData array follows
+		};
+
+		struct UploadCommand
+		{
+			unsigned int Target;
+			unsigned int Buffer;
+			size_t Offset;
+			size_t Size; // Data follows
+		};
+
+		struct BindCommand
+		{
+			unsigned int Target;
+			unsigned int Index;
+			unsigned int Buffer;
+			size_t Offset;
+			size_t Size;
+		};
+
+		struct CallbackCommand
+		{
+			void (*Invoke)(void* data); // Callable follows
+		};
+
+		// Both fit in one alignment unit, so payloads stay aligned
+		static constexpr size_t s_HeaderSize = s_Alignment;
+		static constexpr size_t s_CallbackHeaderSize = s_Alignment;
+
+		// Reserves a command with 'payloadSize' bytes of payload and returns the payload
+		void* Push(CommandType type, size_t payloadSize);
+		void Reserve(size_t capacity);
+		void KeepAlive(const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<Material>& material);
+		void KeepAlive(const std::vector<std::shared_ptr<const void>>& references);
+		// Records a draw whose objects the caller keeps alive (see KeepAlive)
+		void Draw(const DrawPacket& packet);
+
+	private:
+		friend class Renderer;
+
+		std::unique_ptr<unsigned char[]> m_Data;
+		size_t m_Size = 0;
+		size_t m_Capacity = 0;
+		size_t m_CommandCount = 0;
+		size_t m_DrawCount = 0;
+
+		// Lights set since recording started; copied into a SetLights command
+		// by the first draw after they change
+		std::vector<std::shared_ptr<Light>> m_Lights;
+		bool m_LightsDirty = true;
+
+		// References that keep recorded vertex arrays and materials alive.
+		// Consecutive draws of the same objects add one reference.
+		std::vector<std::shared_ptr<const void>> m_References;
+		const void* m_LastVertexArray = nullptr;
+		const void* m_LastMaterial = nullptr;
+
+		// Queue the recording thread was recording into before this one (see Renderer::BeginRecording)
+		RenderQueue* m_OuterRecording = nullptr;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
@@ -0,0 +1,270 @@
+#include "RenderThread.h"
+#include "Renderer.h"
+#include "../Log.h"
+#include "../Debug/Profiler.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+
+namespace Hazel {
+
+	static double ToMilliseconds(std::chrono::steady_clock::duration duration)
+	{
+		return std::chrono::duration<double, std::milli>(duration).count();
+	}
+
+	RenderThread::RenderThread(GLFWwindow* window, int swapInterval)
+		: m_Window(window), m_SwapInterval(swapInterval)
+	{
+	}
+
+	RenderThread::~RenderThread()
+	{
+		Stop();
+	}
+
+	void RenderThread::Start()
+	{
+		if (m_Thread.joinable())
+			return;
+
+		m_Stopping = false;
+		m_ContextRequested = false;
+		m_ContextOnRecordingThread = false;
+
+		glfwMakeContextCurrent(nullptr);
+		m_Thread = std::thread([this]() { ThreadMain(); });
+
+		HZ_INFO("Render thread started");
+	}
+
+	void RenderThread::Stop()
+	{
+		if (!m_Thread.joinable())
+			return;
+
+		if (m_ContextBorrowed)
+			ReleaseContext();
+		if (m_Recording)
+		{
+			// A frame that was never submitted is dropped
+			Renderer::EndRecording();
+			m_Recording = false;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Stopping = true;
+		}
+		m_Condition.notify_all();
+		m_Thread.join();
+
+		glfwMakeContextCurrent(m_Window);
+
+		// Recorded frames may still reference GPU objects; release them with a context
+		m_Frames[0].Clear();
+		m_Frames[1].Clear();
+
+		HZ_INFO("Render thread stopped");
+	}
+
+	RenderQueue& RenderThread::BeginFrame()
+	{
+		RenderQueue& queue = m_Frames[m_RecordIndex];
+		{
+			// The buffer was used two frames ago; wait until its replay is done
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			Clock::time_point start = Clock::now();
+			m_Condition.wait(lock, [this, &queue]() { return m_Pending != &queue && m_Replaying != &queue; });
+			m_StallTotal += ToMilliseconds(Clock::now() - start);
+		}
+
+		Renderer::BeginRecording(queue);
+		m_Recording = true;
+		return queue;
+	}
+
+	void RenderThread::SubmitFrame()
+	{
+		if (!m_Recording)
+			return;
+
+		Renderer::EndRecording();
+		m_Recording = false;
+
+		Submit(m_Frames[m_RecordIndex], true);
+		m_RecordIndex ^= 1;
+	}
+
+	void RenderThread::Submit(RenderQueue& queue, bool present)
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		Clock::time_point start = Clock::now();
+		m_Condition.wait(lock, [this]() { return m_Pending == nullptr; });
+		m_StallTotal += ToMilliseconds(Clock::now() - start);
+
+		if (present)
+			m_LastFrameBytes = queue.GetSize();
+
+		m_Pending = &queue;
+		m_PendingPresent = present;
+		m_PendingTime = Clock::now();
+		lock.unlock();
+		m_Condition.notify_all();
+	}
+
+	void RenderThread::AcquireContext()
+	{
+		if (!m_Thread.joinable() || m_ContextBorrowed)
+			return;
+
+		// What was recorded so far has to reach the GPU before anything drawn directly
+		if (m_Recording)
+		{
+			Renderer::EndRecording();
+			Submit(m_Frames[m_RecordIndex], false);
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			Clock::time_point start = Clock::now();
+			m_ContextRequested = true;
+			m_Condition.notify_all();
+			m_Condition.wait(lock, [this]() { return m_ContextOnRecordingThread; });
+			m_ContextRequested = false;
+			m_StallTotal += ToMilliseconds(Clock::now() - start);
+		}
+
+		glfwMakeContextCurrent(m_Window);
+		m_ContextBorrowed = true;
+	}
+
+	void RenderThread::ReleaseContext()
+	{
+		if (!m_ContextBorrowed)
+			return;
+
+		glfwMakeContextCurrent(nullptr);
+		m_ContextBorrowed = false;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_ContextOnRecordingThread = false;
+		}
+		m_Condition.notify_all();
+
+		// The part of the frame recorded before AcquireContext() has been replayed; continue after it
+		if (m_Recording)
+			Renderer::BeginRecording(m_Frames[m_RecordIndex]);
+	}
+
+	RenderThreadStats RenderThread::GetStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		RenderThreadStats stats;
+		stats.FrameCount = m_FrameCount;
+		stats.MaxHandOffMs = m_HandOffMax;
+		stats.LastFrameBytes = m_LastFrameBytes;
+		if (m_SubmitCount > 0)
+		{
+			stats.AverageHandOffMs = m_HandOffTotal / m_SubmitCount;
+			stats.AverageReplayMs = m_ReplayTotal / m_SubmitCount;
+		}
+		if (m_FrameCount > 0)
+		{
+			stats.AveragePresentMs = m_PresentTotal / m_FrameCount;
+			stats.AverageStallMs = m_StallTotal / m_FrameCount;
+		}
+		return stats;
+	}
+
+	void RenderThread::ResetStats()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_FrameCount = 0;
+		m_SubmitCount = 0;
+		m_HandOffTotal = 0.0;
+		m_HandOffMax = 0.0;
+		m_ReplayTotal = 0.0;
+		m_PresentTotal = 0.0;
+		m_StallTotal = 0.0;
+	}
+
+	void RenderThread::ThreadMain()
+	{
+		Profiler::SetThreadName("Render Thread");
+
+		glfwMakeContextCurrent(m_Window);
+		// The swap interval belongs to the context's thread on some platforms
+		glfwSwapInterval(m_SwapInterval);
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		while (true)
+		{
+			m_Condition.wait(lock, [this]() { return m_Pending || m_ContextRequested || m_Stopping; });
+
+			// Submitted work always goes first: the recording thread waits for
+			// it before it takes the context, and Stop() flushes it
+			if (m_Pending)
+			{
+				RenderQueue* queue = m_Pending;
+				bool present = m_PendingPresent;
+				Clock::time_point submitted = m_PendingTime;
+				m_Pending = nullptr;
+				m_Replaying = queue;
+				lock.unlock();
+				m_Condition.notify_all();
+
+				Clock::time_point start = Clock::now();
+				queue->Execute();
+				Clock::time_point replayed = Clock::now();
+				if (present)
+				{
+					HZ_PROFILE_SCOPE("RenderThread::SwapBuffers");
+					glfwSwapBuffers(m_Window);
+					Renderer::OnPresented();
+				}
+				Clock::time_point presented = Clock::now();
+
+				lock.lock();
+				m_Replaying = nullptr;
+
+				double handOff = ToMilliseconds(start - submitted);
+				m_SubmitCount++;
+				m_HandOffTotal += handOff;
+				m_HandOffMax = (std::max)(m_HandOffMax, handOff);
+				m_ReplayTotal += ToMilliseconds(replayed - start);
+				if (present)
+				{
+					m_FrameCount++;
+					m_PresentTotal += ToMilliseconds(presented - replayed);
+				}
+
+				lock.unlock();
+				m_Condition.notify_all();
+				lock.lock();
+				continue;
+			}
+
+			if (m_ContextRequested && !m_ContextOnRecordingThread)
+			{
+				glfwMakeContextCurrent(nullptr);
+				m_ContextOnRecordingThread = true;
+				lock.unlock();
+				m_Condition.notify_all();
+				lock.lock();
+
+				m_Condition.wait(lock, [this]() { return !m_ContextOnRecordingThread; });
+				glfwMakeContextCurrent(m_Window);
+				continue;
+			}
+
+			if (m_Stopping)
+				break;
+		}
+		lock.unlock();
+
+		glfwMakeContextCurrent(nullptr);
+	}
+
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "../Core.h"
+#include "RenderQueue.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+struct GLFWwindow;
+
+namespace Hazel {
+
+	struct RenderThreadStats
+	{
+		uint64_t FrameCount = 0;
+		// From SubmitFrame() until the render thread starts replaying the frame
+		double AverageHandOffMs = 0.0;
+		double MaxHandOffMs = 0.0;
+		// Replay of the command buffer, and the buffer swap that follows it
+		double AverageReplayMs = 0.0;
+		double AveragePresentMs = 0.0;
+		// Time per frame the recording thread spent blocked on the render thread
+		double AverageStallMs = 0.0;
+		// Size of the last submitted frame's command buffer
+		size_t LastFrameBytes = 0;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
+	// Owns the window's OpenGL context on a dedicated thread. The thread that
+	// drives the frame loop records each frame into a command buffer between
+	// BeginFrame() and SubmitFrame(); the render thread replays it and swaps
+	// buffers while the next frame is recorded into the other buffer. At most
+	// one frame is in flight, so BeginFrame() stalls when the render thread
+	// falls a whole frame behind.
+	//
+	// Code that has to call OpenGL directly (framebuffers, buffer mapping,
+	// texture uploads) borrows the context with AcquireContext(), which first
+	// drains everything recorded so far.
+	//
+	// All members except the constructor are to be called from the thread
+	// that called Start().
+	class HAZEL_API RenderThread
+	{
+	public:
+		RenderThread(GLFWwindow* window, int swapInterval);
+		~RenderThread();
+
+		RenderThread(const RenderThread&) = delete;
+		RenderThread& operator=(const RenderThread&) = delete;
+
+		// The calling thread must have the context current; it gives it up
+		void Start();
+		// Replays what was submitted, then makes the context current on the calling thread again
+		void Stop();
+		bool IsRunning() const { return m_Thread.joinable(); }
+
+		// Starts recording the next frame on the calling thread (see Renderer::BeginRecording)
+		RenderQueue& BeginFrame();
+		// Hands the recorded frame to the render thread, which replays and presents it
+		void SubmitFrame();
+
+		// Makes the context current on the calling thread once everything recorded
+		// so far has been replayed. Renderer calls draw immediately until
+		// ReleaseContext(), after which recording of the current frame resumes.
+		void AcquireContext();
+		void ReleaseContext();
+		bool IsContextBorrowed() const { return m_ContextBorrowed; }
+
+		RenderThreadStats GetStats() const;
+		void ResetStats();
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		void ThreadMain();
+		void Submit(RenderQueue& queue, bool present);
+
+	private:
+		GLFWwindow* m_Window;
+		int m_SwapInterval;
+		std::thread m_Thread;
+
+		// Recording thread only
+		RenderQueue m_Frames[2];
+		uint32_t m_RecordIndex = 0;
+		bool m_Recording = false;
+		bool m_ContextBorrowed = false;
+
+		// Shared with the render thread, guarded by m_Mutex
+		mutable std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		RenderQueue* m_Pending = nullptr;
+		bool m_PendingPresent = false;
+		Clock::time_point m_PendingTime;
+		RenderQueue* m_Replaying = nullptr;
+		bool m_ContextRequested = false;
+		bool m_ContextOnRecordingThread = false;
+		bool m_Stopping = false;
+
+		uint64_t m_FrameCount = 0;
+		uint64_t m_SubmitCount = 0;
+		double m_HandOffTotal = 0.0;
+		double m_HandOffMax = 0.0;
+		double m_ReplayTotal = 0.0;
+		double m_PresentTotal = 0.0;
+		double m_StallTotal = 0.0;
+		size_t m_LastFrameBytes = 0;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
@@ -1,35 +1,92 @@
 #include "Renderer.h"
 #include "OpenGLLoader.h"
+#include "MeshCache.h"
+#include "RenderQueue.h"
+#include "GpuProfiler.h"
+#include "CameraLatch.h"
+#include "../FrameClock.h"
+#include "../Math/TransformBatch.h"
 #include "../Log.h"
+#include "../Memory/MemoryTracker.h"
+#include "../Debug/Profiler.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <mutex>
 
 namespace Hazel {
 
 	Renderer::SceneData* Renderer::s_SceneData = nullptr;
 	static bool s_RendererInitialized = false;
+	// Set while the calling thread records into a queue instead of drawing
+	static thread_local RenderQueue* t_RecordingQueue = nullptr;
 
-	void Renderer::Init()
+	// Written by the thread that owns the context; the last frame is read from any thread
+	static RendererStats s_FrameCounters;
+	static std::mutex s_StatsMutex;
+	static RendererStats s_LastFrameStats;
+
+	// Latched camera latency; written by the thread that owns the context, under s_StatsMutex
+	static FrameTimeHistogram s_LatchToSubmit;
+	static FrameTimeHistogram s_LatchToPresent;
+	// Newest input latched into the frame being drawn, 0 for none; context thread only
+	static int64_t s_FrameInputTime = 0;
+
+	// std140 layout of the camera block
+	struct CameraBlockData
+	{
+		glm::mat4 ViewProjection;
+		glm::mat4 View;
+		glm::mat4 Projection;
+		glm::vec4 Position;
+	};
+
+	bool Renderer::Init()
 	{
+		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_TAG(Renderer);
+
 		if (s_RendererInitialized)
-			return;
+			return true;
 
-		// Initialize OpenGL loader
-		if (imgl3wInit() != 0)
+		// Contexts GLFW created through OSMesa or EGL (headless runs) do not
+		// come from the system OpenGL library. imgl3wInit() opens that library
+		// and reads the version through it, which fails with only such a context
+		// current (or no libGL at all), so those resolve through GLFW alone.
+		GLFWwindow* context = glfwGetCurrentContext();
+		bool nativeContext = !context || glfwGetWindowAttrib(context, GLFW_CONTEXT_CREATION_API) == GLFW_NATIVE_CONTEXT_API;
+		GL3WGetProcAddressProc getProcAddress = nativeContext ? imgl3wGetProcAddress : glfwGetProcAddress;
+		if ((nativeContext ? imgl3wInit() : imgl3wInit2(getProcAddress)) != 0)
 		{
 			HZ_ERROR("Failed to initialize OpenGL loader");
-			return;
+			return false;
 		}
 
 		// Initialize additional Hazel OpenGL functions
-		HazelOpenGLInit();
+		HazelOpenGLInit(getProcAddress);
+		GpuProfiler::Init();
 
 		s_SceneData = new SceneData();
+		if (glBindBufferRange && glGetUniformBlockIndex && glUniformBlockBinding)
+		{
+			glGenBuffers(1, &s_SceneData->CameraBuffer);
+			glBindBuffer(GL_UNIFORM_BUFFER, s_SceneData->CameraBuffer);
+			glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraBlockData), nullptr, GL_DYNAMIC_DRAW);
+			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		}
 		s_RendererInitialized = true;
 		
 		HZ_INFO("Renderer initialized");
+		return true;
 	}
 
 	void Renderer::Shutdown()
 	{
+		// Release cached meshes while the OpenGL context is still alive
+		MeshCache::Clear();
+		GpuProfiler::Shutdown();
+
+		if (s_SceneData && s_SceneData->CameraBuffer)
+			glDeleteBuffers(1, &s_SceneData->CameraBuffer);
 		delete s_SceneData;
 		s_SceneData = nullptr;
 		s_RendererInitialized = false;
@@ -37,12 +94,77 @@ namespace Hazel {
 
 	void Renderer::BeginScene(const Camera& camera)
 	{
+		HZ_PROFILE_FUNCTION();
+
+		if (RenderQueue* queue = t_RecordingQueue)
+		{
+			queue->BeginScene(camera.GetViewMatrix(), camera.GetProjectionMatrix(), nullptr);
+			return;
+		}
+
 		// Lazy initialization
-		if (!s_RendererInitialized)
-			Init();
+		if (!s_RendererInitialized && !Init())
+			return;
 
-		s_SceneData->ViewProjectionMatrix = camera.GetViewProjectionMatrix();
-		
+		s_SceneData->ViewProjectionMatrix = SetCamera(camera.GetViewMatrix(), camera.GetProjectionMatrix(), nullptr);
+		SetSceneState();
+	}
+
+	void Renderer::BeginScene(const Camera& camera, const CameraLatch& latch)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (RenderQueue* queue = t_RecordingQueue)
+		{
+			queue->BeginScene(camera.GetViewMatrix(), camera.GetProjectionMatrix(), &latch);
+			return;
+		}
+
+		if (!s_RendererInitialized && !Init())
+			return;
+
+		s_SceneData->ViewProjectionMatrix = SetCamera(camera.GetViewMatrix(), camera.GetProjectionMatrix(), &latch);
+		SetSceneState();
+	}
+
+	void Renderer::EndScene()
+	{
+		HZ_PROFILE_FUNCTION();
+
+	}
+
+	glm::mat4 Renderer::SetCamera(const glm::mat4& view, const glm::mat4& projection, const CameraLatch* latch)
+	{
+		CameraBlockData camera;
+		camera.View = view;
+
+		int64_t inputTime = 0;
+		if (latch && latch->Resolve(camera.View, inputTime))
+		{
+			s_FrameInputTime = (std::max)(s_FrameInputTime, inputTime);
+			float age = static_cast<float>((FrameClock::Now() - inputTime) / 1.0e6);
+			std::lock_guard<std::mutex> lock(s_StatsMutex);
+			s_LatchToSubmit.AddSample(age);
+		}
+
+		camera.Projection = projection;
+		camera.ViewProjection = projection * camera.View;
+		camera.Position = glm::inverse(camera.View)[3];
+
+		if (s_SceneData && s_SceneData->CameraBuffer)
+		{
+			glBindBuffer(GL_UNIFORM_BUFFER, s_SceneData->CameraBuffer);
+			glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(camera), &camera);
+			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+			glBindBufferRange(GL_UNIFORM_BUFFER, CameraBindingPoint, s_SceneData->CameraBuffer, 0, sizeof(camera));
+			s_FrameCounters.BufferBytesUploaded += sizeof(camera);
+		}
+
+		return camera.ViewProjection;
+	}
+
+	void Renderer::SetSceneState()
+	{
 		// Set up OpenGL state for 3D rendering (done each frame)
 		glEnable(GL_DEPTH_TEST);
 		glDepthFunc(GL_LESS);
@@ -50,47 +172,100 @@ namespace Hazel {
 		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	}
 
-	void Renderer::EndScene()
-	{
-	}
-
 	void Renderer::Submit(const std::shared_ptr<VertexArray>& vertexArray,
 	                      const std::shared_ptr<Material>& material,
 	                      const glm::mat4& transform)
 	{
-		material->Bind();
+		if (RenderQueue* queue = t_RecordingQueue)
+		{
+			queue->Draw(vertexArray, material, transform);
+			return;
+		}
 
-		auto shader = material->GetShader();
-		shader->SetMat4("u_ViewProjection", s_SceneData->ViewProjectionMatrix);
+		std::vector<LightData>& lights = s_SceneData->LightScratch;
+		lights.clear();
+		for (const auto& light : s_SceneData->Lights)
+			lights.push_back(light->GetData());
+
+		const IndexBuffer* indexBuffer = vertexArray->GetIndexBuffer();
+		DrawIndexed(*vertexArray, *material, material->GetProperties(),
+		            s_SceneData->ViewProjectionMatrix, transform, nullptr,
+		            lights.data(), lights.size(),
+		            indexBuffer->GetFirstIndex(), indexBuffer->GetCount(), indexBuffer->GetVertexCount());
+	}
+
+	void Renderer::SubmitPackets(const DrawPacket* const* packets, size_t count,
+	                             const std::vector<std::shared_ptr<const void>>& references)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (RenderQueue* queue = t_RecordingQueue)
+		{
+			queue->KeepAlive(references);
+			for (size_t i = 0; i < count; i++)
+				queue->Draw(*packets[i]);
+			return;
+		}
+
+		// The lights are the same for every packet
+		std::vector<LightData>& lights = s_SceneData->LightScratch;
+		lights.clear();
+		for (const auto& light : s_SceneData->Lights)
+			lights.push_back(light->GetData());
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const DrawPacket& packet = *packets[i];
+			DrawIndexed(*packet.VertexArrayPtr, *packet.MaterialPtr, packet.Properties,
+			            s_SceneData->ViewProjectionMatrix, packet.Transform, &packet.NormalMatrix,
+			            lights.data(), lights.size(),
+			            packet.FirstIndex, packet.IndexCount, packet.VertexCount);
+		}
+	}
+
+	void Renderer::DrawIndexed(const VertexArray& vertexArray, Material& material, const MaterialProperties& properties,
+	                           const glm::mat4& viewProjection, const glm::mat4& transform,
+	                           const glm::mat3* normalMatrix,
+	                           const LightData* lights, size_t lightCount,
+	                           unsigned int firstIndex, unsigned int indexCount, unsigned int vertexCount)
+	{
+		material.Bind(properties);
+
+		auto shader = material.GetShader();
+		if (!shader->UsesCameraBlock())
+			shader->SetMat4("u_ViewProjection", viewProjection);
 		shader->SetMat4("u_Transform", transform);
+		if (shader->UsesNormalMatrix())
+			shader->SetMat3(NormalMatrixUniform, normalMatrix ? *normalMatrix : TransformBatch::GetNormalMatrix(transform));
 
 		// Upload lights to shader
 		int dirLightCount = 0;
 		int pointLightCount = 0;
 		int spotLightCount = 0;
 
-		for (const auto& light : s_SceneData->Lights)
+		for (size_t i = 0; i < lightCount; i++)
 		{
-			switch (light->GetType())
+			const LightData& light = lights[i];
+			switch (light.Type)
 			{
 				case LightType::Directional:
 					if (dirLightCount < 4) // Max 4 directional lights
 					{
-						light->UploadToShader(shader, dirLightCount);
+						Light::Upload(light, shader, dirLightCount);
 						dirLightCount++;
 					}
 					break;
 				case LightType::Point:
 					if (pointLightCount < 4) // Max 4 point lights
 					{
-						light->UploadToShader(shader, pointLightCount);
+						Light::Upload(light, shader, pointLightCount);
 						pointLightCount++;
 					}
 					break;
 				case LightType::Spot:
 					if (spotLightCount < 4) // Max 4 spot lights
 					{
-						light->UploadToShader(shader, spotLightCount);
+						Light::Upload(light, shader, spotLightCount);
 						spotLightCount++;
 					}
 					break;
@@ -101,28 +276,124 @@ namespace Hazel {
 		shader->SetInt("u_PointLightCount", pointLightCount);
 		shader->SetInt("u_SpotLightCount", spotLightCount);
 
-		vertexArray->Bind();
-		glDrawElements(GL_TRIANGLES, vertexArray->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr);
+		vertexArray.Bind();
+		glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT,
+		               (const void*)(uintptr_t)(firstIndex * sizeof(unsigned int)));
+
+		s_FrameCounters.DrawCalls++;
+		s_FrameCounters.Instances++;
+		s_FrameCounters.Vertices += vertexCount;
+		s_FrameCounters.Triangles += indexCount / 3;
 	}
 
 	void Renderer::AddLight(const std::shared_ptr<Light>& light)
 	{
+		if (RenderQueue* queue = t_RecordingQueue)
+		{
+			queue->AddLight(light);
+			return;
+		}
+
 		s_SceneData->Lights.push_back(light);
 	}
 
 	void Renderer::ClearLights()
 	{
+		if (RenderQueue* queue = t_RecordingQueue)
+		{
+			queue->ClearLights();
+			return;
+		}
+
 		s_SceneData->Lights.clear();
 	}
 
 	void Renderer::SetClearColor(const glm::vec4& color)
 	{
+		if (RenderQueue* queue = t_RecordingQueue)
+		{
+			queue->SetClearColor(color);
+			return;
+		}
+
 		glClearColor(color.r, color.g, color.b, color.a);
 	}
 
 	void Renderer::Clear()
 	{
+		if (RenderQueue* queue = t_RecordingQueue)
+		{
+			queue->ClearFramebuffer();
+			return;
+		}
+
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	}
 
+	void Renderer::BeginRecording(RenderQueue& queue)
+	{
+		queue.Clear();
+		queue.m_OuterRecording = t_RecordingQueue;
+		t_RecordingQueue = &queue;
+	}
+
+	void Renderer::EndRecording()
+	{
+		if (RenderQueue* queue = t_RecordingQueue)
+		{
+			t_RecordingQueue = queue->m_OuterRecording;
+			queue->m_OuterRecording = nullptr;
+		}
+	}
+
+	RenderQueue* Renderer::GetRecordingQueue()
+	{
+		return t_RecordingQueue;
+	}
+
+	void Renderer::BeginFrame()
+	{
+		if (RenderQueue* queue = t_RecordingQueue)
+		{
+			queue->Callback([]() { BeginFrame(); });
+			return;
+		}
+
+		s_FrameInputTime = 0;
+		std::lock_guard<std::mutex> lock(s_StatsMutex);
+		s_LastFrameStats = s_FrameCounters;
+		s_FrameCounters = RendererStats();
+	}
+
+	void Renderer::OnPresented()
+	{
+		if (s_FrameInputTime == 0)
+			return;
+
+		float age = static_cast<float>((FrameClock::Now() - s_FrameInputTime) / 1.0e6);
+		s_FrameInputTime = 0;
+		std::lock_guard<std::mutex> lock(s_StatsMutex);
+		s_LatchToPresent.AddSample(age);
+	}
+
+	InputLatencyStats Renderer::GetInputLatency()
+	{
+		std::lock_guard<std::mutex> lock(s_StatsMutex);
+		InputLatencyStats stats;
+		stats.ToSubmit = s_LatchToSubmit.GetSummary();
+		stats.ToPresent = s_LatchToPresent.GetSummary();
+		return stats;
+	}
+
+	RendererStats Renderer::GetStats()
+	{
+		std::lock_guard<std::mutex> lock(s_StatsMutex);
+		return s_LastFrameStats;
+	}
+
+	RendererStats& Renderer::GetFrameCounters()
+	{
+		return s_FrameCounters;
+	}
+
 }
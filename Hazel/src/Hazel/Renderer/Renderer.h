@@ -6,6 +6,7 @@
 #include "Buffer.h"
 #include "Material.h"
 #include "Light.h"
+#include "../Debug/FrameTimeHistogram.h"
 #include <glm/glm.hpp>
 #include <memory>
 
@@ -16,13 +17,62 @@ namespace Hazel {
 	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
 #endif
 
+	class RenderQueue;
+	class ParallelDrawList;
+	class CameraLatch;
+	struct DrawPacket;
+
+	// What the renderer handed to OpenGL during one frame
+	struct RendererStats
+	{
+		uint32_t DrawCalls = 0;
+		// One per draw call until draws are instanced
+		uint32_t Instances = 0;
+		uint64_t Triangles = 0;
+		// Distinct vertices each draw's index range references, per instance
+		uint64_t Vertices = 0;
+		uint32_t ProgramBinds = 0;
+		uint32_t VertexArrayBinds = 0;
+		uint32_t TextureBinds = 0;
+		uint32_t UniformUploads = 0;
+		uint64_t BufferBytesUploaded = 0;
+	};
+
+	// Age of the input behind latched cameras (see CameraLatch), in milliseconds
+	struct InputLatencyStats
+	{
+		// Until the scene's draws were issued
+		FrameTimeSummary ToSubmit;
+		// Until glfwSwapBuffers returned for the frame; scan-out adds up to one refresh
+		FrameTimeSummary ToPresent;
+	};
+
 	class HAZEL_API Renderer
 	{
 	public:
-		static void Init();
+		// Needs a current OpenGL context; false when its functions cannot be loaded
+		static bool Init();
 		static void Shutdown();
 
+		// Shaders receive the scene camera through this uniform block; programs
+		// that declare it are bound to CameraBindingPoint when they link:
+		//
+		//     layout(std140) uniform Camera { mat4 u_ViewProjection; mat4 u_View; mat4 u_Projection; vec4 u_CameraPosition; };
+		//
+		// Shaders with a plain u_ViewProjection uniform keep getting it per draw.
+		static constexpr unsigned int CameraBindingPoint = 0;
+		static constexpr const char* CameraBlockName = "Camera";
+
+		// Inverse transpose of u_Transform's upper 3x3, uploaded with each draw
+		// to shaders that declare it (see Shader::UsesNormalMatrix)
+		static constexpr const char* NormalMatrixUniform = "u_NormalMatrix";
+
 		static void BeginScene(const Camera& camera);
+		// Takes the view from 'latch' when the scene's draws are issued: right
+		// away when rendering immediately, at replay when recording, so a
+		// recorded frame picks up input published after it was recorded. The
+		// projection is the camera's. 'latch' must outlive recorded frames.
+		static void BeginScene(const Camera& camera, const CameraLatch& latch);
 		static void EndScene();
 
 		static void Submit(const std::shared_ptr<VertexArray>& vertexArray, 
@@ -35,11 +85,57 @@ namespace Hazel {
 		static void SetClearColor(const glm::vec4& color);
 		static void Clear();
 
+		// While a queue is being recorded on a thread, BeginScene, Submit, the
+		// light functions, SetClearColor and Clear called from that thread append
+		// to the queue instead of drawing, starting from an empty light list.
+		// Other threads keep rendering immediately.
+		// Recordings nest: EndRecording() resumes the queue that was being
+		// recorded when the matching BeginRecording() was called, so a thread
+		// that runs jobs while it waits keeps its own recording intact.
+		static void BeginRecording(RenderQueue& queue);
+		static void EndRecording();
+		// Queue the calling thread records into, or nullptr when it renders immediately
+		static RenderQueue* GetRecordingQueue();
+
+		// Closes the previous frame's statistics; called by the application once
+		// per frame, and recorded like any other command, so the counters follow
+		// the frame to the thread that replays it
+		static void BeginFrame();
+		// Statistics of the last completed frame
+		static RendererStats GetStats();
+		// Counters of the frame being drawn; for renderer code on the thread that owns the context
+		static RendererStats& GetFrameCounters();
+
+		// Called by whoever presents, right after swapping the frame's buffers
+		static void OnPresented();
+		// Over the last 600 latched scenes and presented frames
+		static InputLatencyStats GetInputLatency();
+
+	private:
+		friend class RenderQueue;
+		friend class ParallelDrawList;
+
+		// Submits packets in the given order; 'references' keeps their objects alive
+		static void SubmitPackets(const DrawPacket* const* packets, size_t count,
+		                          const std::vector<std::shared_ptr<const void>>& references);
+		static void SetSceneState();
+		// Resolves 'latch' if given, uploads the camera block and returns the view-projection
+		static glm::mat4 SetCamera(const glm::mat4& view, const glm::mat4& projection, const CameraLatch* latch);
+		static void DrawIndexed(const VertexArray& vertexArray, Material& material, const MaterialProperties& properties,
+		                        const glm::mat4& viewProjection, const glm::mat4& transform,
+		                        const glm::mat3* normalMatrix, // Derived from 'transform' when null
+		                        const LightData* lights, size_t lightCount,
+		                        unsigned int firstIndex, unsigned int indexCount, unsigned int vertexCount);
+
 	private:
 		struct SceneData
 		{
 			glm::mat4 ViewProjectionMatrix;
+			// Uniform buffer behind the camera block; 0 without uniform buffer support
+			unsigned int CameraBuffer = 0;
 			std::vector<std::shared_ptr<Light>> Lights;
+			// Lights as uploaded by the last Submit(), reused to avoid allocating
+			std::vector<LightData> LightScratch;
 		};
 
 		static SceneData* s_SceneData;
@@ -1,6 +1,8 @@
 #include "Shader.h"
 #include "OpenGLLoader.h"
+#include "Renderer.h"
 #include "../Log.h"
+#include "../Debug/Profiler.h"
 #include <vector>
 
 namespace Hazel {
@@ -20,7 +22,7 @@ namespace Hazel {
 			glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
 			std::vector<char> infoLog(length);
 			glGetShaderInfoLog(shader, length, &length, infoLog.data());
-			HZ_ERROR("Shader compilation failed: " + std::string(infoLog.data()));
+			HZ_ERROR("Shader compilation failed: {}", infoLog.data());
 			glDeleteShader(shader);
 			return 0;
 		}
@@ -30,6 +32,8 @@ namespace Hazel {
 
 	Shader::Shader(const std::string& vertexSrc, const std::string& fragmentSrc)
 	{
+		HZ_PROFILE_FUNCTION();
+
 		// Compile shaders
 		unsigned int vertexShader = CompileShader(GL_VERTEX_SHADER, vertexSrc);
 		unsigned int fragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentSrc);
@@ -48,13 +52,26 @@ namespace Hazel {
 			glGetProgramiv(m_RendererID, GL_INFO_LOG_LENGTH, &length);
 			std::vector<char> infoLog(length);
 			glGetProgramInfoLog(m_RendererID, length, &length, infoLog.data());
-			HZ_ERROR("Shader linking failed: " + std::string(infoLog.data()));
+			HZ_ERROR("Shader linking failed: {}", infoLog.data());
 		}
 
 		// Clean up
 		glDeleteShader(vertexShader);
 		glDeleteShader(fragmentShader);
 
+		if (success && glGetUniformBlockIndex && glUniformBlockBinding)
+		{
+			unsigned int cameraBlock = glGetUniformBlockIndex(m_RendererID, Renderer::CameraBlockName);
+			if (cameraBlock != GL_INVALID_INDEX)
+			{
+				glUniformBlockBinding(m_RendererID, cameraBlock, Renderer::CameraBindingPoint);
+				m_UsesCameraBlock = true;
+			}
+		}
+
+		if (success)
+			m_UsesNormalMatrix = glGetUniformLocation(m_RendererID, Renderer::NormalMatrixUniform) != -1;
+
 		HZ_INFO("Shader created successfully");
 	}
 
@@ -66,6 +83,7 @@ namespace Hazel {
 	void Shader::Bind() const
 	{
 		glUseProgram(m_RendererID);
+		Renderer::GetFrameCounters().ProgramBinds++;
 	}
 
 	void Shader::Unbind() const
@@ -73,29 +91,52 @@ namespace Hazel {
 		glUseProgram(0);
 	}
 
-	void Shader::SetInt(const std::string& name, int value)
+	void Shader::SetInt(const char* name, int value)
+	{
+		glUniform1i(glGetUniformLocation(m_RendererID, name), value);
+		Renderer::GetFrameCounters().UniformUploads++;
+	}
+
+	void Shader::SetFloat(const char* name, float value)
+	{
+		glUniform1f(glGetUniformLocation(m_RendererID, name), value);
+		Renderer::GetFrameCounters().UniformUploads++;
+	}
+
+	void Shader::SetFloat3(const char* name, const glm::vec3& value)
 	{
-		glUniform1i(glGetUniformLocation(m_RendererID, name.c_str()), value);
+		glUniform3f(glGetUniformLocation(m_RendererID, name), value.x, value.y, value.z);
+		Renderer::GetFrameCounters().UniformUploads++;
 	}
 
-	void Shader::SetFloat(const std::string& name, float value)
+	void Shader::SetFloat4(const char* name, const glm::vec4& value)
 	{
-		glUniform1f(glGetUniformLocation(m_RendererID, name.c_str()), value);
+		glUniform4f(glGetUniformLocation(m_RendererID, name), value.x, value.y, value.z, value.w);
+		Renderer::GetFrameCounters().UniformUploads++;
 	}
 
-	void Shader::SetFloat3(const std::string& name, const glm::vec3& value)
+	void Shader::SetMat3(const char* name, const glm::mat3& value)
 	{
-		glUniform3f(glGetUniformLocation(m_RendererID, name.c_str()), value.x, value.y, value.z);
+		glUniformMatrix3fv(glGetUniformLocation(m_RendererID, name), 1, GL_FALSE, &value[0][0]);
+		Renderer::GetFrameCounters().UniformUploads++;
 	}
 
-	void Shader::SetFloat4(const std::string& name, const glm::vec4& value)
+	void Shader::SetMat4(const char* name, const glm::mat4& value)
 	{
-		glUniform4f(glGetUniformLocation(m_RendererID, name.c_str()), value.x, value.y, value.z, value.w);
+		glUniformMatrix4fv(glGetUniformLocation(m_RendererID, name), 1, GL_FALSE, &value[0][0]);
+		Renderer::GetFrameCounters().UniformUploads++;
 	}
 
-	void Shader::SetMat4(const std::string& name, const glm::mat4& value)
+	void Shader::SetUniformBlockBinding(const std::string& blockName, unsigned int binding)
 	{
-		glUniformMatrix4fv(glGetUniformLocation(m_RendererID, name.c_str()), 1, GL_FALSE, &value[0][0]);
+		unsigned int blockIndex = glGetUniformBlockIndex(m_RendererID, blockName.c_str());
+		if (blockIndex == GL_INVALID_INDEX)
+		{
+			HZ_WARN("Shader has no uniform block named {}", blockName);
+			return;
+		}
+
+		glUniformBlockBinding(m_RendererID, blockIndex, binding);
 	}
 
-}
+}
\ No newline at end of file
@@ -15,15 +15,37 @@ namespace Hazel {
 		void Bind() const;
 		void Unbind() const;
 
-		// Uniform setters
-		void SetInt(const std::string& name, int value);
-		void SetFloat(const std::string& name, float value);
-		void SetFloat3(const std::string& name, const glm::vec3& value);
-		void SetFloat4(const std::string& name, const glm::vec4& value);
-		void SetMat4(const std::string& name, const glm::mat4& value);
+		// Uniform setters. The const char* overloads let literal names through
+		// without building a std::string on every call.
+		void SetInt(const char* name, int value);
+		void SetFloat(const char* name, float value);
+		void SetFloat3(const char* name, const glm::vec3& value);
+		void SetFloat4(const char* name, const glm::vec4& value);
+		void SetMat3(const char* name, const glm::mat3& value);
+		void SetMat4(const char* name, const glm::mat4& value);
+
+		void SetInt(const std::string& name, int value) { SetInt(name.c_str(), value); }
+		void SetFloat(const std::string& name, float value) { SetFloat(name.c_str(), value); }
+		void SetFloat3(const std::string& name, const glm::vec3& value) { SetFloat3(name.c_str(), value); }
+		void SetFloat4(const std::string& name, const glm::vec4& value) { SetFloat4(name.c_str(), value); }
+		void SetMat3(const std::string& name, const glm::mat3& value) { SetMat3(name.c_str(), value); }
+		void SetMat4(const std::string& name, const glm::mat4& value) { SetMat4(name.c_str(), value); }
+
+		// Attach a uniform block (e.g. "BoneMatrices") to a uniform buffer binding point
+		void SetUniformBlockBinding(const std::string& blockName, unsigned int binding);
+
+		// True when the program declares Renderer's camera block, which is then
+		// bound already and replaces the per-draw u_ViewProjection upload
+		bool UsesCameraBlock() const { return m_UsesCameraBlock; }
+
+		// True when the program reads u_NormalMatrix; Renderer uploads it with
+		// every draw only then, in place of the vertex stage inverting u_Transform
+		bool UsesNormalMatrix() const { return m_UsesNormalMatrix; }
 
 	private:
 		unsigned int m_RendererID;
+		bool m_UsesCameraBlock = false;
+		bool m_UsesNormalMatrix = false;
 	};
 
 }
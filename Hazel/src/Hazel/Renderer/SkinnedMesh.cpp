@@ -0,0 +1,97 @@
+#include "SkinnedMesh.h"
+#include "Mesh.h"
+#include "../Log.h"
+#include "../Threading/JobSystem.h"
+#include <vector>
+
+namespace Hazel {
+
+	// Skinning a vertex is ~100 flops; below this many per job the scheduling dominates
+	static constexpr size_t s_MinVerticesPerJob = 8192;
+
+	SkinnedMesh::SkinnedMesh(const std::vector<SkinnedVertex>& vertices, const std::vector<unsigned int>& indices)
+		: m_Vertices(vertices), m_IndexCount(static_cast<unsigned int>(indices.size()))
+	{
+		static_assert(sizeof(SkinnedVertex) == 14 * sizeof(float), "SkinnedVertex must match GetLayout()");
+
+		m_VertexArray = std::make_shared<VertexArray>();
+
+		m_VertexBuffer = std::make_shared<VertexBuffer>(reinterpret_cast<float*>(m_Vertices.data()),
+		                                                static_cast<unsigned int>(m_Vertices.size() * sizeof(SkinnedVertex)));
+		m_VertexBuffer->SetLayout(GetLayout());
+		m_VertexArray->AddVertexBuffer(m_VertexBuffer.get());
+
+		m_IndexBuffer = std::make_shared<IndexBuffer>(const_cast<unsigned int*>(indices.data()), m_IndexCount);
+		m_IndexBuffer->SetDrawRange(0, m_IndexCount, static_cast<unsigned int>(m_Vertices.size()));
+		m_VertexArray->SetIndexBuffer(m_IndexBuffer.get());
+	}
+
+	BufferLayout SkinnedMesh::GetLayout()
+	{
+		return {
+			{ ShaderDataType::Float3, "a_Position" },
+			{ ShaderDataType::Float3, "a_Normal" },
+			{ ShaderDataType::Float4, "a_Joints" },
+			{ ShaderDataType::Float4, "a_Weights" }
+		};
+	}
+
+	const std::shared_ptr<VertexArray>& SkinnedMesh::SkinOnCPU(const glm::mat4* skinningMatrices)
+	{
+		unsigned int bytes = static_cast<unsigned int>(m_Vertices.size() * 6 * sizeof(float));
+
+		if (!m_SkinnedVertexArray)
+		{
+			m_SkinnedVertexArray = std::make_shared<VertexArray>();
+			m_SkinnedVertexBuffer = std::make_shared<VertexBuffer>(bytes);
+			m_SkinnedVertexBuffer->SetLayout(Mesh::GetDefaultLayout());
+			m_SkinnedVertexArray->AddVertexBuffer(m_SkinnedVertexBuffer.get());
+			m_SkinnedVertexArray->SetIndexBuffer(m_IndexBuffer.get());
+		}
+
+		// Skin straight into the mapped buffer; the invalidating map lets the
+		// driver hand out fresh storage instead of stalling on last frame's draw
+		float* mapped = static_cast<float*>(m_SkinnedVertexBuffer->Map());
+		if (mapped)
+		{
+			Skin(m_Vertices.data(), m_Vertices.size(), skinningMatrices, mapped);
+			m_SkinnedVertexBuffer->Unmap();
+		}
+		else
+		{
+			HZ_WARN("SkinnedMesh: buffer mapping failed, skinning through a staging copy");
+			std::vector<float> staging(m_Vertices.size() * 6);
+			Skin(m_Vertices.data(), m_Vertices.size(), skinningMatrices, staging.data());
+			m_SkinnedVertexBuffer->SetData(staging.data(), bytes);
+		}
+
+		return m_SkinnedVertexArray;
+	}
+
+	void SkinnedMesh::Skin(const SkinnedVertex* vertices, size_t count, const glm::mat4* skinningMatrices, float* out)
+	{
+		JobSystem::ParallelFor(count, s_MinVerticesPerJob, [=](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				const SkinnedVertex& vertex = vertices[i];
+				glm::mat4 skin = skinningMatrices[static_cast<int>(vertex.Joints.x)] * vertex.Weights.x
+				               + skinningMatrices[static_cast<int>(vertex.Joints.y)] * vertex.Weights.y
+				               + skinningMatrices[static_cast<int>(vertex.Joints.z)] * vertex.Weights.z
+				               + skinningMatrices[static_cast<int>(vertex.Joints.w)] * vertex.Weights.w;
+
+				glm::vec3 position = glm::vec3(skin * glm::vec4(vertex.Position, 1.0f));
+				glm::vec3 normal = glm::normalize(glm::mat3(skin) * vertex.Normal);
+
+				float* target = out + i * 6;
+				target[0] = position.x;
+				target[1] = position.y;
+				target[2] = position.z;
+				target[3] = normal.x;
+				target[4] = normal.y;
+				target[5] = normal.z;
+			}
+		});
+	}
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../Core.h"
+#include "Buffer.h"
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+namespace Hazel {
+
+	// Vertex influenced by up to four joints. Joint indices are stored as floats
+	// so they go through the same attribute path as every other vertex stream.
+	struct SkinnedVertex
+	{
+		glm::vec3 Position = glm::vec3(0.0f);
+		glm::vec3 Normal = glm::vec3(0.0f, 1.0f, 0.0f);
+		glm::vec4 Joints = glm::vec4(0.0f);
+		glm::vec4 Weights = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f);
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
+	// Skinned geometry with two ways to draw it:
+	//  - GPU: GetVertexArray() with a shader reading the "BoneMatrices" uniform
+	//    block (see SkinningBuffer)
+	//  - CPU fallback: SkinOnCPU() deforms the vertices on worker threads into a
+	//    second buffer using Mesh::GetDefaultLayout(), drawable with any static mesh shader
+	class HAZEL_API SkinnedMesh
+	{
+	public:
+		SkinnedMesh(const std::vector<SkinnedVertex>& vertices, const std::vector<unsigned int>& indices);
+
+		// [a_Position, a_Normal, a_Joints, a_Weights]
+		static BufferLayout GetLayout();
+
+		const std::shared_ptr<VertexArray>& GetVertexArray() const { return m_VertexArray; }
+		const std::shared_ptr<VertexArray>& SkinOnCPU(const glm::mat4* skinningMatrices);
+
+		unsigned int GetVertexCount() const { return static_cast<unsigned int>(m_Vertices.size()); }
+		unsigned int GetIndexCount() const { return m_IndexCount; }
+
+		// Linear blend skinning of 'count' vertices into [position.xyz, normal.xyz] pairs
+		static void Skin(const SkinnedVertex* vertices, size_t count, const glm::mat4* skinningMatrices, float* out);
+
+	private:
+		std::vector<SkinnedVertex> m_Vertices;
+		unsigned int m_IndexCount;
+
+		// Buffers are declared first so the vertex arrays referencing them are destroyed first
+		std::shared_ptr<VertexBuffer> m_VertexBuffer;
+		std::shared_ptr<IndexBuffer> m_IndexBuffer;
+		std::shared_ptr<VertexArray> m_VertexArray;
+
+		// Created on first use of the CPU path
+		std::shared_ptr<VertexBuffer> m_SkinnedVertexBuffer;
+		std::shared_ptr<VertexArray> m_SkinnedVertexArray;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
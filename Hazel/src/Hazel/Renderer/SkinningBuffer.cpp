@@ -0,0 +1,91 @@
+#include "SkinningBuffer.h"
+#include "OpenGLLoader.h"
+#include "Renderer.h"
+#include "RenderQueue.h"
+#include "../Log.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Hazel {
+
+	SkinningBuffer::SkinningBuffer(unsigned int paletteCapacity)
+		: m_Capacity(paletteCapacity), m_DirtyBegin(paletteCapacity)
+	{
+		// Every palette slice must start on the driver's binding alignment
+		GLint alignment = 256;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		alignment = (std::max)(alignment, 16);
+
+		unsigned int paletteBytes = MaxBones * sizeof(glm::mat4);
+		m_PaletteStride = (paletteBytes + alignment - 1) / alignment * alignment;
+		m_Staging.resize(static_cast<size_t>(m_PaletteStride) * m_Capacity);
+
+		glGenBuffers(1, &m_RendererID);
+		glBindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+		glBufferData(GL_UNIFORM_BUFFER, m_Staging.size(), nullptr, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	SkinningBuffer::~SkinningBuffer()
+	{
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	void SkinningBuffer::SetPalette(unsigned int palette, const glm::mat4* matrices, unsigned int count)
+	{
+		if (palette >= m_Capacity)
+		{
+			HZ_WARN("SkinningBuffer: palette {} exceeds capacity {}", palette, m_Capacity);
+			return;
+		}
+
+		count = (std::min)(count, MaxBones);
+		std::memcpy(m_Staging.data() + static_cast<size_t>(palette) * m_PaletteStride, matrices, count * sizeof(glm::mat4));
+
+		m_DirtyBegin = (std::min)(m_DirtyBegin, palette);
+		m_DirtyEnd = (std::max)(m_DirtyEnd, palette + 1);
+	}
+
+	void SkinningBuffer::Upload()
+	{
+		if (m_DirtyBegin >= m_DirtyEnd)
+			return;
+
+		size_t offset = static_cast<size_t>(m_DirtyBegin) * m_PaletteStride;
+		size_t size = static_cast<size_t>(m_DirtyEnd - m_DirtyBegin) * m_PaletteStride;
+
+		if (RenderQueue* queue = Renderer::GetRecordingQueue())
+		{
+			// The queue keeps its own copy, so the staging area is free for the next frame
+			queue->UploadBuffer(GL_UNIFORM_BUFFER, m_RendererID, offset, m_Staging.data() + offset, size);
+		}
+		else
+		{
+			glBindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+			glBufferSubData(GL_UNIFORM_BUFFER, offset, size, m_Staging.data() + offset);
+			Renderer::GetFrameCounters().BufferBytesUploaded += size;
+			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		}
+
+		m_DirtyBegin = m_Capacity;
+		m_DirtyEnd = 0;
+	}
+
+	void SkinningBuffer::Bind(unsigned int palette) const
+	{
+		if (palette >= m_Capacity)
+			return;
+
+		size_t offset = static_cast<size_t>(palette) * m_PaletteStride;
+		if (RenderQueue* queue = Renderer::GetRecordingQueue())
+			queue->BindBufferRange(GL_UNIFORM_BUFFER, BindingPoint, m_RendererID, offset, MaxBones * sizeof(glm::mat4));
+		else
+			glBindBufferRange(GL_UNIFORM_BUFFER, BindingPoint, m_RendererID, static_cast<GLintptr>(offset), MaxBones * sizeof(glm::mat4));
+	}
+
+	bool SkinningBuffer::IsSupported()
+	{
+		return glBindBufferRange != nullptr && glGetUniformBlockIndex != nullptr && glUniformBlockBinding != nullptr;
+	}
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../Core.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Hazel {
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
+	// One uniform buffer holding the bone-matrix palettes of many skinned
+	// characters. Palettes are staged on the CPU, uploaded with a single call per
+	// frame, and each draw binds its own slice to the "BoneMatrices" block:
+	//
+	//     layout(std140) uniform BoneMatrices { mat4 u_Bones[128]; };
+	class HAZEL_API SkinningBuffer
+	{
+	public:
+		static constexpr unsigned int MaxBones = 128;
+		static constexpr unsigned int BindingPoint = 1;
+		static constexpr const char* BlockName = "BoneMatrices";
+
+		SkinningBuffer(unsigned int paletteCapacity);
+		~SkinningBuffer();
+
+		SkinningBuffer(const SkinningBuffer&) = delete;
+		SkinningBuffer& operator=(const SkinningBuffer&) = delete;
+
+		void SetPalette(unsigned int palette, const glm::mat4* matrices, unsigned int count);
+		// Uploads every palette written since the last upload. Both calls are
+		// recorded instead when the thread is recording a RenderQueue.
+		void Upload();
+		// Binds one palette to BindingPoint for the following draws
+		void Bind(unsigned int palette) const;
+
+		unsigned int GetCapacity() const { return m_Capacity; }
+
+		// False when the context lacks uniform buffer support; use SkinnedMesh::SkinOnCPU then
+		static bool IsSupported();
+
+	private:
+		unsigned int m_RendererID = 0;
+		unsigned int m_Capacity;
+		unsigned int m_PaletteStride;
+		std::vector<unsigned char> m_Staging;
+		unsigned int m_DirtyBegin;
+		unsigned int m_DirtyEnd = 0;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
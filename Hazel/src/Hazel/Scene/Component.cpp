@@ -0,0 +1,46 @@
+#include "Component.h"
+#include "../Log.h"
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+namespace Hazel {
+
+	static std::mutex s_RegistryMutex;
+	static ComponentInfo s_Components[MaxComponentTypes];
+	static uint32_t s_ComponentCount = 0;
+
+	ComponentId ComponentRegistry::Register(const ComponentInfo& info)
+	{
+		std::lock_guard<std::mutex> lock(s_RegistryMutex);
+
+		// Another module may have registered the same type already
+		for (uint32_t id = 0; id < s_ComponentCount; id++)
+		{
+			if (std::strcmp(s_Components[id].Name, info.Name) == 0)
+				return id;
+		}
+
+		if (s_ComponentCount == MaxComponentTypes)
+		{
+			HZ_FATAL("Scene: more than {} component types; cannot register {}", MaxComponentTypes, info.Name);
+			std::abort();
+		}
+
+		s_Components[s_ComponentCount] = info;
+		return s_ComponentCount++;
+	}
+
+	const ComponentInfo& ComponentRegistry::GetInfo(ComponentId id)
+	{
+		// Entries are written once, before their id is handed out
+		return s_Components[id];
+	}
+
+	uint32_t ComponentRegistry::GetCount()
+	{
+		std::lock_guard<std::mutex> lock(s_RegistryMutex);
+		return s_ComponentCount;
+	}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "../Core.h"
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace Hazel {
+
+	using ComponentId = uint32_t;
+	// Bit i set for component id i
+	using ComponentMask = uint64_t;
+
+	constexpr uint32_t MaxComponentTypes = 64;
+
+	// How the scene stores a component type without knowing it
+	struct ComponentInfo
+	{
+		const char* Name = nullptr;
+		uint32_t Size = 0;
+		uint32_t Alignment = 0;
+		// Trivially copyable and destructible: rows are moved with memcpy and never destroyed
+		bool Trivial = false;
+
+		void (*Construct)(void* memory) = nullptr;
+		void (*Destroy)(void* memory) = nullptr;
+		// Move-constructs into uninitialized 'destination' and destroys 'source'
+		void (*Relocate)(void* destination, void* source) = nullptr;
+	};
+
+	// Process-wide component ids. Types are registered on first use, keyed by
+	// their type name, so the engine and the applications that link it agree
+	// on the ids even though each module instantiates GetId<T>() separately.
+	class HAZEL_API ComponentRegistry
+	{
+	public:
+		template<typename T>
+		static ComponentId GetId()
+		{
+			static_assert(std::is_same_v<T, std::decay_t<T>>, "Components are plain value types");
+			static_assert(alignof(T) <= 64, "Chunk arrays are only 64-byte aligned");
+			static const ComponentId id = Register(MakeInfo<T>());
+			return id;
+		}
+
+		template<typename T>
+		static ComponentMask GetBit() { return ComponentMask(1) << GetId<T>(); }
+
+		static const ComponentInfo& GetInfo(ComponentId id);
+		static uint32_t GetCount();
+
+	private:
+		template<typename T>
+		static ComponentInfo MakeInfo()
+		{
+			ComponentInfo info;
+			info.Name = typeid(T).name();
+			info.Size = static_cast<uint32_t>(sizeof(T));
+			info.Alignment = static_cast<uint32_t>(alignof(T));
+			info.Trivial = std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>;
+			info.Construct = [](void* memory) { new (memory) T(); };
+			info.Destroy = [](void* memory) { static_cast<T*>(memory)->~T(); };
+			info.Relocate = [](void* destination, void* source)
+			{
+				T* from = static_cast<T*>(source);
+				new (destination) T(std::move(*from));
+				from->~T();
+			};
+			return info;
+		}
+
+		static ComponentId Register(const ComponentInfo& info);
+	};
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Entity.h"
+#include <glm/glm.hpp>
+#include <cmath>
+#include <string>
+
+namespace Hazel {
+
+	struct NameComponent
+	{
+		std::string Name;
+	};
+
+	// Local to the parent when the entity has a ParentComponent
+	struct TransformComponent
+	{
+		glm::vec3 Position = glm::vec3(0.0f);
+		glm::vec3 Rotation = glm::vec3(0.0f); // Euler angles in degrees, applied X, Y, Z
+		glm::vec3 Scale = glm::vec3(1.0f);
+
+		// translate * rotateX * rotateY * rotateZ * scale, written out
+		glm::mat4 GetTransform() const
+		{
+			glm::vec3 radians = glm::radians(Rotation);
+			float cx = std::cos(radians.x), sx = std::sin(radians.x);
+			float cy = std::cos(radians.y), sy = std::sin(radians.y);
+			float cz = std::cos(radians.z), sz = std::sin(radians.z);
+
+			glm::mat4 transform;
+			transform[0] = glm::vec4(cy * cz, cx * sz + sx * sy * cz, sx * sz - cx * sy * cz, 0.0f) * Scale.x;
+			transform[1] = glm::vec4(-cy * sz, cx * cz - sx * sy * sz, sx * cz + cx * sy * sz, 0.0f) * Scale.y;
+			transform[2] = glm::vec4(sy, -sx * cy, cx * cy, 0.0f) * Scale.z;
+			transform[3] = glm::vec4(Position, 1.0f);
+			return transform;
+		}
+	};
+
+	// Set through TransformSystem::SetParent, which keeps the hierarchy acyclic
+	struct ParentComponent
+	{
+		Entity Parent;
+	};
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Hazel {
+
+	// Handle to an entity of a Scene: a slot index and the generation the slot
+	// had when the entity was created. Destroying an entity bumps the
+	// generation, so a stale handle is recognized instead of aliasing the
+	// entity that reuses the slot.
+	struct Entity
+	{
+		static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+		uint32_t Index = InvalidIndex;
+		uint32_t Generation = 0;
+
+		bool IsNull() const { return Index == InvalidIndex; }
+		explicit operator bool() const { return !IsNull(); }
+
+		bool operator==(const Entity& other) const { return Index == other.Index && Generation == other.Generation; }
+		bool operator!=(const Entity& other) const { return !(*this == other); }
+	};
+
+}
@@ -0,0 +1,525 @@
+#include "Scene.h"
+#include "../Log.h"
+#include "../Memory/MemoryTracker.h"
+#include "../Debug/Profiler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace Hazel {
+
+	static constexpr size_t ChunkAlignment = 64;
+
+	static size_t AlignUp(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	static unsigned char* AllocateChunkData()
+	{
+		HZ_MEMORY_TAG(Scene);
+		return static_cast<unsigned char*>(::operator new(SceneChunk::Size, std::align_val_t(ChunkAlignment)));
+	}
+
+	static void FreeChunkData(unsigned char* data)
+	{
+		::operator delete(data, std::align_val_t(ChunkAlignment));
+	}
+
+	// 'row' of component 'id' in 'chunk'
+	static unsigned char* GetCell(const Archetype& type, const SceneChunk& chunk, ComponentId id, uint32_t row)
+	{
+		return static_cast<unsigned char*>(type.GetColumn(chunk, id)) + static_cast<size_t>(row) * ComponentRegistry::GetInfo(id).Size;
+	}
+
+	static void RelocateCell(const ComponentInfo& info, void* destination, void* source)
+	{
+		if (info.Trivial)
+			std::memcpy(destination, source, info.Size);
+		else
+			info.Relocate(destination, source);
+	}
+
+	static Entity* GetEntitiesMutable(SceneChunk& chunk)
+	{
+		return reinterpret_cast<Entity*>(chunk.Data);
+	}
+
+	Scene::Scene()
+	{
+		// The archetype of entities without components always exists
+		GetArchetype(0);
+	}
+
+	Scene::~Scene()
+	{
+		Clear();
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Entities /////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	Entity Scene::CreateEntity()
+	{
+		const SceneChunk* chunk = nullptr;
+		uint32_t row = 0;
+		return AllocateEntity(GetArchetype(0), chunk, row);
+	}
+
+	Archetype& Scene::CreateEntities(ComponentMask mask, size_t count, Entity* outEntities)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		Archetype* type = GetArchetype(mask);
+		if (m_FreeSlots.size() < count)
+		{
+			HZ_MEMORY_TAG(Scene);
+			m_Records.reserve(m_Records.size() + count - m_FreeSlots.size());
+		}
+
+		// A chunk's worth of rows at a time, constructing each component array in one pass
+		size_t created = 0;
+		while (created < count)
+		{
+			uint32_t chunkIndex = 0;
+			uint32_t firstRow = 0;
+			AllocateRow(type, chunkIndex, firstRow);
+			SceneChunk& chunk = type->m_Chunks[chunkIndex];
+			uint32_t rows = static_cast<uint32_t>((std::min)(count - created, static_cast<size_t>(type->m_ChunkCapacity - firstRow)));
+			chunk.Count = firstRow + rows;
+			type->m_EntityCount += rows - 1;
+
+			Entity* entities = GetEntitiesMutable(chunk);
+			for (uint32_t row = firstRow; row < firstRow + rows; row++)
+			{
+				uint32_t index;
+				if (!m_FreeSlots.empty())
+				{
+					index = m_FreeSlots.back();
+					m_FreeSlots.pop_back();
+				}
+				else
+				{
+					HZ_MEMORY_TAG(Scene);
+					index = static_cast<uint32_t>(m_Records.size());
+					m_Records.emplace_back();
+				}
+
+				EntityRecord& record = m_Records[index];
+				record.Type = type;
+				record.Chunk = chunkIndex;
+				record.Row = row;
+
+				Entity entity;
+				entity.Index = index;
+				entity.Generation = record.Generation;
+				entities[row] = entity;
+				if (outEntities)
+					outEntities[created + (row - firstRow)] = entity;
+			}
+
+			for (ComponentId id : type->m_Components)
+			{
+				const ComponentInfo& info = ComponentRegistry::GetInfo(id);
+				unsigned char* cell = GetCell(*type, chunk, id, firstRow);
+				for (uint32_t row = 0; row < rows; row++, cell += info.Size)
+					info.Construct(cell);
+			}
+
+			created += rows;
+		}
+
+		m_EntityCount += count;
+		m_StructureVersion++;
+		BumpComponentVersions(*type);
+		return *type;
+	}
+
+	Entity Scene::AllocateEntity(Archetype* type, const SceneChunk*& outChunk, uint32_t& outRow)
+	{
+		uint32_t index;
+		if (!m_FreeSlots.empty())
+		{
+			index = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+		}
+		else
+		{
+			HZ_MEMORY_TAG(Scene);
+			index = static_cast<uint32_t>(m_Records.size());
+			m_Records.emplace_back();
+		}
+
+		EntityRecord& record = m_Records[index];
+		record.Type = type;
+		AllocateRow(type, record.Chunk, record.Row);
+
+		Entity entity;
+		entity.Index = index;
+		entity.Generation = record.Generation;
+
+		SceneChunk& chunk = type->m_Chunks[record.Chunk];
+		GetEntitiesMutable(chunk)[record.Row] = entity;
+		m_EntityCount++;
+		m_StructureVersion++;
+		BumpComponentVersions(*type);
+
+		outChunk = &chunk;
+		outRow = record.Row;
+		return entity;
+	}
+
+	void Scene::DestroyEntity(Entity entity)
+	{
+		if (!IsValid(entity))
+		{
+			HZ_WARN("Scene: DestroyEntity called with an invalid entity ({}, generation {})", entity.Index, entity.Generation);
+			return;
+		}
+
+		EntityRecord& record = m_Records[entity.Index];
+		RemoveRow(record.Type, record.Chunk, record.Row, true);
+		BumpComponentVersions(*record.Type);
+
+		record.Type = nullptr;
+		record.Generation++;
+		m_FreeSlots.push_back(entity.Index);
+		m_EntityCount--;
+		m_StructureVersion++;
+	}
+
+	bool Scene::IsValid(Entity entity) const
+	{
+		if (entity.Index >= m_Records.size())
+			return false;
+
+		const EntityRecord& record = m_Records[entity.Index];
+		return record.Type != nullptr && record.Generation == entity.Generation;
+	}
+
+	void Scene::Clear()
+	{
+		for (const std::unique_ptr<Archetype>& type : m_Archetypes)
+		{
+			if (type->m_EntityCount > 0)
+				BumpComponentVersions(*type);
+
+			for (SceneChunk& chunk : type->m_Chunks)
+			{
+				for (ComponentId id : type->m_Components)
+				{
+					const ComponentInfo& info = ComponentRegistry::GetInfo(id);
+					if (info.Trivial)
+						continue;
+
+					unsigned char* column = static_cast<unsigned char*>(type->GetColumn(chunk, id));
+					for (uint32_t row = 0; row < chunk.Count; row++)
+						info.Destroy(column + static_cast<size_t>(row) * info.Size);
+				}
+				FreeChunkData(chunk.Data);
+			}
+			type->m_Chunks.clear();
+			type->m_EntityCount = 0;
+		}
+
+		m_FreeSlots.clear();
+		for (uint32_t index = static_cast<uint32_t>(m_Records.size()); index-- > 0;)
+		{
+			EntityRecord& record = m_Records[index];
+			if (record.Type)
+			{
+				record.Type = nullptr;
+				record.Generation++;
+			}
+			m_FreeSlots.push_back(index);
+		}
+
+		m_EntityCount = 0;
+		m_StructureVersion++;
+		m_ChunkVersion++;
+	}
+
+	bool Scene::SetNextIndices(const uint32_t* indices, size_t count)
+	{
+		if (m_EntityCount != 0)
+			return false;
+
+		uint32_t indexEnd = static_cast<uint32_t>(m_Records.size());
+		for (size_t i = 0; i < count; i++)
+			indexEnd = (std::max)(indexEnd, indices[i] + 1);
+		{
+			HZ_MEMORY_TAG(Scene);
+			m_Records.resize(indexEnd);
+		}
+
+		std::vector<bool> requested(indexEnd, false);
+		for (size_t i = 0; i < count; i++)
+			requested[indices[i]] = true;
+
+		// Popped from the back: the requested indices first, then the rest
+		// in ascending order as after Clear()
+		m_FreeSlots.clear();
+		for (uint32_t index = indexEnd; index-- > 0;)
+		{
+			if (!requested[index])
+				m_FreeSlots.push_back(index);
+		}
+		for (size_t i = count; i-- > 0;)
+			m_FreeSlots.push_back(indices[i]);
+		return true;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Components ///////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	void* Scene::GetComponentData(Entity entity, ComponentId id) const
+	{
+		if (!IsValid(entity))
+			return nullptr;
+
+		const EntityRecord& record = m_Records[entity.Index];
+		if (!record.Type->Has(id))
+			return nullptr;
+
+		return GetCell(*record.Type, record.Type->m_Chunks[record.Chunk], id, record.Row);
+	}
+
+	void* Scene::AddComponentData(Entity entity, ComponentId id)
+	{
+		if (!IsValid(entity))
+			return nullptr;
+
+		EntityRecord& record = m_Records[entity.Index];
+		Archetype* target = GetNeighbour(record.Type, id, true);
+		MoveEntity(record, target);
+		m_ComponentVersions[id]++;
+		return GetCell(*target, target->m_Chunks[record.Chunk], id, record.Row);
+	}
+
+	bool Scene::RemoveComponentData(Entity entity, ComponentId id)
+	{
+		if (!IsValid(entity))
+			return false;
+
+		EntityRecord& record = m_Records[entity.Index];
+		if (!record.Type->Has(id))
+			return false;
+
+		MoveEntity(record, GetNeighbour(record.Type, id, false));
+		m_ComponentVersions[id]++;
+		return true;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Archetypes and rows //////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	Archetype* Scene::GetArchetype(ComponentMask mask)
+	{
+		auto it = m_ArchetypesByMask.find(mask);
+		if (it != m_ArchetypesByMask.end())
+			return it->second;
+
+		HZ_MEMORY_TAG(Scene);
+
+		std::unique_ptr<Archetype> type = std::make_unique<Archetype>();
+		type->m_Mask = mask;
+
+		size_t rowSize = sizeof(Entity);
+		for (ComponentId id = 0; id < MaxComponentTypes; id++)
+		{
+			if ((mask >> id) & 1)
+			{
+				type->m_Components.push_back(id);
+				rowSize += ComponentRegistry::GetInfo(id).Size;
+			}
+		}
+
+		// As many rows as fit once every array is padded to the chunk alignment
+		size_t capacity = SceneChunk::Size / rowSize;
+		for (;; capacity--)
+		{
+			size_t offset = AlignUp(capacity * sizeof(Entity), ChunkAlignment);
+			for (ComponentId id : type->m_Components)
+			{
+				type->m_ColumnOffsets[id] = static_cast<uint32_t>(offset);
+				offset = AlignUp(offset + capacity * ComponentRegistry::GetInfo(id).Size, ChunkAlignment);
+			}
+			if (offset <= SceneChunk::Size)
+				break;
+		}
+
+		if (capacity == 0)
+		{
+			HZ_FATAL("Scene: components of archetype {} do not fit a {} byte chunk", mask, SceneChunk::Size);
+			std::abort();
+		}
+		type->m_ChunkCapacity = static_cast<uint32_t>(capacity);
+
+		Archetype* result = type.get();
+		m_Archetypes.push_back(std::move(type));
+		m_ArchetypesByMask.emplace(mask, result);
+		return result;
+	}
+
+	Archetype* Scene::GetNeighbour(Archetype* type, ComponentId id, bool add)
+	{
+		Archetype*& edge = add ? type->m_AddEdges[id] : type->m_RemoveEdges[id];
+		if (!edge)
+		{
+			ComponentMask bit = ComponentMask(1) << id;
+			edge = GetArchetype(add ? (type->m_Mask | bit) : (type->m_Mask & ~bit));
+		}
+		return edge;
+	}
+
+	void Scene::AllocateRow(Archetype* type, uint32_t& outChunk, uint32_t& outRow)
+	{
+		if (type->m_Chunks.empty() || type->m_Chunks.back().Count == type->m_ChunkCapacity)
+		{
+			HZ_MEMORY_TAG(Scene);
+
+			SceneChunk chunk;
+			chunk.Type = type;
+			chunk.Data = AllocateChunkData();
+			type->m_Chunks.push_back(chunk);
+			m_ChunkVersion++;
+		}
+
+		SceneChunk& chunk = type->m_Chunks.back();
+		outChunk = static_cast<uint32_t>(type->m_Chunks.size() - 1);
+		outRow = chunk.Count++;
+		type->m_EntityCount++;
+	}
+
+	void Scene::RemoveRow(Archetype* type, uint32_t chunkIndex, uint32_t row, bool destroy)
+	{
+		SceneChunk& chunk = type->m_Chunks[chunkIndex];
+		if (destroy)
+		{
+			for (ComponentId id : type->m_Components)
+			{
+				const ComponentInfo& info = ComponentRegistry::GetInfo(id);
+				if (!info.Trivial)
+					info.Destroy(GetCell(*type, chunk, id, row));
+			}
+		}
+
+		// Keep the rows packed: the archetype's last row fills the hole
+		uint32_t lastChunkIndex = static_cast<uint32_t>(type->m_Chunks.size() - 1);
+		SceneChunk& lastChunk = type->m_Chunks[lastChunkIndex];
+		uint32_t lastRow = lastChunk.Count - 1;
+		if (chunkIndex != lastChunkIndex || row != lastRow)
+		{
+			for (ComponentId id : type->m_Components)
+				RelocateCell(ComponentRegistry::GetInfo(id), GetCell(*type, chunk, id, row), GetCell(*type, lastChunk, id, lastRow));
+
+			Entity moved = lastChunk.GetEntities()[lastRow];
+			GetEntitiesMutable(chunk)[row] = moved;
+
+			EntityRecord& movedRecord = m_Records[moved.Index];
+			movedRecord.Chunk = chunkIndex;
+			movedRecord.Row = row;
+		}
+
+		lastChunk.Count--;
+		type->m_EntityCount--;
+		if (lastChunk.Count == 0)
+		{
+			FreeChunkData(lastChunk.Data);
+			type->m_Chunks.pop_back();
+			m_ChunkVersion++;
+		}
+	}
+
+	void Scene::MoveEntity(EntityRecord& record, Archetype* target)
+	{
+		Archetype* source = record.Type;
+		uint32_t targetChunkIndex = 0;
+		uint32_t targetRow = 0;
+		AllocateRow(target, targetChunkIndex, targetRow);
+
+		SceneChunk& sourceChunk = source->m_Chunks[record.Chunk];
+		SceneChunk& targetChunk = target->m_Chunks[targetChunkIndex];
+		for (ComponentId id : source->m_Components)
+		{
+			const ComponentInfo& info = ComponentRegistry::GetInfo(id);
+			void* cell = GetCell(*source, sourceChunk, id, record.Row);
+			if (target->Has(id))
+				RelocateCell(info, GetCell(*target, targetChunk, id, targetRow), cell);
+			else if (!info.Trivial)
+				info.Destroy(cell);
+		}
+		GetEntitiesMutable(targetChunk)[targetRow] = sourceChunk.GetEntities()[record.Row];
+
+		// Every component of the old row is gone now
+		RemoveRow(source, record.Chunk, record.Row, false);
+
+		record.Type = target;
+		record.Chunk = targetChunkIndex;
+		record.Row = targetRow;
+		m_StructureVersion++;
+	}
+
+	void Scene::BumpComponentVersions(const Archetype& type)
+	{
+		for (ComponentId id : type.m_Components)
+			m_ComponentVersions[id]++;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Queries //////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	const std::vector<SceneChunk*>& Scene::GetQueryChunks(ComponentMask mask)
+	{
+		std::lock_guard<std::mutex> lock(m_QueryMutex);
+
+		QueryCache* query = nullptr;
+		for (const std::unique_ptr<QueryCache>& cached : m_Queries)
+		{
+			if (cached->Mask == mask)
+			{
+				query = cached.get();
+				break;
+			}
+		}
+
+		if (!query)
+		{
+			HZ_MEMORY_TAG(Scene);
+			m_Queries.push_back(std::make_unique<QueryCache>());
+			query = m_Queries.back().get();
+			query->Mask = mask;
+		}
+
+		bool archetypesAdded = false;
+		for (; query->ArchetypesSeen < m_Archetypes.size(); query->ArchetypesSeen++)
+		{
+			Archetype* type = m_Archetypes[query->ArchetypesSeen].get();
+			if ((type->m_Mask & mask) == mask)
+			{
+				query->Archetypes.push_back(type);
+				archetypesAdded = true;
+			}
+		}
+
+		if (archetypesAdded || query->ChunkVersion != m_ChunkVersion)
+		{
+			HZ_MEMORY_TAG(Scene);
+			query->Chunks.clear();
+			for (Archetype* type : query->Archetypes)
+			{
+				for (SceneChunk& chunk : type->m_Chunks)
+					query->Chunks.push_back(&chunk);
+			}
+			query->ChunkVersion = m_ChunkVersion;
+		}
+
+		return query->Chunks;
+	}
+
+}
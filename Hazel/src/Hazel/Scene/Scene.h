@@ -0,0 +1,296 @@
+#pragma once
+
+#include "../Core.h"
+#include "Entity.h"
+#include "Component.h"
+#include "../Threading/JobSystem.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Hazel {
+
+	class Archetype;
+
+	// A fixed-size block of rows of one archetype: the entity handles first,
+	// then one array per component (structure of arrays). Arrays start on
+	// 64-byte boundaries.
+	struct SceneChunk
+	{
+		static constexpr size_t Size = 16 * 1024;
+
+		Archetype* Type = nullptr;
+		unsigned char* Data = nullptr;
+		uint32_t Count = 0;
+
+		const Entity* GetEntities() const { return reinterpret_cast<const Entity*>(Data); }
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
+	// All entities that have exactly the same set of components. Rows are
+	// packed: every chunk but the last is full, and removing a row moves the
+	// archetype's last row into the hole.
+	class HAZEL_API Archetype
+	{
+	public:
+		ComponentMask GetMask() const { return m_Mask; }
+		const std::vector<ComponentId>& GetComponents() const { return m_Components; }
+		bool Has(ComponentId id) const { return (m_Mask >> id) & 1; }
+
+		size_t GetEntityCount() const { return m_EntityCount; }
+		// Rows per chunk
+		uint32_t GetChunkCapacity() const { return m_ChunkCapacity; }
+		size_t GetChunkCount() const { return m_Chunks.size(); }
+		SceneChunk& GetChunk(size_t index) { return m_Chunks[index]; }
+		const SceneChunk& GetChunk(size_t index) const { return m_Chunks[index]; }
+
+		// Start of the array of component 'id' in 'chunk'; the archetype must have it
+		void* GetColumn(const SceneChunk& chunk, ComponentId id) const { return chunk.Data + m_ColumnOffsets[id]; }
+
+		template<typename T>
+		T* GetColumn(const SceneChunk& chunk) const { return static_cast<T*>(GetColumn(chunk, ComponentRegistry::GetId<T>())); }
+
+	private:
+		friend class Scene;
+
+		ComponentMask m_Mask = 0;
+		std::vector<ComponentId> m_Components;
+		uint32_t m_ColumnOffsets[MaxComponentTypes] = {};
+		uint32_t m_ChunkCapacity = 0;
+		std::vector<SceneChunk> m_Chunks;
+		size_t m_EntityCount = 0;
+
+		// Archetypes one component away, filled as entities move between them
+		Archetype* m_AddEdges[MaxComponentTypes] = {};
+		Archetype* m_RemoveEdges[MaxComponentTypes] = {};
+	};
+
+	// Entity-component store with archetype chunks. Components are plain
+	// structs; an entity's components live in the chunk row of the archetype
+	// matching its component set, so iterating a query walks contiguous arrays
+	// of only the requested components.
+	//
+	//   Entity e = scene.CreateEntity(NameComponent{ "Cube" }, TransformComponent{});
+	//   scene.ParallelEach<TransformComponent, Velocity>([](TransformComponent& t, Velocity& v) { ... });
+	//
+	// Queries cache their matching archetypes and chunks and refresh them only
+	// after structural changes. Structural changes (creating and destroying
+	// entities, adding and removing components) must not overlap any other
+	// access to the scene, and they invalidate component pointers. Component
+	// reads and writes of distinct entities may run on many threads at once.
+	class HAZEL_API Scene
+	{
+	public:
+		Scene();
+		~Scene();
+
+		Scene(const Scene&) = delete;
+		Scene& operator=(const Scene&) = delete;
+
+		Entity CreateEntity();
+
+		// Created directly in the archetype of the given components
+		template<typename... Components>
+		Entity CreateEntity(Components&&... components)
+		{
+			Archetype* type = GetArchetype((ComponentRegistry::GetBit<std::decay_t<Components>>() | ...));
+			const SceneChunk* chunk = nullptr;
+			uint32_t row = 0;
+			Entity entity = AllocateEntity(type, chunk, row);
+			(new (static_cast<std::decay_t<Components>*>(type->GetColumn(*chunk, ComponentRegistry::GetId<std::decay_t<Components>>())) + row)
+				std::decay_t<Components>(std::forward<Components>(components)), ...);
+			return entity;
+		}
+
+		// 'count' entities with default-constructed components, e.g. for
+		// spawning; handles are written to 'outEntities' when given
+		template<typename... Components>
+		void CreateEntities(size_t count, Entity* outEntities = nullptr)
+		{
+			ComponentMask mask = 0;
+			((mask |= ComponentRegistry::GetBit<Components>()), ...);
+			CreateEntities(mask, count, outEntities);
+		}
+
+		// The same for the archetype of 'mask'. The new entities become the
+		// archetype's last rows, in order, so their components can be filled
+		// a chunk at a time.
+		Archetype& CreateEntities(ComponentMask mask, size_t count, Entity* outEntities = nullptr);
+
+		void DestroyEntity(Entity entity);
+		bool IsValid(Entity entity) const;
+		// Destroys every entity; handles from before stay invalid
+		void Clear();
+		// On an empty scene, makes the next 'count' creates take 'indices' in
+		// order, e.g. to restore the indices of a saved scene. The indices must
+		// be distinct; returns false when the scene is not empty.
+		bool SetNextIndices(const uint32_t* indices, size_t count);
+
+		size_t GetEntityCount() const { return m_EntityCount; }
+		// Bumped by every create, destroy, add and remove; systems that cache
+		// per-entity data rebuild it when this changes
+		uint64_t GetStructureVersion() const { return m_StructureVersion; }
+		// Bumped whenever an entity gains or loses the component, including by
+		// being created or destroyed. Moves between archetypes for other
+		// components leave it alone, so systems watching a few component types
+		// skip the scene's unrelated churn.
+		uint64_t GetComponentVersion(ComponentId id) const { return m_ComponentVersions[id]; }
+
+		// Returns the existing component if the entity has one; nullptr for an invalid entity
+		template<typename T, typename... Args>
+		T* AddComponent(Entity entity, Args&&... args)
+		{
+			ComponentId id = ComponentRegistry::GetId<T>();
+			if (void* existing = GetComponentData(entity, id))
+				return static_cast<T*>(existing);
+
+			void* memory = AddComponentData(entity, id);
+			return memory ? new (memory) T(std::forward<Args>(args)...) : nullptr;
+		}
+
+		// False when the entity is invalid or lacks the component
+		template<typename T>
+		bool RemoveComponent(Entity entity) { return RemoveComponentData(entity, ComponentRegistry::GetId<T>()); }
+
+		template<typename T>
+		bool HasComponent(Entity entity) const { return GetComponentData(entity, ComponentRegistry::GetId<T>()) != nullptr; }
+
+		// nullptr when the entity is invalid or lacks the component
+		template<typename T>
+		T* GetComponent(Entity entity) { return static_cast<T*>(GetComponentData(entity, ComponentRegistry::GetId<T>())); }
+		template<typename T>
+		const T* GetComponent(Entity entity) const { return static_cast<const T*>(GetComponentData(entity, ComponentRegistry::GetId<T>())); }
+
+		// func(uint32_t count, const Entity* entities, Components*... arrays)
+		// for each non-empty chunk whose archetype has all of Components
+		template<typename... Components, typename Func>
+		void EachChunk(Func&& func)
+		{
+			static_assert(sizeof...(Components) > 0, "A query needs at least one component");
+			const std::vector<SceneChunk*>& chunks = GetQueryChunks((ComponentRegistry::GetBit<Components>() | ...));
+			for (SceneChunk* chunk : chunks)
+			{
+				if (chunk->Count > 0)
+					func(chunk->Count, chunk->GetEntities(), chunk->Type->template GetColumn<Components>(*chunk)...);
+			}
+		}
+
+		// Like EachChunk, with the chunks spread over the job system
+		template<typename... Components, typename Func>
+		void ParallelEachChunk(Func&& func)
+		{
+			static_assert(sizeof...(Components) > 0, "A query needs at least one component");
+			const std::vector<SceneChunk*>& chunks = GetQueryChunks((ComponentRegistry::GetBit<Components>() | ...));
+			JobSystem::ParallelFor(chunks.size(), 1, [&chunks, &func](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					SceneChunk* chunk = chunks[i];
+					if (chunk->Count > 0)
+						func(chunk->Count, chunk->GetEntities(), chunk->Type->template GetColumn<Components>(*chunk)...);
+				}
+			});
+		}
+
+		// func(Components&...) or func(Entity, Components&...) for every
+		// entity that has all of Components
+		template<typename... Components, typename Func>
+		void Each(Func&& func)
+		{
+			EachChunk<Components...>([&func](uint32_t count, const Entity* entities, Components*... arrays)
+			{
+				for (uint32_t i = 0; i < count; i++)
+					Invoke(func, entities[i], arrays[i]...);
+			});
+		}
+
+		template<typename... Components, typename Func>
+		void ParallelEach(Func&& func)
+		{
+			ParallelEachChunk<Components...>([&func](uint32_t count, const Entity* entities, Components*... arrays)
+			{
+				for (uint32_t i = 0; i < count; i++)
+					Invoke(func, entities[i], arrays[i]...);
+			});
+		}
+
+		size_t GetArchetypeCount() const { return m_Archetypes.size(); }
+		const Archetype& GetArchetype(size_t index) const { return *m_Archetypes[index]; }
+
+	private:
+		struct EntityRecord
+		{
+			Archetype* Type = nullptr; // nullptr while the slot is free
+			uint32_t Chunk = 0;
+			uint32_t Row = 0;
+			uint32_t Generation = 0;
+		};
+
+		struct QueryCache
+		{
+			ComponentMask Mask = 0;
+			std::vector<Archetype*> Archetypes;
+			size_t ArchetypesSeen = 0;
+			std::vector<SceneChunk*> Chunks;
+			uint64_t ChunkVersion = ~0ull;
+		};
+
+		template<typename Func, typename... Components>
+		static void Invoke(Func& func, Entity entity, Components&... components)
+		{
+			if constexpr (std::is_invocable_v<Func&, Entity, Components&...>)
+				func(entity, components...);
+			else
+				func(components...);
+		}
+
+		Archetype* GetArchetype(ComponentMask mask);
+		Archetype* GetNeighbour(Archetype* type, ComponentId id, bool add);
+
+		// Reserves a row in 'type' and a handle for it; the components are left uninitialized
+		Entity AllocateEntity(Archetype* type, const SceneChunk*& outChunk, uint32_t& outRow);
+		void AllocateRow(Archetype* type, uint32_t& outChunk, uint32_t& outRow);
+		// Fills the row with the archetype's last row; destroys its components first if asked
+		void RemoveRow(Archetype* type, uint32_t chunk, uint32_t row, bool destroy);
+		// Moves the entity's row to 'target', relocating shared components and
+		// destroying the ones 'target' lacks; the others are left uninitialized
+		void MoveEntity(EntityRecord& record, Archetype* target);
+		// Rows of 'type' were created or destroyed
+		void BumpComponentVersions(const Archetype& type);
+
+		void* GetComponentData(Entity entity, ComponentId id) const;
+		void* AddComponentData(Entity entity, ComponentId id);
+		bool RemoveComponentData(Entity entity, ComponentId id);
+
+		const std::vector<SceneChunk*>& GetQueryChunks(ComponentMask mask);
+
+	private:
+		std::vector<EntityRecord> m_Records;
+		std::vector<uint32_t> m_FreeSlots;
+		size_t m_EntityCount = 0;
+		uint64_t m_StructureVersion = 0;
+		uint64_t m_ComponentVersions[MaxComponentTypes] = {};
+
+		std::vector<std::unique_ptr<Archetype>> m_Archetypes;
+		std::unordered_map<ComponentMask, Archetype*> m_ArchetypesByMask;
+		// Bumped whenever a chunk is created or freed
+		uint64_t m_ChunkVersion = 0;
+
+		std::mutex m_QueryMutex;
+		std::vector<std::unique_ptr<QueryCache>> m_Queries;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
@@ -0,0 +1,1010 @@
+#include "SceneFile.h"
+#include "Scene.h"
+#include "Components.h"
+#include "../Log.h"
+#include "../Memory/MemoryTracker.h"
+#include "../Debug/Profiler.h"
+#include "../Threading/JobSystem.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace Hazel {
+
+	namespace {
+
+		constexpr uint32_t SectionIndex(SceneFileSectionType type)
+		{
+			return static_cast<uint32_t>(type);
+		}
+
+		uint64_t AlignOffset(uint64_t offset)
+		{
+			return (offset + SceneFileAlignment - 1) & ~static_cast<uint64_t>(SceneFileAlignment - 1);
+		}
+
+		template<typename T>
+		const T* GetSection(const unsigned char* data, SceneFileSectionType type)
+		{
+			const SceneFileHeader& header = *reinterpret_cast<const SceneFileHeader*>(data);
+			return reinterpret_cast<const T*>(data + header.Sections[SectionIndex(type)].Offset);
+		}
+
+		double MillisecondsSince(std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		/////////////////////////////////////////////////////////////////////////
+		// Component registry ///////////////////////////////////////////////////
+		/////////////////////////////////////////////////////////////////////////
+
+		struct ComponentCodec
+		{
+			std::string Name;
+			ComponentId Id = 0;
+			uint32_t Size = 0; // Bytes per row in the file
+			SceneFileComponentKind Kind = SceneFileComponentKind::Data;
+			SceneFile::TextFormatter Formatter = nullptr;
+			std::vector<uint32_t> EntityFields;
+		};
+
+		void FormatVec3(const char* label, const glm::vec3& value, std::string& out)
+		{
+			out += label;
+			for (int i = 0; i < 3; i++)
+			{
+				out += ' ';
+				SceneFile::FormatFloat(value[i], out);
+			}
+		}
+
+		void FormatTransform(const void* component, std::string& out)
+		{
+			const TransformComponent& transform = *static_cast<const TransformComponent*>(component);
+			FormatVec3("position", transform.Position, out);
+			FormatVec3(" rotation", transform.Rotation, out);
+			FormatVec3(" scale", transform.Scale, out);
+		}
+
+		// Text exports pass parents holding entity keys, see SceneFile.h
+		void FormatParent(const void* component, std::string& out)
+		{
+			const ParentComponent& parent = *static_cast<const ParentComponent*>(component);
+			if (parent.Parent)
+				out += "entity " + std::to_string(parent.Parent.Index);
+			else
+				out += "none";
+		}
+
+		std::vector<ComponentCodec> CreateBuiltinCodecs()
+		{
+			std::vector<ComponentCodec> codecs(3);
+
+			codecs[0].Name = "Name";
+			codecs[0].Id = ComponentRegistry::GetId<NameComponent>();
+			codecs[0].Size = sizeof(SceneFileString);
+			codecs[0].Kind = SceneFileComponentKind::Name;
+
+			codecs[1].Name = "Transform";
+			codecs[1].Id = ComponentRegistry::GetId<TransformComponent>();
+			codecs[1].Size = sizeof(TransformComponent);
+			codecs[1].Formatter = &FormatTransform;
+
+			codecs[2].Name = "Parent";
+			codecs[2].Id = ComponentRegistry::GetId<ParentComponent>();
+			codecs[2].Size = sizeof(ParentComponent);
+			codecs[2].Formatter = &FormatParent;
+			codecs[2].EntityFields.push_back(static_cast<uint32_t>(offsetof(ParentComponent, Parent)));
+
+			return codecs;
+		}
+
+		std::vector<ComponentCodec>& GetCodecs()
+		{
+			static std::vector<ComponentCodec> codecs = CreateBuiltinCodecs();
+			return codecs;
+		}
+
+		const ComponentCodec* FindCodec(const char* name)
+		{
+			for (const ComponentCodec& codec : GetCodecs())
+			{
+				if (codec.Name == name)
+					return &codec;
+			}
+			return nullptr;
+		}
+
+		// The codec that reads a file's component type, or nullptr
+		const ComponentCodec* FindCodec(const SceneFileComponentType& type)
+		{
+			const ComponentCodec* codec = FindCodec(type.Name);
+			bool matches = codec && codec->Size == type.Size && static_cast<uint32_t>(codec->Kind) == type.Kind;
+			return matches ? codec : nullptr;
+		}
+
+		/////////////////////////////////////////////////////////////////////////
+		// Rows /////////////////////////////////////////////////////////////////
+		/////////////////////////////////////////////////////////////////////////
+
+		// 'count' chunk rows to file rows; entity references become numbers
+		bool SaveRows(const ComponentCodec& codec, const Scene& scene, const std::vector<uint32_t>& numbers,
+		              const unsigned char* source, unsigned char* destination, size_t count, std::string& pool)
+		{
+			if (codec.Kind == SceneFileComponentKind::Name)
+			{
+				const NameComponent* names = reinterpret_cast<const NameComponent*>(source);
+				for (size_t row = 0; row < count; row++)
+				{
+					const std::string& name = names[row].Name;
+					if (pool.size() + name.size() > 0xFFFFFFFFull)
+						return false;
+
+					SceneFileString string = { static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(name.size()) };
+					std::memcpy(destination + row * sizeof(SceneFileString), &string, sizeof(string));
+					pool += name;
+				}
+				return true;
+			}
+
+			std::memcpy(destination, source, count * codec.Size);
+			for (uint32_t field : codec.EntityFields)
+			{
+				for (size_t row = 0; row < count; row++)
+				{
+					unsigned char* cell = destination + row * codec.Size + field;
+					Entity entity;
+					std::memcpy(&entity, cell, sizeof(entity));
+
+					Entity saved;
+					saved.Index = scene.IsValid(entity) ? numbers[entity.Index] : Entity::InvalidIndex;
+					std::memcpy(cell, &saved, sizeof(saved));
+				}
+			}
+			return true;
+		}
+
+		// 'count' file rows to chunk rows holding default-constructed components
+		void LoadRows(const ComponentCodec& codec, const std::vector<Entity>& entities, const char* pool, uint64_t poolSize,
+		              const unsigned char* source, unsigned char* destination, size_t count)
+		{
+			if (codec.Kind == SceneFileComponentKind::Name)
+			{
+				NameComponent* names = reinterpret_cast<NameComponent*>(destination);
+				for (size_t row = 0; row < count; row++)
+				{
+					SceneFileString string;
+					std::memcpy(&string, source + row * sizeof(SceneFileString), sizeof(string));
+					if (static_cast<uint64_t>(string.Offset) + string.Length <= poolSize)
+						names[row].Name.assign(pool + string.Offset, string.Length);
+				}
+				return;
+			}
+
+			std::memcpy(destination, source, count * codec.Size);
+			for (uint32_t field : codec.EntityFields)
+			{
+				for (size_t row = 0; row < count; row++)
+				{
+					unsigned char* cell = destination + row * codec.Size + field;
+					uint32_t number;
+					std::memcpy(&number, cell, sizeof(number));
+
+					Entity entity = number < entities.size() ? entities[number] : Entity();
+					std::memcpy(cell, &entity, sizeof(entity));
+				}
+			}
+		}
+
+		// Numbers of the entities whose saved parent link must not be restored:
+		// links to themselves and one link of every cycle. Numbers outside the
+		// file already load as null. One walk per entity, each stopping at the
+		// first entity an earlier walk reached.
+		std::vector<uint32_t> FindCyclicParents(const unsigned char* data, const SceneFileHeader& header,
+		                                        const SceneFileArchetype* archetypes, const SceneFileColumn* columns,
+		                                        const std::vector<const ComponentCodec*>& codecs)
+		{
+			const ComponentId parentId = ComponentRegistry::GetId<ParentComponent>();
+			const uint32_t count = header.EntityCount;
+
+			std::vector<uint32_t> parents;
+			for (uint32_t a = 0; a < header.ArchetypeCount; a++)
+			{
+				const SceneFileArchetype& archetype = archetypes[a];
+				for (uint32_t i = archetype.FirstColumn; i < archetype.FirstColumn + archetype.ColumnCount; i++)
+				{
+					const ComponentCodec* codec = codecs[columns[i].ComponentType];
+					if (!codec || codec->Id != parentId)
+						continue;
+
+					if (parents.empty())
+						parents.assign(count, Entity::InvalidIndex);
+
+					const unsigned char* blob = data + columns[i].Offset + offsetof(ParentComponent, Parent);
+					for (uint32_t row = 0; row < archetype.EntityCount; row++)
+					{
+						uint32_t number;
+						std::memcpy(&number, blob + static_cast<size_t>(row) * codec->Size, sizeof(number));
+						parents[archetype.FirstEntity + row] = number < count ? number : Entity::InvalidIndex;
+					}
+				}
+			}
+
+			std::vector<uint32_t> cyclic;
+			if (parents.empty())
+				return cyclic;
+
+			// The walk that first reached each entity
+			std::vector<uint32_t> walks(count, Entity::InvalidIndex);
+			for (uint32_t start = 0; start < count; start++)
+			{
+				uint32_t entity = start;
+				uint32_t last = Entity::InvalidIndex;
+				while (entity != Entity::InvalidIndex && walks[entity] == Entity::InvalidIndex)
+				{
+					walks[entity] = start;
+					last = entity;
+					entity = parents[entity];
+				}
+
+				// Back on this walk's own path: cutting its last link breaks the cycle
+				if (entity != Entity::InvalidIndex && walks[entity] == start)
+				{
+					cyclic.push_back(last);
+					parents[last] = Entity::InvalidIndex;
+				}
+			}
+			return cyclic;
+		}
+
+		/////////////////////////////////////////////////////////////////////////
+		// Image ////////////////////////////////////////////////////////////////
+		/////////////////////////////////////////////////////////////////////////
+
+		// The whole file for 'scene', in memory
+		bool BuildImage(const Scene& scene, std::vector<unsigned char>& image)
+		{
+			HZ_PROFILE_FUNCTION();
+			HZ_MEMORY_TAG(Scene);
+
+			const ComponentCodec* codecOfId[MaxComponentTypes] = {};
+			for (const ComponentCodec& codec : GetCodecs())
+				codecOfId[codec.Id] = &codec;
+
+			// Non-empty archetypes in scene order give the file order
+			std::vector<const Archetype*> archetypes;
+			ComponentMask savedMask = 0;
+			ComponentMask skippedMask = 0;
+			uint64_t entityCount = 0;
+			uint32_t indexEnd = 0;
+			for (size_t i = 0; i < scene.GetArchetypeCount(); i++)
+			{
+				const Archetype& type = scene.GetArchetype(i);
+				if (type.GetEntityCount() == 0)
+					continue;
+
+				archetypes.push_back(&type);
+				entityCount += type.GetEntityCount();
+				for (ComponentId id : type.GetComponents())
+					(codecOfId[id] ? savedMask : skippedMask) |= ComponentMask(1) << id;
+
+				for (size_t chunk = 0; chunk < type.GetChunkCount(); chunk++)
+				{
+					const SceneChunk& data = type.GetChunk(chunk);
+					for (uint32_t row = 0; row < data.Count; row++)
+						indexEnd = (std::max)(indexEnd, data.GetEntities()[row].Index + 1);
+				}
+			}
+
+			if (entityCount >= Entity::InvalidIndex)
+			{
+				HZ_ERROR("SceneFile: {} entities are more than a scene file holds", entityCount);
+				return false;
+			}
+
+			for (ComponentId id = 0; id < MaxComponentTypes; id++)
+			{
+				if ((skippedMask >> id) & 1)
+					HZ_WARN("SceneFile: component {} is not registered and is not saved", ComponentRegistry::GetInfo(id).Name);
+			}
+
+			std::vector<uint32_t> numbers(indexEnd, Entity::InvalidIndex);
+			std::vector<uint32_t> keys(entityCount);
+			uint32_t nextNumber = 0;
+			for (const Archetype* type : archetypes)
+			{
+				for (size_t chunk = 0; chunk < type->GetChunkCount(); chunk++)
+				{
+					const SceneChunk& data = type->GetChunk(chunk);
+					for (uint32_t row = 0; row < data.Count; row++)
+					{
+						uint32_t index = data.GetEntities()[row].Index;
+						keys[nextNumber] = index;
+						numbers[index] = nextNumber++;
+					}
+				}
+			}
+
+			// Tables
+			std::vector<SceneFileComponentType> types;
+			uint32_t typeOfId[MaxComponentTypes] = {};
+			for (const ComponentCodec& codec : GetCodecs())
+			{
+				if (!((savedMask >> codec.Id) & 1))
+					continue;
+
+				SceneFileComponentType type = {};
+				std::memcpy(type.Name, codec.Name.c_str(), codec.Name.size());
+				type.Size = codec.Size;
+				type.Kind = static_cast<uint32_t>(codec.Kind);
+				typeOfId[codec.Id] = static_cast<uint32_t>(types.size());
+				types.push_back(type);
+			}
+
+			std::vector<SceneFileArchetype> fileArchetypes;
+			std::vector<SceneFileColumn> columns;
+			std::vector<ComponentId> columnIds;
+			uint32_t firstEntity = 0;
+			uint64_t bareEntities = 0;
+			for (const Archetype* type : archetypes)
+			{
+				SceneFileArchetype archetype = {};
+				archetype.FirstEntity = firstEntity;
+				archetype.EntityCount = static_cast<uint32_t>(type->GetEntityCount());
+				archetype.FirstColumn = static_cast<uint32_t>(columns.size());
+				// In registration order, which the text form follows
+				for (const ComponentCodec& codec : GetCodecs())
+				{
+					ComponentId id = codec.Id;
+					if (!type->Has(id))
+						continue;
+
+					SceneFileColumn column = {};
+					column.ComponentType = typeOfId[id];
+					columns.push_back(column);
+					columnIds.push_back(id);
+					archetype.ColumnCount++;
+				}
+				fileArchetypes.push_back(archetype);
+				firstEntity += archetype.EntityCount;
+				if (archetype.ColumnCount == 0)
+					bareEntities += archetype.EntityCount;
+			}
+
+			if (bareEntities > SceneFileMaxBareEntities)
+			{
+				HZ_ERROR("SceneFile: {} entities have no saved components; a scene file holds at most {}", bareEntities, SceneFileMaxBareEntities);
+				return false;
+			}
+
+			// Layout
+			SceneFileHeader header = {};
+			header.Magic = SceneFileMagic;
+			header.Version = SceneFileVersion;
+			header.HeaderSize = sizeof(SceneFileHeader);
+			header.EntityCount = static_cast<uint32_t>(entityCount);
+			header.ComponentTypeCount = static_cast<uint32_t>(types.size());
+			header.ArchetypeCount = static_cast<uint32_t>(fileArchetypes.size());
+			header.ColumnCount = static_cast<uint32_t>(columns.size());
+
+			uint64_t offset = sizeof(SceneFileHeader);
+			auto placeSection = [&](SceneFileSectionType type, uint64_t size)
+			{
+				offset = AlignOffset(offset);
+				header.Sections[SectionIndex(type)] = { offset, size };
+				offset += size;
+			};
+			placeSection(SceneFileSectionType::ComponentTypes, types.size() * sizeof(SceneFileComponentType));
+			placeSection(SceneFileSectionType::Archetypes, fileArchetypes.size() * sizeof(SceneFileArchetype));
+			placeSection(SceneFileSectionType::Columns, columns.size() * sizeof(SceneFileColumn));
+			placeSection(SceneFileSectionType::EntityKeys, keys.size() * sizeof(uint32_t));
+
+			for (const SceneFileArchetype& archetype : fileArchetypes)
+			{
+				for (uint32_t i = archetype.FirstColumn; i < archetype.FirstColumn + archetype.ColumnCount; i++)
+				{
+					offset = AlignOffset(offset);
+					columns[i].Offset = offset;
+					offset += static_cast<uint64_t>(types[columns[i].ComponentType].Size) * archetype.EntityCount;
+				}
+			}
+			image.assign(offset, 0);
+
+			// Column blobs: rows of a chunk are contiguous in the file, and every
+			// chunk but the last is full
+			std::string pool;
+			for (size_t a = 0; a < archetypes.size(); a++)
+			{
+				const Archetype& type = *archetypes[a];
+				const SceneFileArchetype& archetype = fileArchetypes[a];
+				for (uint32_t i = archetype.FirstColumn; i < archetype.FirstColumn + archetype.ColumnCount; i++)
+				{
+					ComponentId id = columnIds[i];
+					const ComponentCodec& codec = *codecOfId[id];
+					unsigned char* blob = image.data() + columns[i].Offset;
+					size_t chunkRows = static_cast<size_t>(type.GetChunkCapacity()) * codec.Size;
+
+					// Names append to the shared pool in order
+					if (codec.Kind == SceneFileComponentKind::Name)
+					{
+						for (size_t chunk = 0; chunk < type.GetChunkCount(); chunk++)
+						{
+							const SceneChunk& data = type.GetChunk(chunk);
+							if (!SaveRows(codec, scene, numbers, static_cast<const unsigned char*>(type.GetColumn(data, id)),
+							              blob + chunk * chunkRows, data.Count, pool))
+							{
+								HZ_ERROR("SceneFile: names exceed the 4 GB string pool");
+								return false;
+							}
+						}
+						continue;
+					}
+
+					JobSystem::ParallelFor(type.GetChunkCount(), 1, [&](size_t begin, size_t end)
+					{
+						std::string unused;
+						for (size_t chunk = begin; chunk < end; chunk++)
+						{
+							const SceneChunk& data = type.GetChunk(chunk);
+							SaveRows(codec, scene, numbers, static_cast<const unsigned char*>(type.GetColumn(data, id)),
+							         blob + chunk * chunkRows, data.Count, unused);
+						}
+					});
+				}
+			}
+
+			placeSection(SceneFileSectionType::StringPool, pool.size());
+			image.resize(offset);
+
+			const SceneFileSection* sections = header.Sections;
+			std::memcpy(image.data(), &header, sizeof(header));
+			if (!types.empty())
+				std::memcpy(image.data() + sections[SectionIndex(SceneFileSectionType::ComponentTypes)].Offset, types.data(), types.size() * sizeof(SceneFileComponentType));
+			if (!fileArchetypes.empty())
+				std::memcpy(image.data() + sections[SectionIndex(SceneFileSectionType::Archetypes)].Offset, fileArchetypes.data(), fileArchetypes.size() * sizeof(SceneFileArchetype));
+			if (!columns.empty())
+				std::memcpy(image.data() + sections[SectionIndex(SceneFileSectionType::Columns)].Offset, columns.data(), columns.size() * sizeof(SceneFileColumn));
+			if (!keys.empty())
+				std::memcpy(image.data() + sections[SectionIndex(SceneFileSectionType::EntityKeys)].Offset, keys.data(), keys.size() * sizeof(uint32_t));
+			if (!pool.empty())
+				std::memcpy(image.data() + sections[SectionIndex(SceneFileSectionType::StringPool)].Offset, pool.data(), pool.size());
+			return true;
+		}
+
+		/////////////////////////////////////////////////////////////////////////
+		// Text /////////////////////////////////////////////////////////////////
+		/////////////////////////////////////////////////////////////////////////
+
+		void AppendQuoted(const char* text, size_t length, std::string& out)
+		{
+			static const char digits[] = "0123456789abcdef";
+
+			out += '"';
+			for (size_t i = 0; i < length; i++)
+			{
+				unsigned char c = static_cast<unsigned char>(text[i]);
+				if (c == '"' || c == '\\')
+				{
+					out += '\\';
+					out += static_cast<char>(c);
+				}
+				else if (c == '\n')
+					out += "\\n";
+				else if (c < 0x20)
+				{
+					out += "\\x";
+					out += digits[c >> 4];
+					out += digits[c & 15];
+				}
+				else
+					out += static_cast<char>(c);
+			}
+			out += '"';
+		}
+
+		void AppendHex(const unsigned char* data, size_t size, std::string& out)
+		{
+			static const char digits[] = "0123456789abcdef";
+
+			out += "bytes ";
+			for (size_t i = 0; i < size; i++)
+			{
+				out += digits[data[i] >> 4];
+				out += digits[data[i] & 15];
+			}
+		}
+
+		// Text of a validated image, written in pieces so large scenes never
+		// hold all of it in memory
+		bool WriteTextImage(const unsigned char* data, const std::string& path)
+		{
+			HZ_PROFILE_FUNCTION();
+
+			std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+			if (!stream)
+			{
+				HZ_ERROR("SceneFile: failed to create {}", path);
+				return false;
+			}
+
+			const SceneFileHeader& header = *reinterpret_cast<const SceneFileHeader*>(data);
+			const SceneFileComponentType* types = GetSection<SceneFileComponentType>(data, SceneFileSectionType::ComponentTypes);
+			const SceneFileArchetype* archetypes = GetSection<SceneFileArchetype>(data, SceneFileSectionType::Archetypes);
+			const SceneFileColumn* columns = GetSection<SceneFileColumn>(data, SceneFileSectionType::Columns);
+			const char* pool = GetSection<char>(data, SceneFileSectionType::StringPool);
+			uint64_t poolSize = header.Sections[SectionIndex(SceneFileSectionType::StringPool)].Size;
+
+			std::vector<const ComponentCodec*> codecs(header.ComponentTypeCount);
+			std::string text = "hscene " + std::to_string(header.Version) + "\n";
+			text += "entities " + std::to_string(header.EntityCount) + "\n";
+			for (uint32_t i = 0; i < header.ComponentTypeCount; i++)
+			{
+				codecs[i] = FindCodec(types[i]);
+				text += "component ";
+				text += types[i].Name;
+				text += ' ' + std::to_string(types[i].Size) + '\n';
+			}
+
+			// Entities in key order, so the text does not move with the archetype
+			// an entity sits in
+			const uint32_t* keys = GetSection<uint32_t>(data, SceneFileSectionType::EntityKeys);
+			std::vector<uint32_t> order(header.EntityCount);
+			for (uint32_t number = 0; number < header.EntityCount; number++)
+				order[number] = number;
+			std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+			std::vector<unsigned char> scratch;
+			for (uint32_t number : order)
+			{
+				// Last archetype starting at or before the number; empty ones hold none
+				const SceneFileArchetype& archetype = *(std::upper_bound(archetypes, archetypes + header.ArchetypeCount, number,
+					[](uint32_t value, const SceneFileArchetype& entry) { return value < entry.FirstEntity; }) - 1);
+				uint32_t row = number - archetype.FirstEntity;
+
+				text += "\nentity " + std::to_string(keys[number]) + '\n';
+				for (uint32_t i = archetype.FirstColumn; i < archetype.FirstColumn + archetype.ColumnCount; i++)
+				{
+					const SceneFileComponentType& type = types[columns[i].ComponentType];
+					const ComponentCodec* codec = codecs[columns[i].ComponentType];
+					const unsigned char* cell = data + columns[i].Offset + static_cast<size_t>(row) * type.Size;
+
+					text += "  ";
+					text += type.Name;
+					text += ' ';
+					if (type.Kind == static_cast<uint32_t>(SceneFileComponentKind::Name))
+					{
+						SceneFileString string;
+						std::memcpy(&string, cell, sizeof(string));
+						if (static_cast<uint64_t>(string.Offset) + string.Length <= poolSize)
+							AppendQuoted(pool + string.Offset, string.Length, text);
+					}
+					else if (codec && codec->Formatter)
+					{
+						// Entity references are printed as keys too
+						if (!codec->EntityFields.empty())
+						{
+							scratch.assign(cell, cell + type.Size);
+							for (uint32_t field : codec->EntityFields)
+							{
+								uint32_t reference;
+								std::memcpy(&reference, scratch.data() + field, sizeof(reference));
+								if (reference < header.EntityCount)
+									std::memcpy(scratch.data() + field, &keys[reference], sizeof(reference));
+							}
+							cell = scratch.data();
+						}
+						codec->Formatter(cell, text);
+					}
+					else
+						AppendHex(cell, type.Size, text);
+					text += '\n';
+				}
+
+				if (text.size() > 1024 * 1024)
+				{
+					stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+					text.clear();
+				}
+			}
+
+			stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+			if (!stream.good())
+			{
+				HZ_ERROR("SceneFile: failed writing {}", path);
+				return false;
+			}
+			return true;
+		}
+
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Registry /////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	void SceneFile::RegisterComponentType(const char* name, ComponentId id, uint32_t size, TextFormatter formatter,
+	                                      const uint32_t* entityFields, size_t entityFieldCount)
+	{
+		size_t length = name ? std::strlen(name) : 0;
+		if (length == 0 || length > SceneFileMaxNameLength)
+		{
+			HZ_ERROR("SceneFile: component name '{}' must have 1 to {} characters", name ? name : "", SceneFileMaxNameLength);
+			return;
+		}
+		for (size_t i = 0; i < entityFieldCount; i++)
+		{
+			if (static_cast<uint64_t>(entityFields[i]) + sizeof(Entity) > size)
+			{
+				HZ_ERROR("SceneFile: Entity field at offset {} lies outside component {}", entityFields[i], name);
+				return;
+			}
+		}
+
+		// One name per component type and one type per name
+		std::vector<ComponentCodec>& codecs = GetCodecs();
+		codecs.erase(std::remove_if(codecs.begin(), codecs.end(), [&](const ComponentCodec& codec)
+		{
+			return codec.Id == id || codec.Name == name;
+		}), codecs.end());
+
+		ComponentCodec codec;
+		codec.Name = name;
+		codec.Id = id;
+		codec.Size = size;
+		codec.Formatter = formatter;
+		codec.EntityFields.assign(entityFields, entityFields + entityFieldCount);
+		codecs.push_back(std::move(codec));
+	}
+
+	void SceneFile::FormatFloat(float value, std::string& out)
+	{
+		char buffer[32];
+		std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+		out.append(buffer, result.ptr);
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Reading //////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	bool SceneFile::Open(const std::string& path)
+	{
+		Close();
+
+		if (!m_File.Open(path))
+			return false;
+
+		m_Header = reinterpret_cast<const SceneFileHeader*>(m_File.GetData());
+		if (!Validate())
+		{
+			Close();
+			return false;
+		}
+
+		m_File.Prefetch();
+		return true;
+	}
+
+	void SceneFile::Close()
+	{
+		m_Header = nullptr;
+		m_File.Close();
+	}
+
+	bool SceneFile::Validate() const
+	{
+		const std::string& path = m_File.GetPath();
+		const uint64_t fileSize = m_File.GetSize();
+
+		if (fileSize < sizeof(SceneFileHeader) || m_Header->Magic != SceneFileMagic)
+		{
+			HZ_ERROR("SceneFile: {} is not a .hscene file", path);
+			return false;
+		}
+		if (m_Header->Version != SceneFileVersion || m_Header->HeaderSize != sizeof(SceneFileHeader))
+		{
+			HZ_ERROR("SceneFile: {} has unsupported version {}", path, m_Header->Version);
+			return false;
+		}
+		if (m_Header->EntityCount >= Entity::InvalidIndex)
+		{
+			HZ_ERROR("SceneFile: {} has more entities than a scene holds", path);
+			return false;
+		}
+
+		const uint64_t expectedSizes[] = {
+			static_cast<uint64_t>(m_Header->ComponentTypeCount) * sizeof(SceneFileComponentType),
+			static_cast<uint64_t>(m_Header->ArchetypeCount) * sizeof(SceneFileArchetype),
+			static_cast<uint64_t>(m_Header->ColumnCount) * sizeof(SceneFileColumn),
+			static_cast<uint64_t>(m_Header->EntityCount) * sizeof(uint32_t),
+		};
+
+		for (uint32_t i = 0; i < SectionIndex(SceneFileSectionType::Count); i++)
+		{
+			const SceneFileSection& section = m_Header->Sections[i];
+			if (i < sizeof(expectedSizes) / sizeof(expectedSizes[0]) && section.Size != expectedSizes[i])
+			{
+				HZ_ERROR("SceneFile: {} section size does not match its header counts", path);
+				return false;
+			}
+			if (section.Size == 0)
+				continue;
+
+			if (section.Offset % SceneFileAlignment != 0 || section.Offset < sizeof(SceneFileHeader) ||
+			    section.Offset > fileSize || section.Size > fileSize - section.Offset)
+			{
+				HZ_ERROR("SceneFile: {} has a truncated or misaligned section", path);
+				return false;
+			}
+		}
+
+		const SceneFileComponentType* types = GetComponentTypes();
+		for (uint32_t i = 0; i < m_Header->ComponentTypeCount; i++)
+		{
+			const SceneFileComponentType& type = types[i];
+			bool named = std::memchr(type.Name, 0, sizeof(type.Name)) != nullptr && type.Name[0] != 0;
+			bool isName = type.Kind == static_cast<uint32_t>(SceneFileComponentKind::Name);
+			if (!named || type.Size == 0 || type.Kind > static_cast<uint32_t>(SceneFileComponentKind::Name) ||
+			    (isName && type.Size != sizeof(SceneFileString)))
+			{
+				HZ_ERROR("SceneFile: {} has an invalid component type", path);
+				return false;
+			}
+		}
+
+		// Archetypes cover the entity numbers in order, and every column they
+		// use lies inside the file. Values inside the blobs are not scanned;
+		// that would defeat the bulk load.
+		const SceneFileArchetype* archetypes = GetArchetypes();
+		const SceneFileColumn* columns = GetColumns();
+		uint64_t nextEntity = 0;
+		uint64_t bareEntities = 0;
+		for (uint32_t a = 0; a < m_Header->ArchetypeCount; a++)
+		{
+			const SceneFileArchetype& archetype = archetypes[a];
+			if (archetype.FirstEntity != nextEntity ||
+			    static_cast<uint64_t>(archetype.FirstColumn) + archetype.ColumnCount > m_Header->ColumnCount)
+			{
+				HZ_ERROR("SceneFile: {} has an invalid archetype table", path);
+				return false;
+			}
+			nextEntity += archetype.EntityCount;
+
+			if (archetype.ColumnCount == 0)
+				bareEntities += archetype.EntityCount;
+			if (bareEntities > SceneFileMaxBareEntities)
+			{
+				HZ_ERROR("SceneFile: {} has more than {} entities without components", path, SceneFileMaxBareEntities);
+				return false;
+			}
+
+			for (uint32_t i = archetype.FirstColumn; i < archetype.FirstColumn + archetype.ColumnCount; i++)
+			{
+				const SceneFileColumn& column = columns[i];
+				if (column.ComponentType >= m_Header->ComponentTypeCount)
+				{
+					HZ_ERROR("SceneFile: {} has a column of an unknown component type", path);
+					return false;
+				}
+
+				uint64_t size = static_cast<uint64_t>(types[column.ComponentType].Size) * archetype.EntityCount;
+				if (column.Offset % SceneFileAlignment != 0 || column.Offset < sizeof(SceneFileHeader) ||
+				    column.Offset > fileSize || size > fileSize - column.Offset)
+				{
+					HZ_ERROR("SceneFile: {} has a truncated or misaligned column", path);
+					return false;
+				}
+			}
+		}
+
+		if (nextEntity != m_Header->EntityCount)
+		{
+			HZ_ERROR("SceneFile: {} archetypes do not add up to its {} entities", path, m_Header->EntityCount);
+			return false;
+		}
+
+		const uint32_t* keys = GetSection<uint32_t>(m_File.GetData(), SceneFileSectionType::EntityKeys);
+		uint64_t keyEnd = static_cast<uint64_t>(m_Header->EntityCount) + SceneFileMaxUnusedKeys;
+		std::vector<bool> usedKeys(static_cast<size_t>(m_Header->EntityCount) + 1, false);
+		for (uint32_t number = 0; number < m_Header->EntityCount; number++)
+		{
+			uint32_t key = keys[number];
+			if (key >= keyEnd || key >= Entity::InvalidIndex)
+			{
+				HZ_ERROR("SceneFile: {} has an entity key out of range", path);
+				return false;
+			}
+			if (key >= usedKeys.size())
+				usedKeys.resize(key + 1, false);
+			if (usedKeys[key])
+			{
+				HZ_ERROR("SceneFile: {} has duplicate entity keys", path);
+				return false;
+			}
+			usedKeys[key] = true;
+		}
+
+		return true;
+	}
+
+	const SceneFileComponentType* SceneFile::GetComponentTypes() const
+	{
+		return GetSection<SceneFileComponentType>(m_File.GetData(), SceneFileSectionType::ComponentTypes);
+	}
+
+	const SceneFileArchetype* SceneFile::GetArchetypes() const
+	{
+		return GetSection<SceneFileArchetype>(m_File.GetData(), SceneFileSectionType::Archetypes);
+	}
+
+	const SceneFileColumn* SceneFile::GetColumns() const
+	{
+		return GetSection<SceneFileColumn>(m_File.GetData(), SceneFileSectionType::Columns);
+	}
+
+	bool SceneFile::Instantiate(Scene& scene) const
+	{
+		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_TAG(Scene);
+
+		if (!IsOpen())
+			return false;
+
+		const unsigned char* data = m_File.GetData();
+		const SceneFileComponentType* types = GetComponentTypes();
+		const SceneFileArchetype* archetypes = GetArchetypes();
+		const SceneFileColumn* columns = GetColumns();
+		const char* pool = GetSection<char>(data, SceneFileSectionType::StringPool);
+		uint64_t poolSize = m_Header->Sections[SectionIndex(SceneFileSectionType::StringPool)].Size;
+
+		// Registered codec of each component type; null for the skipped ones
+		std::vector<const ComponentCodec*> codecs(m_Header->ComponentTypeCount);
+		for (uint32_t i = 0; i < m_Header->ComponentTypeCount; i++)
+		{
+			codecs[i] = FindCodec(types[i]);
+			if (codecs[i])
+				continue;
+
+			if (FindCodec(types[i].Name))
+				HZ_WARN("SceneFile: {} stores component {} with a different layout; it is skipped", m_File.GetPath(), static_cast<const char*>(types[i].Name));
+			else
+				HZ_WARN("SceneFile: {} has unregistered component {}; it is skipped", m_File.GetPath(), static_cast<const char*>(types[i].Name));
+		}
+
+		std::vector<uint32_t> cyclicParents = FindCyclicParents(data, *m_Header, archetypes, columns, codecs);
+
+		// One bulk create per archetype, so every handle exists before the
+		// entity references are patched. Entities are created in number
+		// order and get their keys as indices.
+		scene.Clear();
+		scene.SetNextIndices(GetSection<uint32_t>(data, SceneFileSectionType::EntityKeys), m_Header->EntityCount);
+		std::vector<Entity> entities(m_Header->EntityCount);
+		std::vector<Archetype*> targets(m_Header->ArchetypeCount);
+		std::vector<size_t> firstRows(m_Header->ArchetypeCount);
+		for (uint32_t a = 0; a < m_Header->ArchetypeCount; a++)
+		{
+			const SceneFileArchetype& archetype = archetypes[a];
+			ComponentMask mask = 0;
+			for (uint32_t i = archetype.FirstColumn; i < archetype.FirstColumn + archetype.ColumnCount; i++)
+			{
+				if (const ComponentCodec* codec = codecs[columns[i].ComponentType])
+					mask |= ComponentMask(1) << codec->Id;
+			}
+
+			Archetype& type = scene.CreateEntities(mask, archetype.EntityCount, entities.data() + archetype.FirstEntity);
+			targets[a] = &type;
+			firstRows[a] = type.GetEntityCount() - archetype.EntityCount;
+		}
+
+		// Then each column is copied straight from the mapping, a chunk per job
+		for (uint32_t a = 0; a < m_Header->ArchetypeCount; a++)
+		{
+			const SceneFileArchetype& archetype = archetypes[a];
+			if (archetype.EntityCount == 0)
+				continue;
+
+			const Archetype& type = *targets[a];
+			size_t capacity = type.GetChunkCapacity();
+			size_t firstRow = firstRows[a];
+			size_t endRow = firstRow + archetype.EntityCount;
+			size_t firstChunk = firstRow / capacity;
+			size_t endChunk = (endRow - 1) / capacity + 1;
+
+			for (uint32_t i = archetype.FirstColumn; i < archetype.FirstColumn + archetype.ColumnCount; i++)
+			{
+				const ComponentCodec* codec = codecs[columns[i].ComponentType];
+				if (!codec)
+					continue;
+
+				const unsigned char* blob = data + columns[i].Offset;
+				uint32_t rowSize = ComponentRegistry::GetInfo(codec->Id).Size;
+				JobSystem::ParallelFor(endChunk - firstChunk, 1, [&](size_t begin, size_t end)
+				{
+					for (size_t chunk = firstChunk + begin; chunk < firstChunk + end; chunk++)
+					{
+						const SceneChunk& target = type.GetChunk(chunk);
+						size_t chunkStart = chunk * capacity;
+						size_t rowBegin = (std::max)(firstRow, chunkStart);
+						size_t rowEnd = (std::min)(endRow, chunkStart + target.Count);
+						if (rowBegin >= rowEnd)
+							continue;
+
+						unsigned char* column = static_cast<unsigned char*>(type.GetColumn(target, codec->Id));
+						LoadRows(*codec, entities, pool, poolSize,
+						         blob + (rowBegin - firstRow) * codec->Size,
+						         column + (rowBegin - chunkStart) * rowSize, rowEnd - rowBegin);
+					}
+				});
+			}
+		}
+
+		if (!cyclicParents.empty())
+		{
+			for (uint32_t number : cyclicParents)
+				scene.GetComponent<ParentComponent>(entities[number])->Parent = Entity();
+			HZ_WARN("SceneFile: {} has {} parent links to the entity itself or forming a cycle; they are detached",
+			        m_File.GetPath(), cyclicParents.size());
+		}
+
+		return true;
+	}
+
+	bool SceneFile::WriteText(const std::string& path) const
+	{
+		return IsOpen() && WriteTextImage(m_File.GetData(), path);
+	}
+
+	bool SceneFile::Load(const std::string& path, Scene& scene)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		SceneFile file;
+		if (!file.Open(path) || !file.Instantiate(scene))
+			return false;
+
+		HZ_INFO("SceneFile: loaded {} ({} entities) in {:.2f} ms", path, file.GetHeader().EntityCount, MillisecondsSince(start));
+		return true;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Writing //////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	bool SceneFile::Write(const std::string& path, const Scene& scene)
+	{
+		HZ_PROFILE_FUNCTION();
+		auto start = std::chrono::steady_clock::now();
+
+		std::vector<unsigned char> image;
+		if (!BuildImage(scene, image))
+			return false;
+
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		if (!stream)
+		{
+			HZ_ERROR("SceneFile::Write - failed to create {}", path);
+			return false;
+		}
+
+		stream.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+		if (!stream.good())
+		{
+			HZ_ERROR("SceneFile::Write - failed writing {}", path);
+			return false;
+		}
+
+		HZ_INFO("SceneFile: wrote {} ({} entities, {} KB) in {:.2f} ms", path, scene.GetEntityCount(), image.size() / 1024, MillisecondsSince(start));
+		return true;
+	}
+
+	bool SceneFile::ExportText(const std::string& path, const Scene& scene)
+	{
+		std::vector<unsigned char> image;
+		return BuildImage(scene, image) && WriteTextImage(image.data(), path);
+	}
+
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "../Core.h"
+#include "../MappedFile.h"
+#include "Component.h"
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+
+namespace Hazel {
+
+	class Scene;
+
+	// .hscene - scene container
+	//
+	// Entities are grouped by archetype. Each archetype stores one 16-byte
+	// aligned blob per saved component, rows packed exactly as the scene's
+	// chunks hold them, so loading copies whole arrays out of the memory
+	// mapping. Entities are numbered densely in file order, archetype after
+	// archetype; Entity fields inside components hold those numbers and are
+	// patched to the new handles on load. Names live in a shared string pool.
+	// All values are little-endian.
+	//
+	// File numbers shift whenever an entity changes archetype, so each entity
+	// also keeps its handle index at save time as a key. Loading hands the
+	// keys back out as handle indices, and the text form is ordered and
+	// cross-referenced by them, so it diffs cleanly across edits and reloads.
+	//
+	//   SceneFileHeader
+	//   ComponentTypes   SceneFileComponentType[ComponentTypeCount]
+	//   Archetypes       SceneFileArchetype[ArchetypeCount]
+	//   Columns          SceneFileColumn[ColumnCount]
+	//   EntityKeys       uint32_t[EntityCount], by entity number
+	//   Column blobs     archetype EntityCount * component type Size bytes each
+	//   StringPool       UTF-8, not null-terminated
+
+	static constexpr uint32_t SceneFileMagic = 0x4E435348; // "HSCN"
+	static constexpr uint32_t SceneFileVersion = 2;
+	static constexpr uint32_t SceneFileAlignment = 16;
+	static constexpr uint32_t SceneFileMaxNameLength = 47;
+	// Entities in archetypes without saved columns have no data bounding
+	// their count by the file size, so their total is capped instead
+	static constexpr uint32_t SceneFileMaxBareEntities = 1u << 20;
+	// Keys are distinct and leave at most this many indices unused, as
+	// loading creates a handle slot for each
+	static constexpr uint32_t SceneFileMaxUnusedKeys = 1u << 20;
+
+	enum class SceneFileSectionType : uint32_t
+	{
+		ComponentTypes = 0, Archetypes, Columns, EntityKeys, StringPool, Count
+	};
+
+	enum class SceneFileComponentKind : uint32_t
+	{
+		Data = 0, // Rows stored byte for byte
+		Name      // NameComponent; rows are SceneFileString
+	};
+
+	struct SceneFileComponentType
+	{
+		char Name[SceneFileMaxNameLength + 1]; // Registered name, null-terminated
+		uint32_t Size;                          // Bytes per row
+		uint32_t Kind;                          // SceneFileComponentKind
+		uint32_t Reserved[2];
+	};
+
+	struct SceneFileArchetype
+	{
+		uint32_t FirstEntity; // Number of the first row's entity
+		uint32_t EntityCount;
+		uint32_t FirstColumn; // Into the column table
+		uint32_t ColumnCount;
+	};
+
+	struct SceneFileColumn
+	{
+		uint32_t ComponentType; // Into the component type table
+		uint32_t Reserved;
+		uint64_t Offset;        // Of the blob, from the start of the file
+	};
+
+	struct SceneFileString
+	{
+		uint32_t Offset; // Into the string pool
+		uint32_t Length;
+	};
+
+	struct SceneFileSection
+	{
+		uint64_t Offset;
+		uint64_t Size;
+	};
+
+	struct SceneFileHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t HeaderSize;
+		uint32_t Flags;
+
+		uint32_t EntityCount;
+		uint32_t ComponentTypeCount;
+		uint32_t ArchetypeCount;
+		uint32_t ColumnCount;
+
+		SceneFileSection Sections[static_cast<uint32_t>(SceneFileSectionType::Count)];
+	};
+
+	static_assert(sizeof(SceneFileComponentType) == 64, "SceneFileComponentType layout changed");
+	static_assert(sizeof(SceneFileArchetype) == 16, "SceneFileArchetype layout changed");
+	static_assert(sizeof(SceneFileColumn) == 16, "SceneFileColumn layout changed");
+	static_assert(sizeof(SceneFileString) == 8, "SceneFileString layout changed");
+	static_assert(sizeof(SceneFileHeader) == 112, "SceneFileHeader layout changed");
+	static_assert(sizeof(SceneFileHeader) % SceneFileAlignment == 0, "Header must keep blobs aligned");
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about STL types in DLL interface
+#endif
+
+	// Reader and writer for .hscene files. Open() maps the file and validates
+	// its tables; Instantiate() then fills a scene with one bulk create per
+	// archetype and one copy per chunk and column.
+	//
+	// Only components registered here are saved; NameComponent,
+	// TransformComponent and ParentComponent are registered already.
+	// Applications register theirs on startup, before saving or loading:
+	//
+	//   SceneFile::RegisterComponent<MeshRendererComponent>("MeshRenderer");
+	//
+	// Components are matched by name on load and skipped with a warning when
+	// their size changed; register a new name when a layout changes.
+	class HAZEL_API SceneFile
+	{
+	public:
+		// Appends a readable form of one component to 'out', for text exports
+		using TextFormatter = void (*)(const void* component, std::string& out);
+
+		// T is saved byte for byte. 'entityFields' are the byte offsets of its
+		// Entity members, which are renumbered on save and patched on load.
+		template<typename T>
+		static void RegisterComponent(const char* name, TextFormatter formatter = nullptr,
+		                              std::initializer_list<uint32_t> entityFields = {})
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Components are saved as raw bytes");
+			RegisterComponentType(name, ComponentRegistry::GetId<T>(), static_cast<uint32_t>(sizeof(T)), formatter,
+			                      entityFields.begin(), entityFields.size());
+		}
+
+		// Shortest text that reads back as the same float, for formatters
+		static void FormatFloat(float value, std::string& out);
+
+		SceneFile() = default;
+
+		bool Open(const std::string& path);
+		void Close();
+		bool IsOpen() const { return m_Header != nullptr; }
+
+		const SceneFileHeader& GetHeader() const { return *m_Header; }
+		const SceneFileComponentType* GetComponentTypes() const;
+		const SceneFileArchetype* GetArchetypes() const;
+		const SceneFileColumn* GetColumns() const;
+
+		// Replaces the contents of 'scene' with the file's entities. Parent
+		// links to the entity itself or forming a cycle are detached, as
+		// TransformSystem::SetParent() would have refused them.
+		bool Instantiate(Scene& scene) const;
+		// Writes the file's contents as text, one entity after another in key
+		// order, for diffs
+		bool WriteText(const std::string& path) const;
+
+		// Convenience: open, instantiate and unmap in one go
+		static bool Load(const std::string& path, Scene& scene);
+		static bool Write(const std::string& path, const Scene& scene);
+		// The text WriteText() would produce for 'scene' once written
+		static bool ExportText(const std::string& path, const Scene& scene);
+
+	private:
+		static void RegisterComponentType(const char* name, ComponentId id, uint32_t size, TextFormatter formatter,
+		                                  const uint32_t* entityFields, size_t entityFieldCount);
+
+		bool Validate() const;
+
+	private:
+		MappedFile m_File;
+		const SceneFileHeader* m_Header = nullptr;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
@@ -0,0 +1,361 @@
+#include "TransformSystem.h"
+#include "Scene.h"
+#include "Components.h"
+#include "../Log.h"
+#include "../Memory/MemoryTracker.h"
+#include "../Debug/Profiler.h"
+#include "../Threading/JobSystem.h"
+#include "../Math/TransformBatch.h"
+#include <algorithm>
+
+namespace Hazel {
+
+	TransformSystem::TransformSystem(Scene& scene)
+		: m_Scene(scene)
+	{
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Hierarchy ////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	bool TransformSystem::SetParent(Entity child, Entity parent)
+	{
+		if (!m_Scene.IsValid(child) || (parent && !m_Scene.IsValid(parent)))
+		{
+			HZ_WARN("TransformSystem: SetParent called with an invalid entity");
+			return false;
+		}
+
+		// The new parent must not be the child or one of its descendants
+		for (Entity ancestor = parent; ancestor; ancestor = GetParent(ancestor))
+		{
+			if (ancestor == child)
+			{
+				HZ_WARN("TransformSystem: entity {} cannot become a child of its own descendant {}", child.Index, parent.Index);
+				return false;
+			}
+		}
+
+		if (parent)
+			m_Scene.AddComponent<ParentComponent>(child)->Parent = parent;
+		else
+			m_Scene.RemoveComponent<ParentComponent>(child);
+
+		m_NeedsRebuild = true;
+		return true;
+	}
+
+	Entity TransformSystem::GetParent(Entity entity) const
+	{
+		const ParentComponent* parent = m_Scene.GetComponent<ParentComponent>(entity);
+		return parent && m_Scene.IsValid(parent->Parent) ? parent->Parent : Entity();
+	}
+
+	Entity TransformSystem::GetFirstChild(Entity entity) const
+	{
+		uint32_t node = GetNode(entity);
+		if (node == InvalidNode || m_FirstChildren[node] == InvalidNode)
+			return Entity();
+		return m_Entities[m_FirstChildren[node]];
+	}
+
+	Entity TransformSystem::GetNextSibling(Entity entity) const
+	{
+		uint32_t node = GetNode(entity);
+		if (node == InvalidNode || m_NextSiblings[node] == InvalidNode)
+			return Entity();
+		return m_Entities[m_NextSiblings[node]];
+	}
+
+	uint32_t TransformSystem::GetNode(Entity entity) const
+	{
+		if (entity.Index >= m_NodeOfEntity.size())
+			return InvalidNode;
+
+		uint32_t node = m_NodeOfEntity[entity.Index];
+		return node != InvalidNode && m_Entities[node] == entity ? node : InvalidNode;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Matrices /////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	void TransformSystem::MarkDirty(Entity entity)
+	{
+		// Entities not in the arrays yet are picked up by the pending rebuild
+		uint32_t node = GetNode(entity);
+		if (node == InvalidNode)
+			return;
+
+		m_Dirty[node] = 1;
+		uint32_t level = static_cast<uint32_t>(std::upper_bound(m_LevelStarts.begin(), m_LevelStarts.end(), node) - m_LevelStarts.begin()) - 1;
+		m_LevelDirty[level] = 1;
+	}
+
+	const glm::mat4* TransformSystem::GetWorldMatrix(Entity entity) const
+	{
+		uint32_t node = GetNode(entity);
+		return node != InvalidNode ? &m_WorldMatrices[node] : nullptr;
+	}
+
+	const glm::mat3* TransformSystem::GetNormalMatrix(Entity entity) const
+	{
+		uint32_t node = GetNode(entity);
+		return node != InvalidNode ? &m_NormalMatrices[node] : nullptr;
+	}
+
+	bool TransformSystem::WasChanged(Entity entity) const
+	{
+		uint32_t node = GetNode(entity);
+		return node != InvalidNode && m_ChangedUpdate[node] == m_UpdateIndex;
+	}
+
+	void TransformSystem::Update()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (m_NeedsRebuild || m_ComponentsVersion != GetComponentsVersion())
+			Rebuild();
+
+		if (m_ChangedCount.load(std::memory_order_relaxed) > 0)
+		{
+			for (std::atomic<uint64_t>& word : m_ChangedWords)
+				word.store(0, std::memory_order_relaxed);
+			m_ChangedCount.store(0, std::memory_order_relaxed);
+		}
+		m_UpdateIndex++;
+
+		// A level needs work when it has dirty nodes or its parents changed
+		bool parentsChanged = false;
+		for (uint32_t level = 0; level + 1 < m_LevelStarts.size(); level++)
+		{
+			if (!m_LevelDirty[level] && !parentsChanged)
+				continue;
+
+			size_t changedBefore = m_ChangedCount.load(std::memory_order_relaxed);
+			UpdateLevel(level);
+			m_LevelDirty[level] = 0;
+			parentsChanged = m_ChangedCount.load(std::memory_order_relaxed) != changedBefore;
+		}
+	}
+
+	void TransformSystem::UpdateLevel(uint32_t level)
+	{
+		uint32_t begin = m_LevelStarts[level];
+		uint32_t end = m_LevelStarts[level + 1];
+
+		JobSystem::ParallelFor(end - begin, 1024, [this, begin](size_t rangeBegin, size_t rangeEnd)
+		{
+			// Dirty locals go through the SIMD kernel a batch at a time, then the
+			// batch is composed with the parents in node order
+			constexpr size_t BatchSize = 64;
+			glm::vec3 positions[BatchSize];
+			glm::quat rotations[BatchSize];
+			glm::vec3 scales[BatchSize];
+			glm::mat4 locals[BatchSize];
+			glm::mat3 localNormals[BatchSize];
+			uint32_t batchNodes[BatchSize];
+			uint8_t batchDirty[BatchSize];
+
+			size_t changed = 0;
+			for (size_t batchBegin = begin + rangeBegin; batchBegin < begin + rangeEnd; batchBegin += BatchSize)
+			{
+				size_t batchEnd = (std::min)(batchBegin + BatchSize, begin + rangeEnd);
+
+				size_t dirtyCount = 0;
+				for (size_t node = batchBegin; node < batchEnd; node++)
+				{
+					batchDirty[node - batchBegin] = m_Dirty[node];
+					if (!m_Dirty[node])
+						continue;
+
+					const TransformComponent* transform = m_Scene.GetComponent<TransformComponent>(m_Entities[node]);
+					positions[dirtyCount] = transform->Position;
+					rotations[dirtyCount] = TransformBatch::EulerToQuat(transform->Rotation);
+					scales[dirtyCount] = transform->Scale;
+					batchNodes[dirtyCount++] = static_cast<uint32_t>(node);
+					m_Dirty[node] = 0;
+				}
+
+				TransformBatch::Compose(positions, rotations, scales, dirtyCount, locals, localNormals);
+				for (size_t i = 0; i < dirtyCount; i++)
+				{
+					m_LocalMatrices[batchNodes[i]] = locals[i];
+					m_LocalNormalMatrices[batchNodes[i]] = localNormals[i];
+				}
+
+				for (size_t node = batchBegin; node < batchEnd; node++)
+				{
+					uint32_t parent = m_Parents[node];
+					bool parentChanged = parent != InvalidNode && m_ChangedUpdate[parent] == m_UpdateIndex;
+					if (!batchDirty[node - batchBegin] && !parentChanged)
+						continue;
+
+					if (parent != InvalidNode)
+					{
+						m_WorldMatrices[node] = m_WorldMatrices[parent] * m_LocalMatrices[node];
+						m_NormalMatrices[node] = m_NormalMatrices[parent] * m_LocalNormalMatrices[node];
+					}
+					else
+					{
+						m_WorldMatrices[node] = m_LocalMatrices[node];
+						m_NormalMatrices[node] = m_LocalNormalMatrices[node];
+					}
+					m_ChangedUpdate[node] = m_UpdateIndex;
+
+					uint32_t index = m_Entities[node].Index;
+					m_ChangedWords[index / 64].fetch_or(uint64_t(1) << (index % 64), std::memory_order_relaxed);
+					changed++;
+				}
+			}
+
+			if (changed > 0)
+				m_ChangedCount.fetch_add(changed, std::memory_order_relaxed);
+		});
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Rebuild //////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	uint64_t TransformSystem::GetComponentsVersion() const
+	{
+		// Both only grow, so the sum changes whenever either does
+		return m_Scene.GetComponentVersion(ComponentRegistry::GetId<TransformComponent>()) +
+		       m_Scene.GetComponentVersion(ComponentRegistry::GetId<ParentComponent>());
+	}
+
+	void TransformSystem::Rebuild()
+	{
+		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_TAG(Scene);
+
+		// The previous arrays, to carry matrices over to the new node order
+		std::vector<Entity> oldEntities = std::move(m_Entities);
+		std::vector<uint32_t> oldParents = std::move(m_Parents);
+		std::vector<uint32_t> oldNodeOfEntity = std::move(m_NodeOfEntity);
+		std::vector<glm::mat4> oldLocalMatrices = std::move(m_LocalMatrices);
+		std::vector<glm::mat4> oldWorldMatrices = std::move(m_WorldMatrices);
+		std::vector<glm::mat3> oldLocalNormalMatrices = std::move(m_LocalNormalMatrices);
+		std::vector<glm::mat3> oldNormalMatrices = std::move(m_NormalMatrices);
+		std::vector<uint8_t> oldDirty = std::move(m_Dirty);
+
+		std::vector<Entity> entities;
+		entities.reserve(m_Scene.GetEntityCount());
+		uint32_t indexEnd = 0;
+		m_Scene.Each<TransformComponent>([&](Entity entity, TransformComponent&)
+		{
+			entities.push_back(entity);
+			indexEnd = (std::max)(indexEnd, entity.Index + 1);
+		});
+
+		// Parents without a transform do not count; their children are roots
+		std::vector<Entity> parents(indexEnd);
+		for (Entity entity : entities)
+		{
+			Entity parent = GetParent(entity);
+			if (parent && m_Scene.HasComponent<TransformComponent>(parent))
+				parents[entity.Index] = parent;
+		}
+
+		// Depth of every entity, walking up until a known depth
+		constexpr uint32_t UnknownDepth = 0xFFFFFFFFu;
+		std::vector<uint32_t> depths(indexEnd, UnknownDepth);
+		std::vector<uint32_t> chain;
+		uint32_t depthCount = 0;
+		for (Entity entity : entities)
+		{
+			uint32_t index = entity.Index;
+			// The chain length check only guards against links written around SetParent()
+			while (depths[index] == UnknownDepth && parents[index] && chain.size() < entities.size())
+			{
+				chain.push_back(index);
+				index = parents[index].Index;
+			}
+
+			uint32_t depth = depths[index] == UnknownDepth ? 0 : depths[index];
+			depths[index] = depth;
+			while (!chain.empty())
+			{
+				depths[chain.back()] = ++depth;
+				chain.pop_back();
+			}
+			depthCount = (std::max)(depthCount, depths[entity.Index] + 1);
+		}
+
+		// Counting sort by depth, keeping chunk order within a level
+		m_LevelStarts.assign(depthCount + 1, 0);
+		for (Entity entity : entities)
+			m_LevelStarts[depths[entity.Index] + 1]++;
+		for (uint32_t level = 0; level < depthCount; level++)
+			m_LevelStarts[level + 1] += m_LevelStarts[level];
+
+		size_t count = entities.size();
+		m_Entities.resize(count);
+		m_NodeOfEntity.assign(indexEnd, InvalidNode);
+		std::vector<uint32_t> cursors(m_LevelStarts.begin(), m_LevelStarts.end() - 1);
+		for (Entity entity : entities)
+		{
+			uint32_t node = cursors[depths[entity.Index]]++;
+			m_Entities[node] = entity;
+			m_NodeOfEntity[entity.Index] = node;
+		}
+
+		m_Parents.assign(count, InvalidNode);
+		m_FirstChildren.assign(count, InvalidNode);
+		m_NextSiblings.assign(count, InvalidNode);
+		for (size_t node = count; node-- > 0;)
+		{
+			Entity parent = parents[m_Entities[node].Index];
+			if (!parent)
+				continue;
+
+			uint32_t parentNode = m_NodeOfEntity[parent.Index];
+			m_Parents[node] = parentNode;
+			m_NextSiblings[node] = m_FirstChildren[parentNode];
+			m_FirstChildren[parentNode] = static_cast<uint32_t>(node);
+		}
+
+		// Nodes that existed before keep their matrices and dirty flag unless
+		// their parent changed; new nodes are computed from scratch
+		m_LocalMatrices.resize(count);
+		m_WorldMatrices.resize(count);
+		m_LocalNormalMatrices.resize(count);
+		m_NormalMatrices.resize(count);
+		m_Dirty.assign(count, 1);
+		m_ChangedUpdate.assign(count, 0);
+		m_LevelDirty.assign(depthCount, 0);
+		for (uint32_t level = 0; level < depthCount; level++)
+		{
+			for (uint32_t node = m_LevelStarts[level]; node < m_LevelStarts[level + 1]; node++)
+			{
+				Entity entity = m_Entities[node];
+				uint32_t oldNode = entity.Index < oldNodeOfEntity.size() ? oldNodeOfEntity[entity.Index] : InvalidNode;
+				if (oldNode != InvalidNode && oldEntities[oldNode] == entity)
+				{
+					Entity oldParent = oldParents[oldNode] != InvalidNode ? oldEntities[oldParents[oldNode]] : Entity();
+					Entity parent = m_Parents[node] != InvalidNode ? m_Entities[m_Parents[node]] : Entity();
+
+					m_LocalMatrices[node] = oldLocalMatrices[oldNode];
+					m_WorldMatrices[node] = oldWorldMatrices[oldNode];
+					m_LocalNormalMatrices[node] = oldLocalNormalMatrices[oldNode];
+					m_NormalMatrices[node] = oldNormalMatrices[oldNode];
+					m_Dirty[node] = oldDirty[oldNode] || oldParent != parent;
+				}
+				m_LevelDirty[level] |= m_Dirty[node];
+			}
+		}
+
+		size_t wordCount = (static_cast<size_t>(indexEnd) + 63) / 64;
+		if (m_ChangedWords.size() < wordCount)
+		{
+			m_ChangedWords = std::vector<std::atomic<uint64_t>>(wordCount);
+			m_ChangedCount.store(0, std::memory_order_relaxed);
+		}
+
+		m_ComponentsVersion = GetComponentsVersion();
+		m_NeedsRebuild = false;
+	}
+
+}
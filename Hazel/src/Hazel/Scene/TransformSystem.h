@@ -0,0 +1,119 @@
+#pragma once
+
+#include "../Core.h"
+#include "Entity.h"
+#include <glm/glm.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Hazel {
+
+	class Scene;
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
+	// World matrices of every entity with a TransformComponent, following
+	// ParentComponent links. Nodes are kept in structure-of-arrays form sorted
+	// by depth, so each parent precedes its children and every depth level is
+	// one contiguous range whose nodes can be processed in parallel.
+	//
+	// Update() recomputes only nodes marked dirty and the subtrees below them;
+	// levels with neither are skipped. The entities whose world matrix changed
+	// in the last Update() are published as a bitset over entity indices, for
+	// culling structures and GPU buffers that update incrementally.
+	//
+	// Local matrices are composed through TransformBatch together with their
+	// normal matrices, which concatenate down the hierarchy like the world
+	// matrices do, so no matrix is ever inverted.
+	//
+	// Writers of a TransformComponent call MarkDirty(). Entities gaining or
+	// losing a TransformComponent or ParentComponent, and SetParent(), rebuild
+	// the arrays on the next Update(). Matrices carry over the rebuild; only
+	// new nodes and nodes whose parent changed are recomputed, with their
+	// subtrees.
+	class HAZEL_API TransformSystem
+	{
+	public:
+		explicit TransformSystem(Scene& scene);
+
+		TransformSystem(const TransformSystem&) = delete;
+		TransformSystem& operator=(const TransformSystem&) = delete;
+
+		// A null parent detaches. Fails when either entity is invalid or the
+		// link would form a cycle.
+		bool SetParent(Entity child, Entity parent);
+		Entity GetParent(Entity entity) const;
+
+		// Children as of the last Update(), in depth-sorted order
+		Entity GetFirstChild(Entity entity) const;
+		Entity GetNextSibling(Entity entity) const;
+
+		// The entity's TransformComponent was written
+		void MarkDirty(Entity entity);
+
+		void Update();
+
+		// nullptr until the entity has been through Update()
+		const glm::mat4* GetWorldMatrix(Entity entity) const;
+		// Inverse transpose of the world matrix's upper 3x3, for normals
+		const glm::mat3* GetNormalMatrix(Entity entity) const;
+
+		// Entities whose world matrix changed in the last Update()
+		bool WasChanged(Entity entity) const;
+		size_t GetChangedCount() const { return m_ChangedCount.load(std::memory_order_relaxed); }
+		// Bit i of the bitset is entity index i
+		size_t GetChangedWordCount() const { return m_ChangedWords.size(); }
+		uint64_t GetChangedWord(size_t index) const { return m_ChangedWords[index].load(std::memory_order_relaxed); }
+
+		size_t GetNodeCount() const { return m_Entities.size(); }
+		uint32_t GetDepthCount() const { return m_LevelStarts.empty() ? 0 : static_cast<uint32_t>(m_LevelStarts.size() - 1); }
+
+	private:
+		static constexpr uint32_t InvalidNode = 0xFFFFFFFFu;
+
+		uint32_t GetNode(Entity entity) const;
+		// Versions of the components that shape the hierarchy
+		uint64_t GetComponentsVersion() const;
+		void Rebuild();
+		void UpdateLevel(uint32_t level);
+
+	private:
+		Scene& m_Scene;
+		uint64_t m_ComponentsVersion = ~0ull;
+		bool m_NeedsRebuild = true;
+
+		// Per node, sorted by depth
+		std::vector<Entity> m_Entities;
+		std::vector<uint32_t> m_Parents;
+		std::vector<uint32_t> m_FirstChildren;
+		std::vector<uint32_t> m_NextSiblings;
+		std::vector<glm::mat4> m_LocalMatrices;
+		std::vector<glm::mat4> m_WorldMatrices;
+		std::vector<glm::mat3> m_LocalNormalMatrices;
+		std::vector<glm::mat3> m_NormalMatrices;
+		std::vector<uint8_t> m_Dirty;
+		// Update() that last changed the world matrix
+		std::vector<uint32_t> m_ChangedUpdate;
+
+		// Nodes of depth d are [m_LevelStarts[d], m_LevelStarts[d + 1])
+		std::vector<uint32_t> m_LevelStarts;
+		std::vector<uint8_t> m_LevelDirty;
+
+		// Indexed by entity index
+		std::vector<uint32_t> m_NodeOfEntity;
+
+		uint32_t m_UpdateIndex = 0;
+		std::vector<std::atomic<uint64_t>> m_ChangedWords;
+		std::atomic<size_t> m_ChangedCount{ 0 };
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
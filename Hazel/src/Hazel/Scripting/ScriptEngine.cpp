@@ -1,5 +1,6 @@
 #include "ScriptEngine.h"
 #include "../Log.h"
+#include "../Memory/MemoryTracker.h"
 
 namespace Hazel {
 
@@ -8,6 +9,8 @@ namespace Hazel {
 
 	void ScriptEngine::Init()
 	{
+		HZ_MEMORY_TAG(Scripting);
+
 		if (!s_Initialized)
 		{
 			HZ_INFO("Initializing C# Scripting Engine...");
@@ -37,8 +40,10 @@ namespace Hazel {
 
 	void ScriptEngine::LoadAssembly(const std::string& assemblyPath)
 	{
+		HZ_MEMORY_TAG(Scripting);
+
 		s_AssemblyPath = assemblyPath;
-		HZ_INFO("Loading C# Assembly: " + assemblyPath);
+		HZ_INFO("Loading C# Assembly: {}", assemblyPath);
 		
 		// Load the assembly using Mono:
 		// MonoDomain* domain = mono_domain_get();
@@ -57,7 +62,9 @@ namespace Hazel {
 
 	std::shared_ptr<ScriptInstance> ScriptEngine::CreateScriptInstance(const std::string& className)
 	{
-		HZ_INFO("Creating Script Instance: " + className);
+		HZ_MEMORY_TAG(Scripting);
+
+		HZ_INFO("Creating Script Instance: {}", className);
 		return std::make_shared<ScriptInstance>(className);
 	}
 
@@ -66,7 +73,7 @@ namespace Hazel {
 	ScriptInstance::ScriptInstance(const std::string& className)
 		: m_ClassName(className)
 	{
-		HZ_TRACE("ScriptInstance created for class: " + className);
+		HZ_TRACE("ScriptInstance created for class: {}", className);
 		
 		// Create Mono object instance:
 		// MonoClass* monoClass = mono_class_from_name(image, "Hazel", className.c_str());
@@ -76,7 +83,7 @@ namespace Hazel {
 
 	ScriptInstance::~ScriptInstance()
 	{
-		HZ_TRACE("ScriptInstance destroyed for class: " + m_ClassName);
+		HZ_TRACE("ScriptInstance destroyed for class: {}", m_ClassName);
 	}
 
 	void ScriptInstance::InvokeOnCreate()
@@ -0,0 +1,201 @@
+#include "JobBenchmark.h"
+#include "JobSystem.h"
+#include "../Log.h"
+#include "../Renderer/MeshGenerator.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <thread>
+
+namespace Hazel {
+
+	namespace {
+
+		struct Workload
+		{
+			const char* Name;
+			std::function<void()> Run;
+		};
+
+		struct TransformInput
+		{
+			glm::vec3 Translation;
+			glm::quat Rotation;
+			glm::vec3 Scale;
+		};
+
+		// Keeps the optimizer from discarding a workload's results
+		volatile float s_Sink = 0.0f;
+
+	}
+
+	std::vector<JobScalingResult> JobBenchmark::RunScaling(uint32_t maxThreads, uint32_t iterations)
+	{
+		uint32_t previousThreadCount = JobSystem::IsInitialized() ? JobSystem::GetThreadCount() : 0;
+		if (maxThreads == 0)
+			maxThreads = (std::max)(std::thread::hardware_concurrency(), 1u);
+		iterations = (std::max)(iterations, 1u);
+
+		/////////////////////////////////////////////////////////////////////////
+		// Workloads ////////////////////////////////////////////////////////////
+		/////////////////////////////////////////////////////////////////////////
+
+		TerrainSettings terrain;
+		terrain.Resolution = 512;
+		MeshSize terrainSize = MeshGenerator::GetTerrainSize(terrain);
+		std::vector<float> terrainVertices(terrainSize.GetVertexFloatCount());
+		std::vector<unsigned int> terrainIndices(terrainSize.IndexCount);
+
+		const size_t transformCount = 1 << 18;
+		std::vector<TransformInput> transforms(transformCount);
+		std::vector<glm::mat4> matrices(transformCount);
+		for (size_t i = 0; i < transformCount; i++)
+		{
+			float f = static_cast<float>(i);
+			transforms[i] = { glm::vec3(f, f * 0.5f, -f), glm::angleAxis(f * 0.01f, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f))), glm::vec3(1.0f + (i % 7) * 0.1f) };
+		}
+
+		const size_t sphereCount = 1 << 20;
+		std::vector<glm::vec4> spheres(sphereCount);
+		std::vector<uint8_t> visible(sphereCount);
+		for (size_t i = 0; i < sphereCount; i++)
+		{
+			float f = static_cast<float>(i);
+			spheres[i] = glm::vec4(std::fmod(f * 0.37f, 200.0f) - 100.0f, std::fmod(f * 0.11f, 50.0f) - 25.0f, -std::fmod(f * 0.23f, 300.0f), 1.0f);
+		}
+		glm::mat4 viewProjection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 250.0f);
+		glm::vec4 planes[6];
+		for (int i = 0; i < 3; i++)
+		{
+			glm::vec4 row = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+			glm::vec4 w = glm::vec4(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+			planes[i * 2 + 0] = (w + row) / glm::length(glm::vec3(w + row));
+			planes[i * 2 + 1] = (w - row) / glm::length(glm::vec3(w - row));
+		}
+
+		const size_t tinyJobCount = 1 << 14;
+
+		std::vector<Workload> workloads = {
+			{ "Terrain generation (513x513)", [&]()
+			{
+				MeshGenerator::GenerateTerrain(terrain, terrainVertices.data(), terrainIndices.data());
+				s_Sink = terrainVertices[terrainVertices.size() / 2];
+			} },
+			{ "Transform update (256K TRS)", [&]()
+			{
+				JobSystem::ParallelFor(transformCount, 1024, [&](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; i++)
+					{
+						const TransformInput& t = transforms[i];
+						matrices[i] = glm::translate(glm::mat4(1.0f), t.Translation) * glm::mat4_cast(t.Rotation) * glm::scale(glm::mat4(1.0f), t.Scale);
+					}
+				});
+				s_Sink = matrices[transformCount / 2][3][0];
+			} },
+			{ "Frustum culling (1M spheres)", [&]()
+			{
+				JobSystem::ParallelFor(sphereCount, 4096, [&](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; i++)
+					{
+						glm::vec4 sphere = glm::vec4(glm::vec3(spheres[i]), 1.0f);
+						bool inside = true;
+						for (int p = 0; p < 6; p++)
+							inside &= glm::dot(planes[p], sphere) >= -spheres[i].w;
+						visible[i] = inside ? 1 : 0;
+					}
+				});
+				s_Sink = visible[sphereCount / 2];
+			} },
+			{ "Tiny jobs (16K x ~1us)", [&]()
+			{
+				JobCounter counter;
+				std::atomic<uint32_t> total{ 0 };
+				for (size_t i = 0; i < tinyJobCount; i++)
+				{
+					JobSystem::Run([&total, i]()
+					{
+						uint32_t x = static_cast<uint32_t>(i) + 1;
+						for (int k = 0; k < 200; k++)
+							x = x * 1664525u + 1013904223u;
+						total.fetch_add(x, std::memory_order_relaxed);
+					}, &counter);
+				}
+				JobSystem::Wait(counter);
+				s_Sink = static_cast<float>(total.load());
+			} }
+		};
+
+		/////////////////////////////////////////////////////////////////////////
+		// Measurement //////////////////////////////////////////////////////////
+		/////////////////////////////////////////////////////////////////////////
+
+		std::vector<uint32_t> threadCounts;
+		for (uint32_t threads = 1; threads < maxThreads; threads *= 2)
+			threadCounts.push_back(threads);
+		threadCounts.push_back(maxThreads);
+
+		std::vector<JobScalingResult> results(workloads.size());
+		for (size_t w = 0; w < workloads.size(); w++)
+			results[w].Workload = workloads[w].Name;
+
+		for (uint32_t threads : threadCounts)
+		{
+			JobSystem::Shutdown();
+			JobSystem::Init(threads);
+
+			for (size_t w = 0; w < workloads.size(); w++)
+			{
+				// One untimed run warms caches and the job pools
+				workloads[w].Run();
+
+				double best = 1e30;
+				for (uint32_t i = 0; i < iterations; i++)
+				{
+					auto start = std::chrono::high_resolution_clock::now();
+					workloads[w].Run();
+					auto end = std::chrono::high_resolution_clock::now();
+					best = (std::min)(best, std::chrono::duration<double, std::milli>(end - start).count());
+				}
+
+				JobScalingSample sample;
+				sample.ThreadCount = threads;
+				sample.Milliseconds = best;
+				double baseline = results[w].Samples.empty() ? best : results[w].Samples.front().Milliseconds;
+				sample.Speedup = baseline / best;
+				sample.Efficiency = sample.Speedup / threads;
+				results[w].Samples.push_back(sample);
+			}
+		}
+
+		JobSystem::Shutdown();
+		if (previousThreadCount > 0)
+			JobSystem::Init(previousThreadCount);
+
+		return results;
+	}
+
+	void JobBenchmark::LogResults(const std::vector<JobScalingResult>& results)
+	{
+		HZ_INFO("JobSystem scaling benchmark:");
+		for (const auto& result : results)
+		{
+			HZ_INFO("  {}", result.Workload);
+			for (const auto& sample : result.Samples)
+			{
+				char line[128];
+				std::snprintf(line, sizeof(line), "    %2u threads: %8.3f ms  speedup %5.2fx  efficiency %3.0f%%",
+				              sample.ThreadCount, sample.Milliseconds, sample.Speedup, sample.Efficiency * 100.0);
+				Log::Info(line);
+			}
+		}
+	}
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../Core.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Hazel {
+
+	struct JobScalingSample
+	{
+		uint32_t ThreadCount = 0;
+		double Milliseconds = 0.0; // Best of the measured iterations
+		double Speedup = 1.0;      // Relative to the single-thread sample
+		double Efficiency = 1.0;   // Speedup / ThreadCount
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
+	struct HAZEL_API JobScalingResult
+	{
+		std::string Workload;
+		std::vector<JobScalingSample> Samples;
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+	// Measures how engine workloads scale over the job system: terrain
+	// generation, transform updates, sphere-frustum culling and a burst of tiny
+	// jobs that exposes scheduling overhead. Each workload is timed at
+	// 1, 2, 4, ... threads up to maxThreads.
+	//
+	// The job system is restarted for every thread count, so call this from the
+	// thread that owns it while nothing else uses it: applications run it with
+	// --job-benchmark, before any window or layer exists. The original thread
+	// count is restored afterwards.
+	class HAZEL_API JobBenchmark
+	{
+	public:
+		// maxThreads = 0 uses one thread per hardware thread
+		static std::vector<JobScalingResult> RunScaling(uint32_t maxThreads = 0, uint32_t iterations = 5);
+		static void LogResults(const std::vector<JobScalingResult>& results);
+	};
+
+}
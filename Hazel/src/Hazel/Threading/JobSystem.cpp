@@ -0,0 +1,424 @@
+#include "JobSystem.h"
+#include "../Log.h"
+#include "../Debug/Profiler.h"
+#include <cstdio>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <thread>
+
+namespace Hazel {
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Work-stealing deque //////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	namespace {
+
+		// Fixed-capacity Chase-Lev deque (Le et al., "Correct and Efficient
+		// Work-Stealing for Weak Memory Models"). Only the owning thread calls
+		// Push/Pop; any thread may call Steal.
+		class WorkStealingDeque
+		{
+		public:
+			static constexpr int64_t Capacity = 4096;
+			static constexpr int64_t Mask = Capacity - 1;
+
+			bool Push(Job* job)
+			{
+				int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+				int64_t top = m_Top.load(std::memory_order_acquire);
+				if (bottom - top >= Capacity)
+					return false;
+
+				m_Jobs[bottom & Mask].store(job, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+				return true;
+			}
+
+			Job* Pop()
+			{
+				int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+				m_Bottom.store(bottom, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				int64_t top = m_Top.load(std::memory_order_relaxed);
+
+				if (top > bottom)
+				{
+					// Empty
+					m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+					return nullptr;
+				}
+
+				Job* job = m_Jobs[bottom & Mask].load(std::memory_order_relaxed);
+				if (top == bottom)
+				{
+					// Last job: race the thieves for it
+					if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+						job = nullptr;
+					m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+				}
+				return job;
+			}
+
+			Job* Steal()
+			{
+				int64_t top = m_Top.load(std::memory_order_acquire);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+				if (top >= bottom)
+					return nullptr;
+
+				Job* job = m_Jobs[top & Mask].load(std::memory_order_relaxed);
+				if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					return nullptr;
+				return job;
+			}
+
+		private:
+			// Thieves and the owner touch different ends; keep them on separate cache lines
+			alignas(64) std::atomic<int64_t> m_Top{ 0 };
+			alignas(64) std::atomic<int64_t> m_Bottom{ 0 };
+			alignas(64) std::atomic<Job*> m_Jobs[Capacity] = {};
+		};
+
+		struct WorkerState
+		{
+			WorkStealingDeque Queue;
+
+			// Jobs are recycled round-robin; allocation helps run queued jobs
+			// if the next slot still holds one that has not run yet
+			static constexpr uint32_t JobPoolSize = 4096;
+			std::unique_ptr<Job[]> JobPool{ new Job[JobPoolSize] };
+			uint32_t NextJob = 0;
+
+			uint32_t RandomState = 0;
+		};
+
+		struct JobSystemData
+		{
+			std::vector<std::unique_ptr<WorkerState>> Workers;
+			std::vector<std::thread> Threads;
+			std::atomic<bool> Running{ false };
+
+			// Jobs submitted from threads the system does not own (e.g. a loader thread)
+			std::mutex ExternalMutex;
+			std::deque<Job*> ExternalQueue;
+
+			// Idle workers sleep once they find nothing to do for a while
+			std::atomic<int> PendingJobs{ 0 };
+			std::atomic<int> SleepingWorkers{ 0 };
+			std::mutex SleepMutex;
+			std::condition_variable WakeCondition;
+		};
+
+		JobSystemData* s_Data = nullptr;
+		thread_local int t_ThreadIndex = -1;
+
+		// Spins this many times through the queues before a worker goes to sleep
+		constexpr int s_IdleSpins = 64;
+
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// Scheduling ///////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	static void WakeWorker()
+	{
+		if (s_Data->SleepingWorkers.load() > 0)
+		{
+			std::lock_guard<std::mutex> lock(s_Data->SleepMutex);
+			s_Data->WakeCondition.notify_one();
+		}
+	}
+
+	void JobSystem::Enqueue(Job* job)
+	{
+		s_Data->PendingJobs.fetch_add(1);
+
+		int index = t_ThreadIndex;
+		if (index >= 0)
+		{
+			if (!s_Data->Workers[index]->Queue.Push(job))
+			{
+				// Deque full: running the job here is always correct, just less parallel
+				s_Data->PendingJobs.fetch_sub(1);
+				Execute(job);
+				return;
+			}
+		}
+		else
+		{
+			std::lock_guard<std::mutex> lock(s_Data->ExternalMutex);
+			s_Data->ExternalQueue.push_back(job);
+		}
+
+		WakeWorker();
+	}
+
+	static Job* FindJob()
+	{
+		int index = t_ThreadIndex;
+		int workerCount = static_cast<int>(s_Data->Workers.size());
+
+		if (index >= 0)
+		{
+			if (Job* job = s_Data->Workers[index]->Queue.Pop())
+				return job;
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(s_Data->ExternalMutex, std::try_to_lock);
+			if (lock.owns_lock() && !s_Data->ExternalQueue.empty())
+			{
+				Job* job = s_Data->ExternalQueue.front();
+				s_Data->ExternalQueue.pop_front();
+				return job;
+			}
+		}
+
+		// Steal from the others, starting at a random victim so thieves spread out
+		uint32_t start = 0;
+		if (index >= 0)
+		{
+			uint32_t& state = s_Data->Workers[index]->RandomState;
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			start = state;
+		}
+
+		for (int i = 0; i < workerCount; i++)
+		{
+			int victim = static_cast<int>((start + i) % workerCount);
+			if (victim == index)
+				continue;
+			if (Job* job = s_Data->Workers[victim]->Queue.Steal())
+				return job;
+		}
+
+		return nullptr;
+	}
+
+	bool JobSystem::RunOneJob()
+	{
+		Job* job = FindJob();
+		if (!job)
+			return false;
+
+		s_Data->PendingJobs.fetch_sub(1);
+		Execute(job);
+		return true;
+	}
+
+	void JobSystem::WorkerMain(int index)
+	{
+		t_ThreadIndex = index;
+
+		char name[32];
+		std::snprintf(name, sizeof(name), "Job Worker %d", index);
+		Profiler::SetThreadName(name);
+
+		int idle = 0;
+		while (s_Data->Running.load(std::memory_order_relaxed))
+		{
+			if (RunOneJob())
+			{
+				idle = 0;
+				continue;
+			}
+
+			if (++idle < s_IdleSpins)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(s_Data->SleepMutex);
+			s_Data->SleepingWorkers.fetch_add(1);
+			s_Data->WakeCondition.wait(lock, []()
+			{
+				return s_Data->PendingJobs.load() > 0 || !s_Data->Running.load();
+			});
+			s_Data->SleepingWorkers.fetch_sub(1);
+			idle = 0;
+		}
+
+		t_ThreadIndex = -1;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// JobSystem ////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	void JobSystem::Init(uint32_t threadCount)
+	{
+		HZ_MEMORY_TAG(Jobs);
+
+		if (s_Data)
+		{
+			HZ_WARN("JobSystem already initialized");
+			return;
+		}
+
+		if (threadCount == 0)
+			threadCount = (std::max)(std::thread::hardware_concurrency(), 1u);
+
+		s_Data = new JobSystemData();
+		s_Data->Running = true;
+
+		s_Data->Workers.reserve(threadCount);
+		for (uint32_t i = 0; i < threadCount; i++)
+		{
+			s_Data->Workers.push_back(std::make_unique<WorkerState>());
+			s_Data->Workers.back()->RandomState = 0x9E3779B9u * (i + 1);
+		}
+
+		// The calling thread is worker 0; it runs jobs while it waits
+		t_ThreadIndex = 0;
+		s_Data->Threads.reserve(threadCount - 1);
+		for (uint32_t i = 1; i < threadCount; i++)
+			s_Data->Threads.emplace_back(&JobSystem::WorkerMain, static_cast<int>(i));
+
+		HZ_INFO("JobSystem initialized with {} threads", threadCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		if (!s_Data)
+			return;
+
+		// Drain whatever is still queued so no counter is left waiting
+		while (RunOneJob()) {}
+
+		{
+			std::lock_guard<std::mutex> lock(s_Data->SleepMutex);
+			s_Data->Running = false;
+		}
+		s_Data->WakeCondition.notify_all();
+
+		for (auto& thread : s_Data->Threads)
+			thread.join();
+
+		t_ThreadIndex = -1;
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	bool JobSystem::IsInitialized()
+	{
+		return s_Data != nullptr;
+	}
+
+	uint32_t JobSystem::GetThreadCount()
+	{
+		return s_Data ? static_cast<uint32_t>(s_Data->Workers.size()) : 1;
+	}
+
+	int JobSystem::GetThreadIndex()
+	{
+		return t_ThreadIndex;
+	}
+
+	size_t JobSystem::GetGrainSize(size_t count, size_t minGrain)
+	{
+		size_t threadCount = GetThreadCount();
+		if (threadCount <= 1)
+			return count;
+
+		// Enough ranges that a thread finishing early always finds one to steal
+		return (std::max)((std::max)(minGrain, static_cast<size_t>(1)), count / (threadCount * 8));
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			if (!s_Data || !RunOneJob())
+				std::this_thread::yield();
+		}
+	}
+
+	Job* JobSystem::AllocateJob()
+	{
+		int index = t_ThreadIndex;
+		if (index < 0)
+		{
+			Job* job = new Job();
+			job->HeapAllocated = true;
+			return job;
+		}
+
+		WorkerState& worker = *s_Data->Workers[index];
+		Job* job = &worker.JobPool[worker.NextJob++ & (WorkerState::JobPoolSize - 1)];
+		while (job->Busy.load(std::memory_order_acquire))
+		{
+			if (!RunOneJob())
+				std::this_thread::yield();
+		}
+
+		job->HeapAllocated = false;
+		job->Busy.store(true, std::memory_order_relaxed);
+		return job;
+	}
+
+	void JobSystem::Submit(Job* job, JobCounter* counter, JobCounter* dependency)
+	{
+		job->Counter = counter;
+		job->Tag = MemoryTracker::GetCurrentTag();
+		if (counter)
+			counter->m_Value.fetch_add(1);
+
+		if (dependency)
+		{
+			// Checked under the lock so a counter reaching zero concurrently either
+			// sees this continuation or we see the zero
+			std::lock_guard<std::mutex> lock(dependency->m_Mutex);
+			if (dependency->m_Value.load() != 0)
+			{
+				dependency->m_Continuations.push_back(job);
+				return;
+			}
+		}
+
+		Enqueue(job);
+	}
+
+	void JobSystem::Execute(Job* job)
+	{
+		{
+			HZ_PROFILE_SCOPE("Job");
+			MemoryTagScope tag(job->Tag);
+			job->Invoke(job->Payload);
+		}
+
+		// Read everything needed before the slot is released for reuse
+		JobCounter* counter = job->Counter;
+		if (job->HeapAllocated)
+			delete job;
+		else
+			job->Busy.store(false, std::memory_order_release);
+
+		if (!counter)
+			return;
+
+		// m_Finishing keeps IsDone() false until this thread stops touching the counter
+		counter->m_Finishing.fetch_add(1);
+		if (counter->m_Value.fetch_sub(1) == 1)
+		{
+			// Last job of the counter: release everything that depended on it
+			std::vector<Job*> continuations;
+			{
+				std::lock_guard<std::mutex> lock(counter->m_Mutex);
+				continuations.swap(counter->m_Continuations);
+			}
+			for (Job* continuation : continuations)
+				Enqueue(continuation);
+		}
+		counter->m_Finishing.fetch_sub(1);
+	}
+
+}
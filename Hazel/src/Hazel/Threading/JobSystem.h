@@ -0,0 +1,160 @@
+#pragma once
+
+#include "../Core.h"
+#include "../Memory/MemoryTracker.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Hazel {
+
+	class JobCounter;
+
+	// A unit of work. The callable is stored inline, so submitting a job never
+	// touches the heap on worker threads.
+	struct alignas(64) Job
+	{
+		static constexpr size_t PayloadSize = 96;
+
+		alignas(16) unsigned char Payload[PayloadSize];
+		void (*Invoke)(void* payload) = nullptr;
+		JobCounter* Counter = nullptr;
+		bool HeapAllocated = false;
+		MemoryTag Tag = MemoryTag::Untagged; // Of the submitting thread, in effect while the job runs
+		std::atomic<bool> Busy{ false }; // Set from allocation until the job has run
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4251) // Disable warning about DLL interface for private members
+#endif
+
+	// Tracks outstanding jobs. JobSystem::Run increments it, each finished job
+	// decrements it, and jobs submitted with it as a dependency are held back
+	// until it drops to zero.
+	class HAZEL_API JobCounter
+	{
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		// Also false while the last job is still releasing continuations, so a
+		// counter can be destroyed as soon as this returns true
+		bool IsDone() const { return m_Value.load() == 0 && m_Finishing.load() == 0; }
+		int GetValue() const { return m_Value.load(); }
+
+	private:
+		friend class JobSystem;
+
+		std::atomic<int> m_Value{ 0 };
+		std::atomic<int> m_Finishing{ 0 };
+		std::mutex m_Mutex;
+		std::vector<Job*> m_Continuations;
+	};
+
+	// Worker pool with one Chase-Lev deque per thread. A thread pushes and pops
+	// its own jobs at the bottom of its deque (LIFO, cache friendly) while idle
+	// threads steal from the top of the others. The thread that calls Init()
+	// becomes worker 0 and executes jobs whenever it waits on a counter.
+	//
+	// Before Init() (or after Shutdown()) every job runs inline on the caller, so
+	// code using the job system also works in tools that never start it.
+	class HAZEL_API JobSystem
+	{
+	public:
+		// threadCount includes the calling thread; 0 uses one thread per hardware thread
+		static void Init(uint32_t threadCount = 0);
+		static void Shutdown();
+
+		static bool IsInitialized();
+		static uint32_t GetThreadCount();
+		// Index of the calling thread in [0, GetThreadCount()), or -1 for threads the system does not own
+		static int GetThreadIndex();
+
+		// Queues func() to run on any thread. 'counter' is incremented now and
+		// decremented when the job finishes; if 'dependency' is given, the job
+		// only starts once that counter reaches zero.
+		template<typename Func>
+		static void Run(Func&& func, JobCounter* counter = nullptr, JobCounter* dependency = nullptr)
+		{
+			using Callable = std::decay_t<Func>;
+			static_assert(sizeof(Callable) <= Job::PayloadSize, "Job callable is too large; capture by reference or pointer");
+			static_assert(alignof(Callable) <= 16, "Job callable is over-aligned");
+
+			if (!IsInitialized())
+			{
+				func();
+				return;
+			}
+
+			Job* job = AllocateJob();
+			new (job->Payload) Callable(std::forward<Func>(func));
+			job->Invoke = [](void* payload)
+			{
+				Callable* callable = static_cast<Callable*>(payload);
+				(*callable)();
+				callable->~Callable();
+			};
+			Submit(job, counter, dependency);
+		}
+
+		// Blocks until 'counter' reaches zero, executing queued jobs meanwhile
+		static void Wait(JobCounter& counter);
+
+		// Runs func(begin, end) over disjoint ranges covering [0, count). Ranges are
+		// split in halves until they reach the grain size, which adapts to the
+		// thread count but never drops below minGrain; idle threads steal the
+		// upper halves. Returns once every range has run.
+		template<typename Func>
+		static void ParallelFor(size_t count, size_t minGrain, const Func& func)
+		{
+			if (count == 0)
+				return;
+
+			size_t grain = GetGrainSize(count, minGrain);
+			if (grain >= count)
+			{
+				func(static_cast<size_t>(0), count);
+				return;
+			}
+
+			JobCounter counter;
+			SplitRange(0, count, grain, func, counter);
+			Wait(counter);
+		}
+
+		// Grain ParallelFor would use: about eight ranges per thread, at least minGrain
+		static size_t GetGrainSize(size_t count, size_t minGrain);
+
+	private:
+		template<typename Func>
+		static void SplitRange(size_t begin, size_t end, size_t grain, const Func& func, JobCounter& counter)
+		{
+			while (end - begin > grain)
+			{
+				size_t middle = begin + (end - begin) / 2;
+				Run([middle, end, grain, &func, &counter]() { SplitRange(middle, end, grain, func, counter); }, &counter);
+				end = middle;
+			}
+			func(begin, end);
+		}
+
+		static Job* AllocateJob();
+		static void Submit(Job* job, JobCounter* counter, JobCounter* dependency);
+		static void Enqueue(Job* job);
+		static void Execute(Job* job);
+		static bool RunOneJob();
+		static void WorkerMain(int index);
+	};
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+}
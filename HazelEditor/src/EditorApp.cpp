@@ -4,7 +4,8 @@
 class HazelEditorApp : public Hazel::Application
 {
 public:
-	HazelEditorApp()
+	HazelEditorApp(const Hazel::ApplicationSettings& settings)
+		: Hazel::Application(settings)
 	{
 		HZ_INFO("Hazel Editor Application Created");
 		HZ_INFO("Initializing Unity-like Editor Interface...");
@@ -31,7 +32,7 @@ public:
 	}
 };
 
-Hazel::Application* Hazel::CreateApplication()
+Hazel::Application* Hazel::CreateApplication(const Hazel::ApplicationSettings& settings)
 {
-	return new HazelEditorApp();
+	return new HazelEditorApp(settings);
 }
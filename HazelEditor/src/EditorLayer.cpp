@@ -1,31 +1,47 @@
 #include "EditorLayer.h"
 #include "Hazel/ImGui/ImGuiLayer.h"
 #include "Hazel/Application.h"
-#include "Hazel/Renderer/MeshGenerator.h"
+#include "Hazel/FrameClock.h"
+#include "Hazel/Renderer/MeshCache.h"
+#include "Hazel/Renderer/GpuProfiler.h"
 #include "Hazel/Renderer/OpenGLLoader.h"
+#include "Hazel/Threading/JobSystem.h"
+#include "Hazel/Memory/FrameAllocator.h"
+#include "Hazel/Memory/MemoryTracker.h"
+#include "Hazel/Debug/Profiler.h"
+#include "Hazel/Scene/SceneFile.h"
 #include <imgui.h>
 #include <ImGuizmo.h>
+#include <GLFW/glfw3.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <string>
 
 namespace HazelEditor {
 
-	glm::mat4 Transform::GetTransformMatrix() const
+	// Text form of a MeshRendererComponent in scene exports
+	static void FormatMeshRenderer(const void* component, std::string& out)
 	{
-		glm::mat4 transform = glm::translate(glm::mat4(1.0f), Position);
-		transform = glm::rotate(transform, glm::radians(Rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-		transform = glm::rotate(transform, glm::radians(Rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-		transform = glm::rotate(transform, glm::radians(Rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-		transform = glm::scale(transform, Scale);
-		return transform;
+		static const char* meshNames[] = { "None", "Cube", "Sphere", "Capsule" };
+
+		const MeshRendererComponent& meshRenderer = *static_cast<const MeshRendererComponent*>(component);
+		int mesh = static_cast<int>(meshRenderer.Mesh);
+		out += mesh >= 0 && mesh < 4 ? std::string(meshNames[mesh]) : std::to_string(mesh);
+		out += " color";
+		for (int i = 0; i < 4; i++)
+		{
+			out += ' ';
+			Hazel::SceneFile::FormatFloat(meshRenderer.Color[i], out);
+		}
 	}
 
 	EditorLayer::EditorLayer()
-		: Layer("EditorLayer")
+		: Layer("EditorLayer"), m_TransformSystem(m_Scene)
 	{
+		Hazel::SceneFile::RegisterComponent<MeshRendererComponent>("MeshRenderer", &FormatMeshRenderer);
 	}
 
 	void EditorLayer::OnAttach()
@@ -46,8 +62,15 @@ namespace HazelEditor {
 			layout(location = 0) in vec3 a_Position;
 			layout(location = 1) in vec3 a_Normal;
 
-			uniform mat4 u_ViewProjection;
+			layout(std140) uniform Camera
+			{
+				mat4 u_ViewProjection;
+				mat4 u_View;
+				mat4 u_Projection;
+				vec4 u_CameraPosition;
+			};
 			uniform mat4 u_Transform;
+			uniform mat3 u_NormalMatrix;
 
 			out vec3 v_FragPos;
 			out vec3 v_Normal;
@@ -55,7 +78,7 @@ namespace HazelEditor {
 			void main()
 			{
 				v_FragPos = vec3(u_Transform * vec4(a_Position, 1.0));
-				v_Normal = mat3(transpose(inverse(u_Transform))) * a_Normal;
+				v_Normal = u_NormalMatrix * a_Normal;
 				gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
 			}
 		)";
@@ -127,22 +150,24 @@ namespace HazelEditor {
 		// Initialize mesh buffers
 		InitializeMeshBuffers();
 
+		// Flagged in the Memory panel and the console when exceeded
+		Hazel::MemoryTracker::SetBudget(Hazel::MemoryTag::Log, 16 * 1024 * 1024);
+		Hazel::MemoryTracker::SetBudget(Hazel::MemoryTag::Scene, 64 * 1024 * 1024);
+		Hazel::MemoryTracker::SetBudget(Hazel::MemoryTag::Renderer, 256 * 1024 * 1024);
+
 		// Create sample scene hierarchy
-		m_Entities.emplace_back("Main Camera", m_NextEntityID++);
-		m_Entities.emplace_back("Directional Light", m_NextEntityID++);
+		NewScene();
 		
 		// Add a default cube to demonstrate
-		CreateEntity("Cube", MeshType::Cube);
-		m_Entities.back().EntityTransform.Position = glm::vec3(0.0f, 0.0f, 0.0f);
-		m_Entities.back().Color = glm::vec4(0.8f, 0.3f, 0.3f, 1.0f);
+		Hazel::Entity cube = CreateEntity("Cube", MeshType::Cube);
 		
 		// Add a sphere for testing
-		CreateEntity("Sphere", MeshType::Sphere);
-		m_Entities.back().EntityTransform.Position = glm::vec3(2.0f, 0.0f, 0.0f);
-		m_Entities.back().Color = glm::vec4(0.3f, 0.8f, 0.3f, 1.0f);
+		Hazel::Entity sphere = CreateEntity("Sphere", MeshType::Sphere);
+		m_Scene.GetComponent<Hazel::TransformComponent>(sphere)->Position = glm::vec3(2.0f, 0.0f, 0.0f);
+		m_Scene.GetComponent<MeshRendererComponent>(sphere)->Color = glm::vec4(0.3f, 0.8f, 0.3f, 1.0f);
 		
 		// Focus camera on the default cube so it's visible
-		FocusOnEntity(&m_Entities[2]); // Focus on the cube (skip camera and light)
+		FocusOnEntity(cube);
 	}
 
 	void EditorLayer::OnDetach()
@@ -154,20 +179,12 @@ namespace HazelEditor {
 		// after the context has been destroyed by GLFW
 		
 		// Release resources in reverse order of creation/dependency:
-		// 1. Vertex arrays (reference buffers, so release first)
+		// 1. Mesh handles (the GPU buffers are freed once the MeshCache drops them too)
 		m_CubeMesh.reset();
 		m_SphereMesh.reset();
 		m_CapsuleMesh.reset();
 		
-		// 2. Index and vertex buffers
-		m_CubeIndexBuffer.reset();
-		m_CubeVertexBuffer.reset();
-		m_SphereIndexBuffer.reset();
-		m_SphereVertexBuffer.reset();
-		m_CapsuleIndexBuffer.reset();
-		m_CapsuleVertexBuffer.reset();
-		
-		// 3. High-level rendering resources
+		// 2. High-level rendering resources
 		m_SceneLight.reset();
 		m_DefaultMaterial.reset();
 		m_SceneShader.reset();
@@ -179,13 +196,10 @@ namespace HazelEditor {
 
 	void EditorLayer::OnUpdate(float deltaTime)
 	{
-		// Update editor camera
-		// Update when viewport is hovered (allows flying camera mode when right-clicking)
-		if (m_ViewportHovered)
-		{
-			m_EditorCamera->OnUpdate(deltaTime);
-		}
-		
+		HZ_PROFILE_FUNCTION();
+
+		// The editor camera moves in LatchCameraInput(), right before the scene is drawn
+
 		// Update editor logic
 		if (m_IsPlaying && !m_IsPaused)
 		{
@@ -195,6 +209,8 @@ namespace HazelEditor {
 
 	void EditorLayer::OnImGuiRender()
 	{
+		HZ_PROFILE_FUNCTION();
+
 		// Initialize ImGuizmo for this frame
 		ImGuizmo::BeginFrame();
 		
@@ -265,20 +281,47 @@ namespace HazelEditor {
 		DrawConsole();
 		DrawGameView();
 		DrawSceneView();
+		DrawStatsOverlay();
 		DrawAssetBrowser();
+		DrawMemoryPanel();
+		DrawScenePathPopup();
 	}
 
 	void EditorLayer::DrawMenuBar()
 	{
+		auto save = [this]()
+		{
+			if (m_ScenePath.empty())
+				RequestScenePath(ScenePathAction::SaveAs);
+			else
+				SaveScene(m_ScenePath);
+		};
+
+		// File shortcuts work from every panel
+		if (ImGui::Shortcut(ImGuiMod_Ctrl | ImGuiKey_N, ImGuiInputFlags_RouteGlobal))
+			NewScene();
+		if (ImGui::Shortcut(ImGuiMod_Ctrl | ImGuiKey_O, ImGuiInputFlags_RouteGlobal))
+			RequestScenePath(ScenePathAction::Open);
+		if (ImGui::Shortcut(ImGuiMod_Ctrl | ImGuiKey_S, ImGuiInputFlags_RouteGlobal))
+			save();
+		if (ImGui::Shortcut(ImGuiMod_Ctrl | ImGuiMod_Shift | ImGuiKey_S, ImGuiInputFlags_RouteGlobal))
+			RequestScenePath(ScenePathAction::SaveAs);
+
 		// Create main menu bar at the top of the screen
 		if (ImGui::BeginMainMenuBar())
 		{
 			if (ImGui::BeginMenu("File"))
 			{
-				if (ImGui::MenuItem("New Scene", "Ctrl+N")) {}
-				if (ImGui::MenuItem("Open Scene", "Ctrl+O")) {}
-				if (ImGui::MenuItem("Save", "Ctrl+S")) {}
-				if (ImGui::MenuItem("Save As...", "Ctrl+Shift+S")) {}
+				if (ImGui::MenuItem("New Scene", "Ctrl+N"))
+					NewScene();
+				if (ImGui::MenuItem("Open Scene", "Ctrl+O"))
+					RequestScenePath(ScenePathAction::Open);
+				if (ImGui::MenuItem("Save", "Ctrl+S"))
+					save();
+				if (ImGui::MenuItem("Save As...", "Ctrl+Shift+S"))
+					RequestScenePath(ScenePathAction::SaveAs);
+				if (ImGui::MenuItem("Export Text..."))
+					RequestScenePath(ScenePathAction::ExportText);
 				ImGui::Separator();
 				if (ImGui::MenuItem("Exit")) {}
 				ImGui::EndMenu();
@@ -327,6 +370,16 @@ namespace HazelEditor {
 					if (ImGui::MenuItem("Plane")) {}
 					ImGui::EndMenu();
 				}
+				if (ImGui::BeginMenu("Stress Test"))
+				{
+					if (ImGui::MenuItem("10,000 Cubes"))
+						SpawnStressTest(10000);
+					if (ImGui::MenuItem("100,000 Cubes"))
+						SpawnStressTest(100000);
+					if (ImGui::MenuItem("1,000,000 Cubes"))
+						SpawnStressTest(1000000);
+					ImGui::EndMenu();
+				}
 				if (ImGui::MenuItem("Camera")) {}
 				if (ImGui::BeginMenu("Light"))
 				{
@@ -350,6 +403,34 @@ namespace HazelEditor {
 				if (ImGui::MenuItem("Hierarchy", nullptr, true)) {}
 				if (ImGui::MenuItem("Console", nullptr, true)) {}
 				if (ImGui::MenuItem("Project", nullptr, true)) {}
+				ImGui::MenuItem("Memory", nullptr, &m_ShowMemoryPanel);
+				ImGui::MenuItem("Statistics Overlay", nullptr, &m_ShowStatsOverlay);
+				ImGui::EndMenu();
+			}
+			if (ImGui::BeginMenu("Tools"))
+			{
+				// Open the written file in chrome://tracing or ui.perfetto.dev
+				if (ImGui::MenuItem("Capture Profile (120 Frames)", nullptr, false, !Hazel::Profiler::IsCapturing()))
+					Hazel::Profiler::StartCapture(120, "HazelEditorProfile.json");
+				if (ImGui::BeginMenu("Frame Limit"))
+				{
+					Hazel::Application& app = Hazel::Application::Get();
+					Hazel::FrameLimitMode mode = app.GetFrameLimitMode();
+					if (ImGui::MenuItem("VSync", nullptr, mode == Hazel::FrameLimitMode::VSync))
+						app.SetFrameLimit(Hazel::FrameLimitMode::VSync, app.GetTargetFps());
+					if (ImGui::MenuItem("Uncapped", nullptr, mode == Hazel::FrameLimitMode::Uncapped))
+						app.SetFrameLimit(Hazel::FrameLimitMode::Uncapped, app.GetTargetFps());
+					ImGui::Separator();
+					for (double fps : { 30.0, 60.0, 120.0, 144.0, 240.0 })
+					{
+						char label[32];
+						std::snprintf(label, sizeof(label), "%.0f FPS", fps);
+						bool selected = mode == Hazel::FrameLimitMode::TargetFps && app.GetTargetFps() == fps;
+						if (ImGui::MenuItem(label, nullptr, selected))
+							app.SetFrameLimit(Hazel::FrameLimitMode::TargetFps, fps);
+					}
+					ImGui::EndMenu();
+				}
 				ImGui::EndMenu();
 			}
 			if (ImGui::BeginMenu("Help"))
@@ -457,28 +538,80 @@ namespace HazelEditor {
 		
 		ImGui::Separator();
 		
-		for (auto& entity : m_Entities)
+		// The tree is flattened into rows so that only the visible ones are drawn
+		auto rows = Hazel::MakeFrameVector<std::pair<Hazel::Entity, int>>(m_HierarchyEntities.size());
+		for (Hazel::Entity entity : m_HierarchyEntities)
 		{
-			DrawEntityNode(&entity);
+			if (!m_TransformSystem.GetParent(entity))
+				AppendHierarchyRows(entity, 0, rows);
+		}
+
+		ImGuiListClipper clipper;
+		clipper.Begin(static_cast<int>(rows.size()));
+		while (clipper.Step())
+		{
+			for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+				DrawEntityNode(rows[i].first, rows[i].second);
+		}
+
+		// Dropping onto the empty space below the tree detaches
+		ImGui::Dummy(ImGui::GetContentRegionAvail());
+		if (ImGui::BeginDragDropTarget())
+		{
+			if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("HIERARCHY_ENTITY"))
+				ReparentEntity(*static_cast<const Hazel::Entity*>(payload->Data), Hazel::Entity());
+			ImGui::EndDragDropTarget();
 		}
 		
 		ImGui::End();
 	}
 
-	void EditorLayer::DrawEntityNode(Entity* entity)
+	void EditorLayer::AppendHierarchyRows(Hazel::Entity entity, int depth, Hazel::FrameVector<std::pair<Hazel::Entity, int>>& rows)
+	{
+		if (!m_Scene.HasComponent<Hazel::NameComponent>(entity))
+			return;
+
+		rows.emplace_back(entity, depth);
+		if (m_ExpandedEntities.count(entity.Index) == 0)
+			return;
+
+		for (Hazel::Entity child = m_TransformSystem.GetFirstChild(entity); child; child = m_TransformSystem.GetNextSibling(child))
+			AppendHierarchyRows(child, depth + 1, rows);
+	}
+
+	void EditorLayer::DrawEntityNode(Hazel::Entity entity, int depth)
 	{
-		ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth;
-		if (entity->IsSelected)
+		const Hazel::NameComponent* name = m_Scene.GetComponent<Hazel::NameComponent>(entity);
+		if (!name)
+			return;
+
+		// Rows are drawn flat, so the tree indentation is applied by hand
+		ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+		if (entity == m_SelectedEntity)
 			flags |= ImGuiTreeNodeFlags_Selected;
-		if (entity->Children.empty())
+		if (!m_TransformSystem.GetFirstChild(entity))
 			flags |= ImGuiTreeNodeFlags_Leaf;
 
-		bool opened = ImGui::TreeNodeEx((void*)(intptr_t)entity->ID, flags, "%s", entity->Name.c_str());
+		float indent = depth * ImGui::GetStyle().IndentSpacing;
+		if (indent > 0.0f)
+			ImGui::Indent(indent);
+
+		bool expanded = m_ExpandedEntities.count(entity.Index) != 0;
+		ImGui::SetNextItemOpen(expanded);
+		bool opened = ImGui::TreeNodeEx((void*)(intptr_t)entity.Index, flags, "%s", name->Name.c_str());
+		if (opened != expanded)
+		{
+			if (opened)
+				m_ExpandedEntities.insert(entity.Index);
+			else
+				m_ExpandedEntities.erase(entity.Index);
+		}
+
+		if (indent > 0.0f)
+			ImGui::Unindent(indent);
 
 		if (ImGui::IsItemClicked())
 		{
-			ClearSelection();
-			entity->IsSelected = true;
 			m_SelectedEntity = entity;
 		}
 
@@ -488,13 +621,21 @@ namespace HazelEditor {
 			FocusOnEntity(entity);
 		}
 
-		if (opened)
+		// Drag onto another entity to parent to it
+		if (ImGui::BeginDragDropSource())
+		{
+			ImGui::SetDragDropPayload("HIERARCHY_ENTITY", &entity, sizeof(Hazel::Entity));
+			ImGui::Text("%s", name->Name.c_str());
+			ImGui::EndDragDropSource();
+		}
+		if (ImGui::BeginDragDropTarget())
 		{
-			for (auto* child : entity->Children)
+			if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("HIERARCHY_ENTITY"))
 			{
-				DrawEntityNode(child);
+				ReparentEntity(*static_cast<const Hazel::Entity*>(payload->Data), entity);
+				m_ExpandedEntities.insert(entity.Index);
 			}
-			ImGui::TreePop();
+			ImGui::EndDragDropTarget();
 		}
 	}
 
@@ -502,32 +643,41 @@ namespace HazelEditor {
 	{
 		ImGui::Begin("Inspector");
 		
-		if (m_SelectedEntity)
+		if (m_Scene.IsValid(m_SelectedEntity))
 		{
-			ImGui::Text("GameObject: %s", m_SelectedEntity->Name.c_str());
+			const Hazel::NameComponent* name = m_Scene.GetComponent<Hazel::NameComponent>(m_SelectedEntity);
+			ImGui::Text("GameObject: %s", name ? name->Name.c_str() : "(unnamed)");
 			ImGui::Separator();
 			
 			// Transform component
-			if (ImGui::CollapsingHeader("Transform", ImGuiTreeNodeFlags_DefaultOpen))
+			Hazel::TransformComponent* transform = m_Scene.GetComponent<Hazel::TransformComponent>(m_SelectedEntity);
+			if (transform && ImGui::CollapsingHeader("Transform", ImGuiTreeNodeFlags_DefaultOpen))
 			{
-				ImGui::DragFloat3("Position", glm::value_ptr(m_SelectedEntity->EntityTransform.Position), 0.1f);
-				ImGui::DragFloat3("Rotation", glm::value_ptr(m_SelectedEntity->EntityTransform.Rotation), 1.0f);
-				ImGui::DragFloat3("Scale", glm::value_ptr(m_SelectedEntity->EntityTransform.Scale), 0.1f);
+				bool changed = ImGui::DragFloat3("Position", glm::value_ptr(transform->Position), 0.1f);
+				changed |= ImGui::DragFloat3("Rotation", glm::value_ptr(transform->Rotation), 1.0f);
+				changed |= ImGui::DragFloat3("Scale", glm::value_ptr(transform->Scale), 0.1f);
+				if (changed)
+					m_TransformSystem.MarkDirty(m_SelectedEntity);
 			}
 			
 			// Mesh Renderer component (if entity has a mesh)
-			if (m_SelectedEntity->Mesh != MeshType::None)
+			MeshRendererComponent* meshRenderer = m_Scene.GetComponent<MeshRendererComponent>(m_SelectedEntity);
+			if (meshRenderer)
 			{
 				if (ImGui::CollapsingHeader("Mesh Renderer", ImGuiTreeNodeFlags_DefaultOpen))
 				{
 					const char* meshNames[] = { "None", "Cube", "Sphere", "Capsule" };
-					int meshType = (int)m_SelectedEntity->Mesh;
+					int meshType = (int)meshRenderer->Mesh;
+					ImGui::ColorEdit4("Color", glm::value_ptr(meshRenderer->Color));
+					
+					// Last, as choosing None removes the component
 					if (ImGui::Combo("Mesh", &meshType, meshNames, 4))
 					{
-						m_SelectedEntity->Mesh = (MeshType)meshType;
+						if ((MeshType)meshType == MeshType::None)
+							m_Scene.RemoveComponent<MeshRendererComponent>(m_SelectedEntity);
+						else
+							meshRenderer->Mesh = (MeshType)meshType;
 					}
-					
-					ImGui::ColorEdit4("Color", glm::value_ptr(m_SelectedEntity->Color));
 				}
 			}
 			
@@ -548,41 +698,154 @@ namespace HazelEditor {
 	void EditorLayer::DrawConsole()
 	{
 		ImGui::Begin("Console");
-		
-		// Filter buttons
-		ImGui::Checkbox("Trace", &m_ShowTrace); ImGui::SameLine();
-		ImGui::Checkbox("Info", &m_ShowInfo); ImGui::SameLine();
-		ImGui::Checkbox("Warn", &m_ShowWarn); ImGui::SameLine();
-		ImGui::Checkbox("Error", &m_ShowError); ImGui::SameLine();
-		ImGui::Checkbox("Fatal", &m_ShowFatal); ImGui::SameLine();
-		
-		if (ImGui::Button("Clear"))
+
+		const Hazel::LogHistory& history = Hazel::Log::GetHistory();
+		bool filterChanged = false;
+
+		// Level filters, with the number of retained lines of each level
+		static const char* const s_LevelNames[Hazel::LogLevelCount] = { "Trace", "Info", "Warn", "Error", "Fatal" };
+		for (uint32_t level = 0; level < Hazel::LogLevelCount; level++)
 		{
-			// Clear console
+			char label[48];
+			std::snprintf(label, sizeof(label), "%s (%llu)###%s", s_LevelNames[level],
+			              static_cast<unsigned long long>(history.GetLevelCount(static_cast<Hazel::LogLevel>(level))), s_LevelNames[level]);
+			filterChanged |= ImGui::CheckboxFlags(label, &m_ConsoleLevelMask, 1u << level);
+			ImGui::SameLine();
 		}
-		
+
+		if (ImGui::Button("Clear"))
+			Hazel::Log::ClearMessages();
+
 		ImGui::SameLine();
 		ImGui::Checkbox("Auto-scroll", &m_AutoScroll);
-		
+
+		ImGui::SameLine();
+		filterChanged |= m_ConsoleFilter.Draw("Search", 240.0f);
+
 		ImGui::Separator();
-		
-		// Console output area
-		ImGui::BeginChild("ConsoleOutput");
-		ImGui::TextWrapped("Console output will appear here...");
-		ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "[TRACE] Detailed debug information");
-		ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "[INFO] General informational messages");
-		ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "[WARN] Warning messages");
-		ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "[ERROR] Error messages");
-		ImGui::TextColored(ImVec4(0.8f, 0.0f, 0.0f, 1.0f), "[FATAL] Critical errors");
-		
+
+		UpdateConsoleIndex(filterChanged);
+
+		// Only the visible rows are fetched and drawn
+		ImGui::BeginChild("ConsoleOutput", ImVec2(0.0f, 0.0f), ImGuiChildFlags_None, ImGuiWindowFlags_HorizontalScrollbar);
+		ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(4.0f, 1.0f));
+
+		static const ImVec4 s_LevelColors[Hazel::LogLevelCount] = {
+			ImVec4(0.5f, 0.5f, 0.5f, 1.0f),
+			ImVec4(1.0f, 1.0f, 1.0f, 1.0f),
+			ImVec4(1.0f, 1.0f, 0.0f, 1.0f),
+			ImVec4(1.0f, 0.0f, 0.0f, 1.0f),
+			ImVec4(0.8f, 0.0f, 0.0f, 1.0f)
+		};
+
+		const uint64_t* lines = m_ConsoleIndex.data() + m_ConsoleIndexStart;
+		ImGuiListClipper clipper;
+		clipper.Begin(static_cast<int>(m_ConsoleIndex.size() - m_ConsoleIndexStart));
+		while (clipper.Step())
+		{
+			history.ForEachOf(lines + clipper.DisplayStart, static_cast<size_t>(clipper.DisplayEnd - clipper.DisplayStart),
+				[](const Hazel::LogEntry& entry)
+				{
+					char timestamp[16];
+					Hazel::Log::FormatTimestamp(entry.Time, timestamp);
+					uint32_t level = static_cast<uint32_t>(entry.Level);
+
+					ImGui::TextColored(s_LevelColors[level], "[%s] [%s]", timestamp, s_LevelNames[level]);
+					ImGui::SameLine();
+					ImGui::TextUnformatted(entry.Text, entry.Text + entry.Length);
+				});
+		}
+		clipper.End();
+
+		ImGui::PopStyleVar();
+
 		if (m_AutoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
 			ImGui::SetScrollHereY(1.0f);
-			
+
 		ImGui::EndChild();
-		
+
 		ImGui::End();
 	}
 
+	void EditorLayer::UpdateConsoleIndex(bool filterChanged)
+	{
+		const Hazel::LogHistory& history = Hazel::Log::GetHistory();
+		uint64_t begin = history.GetBegin();
+		uint64_t end = history.GetEnd();
+
+		// Forget lines the history has dropped; compacted once the dead prefix dominates
+		auto trim = [begin](std::vector<uint64_t>& lines, size_t& start)
+		{
+			start = static_cast<size_t>(std::lower_bound(lines.begin() + start, lines.end(), begin) - lines.begin());
+			if (start > 4096 && start > lines.size() / 2)
+			{
+				lines.erase(lines.begin(), lines.begin() + start);
+				start = 0;
+			}
+		};
+		for (uint32_t level = 0; level < Hazel::LogLevelCount; level++)
+			trim(m_ConsoleLevelLines[level], m_ConsoleLevelStart[level]);
+		trim(m_ConsoleIndex, m_ConsoleIndexStart);
+
+		// Lines added since the last frame go to their level's list and, while
+		// the filter stays the same, straight to the shown lines
+		uint32_t mask = m_ConsoleLevelMask;
+		const ImGuiTextFilter& filter = m_ConsoleFilter;
+		bool search = filter.IsActive();
+		bool append = !filterChanged;
+		std::vector<uint64_t>* levelLines = m_ConsoleLevelLines;
+		std::vector<uint64_t>& index = m_ConsoleIndex;
+		history.ForEach(m_ConsoleScanned, end, [&](const Hazel::LogEntry& entry)
+		{
+			levelLines[static_cast<uint32_t>(entry.Level)].push_back(entry.Sequence);
+			if (append && (entry.LevelBit & mask) && (!search || filter.PassFilter(entry.Text, entry.Text + entry.Length)))
+				index.push_back(entry.Sequence);
+		});
+		m_ConsoleScanned = end;
+
+		if (!filterChanged)
+			return;
+
+		// A new filter merges the enabled levels' lists; only a search reads
+		// the text, and only of those lines
+		const uint64_t* heads[Hazel::LogLevelCount] = {};
+		const uint64_t* ends[Hazel::LogLevelCount] = {};
+		for (uint32_t level = 0; level < Hazel::LogLevelCount; level++)
+		{
+			if (mask & (1u << level))
+			{
+				heads[level] = m_ConsoleLevelLines[level].data() + m_ConsoleLevelStart[level];
+				ends[level] = m_ConsoleLevelLines[level].data() + m_ConsoleLevelLines[level].size();
+			}
+		}
+
+		m_ConsoleIndex.clear();
+		m_ConsoleIndexStart = 0;
+		for (;;)
+		{
+			int next = -1;
+			for (uint32_t level = 0; level < Hazel::LogLevelCount; level++)
+			{
+				if (heads[level] != ends[level] && (next < 0 || *heads[level] < *heads[next]))
+					next = static_cast<int>(level);
+			}
+			if (next < 0)
+				break;
+			m_ConsoleIndex.push_back(*heads[next]++);
+		}
+
+		if (search)
+		{
+			size_t kept = 0;
+			history.ForEachOf(index.data(), index.size(), [&](const Hazel::LogEntry& entry)
+			{
+				if (filter.PassFilter(entry.Text, entry.Text + entry.Length))
+					index[kept++] = entry.Sequence;
+			});
+			index.resize(kept);
+		}
+	}
+
 	void EditorLayer::DrawGameView()
 	{
 		ImGui::Begin("Game");
@@ -642,7 +905,9 @@ namespace HazelEditor {
 		}
 		
 		// Draw gizmo for selected entity
-		if (m_SelectedEntity && m_GizmoEnabled && m_SelectedEntity->Mesh != MeshType::None)
+		Hazel::TransformComponent* selectedTransform = m_Scene.GetComponent<Hazel::TransformComponent>(m_SelectedEntity);
+		const glm::mat4* selectedWorld = m_TransformSystem.GetWorldMatrix(m_SelectedEntity);
+		if (selectedTransform && selectedWorld && m_GizmoEnabled && m_Scene.HasComponent<MeshRendererComponent>(m_SelectedEntity))
 		{
 			ImGuizmo::SetOrthographic(false);
 			ImGuizmo::SetDrawlist();
@@ -654,8 +919,8 @@ namespace HazelEditor {
 			glm::mat4 cameraView = m_EditorCamera->GetViewMatrix();
 			glm::mat4 cameraProjection = m_EditorCamera->GetProjectionMatrix();
 			
-			// Get entity transform matrix
-			glm::mat4 transform = m_SelectedEntity->EntityTransform.GetTransformMatrix();
+			// The gizmo works in world space
+			glm::mat4 transform = *selectedWorld;
 			
 			// Determine ImGuizmo operation
 			ImGuizmo::OPERATION operation = ImGuizmo::TRANSLATE;
@@ -679,22 +944,29 @@ namespace HazelEditor {
 			// If the gizmo was used, update the entity transform
 			if (ImGuizmo::IsUsing())
 			{
-				// Decompose the transform matrix back to position, rotation, scale
+				// Back to the parent's space, then to position, rotation, scale
+				if (const glm::mat4* parentWorld = m_TransformSystem.GetWorldMatrix(m_TransformSystem.GetParent(m_SelectedEntity)))
+					transform = glm::inverse(*parentWorld) * transform;
+
 				glm::vec3 position, rotation, scale;
 				ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(transform),
 				                                       glm::value_ptr(position),
 				                                       glm::value_ptr(rotation),
 				                                       glm::value_ptr(scale));
 				
-				m_SelectedEntity->EntityTransform.Position = position;
-				m_SelectedEntity->EntityTransform.Rotation = rotation;
-				m_SelectedEntity->EntityTransform.Scale = scale;
+				selectedTransform->Position = position;
+				selectedTransform->Rotation = rotation;
+				selectedTransform->Scale = scale;
+				m_TransformSystem.MarkDirty(m_SelectedEntity);
 			}
 		}
 		
-		// Handle mouse input for camera rotation
-		// Don't allow camera rotation when gizmo is being manipulated
-		if (m_ViewportHovered && ImGui::IsMouseDown(ImGuiMouseButton_Right) && !ImGuizmo::IsUsing())
+		// Right mouse button held over the viewport flies the camera. The
+		// rotation and movement themselves are applied by LatchCameraInput()
+		// from the raw cursor and keys, right before the next scene draw.
+		// Don't allow camera control when gizmo is being manipulated
+		bool flying = m_ViewportHovered && ImGui::IsMouseDown(ImGuiMouseButton_Right) && !ImGuizmo::IsUsing();
+		if (flying)
 		{
 			ImGui::SetMouseCursor(ImGuiMouseCursor_None);
 			
@@ -703,28 +975,11 @@ namespace HazelEditor {
 			{
 				Hazel::Application::Get().SetCursorMode(Hazel::CursorMode::Disabled);
 				m_CameraRotating = true;
+				m_LatchedCursorValid = false;
 			}
 			
 			ImVec2 mousePos = ImGui::GetMousePos();
 			
-			// Initialize last mouse position on first frame
-			if (m_LastMousePos.x == 0.0f && m_LastMousePos.y == 0.0f)
-			{
-				m_LastMousePos = glm::vec2(mousePos.x, mousePos.y);
-			}
-			
-			// Calculate delta from current position
-			glm::vec2 currentPos(mousePos.x, mousePos.y);
-			glm::vec2 delta = currentPos - m_LastMousePos;
-			
-			// Clamp delta to prevent extreme jumps when cursor repositions
-			const float maxDelta = 100.0f;
-			delta.x = glm::clamp(delta.x, -maxDelta, maxDelta);
-			delta.y = glm::clamp(delta.y, -maxDelta, maxDelta);
-			
-			// Apply camera rotation
-			m_EditorCamera->ProcessMouseMovement(delta.x, -delta.y);
-			
 			// Use a buffer zone to start repositioning before cursor reaches actual edge
 			// This makes it much harder for fast mouse movement to escape
 			const float edgeBuffer = 50.0f; // Start repositioning 50px from edge
@@ -742,13 +997,10 @@ namespace HazelEditor {
 				// Reset cursor to center of viewport to keep it contained
 				glm::vec2 viewportCenter = (m_ViewportBounds[0] + m_ViewportBounds[1]) * 0.5f;
 				
-				// Reposition cursor without changing mode (stays in Disabled mode)
+				// Reposition cursor without changing mode (stays in Disabled mode);
+				// the jump must not turn into a rotation at the next latch
 				Hazel::Application::Get().SetCursorPosition(viewportCenter.x, viewportCenter.y);
-				m_LastMousePos = viewportCenter;
-			}
-			else
-			{
-				m_LastMousePos = currentPos;
+				m_LatchedCursorValid = false;
 			}
 		}
 		else
@@ -758,32 +1010,7 @@ namespace HazelEditor {
 			{
 				Hazel::Application::Get().SetCursorMode(Hazel::CursorMode::Normal);
 				m_CameraRotating = false;
-				m_LastMousePos = glm::vec2(0.0f, 0.0f); // Reset for next time
 			}
-		}
-		
-		// Handle keyboard input for camera movement (WASD + QE)
-		// Only allow movement when right mouse button is held down (flying camera mode)
-		// Don't allow camera movement when gizmo is being manipulated
-		if (m_ViewportHovered && ImGui::IsMouseDown(ImGuiMouseButton_Right) && !ImGuizmo::IsUsing())
-		{
-			// When right-click is held, WASD always moves the camera (FPS fly mode)
-			m_EditorCamera->SetMoveForward(ImGui::IsKeyDown(ImGuiKey_W));
-			m_EditorCamera->SetMoveBackward(ImGui::IsKeyDown(ImGuiKey_S));
-			m_EditorCamera->SetMoveLeft(ImGui::IsKeyDown(ImGuiKey_A));
-			m_EditorCamera->SetMoveRight(ImGui::IsKeyDown(ImGuiKey_D));
-			m_EditorCamera->SetMoveUp(ImGui::IsKeyDown(ImGuiKey_E));
-			m_EditorCamera->SetMoveDown(ImGui::IsKeyDown(ImGuiKey_Q));
-		}
-		else
-		{
-			// Stop all movement when right mouse button is not held
-			m_EditorCamera->SetMoveForward(false);
-			m_EditorCamera->SetMoveBackward(false);
-			m_EditorCamera->SetMoveLeft(false);
-			m_EditorCamera->SetMoveRight(false);
-			m_EditorCamera->SetMoveUp(false);
-			m_EditorCamera->SetMoveDown(false);
 			
 			// Gizmo mode shortcuts (Q, W, E, R) - only active when NOT in camera fly mode
 			if (m_ViewportHovered)
@@ -833,31 +1060,183 @@ namespace HazelEditor {
 		ImGui::End();
 	}
 
-	void EditorLayer::ClearSelection()
+	static void FormatBytes(char* buffer, size_t size, int64_t bytes)
 	{
-		for (auto& entity : m_Entities)
+		double value = static_cast<double>(bytes);
+		if (value >= 1024.0 * 1024.0 || value <= -1024.0 * 1024.0)
+			std::snprintf(buffer, size, "%.1f MB", value / (1024.0 * 1024.0));
+		else if (value >= 1024.0 || value <= -1024.0)
+			std::snprintf(buffer, size, "%.1f KB", value / 1024.0);
+		else
+			std::snprintf(buffer, size, "%lld B", static_cast<long long>(bytes));
+	}
+
+	void EditorLayer::DrawMemoryPanel()
+	{
+		if (!m_ShowMemoryPanel)
+			return;
+
+		ImGui::Begin("Memory", &m_ShowMemoryPanel);
+
+		if (!Hazel::MemoryTracker::IsEnabled())
 		{
-			entity.IsSelected = false;
+			ImGui::TextWrapped("Allocation tracking is compiled out (HZ_DISABLE_MEMORY_TRACKING).");
 		}
-		m_SelectedEntity = nullptr;
+		else if (ImGui::BeginTable("MemoryTags", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp))
+		{
+			ImGui::TableSetupColumn("Tag");
+			ImGui::TableSetupColumn("Current");
+			ImGui::TableSetupColumn("Peak");
+			ImGui::TableSetupColumn("Live Allocs");
+			ImGui::TableSetupColumn("Frame Allocs");
+			ImGui::TableSetupColumn("Budget");
+			ImGui::TableHeadersRow();
+
+			Hazel::MemoryTagStats total;
+			char current[32], peak[32], frame[32], budget[32];
+			for (int i = 0; i < static_cast<int>(Hazel::MemoryTag::Count); i++)
+			{
+				Hazel::MemoryTag tag = static_cast<Hazel::MemoryTag>(i);
+				Hazel::MemoryTagStats stats = Hazel::MemoryTracker::GetStats(tag);
+				total.CurrentBytes += stats.CurrentBytes;
+				total.CurrentAllocations += stats.CurrentAllocations;
+				total.FrameAllocations += stats.FrameAllocations;
+				total.FrameBytes += stats.FrameBytes;
+
+				FormatBytes(current, sizeof(current), stats.CurrentBytes);
+				FormatBytes(peak, sizeof(peak), stats.PeakBytes);
+				FormatBytes(frame, sizeof(frame), static_cast<int64_t>(stats.FrameBytes));
+				if (stats.Budget > 0)
+					FormatBytes(budget, sizeof(budget), static_cast<int64_t>(stats.Budget));
+				else
+					std::snprintf(budget, sizeof(budget), "-");
+
+				// Over budget in red, allocation spikes in yellow
+				bool highlight = stats.OverBudget || stats.Spike;
+				if (highlight)
+					ImGui::PushStyleColor(ImGuiCol_Text, stats.OverBudget ? ImVec4(1.0f, 0.3f, 0.3f, 1.0f) : ImVec4(1.0f, 1.0f, 0.0f, 1.0f));
+
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn(); ImGui::TextUnformatted(Hazel::MemoryTracker::GetTagName(tag));
+				ImGui::TableNextColumn(); ImGui::TextUnformatted(current);
+				ImGui::TableNextColumn(); ImGui::TextUnformatted(peak);
+				ImGui::TableNextColumn(); ImGui::Text("%lld", static_cast<long long>(stats.CurrentAllocations));
+				ImGui::TableNextColumn(); ImGui::Text("%llu (%s)", static_cast<unsigned long long>(stats.FrameAllocations), frame);
+				ImGui::TableNextColumn(); ImGui::TextUnformatted(budget);
+
+				if (highlight)
+					ImGui::PopStyleColor();
+			}
+
+			FormatBytes(current, sizeof(current), total.CurrentBytes);
+			FormatBytes(frame, sizeof(frame), static_cast<int64_t>(total.FrameBytes));
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn(); ImGui::TextUnformatted("Total");
+			ImGui::TableNextColumn(); ImGui::TextUnformatted(current);
+			ImGui::TableNextColumn();
+			ImGui::TableNextColumn(); ImGui::Text("%lld", static_cast<long long>(total.CurrentAllocations));
+			ImGui::TableNextColumn(); ImGui::Text("%llu (%s)", static_cast<unsigned long long>(total.FrameAllocations), frame);
+			ImGui::TableNextColumn();
+
+			ImGui::EndTable();
+		}
+
+		// Transient memory that never reaches the heap
+		Hazel::FrameAllocatorStats arena = Hazel::FrameAllocator::GetStats();
+		char used[32], capacity[32];
+		FormatBytes(used, sizeof(used), static_cast<int64_t>(arena.BytesUsed));
+		FormatBytes(capacity, sizeof(capacity), static_cast<int64_t>(arena.Capacity));
+		ImGui::Separator();
+		ImGui::Text("Frame arena: %s of %s, %u heap fallbacks", used, capacity, arena.OverflowAllocations);
+
+		ImGui::End();
+	}
+
+	static void DrawTimingRow(const char* label, const Hazel::FrameTimeSummary& summary)
+	{
+		ImGui::Text("%-6s p50 %5.2f  p95 %5.2f  p99 %5.2f  max %6.2f ms", label,
+		            summary.P50, summary.P95, summary.P99, summary.Max);
+		if (summary.Hitches > 0)
+		{
+			ImGui::SameLine();
+			ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), " %u hitches", summary.Hitches);
+		}
+	}
+
+	void EditorLayer::DrawStatsOverlay()
+	{
+		if (!m_ShowStatsOverlay || m_ViewportSize.x <= 0.0f || m_ViewportSize.y <= 0.0f)
+			return;
+
+		// Pinned to the top-left corner of the scene view
+		ImGui::SetNextWindowPos(ImVec2(m_ViewportBounds[0].x + 10.0f, m_ViewportBounds[0].y + 10.0f));
+		ImGui::SetNextWindowBgAlpha(0.6f);
+		ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+		                         ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing |
+		                         ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoDocking;
+		if (!ImGui::Begin("##SceneStatistics", nullptr, flags))
+		{
+			ImGui::End();
+			return;
+		}
+
+		const Hazel::Application& app = Hazel::Application::Get();
+		Hazel::FrameTimeSummary frame = app.GetFrameTimes().GetSummary();
+		DrawTimingRow("Frame", frame);
+		DrawTimingRow("Update", app.GetUpdateTimes().GetSummary());
+		if (frame.Average > 0.0f)
+			ImGui::Text("%.0f FPS over %u frames", 1000.0f / frame.Average, frame.SampleCount);
+
+		if (Hazel::GpuProfiler::IsSupported())
+		{
+			Hazel::GpuFrameResult gpu = Hazel::GpuProfiler::GetLastFrame();
+			ImGui::Separator();
+			ImGui::Text("GPU    %.2f ms", gpu.FrameMilliseconds);
+			for (const Hazel::GpuZoneResult& zone : gpu.Zones)
+				ImGui::Text("%*s%-12s %.2f ms", 2 + 2 * static_cast<int>(zone.Depth), "", zone.Name, zone.Milliseconds);
+		}
+
+		Hazel::RendererStats stats = Hazel::Renderer::GetStats();
+		char uploaded[32];
+		FormatBytes(uploaded, sizeof(uploaded), static_cast<int64_t>(stats.BufferBytesUploaded));
+		ImGui::Separator();
+		ImGui::Text("Draws %u  Instances %u", stats.DrawCalls, stats.Instances);
+		ImGui::Text("Triangles %llu  Vertices %llu",
+		            static_cast<unsigned long long>(stats.Triangles), static_cast<unsigned long long>(stats.Vertices));
+		ImGui::Text("Binds: program %u  VAO %u  texture %u", stats.ProgramBinds, stats.VertexArrayBinds, stats.TextureBinds);
+		ImGui::Text("Uniforms %u  Uploaded %s", stats.UniformUploads, uploaded);
+
+		Hazel::InputLatencyStats latency = Hazel::Renderer::GetInputLatency();
+		if (latency.ToPresent.SampleCount > 0)
+		{
+			// From sampling the camera input to issuing the draws and to the swap
+			ImGui::Separator();
+			ImGui::Text("Camera input latency");
+			DrawTimingRow("Draw", latency.ToSubmit);
+			DrawTimingRow("Swap", latency.ToPresent);
+		}
+
+		ImGui::End();
 	}
 
-	void EditorLayer::FocusOnEntity(Entity* entity)
+	void EditorLayer::FocusOnEntity(Hazel::Entity entity)
 	{
-		if (!entity || !m_EditorCamera)
+		const Hazel::TransformComponent* transform = m_Scene.GetComponent<Hazel::TransformComponent>(entity);
+		if (!transform || !m_EditorCamera)
 		{
-			HZ_WARN("FocusOnEntity called with null entity or camera");
+			HZ_WARN("FocusOnEntity called with an invalid entity or no camera");
 			return;
 		}
 
-		// Get the entity's position from its transform
-		glm::vec3 entityPos = entity->EntityTransform.Position;
+		// Get the entity's world position, or its local one before its first update
+		const glm::mat4* world = m_TransformSystem.GetWorldMatrix(entity);
+		glm::vec3 entityPos = world ? glm::vec3((*world)[3]) : transform->Position;
 		
 		// Calculate the size of the object based on its scale
 		// Use the maximum scale component to determine distance
-		float maxScale = (std::max)(entity->EntityTransform.Scale.x, 
-		                            (std::max)(entity->EntityTransform.Scale.y, 
-		                                       entity->EntityTransform.Scale.z));
+		float maxScale = (std::max)(transform->Scale.x, 
+		                            (std::max)(transform->Scale.y, 
+		                                       transform->Scale.z));
 		
 		// Calculate camera distance based on object size
 		// Distance should be enough to frame the object nicely
@@ -884,39 +1263,223 @@ namespace HazelEditor {
 		m_EditorCamera->SetYaw(yaw);
 		m_EditorCamera->SetPitch(pitch);
 		
-		HZ_INFO("Camera focused on entity: " + entity->Name + 
-		        " at pos(" + std::to_string(entityPos.x) + "," + std::to_string(entityPos.y) + "," + std::to_string(entityPos.z) + ")" +
-		        " camera at(" + std::to_string(newCameraPos.x) + "," + std::to_string(newCameraPos.y) + "," + std::to_string(newCameraPos.z) + ")" +
-		        " yaw=" + std::to_string(yaw) + " pitch=" + std::to_string(pitch));
+		const Hazel::NameComponent* name = m_Scene.GetComponent<Hazel::NameComponent>(entity);
+		HZ_INFO("Camera focused on entity: {} at pos({:.2},{:.2},{:.2}) camera at({:.2},{:.2},{:.2}) yaw={:.1} pitch={:.1}",
+		        name ? name->Name.c_str() : "(unnamed)", entityPos.x, entityPos.y, entityPos.z,
+		        newCameraPos.x, newCameraPos.y, newCameraPos.z, yaw, pitch);
 	}
 
-	void EditorLayer::CreateEntity(const std::string& name, MeshType meshType)
+	Hazel::Entity EditorLayer::CreateEntity(const std::string& name, MeshType meshType)
 	{
-		Entity newEntity(name, m_NextEntityID++);
-		newEntity.Mesh = meshType;
+		HZ_MEMORY_TAG(Scene);
+
+		Hazel::Entity entity = m_Scene.CreateEntity(Hazel::NameComponent{ name }, Hazel::TransformComponent{});
+		m_HierarchyEntities.push_back(entity);
+		if (meshType == MeshType::None)
+			return entity;
+
+		MeshRendererComponent meshRenderer;
+		meshRenderer.Mesh = meshType;
 		
 		// Set default colors based on mesh type
 		switch (meshType)
 		{
 		case MeshType::Cube:
-			newEntity.Color = glm::vec4(0.8f, 0.3f, 0.3f, 1.0f); // Red
+			meshRenderer.Color = glm::vec4(0.8f, 0.3f, 0.3f, 1.0f); // Red
 			break;
 		case MeshType::Sphere:
-			newEntity.Color = glm::vec4(0.3f, 0.8f, 0.3f, 1.0f); // Green
+			meshRenderer.Color = glm::vec4(0.3f, 0.8f, 0.3f, 1.0f); // Green
 			break;
 		case MeshType::Capsule:
-			newEntity.Color = glm::vec4(0.3f, 0.3f, 0.8f, 1.0f); // Blue
+			meshRenderer.Color = glm::vec4(0.3f, 0.3f, 0.8f, 1.0f); // Blue
 			break;
 		default:
-			newEntity.Color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f); // White
+			meshRenderer.Color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f); // White
 			break;
 		}
 		
-		m_Entities.push_back(newEntity);
+		m_Scene.AddComponent<MeshRendererComponent>(entity, meshRenderer);
+		return entity;
+	}
+
+	void EditorLayer::ReparentEntity(Hazel::Entity child, Hazel::Entity parent)
+	{
+		Hazel::TransformComponent* transform = m_Scene.GetComponent<Hazel::TransformComponent>(child);
+		const glm::mat4* childWorld = m_TransformSystem.GetWorldMatrix(child);
+		if (!transform || !childWorld || child == parent || m_TransformSystem.GetParent(child) == parent)
+			return;
+
+		// The local transform that keeps the child where it is under the new parent
+		glm::mat4 local = *childWorld;
+		if (const glm::mat4* parentWorld = m_TransformSystem.GetWorldMatrix(parent))
+			local = glm::inverse(*parentWorld) * local;
+
+		if (!m_TransformSystem.SetParent(child, parent))
+			return;
+
+		// SetParent may have moved the component
+		transform = m_Scene.GetComponent<Hazel::TransformComponent>(child);
+		ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(local),
+		                                       glm::value_ptr(transform->Position),
+		                                       glm::value_ptr(transform->Rotation),
+		                                       glm::value_ptr(transform->Scale));
+	}
+
+	void EditorLayer::SpawnStressTest(size_t count)
+	{
+		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_TAG(Scene);
+
+		// Unnamed, so they stay out of the hierarchy
+		std::vector<Hazel::Entity> entities(count);
+		m_Scene.CreateEntities<Hazel::TransformComponent, MeshRendererComponent>(count, entities.data());
+
+		// A cube of cubes beside the sample scene
+		size_t side = static_cast<size_t>(std::ceil(std::cbrt(static_cast<double>(count))));
+		Hazel::JobSystem::ParallelFor(count, 4096, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				size_t x = i % side;
+				size_t y = (i / side) % side;
+				size_t z = i / (side * side);
+
+				Hazel::TransformComponent* transform = m_Scene.GetComponent<Hazel::TransformComponent>(entities[i]);
+				transform->Position = glm::vec3(5.0f + 1.5f * x, 1.5f * y, -1.5f * z);
+				transform->Scale = glm::vec3(0.5f);
+
+				MeshRendererComponent* meshRenderer = m_Scene.GetComponent<MeshRendererComponent>(entities[i]);
+				meshRenderer->Color = glm::vec4(static_cast<float>(x) / side, static_cast<float>(y) / side, static_cast<float>(z) / side, 1.0f);
+			}
+		});
+
+		HZ_INFO("Spawned {} cubes; the scene has {} entities", count, m_Scene.GetEntityCount());
+	}
+
+	void EditorLayer::NewScene()
+	{
+		m_Scene.Clear();
+		ResetSceneState();
+		m_ScenePath.clear();
+
+		CreateEntity("Main Camera", MeshType::None);
+		CreateEntity("Directional Light", MeshType::None);
+	}
+
+	bool EditorLayer::OpenScene(const std::string& path)
+	{
+		// A file that fails to open leaves the current scene alone
+		if (!Hazel::SceneFile::Load(path, m_Scene))
+			return false;
+
+		ResetSceneState();
+		m_ScenePath = path;
+		return true;
+	}
+
+	bool EditorLayer::SaveScene(const std::string& path)
+	{
+		if (!Hazel::SceneFile::Write(path, m_Scene))
+			return false;
+
+		m_ScenePath = path;
+		return true;
+	}
+
+	void EditorLayer::RequestScenePath(ScenePathAction action)
+	{
+		std::string path = m_ScenePath.empty() ? "Untitled.hscene" : m_ScenePath;
+		if (action == ScenePathAction::ExportText)
+			path += ".txt";
+
+		std::snprintf(m_ScenePathBuffer, sizeof(m_ScenePathBuffer), "%s", path.c_str());
+		m_ScenePathAction = action;
+	}
+
+	void EditorLayer::ResetSceneState()
+	{
+		m_SelectedEntity = Hazel::Entity();
+		m_ExpandedEntities.clear();
+
+		// Named entities make up the hierarchy, as in CreateEntity()
+		m_HierarchyEntities.clear();
+		m_Scene.Each<Hazel::NameComponent>([this](Hazel::Entity entity, const Hazel::NameComponent&)
+		{
+			m_HierarchyEntities.push_back(entity);
+		});
+	}
+
+	void EditorLayer::DrawScenePathPopup()
+	{
+		if (m_ScenePathAction == ScenePathAction::None)
+			return;
+
+		// Opened here rather than from the menu, whose ID stack the popup would not share
+		const char* title = "Scene File";
+		if (!ImGui::IsPopupOpen(title))
+			ImGui::OpenPopup(title);
+
+		if (ImGui::BeginPopupModal(title, nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+		{
+			const char* prompt = "Save scene as:";
+			const char* button = "Save";
+			if (m_ScenePathAction == ScenePathAction::Open)
+			{
+				prompt = "Open scene:";
+				button = "Open";
+			}
+			else if (m_ScenePathAction == ScenePathAction::ExportText)
+			{
+				prompt = "Export scene as text to:";
+				button = "Export";
+			}
+
+			ImGui::TextUnformatted(prompt);
+			if (ImGui::IsWindowAppearing())
+				ImGui::SetKeyboardFocusHere();
+			ImGui::SetNextItemWidth(400.0f);
+			bool confirmed = ImGui::InputText("##ScenePath", m_ScenePathBuffer, sizeof(m_ScenePathBuffer), ImGuiInputTextFlags_EnterReturnsTrue);
+			confirmed |= ImGui::Button(button, ImVec2(120.0f, 0.0f));
+			ImGui::SameLine();
+			bool cancelled = ImGui::Button("Cancel", ImVec2(120.0f, 0.0f)) || ImGui::IsKeyPressed(ImGuiKey_Escape);
+
+			// Failures are logged to the console and keep the popup open
+			bool done = false;
+			if (confirmed && m_ScenePathBuffer[0] != '\0')
+			{
+				std::string path = m_ScenePathBuffer;
+				switch (m_ScenePathAction)
+				{
+				case ScenePathAction::Open:
+					done = OpenScene(path);
+					break;
+				case ScenePathAction::SaveAs:
+					done = SaveScene(path);
+					break;
+				case ScenePathAction::ExportText:
+					done = Hazel::SceneFile::ExportText(path, m_Scene);
+					if (done)
+						HZ_INFO("Exported the scene to {}", path);
+					break;
+				default:
+					break;
+				}
+			}
+
+			if (done || cancelled)
+			{
+				m_ScenePathAction = ScenePathAction::None;
+				ImGui::CloseCurrentPopup();
+			}
+			ImGui::EndPopup();
+		}
 	}
 
 	void EditorLayer::RenderScene()
 	{
+		HZ_PROFILE_FUNCTION();
+		HZ_PROFILE_GPU("Scene");
+
 		static bool logOnce = true;
 		if (logOnce)
 		{
@@ -930,7 +1493,7 @@ namespace HazelEditor {
 		GLenum err = glGetError();
 		if (err != GL_NO_ERROR && logOnce)
 		{
-			HZ_ERROR("OpenGL error after framebuffer bind: " + std::to_string(err));
+			HZ_ERROR("OpenGL error after framebuffer bind: {}", err);
 		}
 		
 		Hazel::Renderer::SetClearColor(glm::vec4(0.2f, 0.2f, 0.2f, 1.0f));
@@ -940,45 +1503,58 @@ namespace HazelEditor {
 		Hazel::Renderer::ClearLights();
 		Hazel::Renderer::AddLight(m_SceneLight);
 		
-		// Begin scene with editor camera
-		Hazel::Renderer::BeginScene(*m_EditorCamera);
+		// Begin scene with editor camera, moved by the freshest input there is
+		LatchCameraInput();
+		Hazel::Renderer::BeginScene(*m_EditorCamera, m_CameraLatch);
 		
-		// Render all entities with meshes
-		int entitiesRendered = 0;
-		int totalEntities = static_cast<int>(m_Entities.size());
-		for (auto& entity : m_Entities)
+		// World matrices of what moved since the last frame
+		m_TransformSystem.Update();
+
+		// Record entity draws on the job system, a scene chunk per job, then
+		// submit them sorted by material, mesh and depth
+		std::shared_ptr<Hazel::VertexArray> meshVertexArrays[] = {
+			nullptr,
+			GetMeshVertexArray(MeshType::Cube),
+			GetMeshVertexArray(MeshType::Sphere),
+			GetMeshVertexArray(MeshType::Capsule)
+		};
+		Hazel::MaterialProperties defaultProperties = m_DefaultMaterial->GetProperties();
+		glm::vec3 cameraPosition = m_EditorCamera->GetPosition();
+
+		m_SceneDrawList.Reset();
+		m_Scene.ParallelEach<MeshRendererComponent>([&](Hazel::Entity entity, const MeshRendererComponent& meshRenderer)
 		{
-			if (entity.Mesh != MeshType::None)
-			{
-				auto meshVA = GetMeshVertexArray(entity.Mesh);
-				if (meshVA)
-				{
-					// Update material color
-					m_DefaultMaterial->SetColor(entity.Color);
-					
-					// Get transform matrix
-					glm::mat4 transform = entity.EntityTransform.GetTransformMatrix();
-					
-					// Submit for rendering
-					Hazel::Renderer::Submit(meshVA, m_DefaultMaterial, transform);
-					entitiesRendered++;
-				}
-				else
-				{
-					HZ_WARN("Mesh vertex array is null for entity: " + entity.Name);
-				}
-			}
-		}
+			// Mesh comes straight from scene files; unknown types are not drawn
+			int mesh = static_cast<int>(meshRenderer.Mesh);
+			if (mesh < 0 || mesh > static_cast<int>(MeshType::Capsule))
+				return;
+
+			const std::shared_ptr<Hazel::VertexArray>& vertexArray = meshVertexArrays[mesh];
+			const glm::mat4* transform = m_TransformSystem.GetWorldMatrix(entity);
+			const glm::mat3* normalMatrix = m_TransformSystem.GetNormalMatrix(entity);
+			if (!vertexArray || !transform)
+				return;
+
+			Hazel::MaterialProperties properties = defaultProperties;
+			properties.Color = meshRenderer.Color;
+
+			float depth = glm::length(glm::vec3((*transform)[3]) - cameraPosition);
+			m_SceneDrawList.Submit(vertexArray, m_DefaultMaterial, properties, *transform, *normalMatrix, depth);
+		});
+		m_SceneDrawList.Flush();
+
+		int entitiesRendered = static_cast<int>(m_SceneDrawList.GetDrawCount());
+		int totalEntities = static_cast<int>(m_Scene.GetEntityCount());
 		
 		if (logOnce)
 		{
-			HZ_INFO("First render pass: " + std::to_string(entitiesRendered) + " entities rendered out of " + std::to_string(totalEntities) + " total");
+			HZ_INFO("First render pass: {} entities rendered out of {} total", entitiesRendered, totalEntities);
 			
 			// Check framebuffer status
 			GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
 			if (status != GL_FRAMEBUFFER_COMPLETE)
 			{
-				HZ_ERROR("Framebuffer is not complete! Status: " + std::to_string(status));
+				HZ_ERROR("Framebuffer is not complete! Status: {}", status);
 			}
 			else
 			{
@@ -986,14 +1562,17 @@ namespace HazelEditor {
 			}
 			
 			// Log framebuffer texture ID
-			HZ_INFO("Framebuffer color attachment ID: " + std::to_string(m_SceneFramebuffer->GetColorAttachment()));
+			HZ_INFO("Framebuffer color attachment ID: {}", m_SceneFramebuffer->GetColorAttachment());
 			
 			logOnce = false;
 		}
 		
-		if (entitiesRendered == 0 && totalEntities > 0)
+		// Reported once per entity count rather than every frame
+		static int warnedTotalEntities = 0;
+		if (entitiesRendered == 0 && totalEntities > 0 && totalEntities != warnedTotalEntities)
 		{
-			HZ_WARN("No entities were rendered in scene (0/" + std::to_string(totalEntities) + ")");
+			HZ_WARN("No entities were rendered in scene (0/{})", totalEntities);
+			warnedTotalEntities = totalEntities;
 		}
 		
 		Hazel::Renderer::EndScene();
@@ -1005,7 +1584,7 @@ namespace HazelEditor {
 			static bool errorLogged = false;
 			if (!errorLogged)
 			{
-				HZ_ERROR("OpenGL error after rendering: " + std::to_string(err));
+				HZ_ERROR("OpenGL error after rendering: {}", err);
 				errorLogged = true;
 			}
 		}
@@ -1014,72 +1593,61 @@ namespace HazelEditor {
 		m_SceneFramebuffer->Unbind();
 	}
 
+	void EditorLayer::LatchCameraInput()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		GLFWwindow* window = Hazel::Application::Get().GetWindow();
+		int64_t now = Hazel::FrameClock::Now();
+
+		// Movement is integrated over the time between latches, not the frame step
+		float deltaTime = m_LastLatchTime > 0 ? static_cast<float>((now - m_LastLatchTime) / 1.0e9) : 0.0f;
+		deltaTime = glm::clamp(deltaTime, 0.0f, 0.1f);
+		m_LastLatchTime = now;
+
+		bool flying = m_CameraRotating && !ImGuizmo::IsUsing() &&
+		              glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS;
+		if (flying)
+		{
+			// Queried from the OS now instead of the position ImGui saw when the frame started
+			double x = 0.0, y = 0.0;
+			glfwGetCursorPos(window, &x, &y);
+			if (m_LatchedCursorValid)
+			{
+				// Clamp delta to prevent extreme jumps when cursor repositions
+				const float maxDelta = 100.0f;
+				float deltaX = glm::clamp(static_cast<float>(x - m_LatchedCursor.x), -maxDelta, maxDelta);
+				float deltaY = glm::clamp(static_cast<float>(y - m_LatchedCursor.y), -maxDelta, maxDelta);
+				m_EditorCamera->ProcessMouseMovement(deltaX, -deltaY);
+			}
+			m_LatchedCursor = { x, y };
+			m_LatchedCursorValid = true;
+		}
+
+		// While flying, WASD + QE always move the camera (FPS fly mode)
+		m_EditorCamera->SetMoveForward(flying && glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS);
+		m_EditorCamera->SetMoveBackward(flying && glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS);
+		m_EditorCamera->SetMoveLeft(flying && glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS);
+		m_EditorCamera->SetMoveRight(flying && glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS);
+		m_EditorCamera->SetMoveUp(flying && glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS);
+		m_EditorCamera->SetMoveDown(flying && glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS);
+		m_EditorCamera->OnUpdate(deltaTime);
+
+		m_CameraLatch.Publish(m_EditorCamera->GetViewMatrix(), now);
+	}
+
 	void EditorLayer::InitializeMeshBuffers()
 	{
 		using namespace Hazel;
 		
 		HZ_INFO("Initializing mesh buffers...");
 		
-		// Create cube mesh
-		{
-			MeshData cubeData = MeshGenerator::CreateCube(1.0f);
-			HZ_INFO("Cube mesh data: " + std::to_string(cubeData.Vertices.size()) + " vertices, " + std::to_string(cubeData.Indices.size()) + " indices");
-			
-			m_CubeMesh = std::make_shared<VertexArray>();
-			m_CubeVertexBuffer = std::make_shared<VertexBuffer>(
-				cubeData.Vertices.data(), 
-				static_cast<unsigned int>(cubeData.Vertices.size() * sizeof(float)));
-			m_CubeVertexBuffer->SetLayout({
-				{ ShaderDataType::Float3, "a_Position" },
-				{ ShaderDataType::Float3, "a_Normal" }
-			});
-			m_CubeMesh->AddVertexBuffer(m_CubeVertexBuffer.get());
-			
-			m_CubeIndexBuffer = std::make_shared<IndexBuffer>(
-				cubeData.Indices.data(), 
-				static_cast<unsigned int>(cubeData.Indices.size()));
-			m_CubeMesh->SetIndexBuffer(m_CubeIndexBuffer.get());
-		}
+		// Meshes are shared with any other layer requesting the same primitive
+		m_CubeMesh = MeshCache::GetCube(1.0f);
+		HZ_INFO("Cube mesh: {} vertices, {} indices", m_CubeMesh->GetVertexCount(), m_CubeMesh->GetIndexCount());
 		
-		// Create sphere mesh
-		{
-			MeshData sphereData = MeshGenerator::CreateSphere(0.5f, 32);
-			
-			m_SphereMesh = std::make_shared<VertexArray>();
-			m_SphereVertexBuffer = std::make_shared<VertexBuffer>(
-				sphereData.Vertices.data(), 
-				static_cast<unsigned int>(sphereData.Vertices.size() * sizeof(float)));
-			m_SphereVertexBuffer->SetLayout({
-				{ ShaderDataType::Float3, "a_Position" },
-				{ ShaderDataType::Float3, "a_Normal" }
-			});
-			m_SphereMesh->AddVertexBuffer(m_SphereVertexBuffer.get());
-			
-			m_SphereIndexBuffer = std::make_shared<IndexBuffer>(
-				sphereData.Indices.data(), 
-				static_cast<unsigned int>(sphereData.Indices.size()));
-			m_SphereMesh->SetIndexBuffer(m_SphereIndexBuffer.get());
-		}
-		
-		// Create capsule mesh
-		{
-			MeshData capsuleData = MeshGenerator::CreateCapsule(1.0f, 0.5f, 32);
-			
-			m_CapsuleMesh = std::make_shared<VertexArray>();
-			m_CapsuleVertexBuffer = std::make_shared<VertexBuffer>(
-				capsuleData.Vertices.data(), 
-				static_cast<unsigned int>(capsuleData.Vertices.size() * sizeof(float)));
-			m_CapsuleVertexBuffer->SetLayout({
-				{ ShaderDataType::Float3, "a_Position" },
-				{ ShaderDataType::Float3, "a_Normal" }
-			});
-			m_CapsuleMesh->AddVertexBuffer(m_CapsuleVertexBuffer.get());
-			
-			m_CapsuleIndexBuffer = std::make_shared<IndexBuffer>(
-				capsuleData.Indices.data(), 
-				static_cast<unsigned int>(capsuleData.Indices.size()));
-			m_CapsuleMesh->SetIndexBuffer(m_CapsuleIndexBuffer.get());
-		}
+		m_SphereMesh = MeshCache::GetSphere(0.5f, 32);
+		m_CapsuleMesh = MeshCache::GetCapsule(1.0f, 0.5f, 32);
 	}
 
 	std::shared_ptr<Hazel::VertexArray> EditorLayer::GetMeshVertexArray(MeshType type)
@@ -1087,11 +1655,11 @@ namespace HazelEditor {
 		switch (type)
 		{
 		case MeshType::Cube:
-			return m_CubeMesh;
+			return m_CubeMesh ? m_CubeMesh->GetVertexArray() : nullptr;
 		case MeshType::Sphere:
-			return m_SphereMesh;
+			return m_SphereMesh ? m_SphereMesh->GetVertexArray() : nullptr;
 		case MeshType::Capsule:
-			return m_CapsuleMesh;
+			return m_CapsuleMesh ? m_CapsuleMesh->GetVertexArray() : nullptr;
 		default:
 			return nullptr;
 		}
@@ -1112,15 +1680,12 @@ namespace HazelEditor {
 		
 		// For now, just cycle through entities with meshes on click
 		// A proper implementation would do ray casting against mesh bounds
-		if (m_Entities.empty())
-			return;
-		
-		// Find entities with meshes
-		std::vector<Entity*> selectableEntities;
-		for (auto& entity : m_Entities)
+		// Find hierarchy entities with meshes
+		auto selectableEntities = Hazel::MakeFrameVector<Hazel::Entity>(m_HierarchyEntities.size());
+		for (Hazel::Entity entity : m_HierarchyEntities)
 		{
-			if (entity.Mesh != MeshType::None)
-				selectableEntities.push_back(&entity);
+			if (m_Scene.HasComponent<MeshRendererComponent>(entity))
+				selectableEntities.push_back(entity);
 		}
 		
 		if (selectableEntities.empty())
@@ -1140,11 +1705,10 @@ namespace HazelEditor {
 		// Select next entity (or first if none selected)
 		int nextIndex = (currentIndex + 1) % static_cast<int>(selectableEntities.size());
 		
-		ClearSelection();
-		selectableEntities[nextIndex]->IsSelected = true;
 		m_SelectedEntity = selectableEntities[nextIndex];
 		
-		HZ_INFO("Selected entity: " + m_SelectedEntity->Name);
+		const Hazel::NameComponent* name = m_Scene.GetComponent<Hazel::NameComponent>(m_SelectedEntity);
+		HZ_INFO("Selected entity: {}", name ? name->Name.c_str() : "(unnamed)");
 	}
 
 }
@@ -2,14 +2,24 @@
 
 #include "Hazel/Layer.h"
 #include "Hazel/Log.h"
+#include "Hazel/LogHistory.h"
 #include "Hazel/Renderer/EditorCamera.h"
+#include "Hazel/Renderer/CameraLatch.h"
 #include "Hazel/Renderer/Framebuffer.h"
 #include "Hazel/Renderer/Buffer.h"
 #include "Hazel/Renderer/Material.h"
 #include "Hazel/Renderer/Shader.h"
 #include "Hazel/Renderer/Light.h"
 #include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/Mesh.h"
+#include "Hazel/Renderer/ParallelDrawList.h"
+#include "Hazel/Memory/FrameAllocator.h"
+#include "Hazel/Scene/Scene.h"
+#include "Hazel/Scene/Components.h"
+#include "Hazel/Scene/TransformSystem.h"
+#include <imgui.h>
 #include <string>
+#include <unordered_set>
 #include <vector>
 #include <memory>
 #include <glm/glm.hpp>
@@ -24,6 +34,15 @@ namespace HazelEditor {
 		Scale
 	};
 
+	// File menu action waiting for a path
+	enum class ScenePathAction
+	{
+		None,
+		Open,
+		SaveAs,
+		ExportText
+	};
+
 	// Mesh type enumeration
 	enum class MeshType
 	{
@@ -33,30 +52,11 @@ namespace HazelEditor {
 		Capsule
 	};
 
-	// Transform component
-	struct Transform
+	// Drawn with the editor's mesh for 'Mesh'; entities without one have no renderer
+	struct MeshRendererComponent
 	{
-		glm::vec3 Position = { 0.0f, 0.0f, 0.0f };
-		glm::vec3 Rotation = { 0.0f, 0.0f, 0.0f };
-		glm::vec3 Scale = { 1.0f, 1.0f, 1.0f };
-
-		glm::mat4 GetTransformMatrix() const;
-	};
-
-	// Simple entity for scene hierarchy
-	struct Entity
-	{
-		std::string Name;
-		int ID;
-		bool IsSelected = false;
-		std::vector<Entity*> Children;
-		
-		// Components
-		Transform EntityTransform;
-		MeshType Mesh = MeshType::None;
+		MeshType Mesh = MeshType::Cube;
 		glm::vec4 Color = { 1.0f, 1.0f, 1.0f, 1.0f };
-
-		Entity(const std::string& name, int id) : Name(name), ID(id) {}
 	};
 
 	class EditorLayer : public Hazel::Layer
@@ -75,17 +75,37 @@ namespace HazelEditor {
 		void DrawSceneHierarchy();
 		void DrawInspector();
 		void DrawConsole();
+		void UpdateConsoleIndex(bool filterChanged);
 		void DrawGameView();
 		void DrawSceneView();
 		void DrawAssetBrowser();
+		void DrawMemoryPanel();
+		void DrawStatsOverlay();
 		void DrawToolbar();
+		void DrawScenePathPopup();
 
 		// Helper functions
-		void DrawEntityNode(Entity* entity);
-		void ClearSelection();
-		void CreateEntity(const std::string& name, MeshType meshType);
+		void DrawEntityNode(Hazel::Entity entity, int depth);
+		// Appends the entity, and its named children when expanded, as hierarchy rows
+		void AppendHierarchyRows(Hazel::Entity entity, int depth, Hazel::FrameVector<std::pair<Hazel::Entity, int>>& rows);
+		// Parents 'child' to 'parent' (null to detach) without moving it in the world
+		void ReparentEntity(Hazel::Entity child, Hazel::Entity parent);
+		Hazel::Entity CreateEntity(const std::string& name, MeshType meshType);
+		// Fills the scene with 'count' cubes on a grid
+		void SpawnStressTest(size_t count);
+
+		// Scene files (.hscene)
+		void NewScene();
+		bool OpenScene(const std::string& path);
+		bool SaveScene(const std::string& path);
+		void RequestScenePath(ScenePathAction action);
+		// Drops the editor state of the previous scene's entities
+		void ResetSceneState();
 		void RenderScene();
-		void FocusOnEntity(Entity* entity);
+		// Moves the camera from the cursor and keys as they are right now and
+		// publishes its view to m_CameraLatch; runs just before the scene draws
+		void LatchCameraInput();
+		void FocusOnEntity(Hazel::Entity entity);
 		void HandleSceneViewMousePicking();
 		
 		// Mesh management
@@ -94,20 +114,41 @@ namespace HazelEditor {
 
 	private:
 		// Scene data
-		std::vector<Entity> m_Entities;
-		Entity* m_SelectedEntity = nullptr;
+		Hazel::Scene m_Scene;
+		Hazel::Entity m_SelectedEntity;
+		Hazel::TransformSystem m_TransformSystem;
+		// Named entities in creation order; the hierarchy lists the roots among them
+		std::vector<Hazel::Entity> m_HierarchyEntities;
+		// Entity indices of the hierarchy nodes shown open
+		std::unordered_set<uint32_t> m_ExpandedEntities;
+		// File the scene was opened from or last saved to; empty until then
+		std::string m_ScenePath;
+		ScenePathAction m_ScenePathAction = ScenePathAction::None;
+		char m_ScenePathBuffer[260] = {};
 
 		// Editor state
 		bool m_IsPlaying = false;
 		bool m_IsPaused = false;
 
 		// Console state
-		bool m_ShowTrace = true;
-		bool m_ShowInfo = true;
-		bool m_ShowWarn = true;
-		bool m_ShowError = true;
-		bool m_ShowFatal = true;
+		uint32_t m_ConsoleLevelMask = Hazel::LogLevelAll;
+		ImGuiTextFilter m_ConsoleFilter;
 		bool m_AutoScroll = true;
+		// Sequence numbers of each level's history lines, oldest first; the
+		// first m_ConsoleLevelStart[level] have left the history
+		std::vector<uint64_t> m_ConsoleLevelLines[Hazel::LogLevelCount];
+		size_t m_ConsoleLevelStart[Hazel::LogLevelCount] = {};
+		// The lines shown: the enabled levels merged, narrowed by the search
+		std::vector<uint64_t> m_ConsoleIndex;
+		size_t m_ConsoleIndexStart = 0;
+		// History lines up to here have been sorted into the lists above
+		uint64_t m_ConsoleScanned = 0;
+
+		// Memory panel state
+		bool m_ShowMemoryPanel = true;
+
+		// Scene view statistics overlay
+		bool m_ShowStatsOverlay = true;
 
 		// Asset browser state
 		std::string m_CurrentDirectory = "Assets";
@@ -118,30 +159,27 @@ namespace HazelEditor {
 		std::shared_ptr<Hazel::Shader> m_SceneShader;
 		std::shared_ptr<Hazel::Material> m_DefaultMaterial;
 		std::shared_ptr<Hazel::DirectionalLight> m_SceneLight;
+		// Entity draws, recorded by jobs over the scene's chunks
+		Hazel::ParallelDrawList m_SceneDrawList;
 		
-		// Mesh buffers
-		std::shared_ptr<Hazel::VertexArray> m_CubeMesh;
-		std::shared_ptr<Hazel::VertexBuffer> m_CubeVertexBuffer;
-		std::shared_ptr<Hazel::IndexBuffer> m_CubeIndexBuffer;
-		
-		std::shared_ptr<Hazel::VertexArray> m_SphereMesh;
-		std::shared_ptr<Hazel::VertexBuffer> m_SphereVertexBuffer;
-		std::shared_ptr<Hazel::IndexBuffer> m_SphereIndexBuffer;
-		
-		std::shared_ptr<Hazel::VertexArray> m_CapsuleMesh;
-		std::shared_ptr<Hazel::VertexBuffer> m_CapsuleVertexBuffer;
-		std::shared_ptr<Hazel::IndexBuffer> m_CapsuleIndexBuffer;
+		// Meshes (shared through Hazel::MeshCache)
+		std::shared_ptr<Hazel::Mesh> m_CubeMesh;
+		std::shared_ptr<Hazel::Mesh> m_SphereMesh;
+		std::shared_ptr<Hazel::Mesh> m_CapsuleMesh;
 		
 		// Scene view state
 		glm::vec2 m_ViewportSize = { 1280.0f, 720.0f };
 		glm::vec2 m_ViewportBounds[2];
 		bool m_ViewportFocused = false;
 		bool m_ViewportHovered = false;
-		glm::vec2 m_LastMousePos = { 0.0f, 0.0f };
 		
 		// Camera control
 		bool m_CameraRotating = false;
-		int m_NextEntityID = 100;
+		Hazel::CameraLatch m_CameraLatch;
+		// GLFW cursor position at the previous latch; invalid after the cursor is moved
+		glm::dvec2 m_LatchedCursor = { 0.0, 0.0 };
+		bool m_LatchedCursorValid = false;
+		int64_t m_LastLatchTime = 0;
 		
 		// Gizmo state
 		GizmoOperation m_GizmoOperation = GizmoOperation::Translate;
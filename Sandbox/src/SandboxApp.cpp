@@ -1,6 +1,8 @@
 #include <Hazel.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/constants.hpp>
+#include <cmath>
 #include <memory>
 
 // Example game layer that demonstrates 3D rendering with materials and lighting
@@ -21,63 +23,8 @@ public:
 		m_Camera->SetPerspective(45.0f, 16.0f / 9.0f, 0.1f, 100.0f);
 		m_Camera->SetPosition(glm::vec3(0.0f, 0.0f, 5.0f));
 
-		// Create cube vertex data
-		float vertices[] = {
-			// positions          // normals
-			-0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-			 0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-			 0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-			-0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-
-			-0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-			 0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-			 0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-			-0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-
-			-0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
-			-0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
-			-0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
-			-0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
-
-			 0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
-			 0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
-			 0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
-			 0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
-
-			-0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
-			 0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
-			 0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
-			-0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
-
-			-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,
-			 0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,
-			 0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
-			-0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
-		};
-
-		unsigned int indices[] = {
-			0, 1, 2, 2, 3, 0,       // front
-			4, 5, 6, 6, 7, 4,       // back
-			8, 9, 10, 10, 11, 8,    // left
-			12, 13, 14, 14, 15, 12, // right
-			16, 17, 18, 18, 19, 16, // bottom
-			20, 21, 22, 22, 23, 20  // top
-		};
-
-		// Create vertex array
-		m_VertexArray = std::make_shared<Hazel::VertexArray>();
-
-		// Create vertex buffer
-		m_VertexBuffer = std::make_shared<Hazel::VertexBuffer>(vertices, sizeof(vertices));
-		m_VertexBuffer->SetLayout({
-			{ Hazel::ShaderDataType::Float3, "a_Position" },
-			{ Hazel::ShaderDataType::Float3, "a_Normal" }
-		});
-		m_VertexArray->AddVertexBuffer(m_VertexBuffer.get());
-
-		// Create index buffer
-		m_IndexBuffer = std::make_shared<Hazel::IndexBuffer>(indices, sizeof(indices) / sizeof(unsigned int));
-		m_VertexArray->SetIndexBuffer(m_IndexBuffer.get());
+		// Get the shared cube mesh (generated and uploaded once per process)
+		m_CubeMesh = Hazel::MeshCache::GetCube(1.0f);
 
 		// Create shader
 		std::string vertexSrc = R"(
@@ -87,6 +34,7 @@ public:
 
 			uniform mat4 u_ViewProjection;
 			uniform mat4 u_Transform;
+			uniform mat3 u_NormalMatrix;
 
 			out vec3 v_FragPos;
 			out vec3 v_Normal;
@@ -94,7 +42,7 @@ public:
 			void main()
 			{
 				v_FragPos = vec3(u_Transform * vec4(a_Position, 1.0));
-				v_Normal = mat3(transpose(inverse(u_Transform))) * a_Normal;
+				v_Normal = u_NormalMatrix * a_Normal;
 				gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
 			}
 		)";
@@ -183,14 +131,10 @@ public:
 		// after the context has been destroyed by GLFW
 		
 		// Release resources in reverse order of creation/dependency:
-		// 1. Vertex array (references buffers, so release first)
-		m_VertexArray.reset();
+		// 1. Mesh handle
+		m_CubeMesh.reset();
 		
-		// 2. Index and vertex buffers
-		m_IndexBuffer.reset();
-		m_VertexBuffer.reset();
-		
-		// 3. High-level rendering resources
+		// 2. High-level rendering resources
 		m_Light.reset();
 		m_Material.reset();
 		m_Shader.reset();
@@ -201,6 +145,8 @@ public:
 
 	virtual void OnUpdate(float deltaTime) override
 	{
+		HZ_PROFILE_FUNCTION();
+
 		// Rotate the cube
 		m_Rotation += deltaTime * 50.0f; // 50 degrees per second
 		if (m_Rotation > 360.0f)
@@ -220,7 +166,7 @@ public:
 		transform = glm::rotate(transform, glm::radians(m_Rotation), glm::vec3(0.5f, 1.0f, 0.0f));
 
 		// Submit draw call
-		Hazel::Renderer::Submit(m_VertexArray, m_Material, transform);
+		Hazel::Renderer::Submit(m_CubeMesh->GetVertexArray(), m_Material, transform);
 
 		// End scene
 		Hazel::Renderer::EndScene();
@@ -231,11 +177,12 @@ public:
 		// ImGui windows can be added here to control the 3D scene
 	}
 
+	// OnUpdate only goes through the Renderer, so it can run ahead on a worker
+	virtual bool SupportsPipelinedUpdate() const override { return true; }
+
 private:
 	std::shared_ptr<Hazel::Camera> m_Camera;
-	std::shared_ptr<Hazel::VertexArray> m_VertexArray;
-	std::shared_ptr<Hazel::VertexBuffer> m_VertexBuffer;
-	std::shared_ptr<Hazel::IndexBuffer> m_IndexBuffer;
+	std::shared_ptr<Hazel::Mesh> m_CubeMesh;
 	std::shared_ptr<Hazel::Shader> m_Shader;
 	std::shared_ptr<Hazel::Material> m_Material;
 	std::shared_ptr<Hazel::DirectionalLight> m_Light;
@@ -268,10 +215,15 @@ public:
 
 	virtual void OnUpdate(float deltaTime) override
 	{
+		HZ_PROFILE_FUNCTION();
+
 		// Update game logic
 		m_PlayerScript.OnUpdate(deltaTime);
 	}
 
+	// Game logic only; never touches OpenGL
+	virtual bool UsesDirectOpenGL() const override { return false; }
+
 	virtual void OnImGuiRender() override
 	{
 		// ImGui dockable windows would be rendered here
@@ -285,12 +237,294 @@ private:
 	Hazel::ScriptComponent m_PlayerScript;
 };
 
+// Example layer that demonstrates skeletal animation: a field of tentacles,
+// each with its own animator, skinned on the GPU (or the CPU as a fallback)
+class AnimationLayer : public Hazel::Layer
+{
+public:
+	AnimationLayer()
+		: Layer("AnimationLayer")
+	{
+	}
+
+	virtual void OnAttach() override
+	{
+		HZ_INFO("AnimationLayer::OnAttach - Initializing skeletal animation demo");
+
+		m_Camera = std::make_shared<Hazel::Camera>(Hazel::Camera::ProjectionType::Perspective);
+		m_Camera->SetPerspective(45.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+		m_Camera->SetPosition(glm::vec3(0.0f, 0.0f, 5.0f));
+
+		// A chain of joints standing up along +Y
+		m_Skeleton = std::make_shared<Hazel::Skeleton>();
+		int32_t parent = -1;
+		for (int i = 0; i < s_JointCount; i++)
+		{
+			Hazel::JointTransform bind;
+			bind.Translation = glm::vec3(0.0f, i == 0 ? 0.0f : s_JointLength, 0.0f);
+			parent = m_Skeleton->AddJoint("Joint" + std::to_string(i), parent, bind);
+		}
+
+		// Two clips bending the chain around different axes
+		m_Clips[0] = CreateWaveClip("Sway", glm::vec3(0.0f, 0.0f, 1.0f), 2.0f);
+		m_Clips[1] = CreateWaveClip("Swirl", glm::vec3(1.0f, 0.0f, 0.0f), 1.5f);
+
+		m_Mesh = CreateTentacleMesh();
+
+		m_Animators.reserve(s_CharacterCount);
+		for (int i = 0; i < s_CharacterCount; i++)
+		{
+			m_Animators.emplace_back(m_Skeleton);
+			m_Animators.back().Play(m_Clips[i % 2]);
+			m_Animators.back().Update(0.1f * i); // De-synchronize the field
+			m_AnimatorPointers.push_back(&m_Animators.back());
+		}
+
+		m_UseGPUSkinning = Hazel::SkinningBuffer::IsSupported();
+		if (m_UseGPUSkinning)
+			m_SkinningBuffer = std::make_unique<Hazel::SkinningBuffer>(s_CharacterCount);
+
+		std::string vertexSrc = m_UseGPUSkinning ? R"(
+			#version 330 core
+			layout(location = 0) in vec3 a_Position;
+			layout(location = 1) in vec3 a_Normal;
+			layout(location = 2) in vec4 a_Joints;
+			layout(location = 3) in vec4 a_Weights;
+
+			layout(std140) uniform BoneMatrices { mat4 u_Bones[128]; };
+
+			uniform mat4 u_ViewProjection;
+			uniform mat4 u_Transform;
+
+			out vec3 v_Normal;
+
+			void main()
+			{
+				mat4 skin = u_Bones[int(a_Joints.x)] * a_Weights.x
+				          + u_Bones[int(a_Joints.y)] * a_Weights.y
+				          + u_Bones[int(a_Joints.z)] * a_Weights.z
+				          + u_Bones[int(a_Joints.w)] * a_Weights.w;
+
+				v_Normal = mat3(u_Transform) * mat3(skin) * a_Normal;
+				gl_Position = u_ViewProjection * u_Transform * skin * vec4(a_Position, 1.0);
+			}
+		)" : R"(
+			#version 330 core
+			layout(location = 0) in vec3 a_Position;
+			layout(location = 1) in vec3 a_Normal;
+
+			uniform mat4 u_ViewProjection;
+			uniform mat4 u_Transform;
+
+			out vec3 v_Normal;
+
+			void main()
+			{
+				v_Normal = mat3(u_Transform) * a_Normal;
+				gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
+			}
+		)";
+
+		std::string fragmentSrc = R"(
+			#version 330 core
+			layout(location = 0) out vec4 color;
+
+			struct Material {
+				vec4 color;
+				float shininess;
+				float metallic;
+				float roughness;
+			};
+
+			struct DirectionalLight {
+				vec3 direction;
+				vec3 color;
+				float intensity;
+			};
+
+			in vec3 v_Normal;
+
+			uniform Material u_Material;
+			uniform DirectionalLight u_DirectionalLights[4];
+			uniform int u_DirectionalLightCount;
+
+			void main()
+			{
+				vec3 normal = normalize(v_Normal);
+				vec3 result = 0.2 * u_Material.color.rgb;
+				for (int i = 0; i < u_DirectionalLightCount; i++)
+				{
+					float diff = max(dot(normal, normalize(-u_DirectionalLights[i].direction)), 0.0);
+					result += diff * u_DirectionalLights[i].color * u_DirectionalLights[i].intensity * u_Material.color.rgb;
+				}
+				color = vec4(result, u_Material.color.a);
+			}
+		)";
+
+		m_Shader = std::make_shared<Hazel::Shader>(vertexSrc, fragmentSrc);
+		if (m_UseGPUSkinning)
+			m_Shader->SetUniformBlockBinding(Hazel::SkinningBuffer::BlockName, Hazel::SkinningBuffer::BindingPoint);
+
+		m_Material = std::make_shared<Hazel::Material>(m_Shader);
+		m_Material->SetColor(glm::vec4(0.9f, 0.5f, 0.3f, 1.0f));
+
+		HZ_INFO("Skeletal animation demo: {} characters, {}, {} pose blending", s_CharacterCount,
+		        m_UseGPUSkinning ? "GPU skinning" : "CPU skinning fallback",
+		        Hazel::PoseOps::IsSimdEnabled() ? "SIMD" : "scalar");
+	}
+
+	virtual void OnDetach() override
+	{
+		// Release OpenGL resources while the context is still alive
+		m_SkinningBuffer.reset();
+		m_Mesh.reset();
+		m_Material.reset();
+		m_Shader.reset();
+		m_Camera.reset();
+	}
+
+	virtual void OnUpdate(float deltaTime) override
+	{
+		HZ_PROFILE_FUNCTION();
+
+		// Alternate clips every few seconds to exercise cross-fading
+		m_SwitchTimer += deltaTime;
+		if (m_SwitchTimer > 3.0f)
+		{
+			m_SwitchTimer = 0.0f;
+			m_ClipIndex ^= 1;
+			for (size_t i = 0; i < m_Animators.size(); i++)
+				m_Animators[i].CrossFade(m_Clips[(m_ClipIndex + i) % 2], 0.5f);
+		}
+
+		// Sample, blend and build skinning matrices for every character in parallel
+		Hazel::AnimationSystem::Update(m_AnimatorPointers, deltaTime);
+
+		if (m_UseGPUSkinning)
+		{
+			for (int i = 0; i < s_CharacterCount; i++)
+				m_SkinningBuffer->SetPalette(i, m_Animators[i].GetSkinningMatrices().data(), s_JointCount);
+			m_SkinningBuffer->Upload();
+		}
+
+		Hazel::Renderer::BeginScene(*m_Camera);
+
+		for (int i = 0; i < s_CharacterCount; i++)
+		{
+			int x = i % s_GridSize;
+			int z = i / s_GridSize;
+			glm::mat4 transform = glm::translate(glm::mat4(1.0f),
+				glm::vec3((x - s_GridSize * 0.5f) * 1.2f, -3.0f, -6.0f - z * 1.2f));
+
+			if (m_UseGPUSkinning)
+			{
+				m_SkinningBuffer->Bind(i);
+				Hazel::Renderer::Submit(m_Mesh->GetVertexArray(), m_Material, transform);
+			}
+			else
+			{
+				Hazel::Renderer::Submit(m_Mesh->SkinOnCPU(m_Animators[i].GetSkinningMatrices().data()), m_Material, transform);
+			}
+		}
+
+		Hazel::Renderer::EndScene();
+	}
+
+	// Palette uploads and bindings are recorded with the draws; CPU skinning maps buffers and cannot
+	virtual bool SupportsPipelinedUpdate() const override { return m_UseGPUSkinning; }
+
+private:
+	std::shared_ptr<Hazel::AnimationClip> CreateWaveClip(const std::string& name, const glm::vec3& axis, float duration)
+	{
+		auto clip = std::make_shared<Hazel::AnimationClip>(name, *m_Skeleton, duration);
+		for (uint32_t frame = 0; frame < clip->GetFrameCount(); frame++)
+		{
+			float phase = frame / (clip->GetSampleRate() * duration) * glm::two_pi<float>();
+			for (uint32_t joint = 1; joint < m_Skeleton->GetJointCount(); joint++)
+			{
+				Hazel::JointTransform transform = clip->GetJointTransform(frame, joint);
+				transform.Rotation = glm::angleAxis(0.25f * std::sin(phase + joint * 0.6f), axis);
+				clip->SetJointTransform(frame, joint, transform);
+			}
+		}
+		return clip;
+	}
+
+	// Cylinder along the joint chain; each ring is weighted between its two nearest joints
+	std::unique_ptr<Hazel::SkinnedMesh> CreateTentacleMesh()
+	{
+		const int segments = 12;
+		const int rings = s_JointCount * 4;
+		const float height = (s_JointCount - 1) * s_JointLength;
+
+		std::vector<Hazel::SkinnedVertex> vertices;
+		std::vector<unsigned int> indices;
+		for (int ring = 0; ring <= rings; ring++)
+		{
+			float y = height * ring / rings;
+			float radius = 0.15f * (1.0f - 0.7f * y / height);
+			float jointPosition = y / s_JointLength;
+			int joint = (std::min)(static_cast<int>(jointPosition), s_JointCount - 2);
+			float blend = (std::min)(jointPosition - joint, 1.0f);
+
+			for (int s = 0; s <= segments; s++)
+			{
+				float angle = glm::two_pi<float>() * s / segments;
+				Hazel::SkinnedVertex vertex;
+				vertex.Normal = glm::vec3(std::cos(angle), 0.0f, std::sin(angle));
+				vertex.Position = glm::vec3(0.0f, y, 0.0f) + vertex.Normal * radius;
+				vertex.Joints = glm::vec4(static_cast<float>(joint), static_cast<float>(joint + 1), 0.0f, 0.0f);
+				vertex.Weights = glm::vec4(1.0f - blend, blend, 0.0f, 0.0f);
+				vertices.push_back(vertex);
+			}
+		}
+
+		for (int ring = 0; ring < rings; ring++)
+		{
+			for (int s = 0; s < segments; s++)
+			{
+				unsigned int current = ring * (segments + 1) + s;
+				unsigned int next = current + segments + 1;
+				indices.insert(indices.end(), { current, next, current + 1, current + 1, next, next + 1 });
+			}
+		}
+
+		return std::make_unique<Hazel::SkinnedMesh>(vertices, indices);
+	}
+
+private:
+	static constexpr int s_JointCount = 8;
+	static constexpr float s_JointLength = 0.5f;
+	static constexpr int s_GridSize = 20;
+	static constexpr int s_CharacterCount = s_GridSize * s_GridSize;
+
+	std::shared_ptr<Hazel::Camera> m_Camera;
+	std::shared_ptr<Hazel::Skeleton> m_Skeleton;
+	std::shared_ptr<Hazel::AnimationClip> m_Clips[2];
+	std::unique_ptr<Hazel::SkinnedMesh> m_Mesh;
+	std::unique_ptr<Hazel::SkinningBuffer> m_SkinningBuffer;
+	std::shared_ptr<Hazel::Shader> m_Shader;
+	std::shared_ptr<Hazel::Material> m_Material;
+
+	std::vector<Hazel::Animator> m_Animators;
+	std::vector<Hazel::Animator*> m_AnimatorPointers;
+	bool m_UseGPUSkinning = false;
+	float m_SwitchTimer = 0.0f;
+	int m_ClipIndex = 0;
+};
+
 class Sandbox : public Hazel::Application
 {
 public:
-	Sandbox()
+	Sandbox(const Hazel::ApplicationSettings& settings)
+		: Hazel::Application(settings)
 	{
 		HZ_INFO("Sandbox Application Created");
+
+		// Simulate the next frame while the current one renders
+		SetFrameMode(Hazel::FrameMode::Pipelined);
+		// Replay recorded frames and talk to the driver on a dedicated thread
+		SetRenderThreadEnabled(true);
 		
 		// Add ImGui layer for dockable windows
 		PushOverlay(new Hazel::ImGuiLayer());
@@ -298,6 +532,9 @@ public:
 		// Add 3D rendering demo layer
 		PushLayer(new Render3DLayer());
 		
+		// Add skeletal animation demo layer
+		PushLayer(new AnimationLayer());
+
 		// Add game layer
 		PushLayer(new GameLayer());
 		
@@ -307,6 +544,7 @@ public:
 		HZ_INFO("  2. Dockable Windows - ImGui integration with docking support");
 		HZ_INFO("  3. C# Scripting - Mono runtime integration for hot-reloadable scripts");
 		HZ_INFO("  4. 3D Rendering - Rotating cube with materials and lighting");
+		HZ_INFO("  5. Skeletal Animation - Field of skinned, cross-fading tentacles");
 	}
 
 	~Sandbox()
@@ -315,7 +553,9 @@ public:
 	}
 };
 
-Hazel::Application* Hazel::CreateApplication()
+Hazel::Application* Hazel::CreateApplication(const Hazel::ApplicationSettings& settings)
 {
-	return new Sandbox();
+	Hazel::ApplicationSettings sandboxSettings = settings;
+	sandboxSettings.Name = "Hazel Sandbox";
+	return new Sandbox(sandboxSettings);
 }
\ No newline at end of file